@@ -572,7 +572,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
  * @param descr Pointer to the descriptor array
  * @param descr_len Number of elements in the descriptor array. Must be less
  * than 63 due to implementation detail reasons (if more fields are
- * necessary, use two descriptors)
+ * necessary, use json_obj_parse_fields())
  * @param val Pointer to the struct to hold the decoded values
  *
  * @return < 0 if error, bitmap of decoded fields on success (bit 0
@@ -582,6 +582,39 @@ int64_t json_obj_parse(char *json, size_t len,
 	const struct json_obj_descr *descr, size_t descr_len,
 	void *val);
 
+/**
+ * @brief Number of 32-bit words of the bitmap of decoded fields given to
+ * json_obj_parse_fields().
+ *
+ * @param descr_len Number of elements in the descriptor array
+ */
+#define JSON_OBJ_DECODED_WORDS(descr_len) DIV_ROUND_UP(descr_len, 32)
+
+/**
+ * @brief Parses the JSON-encoded object pointed to by @a json, as
+ * json_obj_parse() does, for descriptors of any number of fields.
+ *
+ * The decoded fields are reported in the bitmap pointed to by @a decoded:
+ * bit i % 32 of word i / 32 is set if the i-th field in the descriptor has
+ * been properly decoded.
+ *
+ * The descriptors of nested objects can have up to
+ * CONFIG_JSON_LIBRARY_MAX_FIELDS fields, -EINVAL is returned otherwise.
+ *
+ * @param json Pointer to JSON-encoded value to be parsed
+ * @param len Length of JSON-encoded value
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array
+ * @param val Pointer to the struct to hold the decoded values
+ * @param decoded Bitmap of JSON_OBJ_DECODED_WORDS(@a descr_len) words
+ * receiving the decoded fields
+ *
+ * @return < 0 if error, number of decoded fields on success.
+ */
+int json_obj_parse_fields(char *json, size_t len,
+			  const struct json_obj_descr *descr, size_t descr_len,
+			  void *val, uint32_t *decoded);
+
 /**
  * @brief Parses the JSON-encoded array pointed to by @a json, with
  * size @a len, according to the descriptor pointed to by @a descr.
@@ -643,7 +676,8 @@ int json_arr_separate_object_parse_init(struct json_obj *json, char *payload, si
  *
  * @param json Pointer to JSON-object message state
  * @param descr Pointer to the descriptor array
- * @param descr_len Number of elements in the descriptor array. Must be less than 31.
+ * @param descr_len Number of elements in the descriptor array. Must be less than 32,
+ * -EINVAL is returned otherwise.
  * @param val Pointer to the struct to hold the decoded values
  *
  * @return < 0 if error, 0 for end of message, bitmap of decoded fields on success (bit 0
@@ -764,6 +798,124 @@ int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
 int json_arr_encode(const struct json_obj_descr *descr, const void *val,
 		    json_append_bytes_t append_bytes, void *data);
 
+/** Maximum nesting of objects and arrays of the streaming parser */
+#define JSON_STREAM_MAX_DEPTH 32
+
+/**
+ * @brief Token reported by the streaming parser
+ */
+struct json_stream_token {
+	/** JSON_TOK_OBJECT_START, JSON_TOK_OBJECT_END, JSON_TOK_ARRAY_START,
+	 * JSON_TOK_ARRAY_END, JSON_TOK_STRING, JSON_TOK_NUMBER, JSON_TOK_TRUE,
+	 * JSON_TOK_FALSE or JSON_TOK_NULL
+	 */
+	enum json_tokens type;
+
+	/** Key of the object member, NULL for the elements of arrays, the top
+	 * level value and the ends of objects and arrays. NUL-terminated.
+	 */
+	const char *key;
+
+	/** Length of the key */
+	size_t key_len;
+
+	/** Text of strings, without the quotes and not unescaped, and of
+	 * numbers. NULL for the other tokens. NUL-terminated.
+	 */
+	const char *value;
+
+	/** Length of the value */
+	size_t value_len;
+
+	/** Nesting level, 0 for the top level value and its end */
+	size_t depth;
+};
+
+/**
+ * @brief Callback of the streaming parser, called for each token.
+ *
+ * The key and value of the token are only valid during the call.
+ *
+ * @param token Token parsed
+ * @param user_data User data given to json_stream_init()
+ *
+ * @return 0 to go on parsing, or a negative number to stop, which is then
+ * returned by json_stream_feed().
+ */
+typedef int (*json_stream_cb_t)(const struct json_stream_token *token,
+				void *user_data);
+
+/**
+ * @brief Streaming parser state
+ *
+ * The members are internal to the parser.
+ */
+struct json_stream {
+	json_stream_cb_t cb;
+	void *user_data;
+	char *buf;
+	size_t buf_size;
+	size_t buf_len;
+	size_t key_len;
+	uint32_t arrays;
+	uint8_t depth;
+	uint8_t state;
+	uint8_t escape;
+	bool has_key;
+	int error;
+};
+
+/**
+ * @brief Initialize a streaming parser
+ *
+ * The streaming parser parses a JSON document given in chunks of any size,
+ * as they are received, and reports its tokens to a callback. It does not
+ * need the whole document: only the key and value being parsed are kept,
+ * in the buffer given. The parsing liberties of json_obj_parse() apply.
+ *
+ * @param stream Parser to initialize
+ * @param buf Buffer for the key and the value being parsed, which must fit
+ * the longest key and string or number value, their terminators included
+ * @param buf_size Size of the buffer
+ * @param cb Callback called for each token
+ * @param user_data User data given to the callback
+ */
+void json_stream_init(struct json_stream *stream, char *buf, size_t buf_size,
+		      json_stream_cb_t cb, void *user_data);
+
+/**
+ * @brief Parse a chunk of a JSON document
+ *
+ * @param stream Parser
+ * @param data Next bytes of the document
+ * @param len Number of bytes
+ *
+ * @retval 0 if the chunk has been parsed.
+ * @retval -EINVAL if the document is invalid.
+ * @retval -ENOMEM if a key or value does not fit the buffer.
+ * @retval -ENOSPC if objects and arrays are nested deeper than
+ * JSON_STREAM_MAX_DEPTH.
+ * @retval <0 error returned by the callback.
+ *
+ * Once an error has been returned, it is returned by all the following
+ * calls.
+ */
+int json_stream_feed(struct json_stream *stream, const char *data, size_t len);
+
+/**
+ * @brief Finish parsing a JSON document
+ *
+ * Ends the top level value if it is a number, and checks the document is
+ * complete.
+ *
+ * @param stream Parser
+ *
+ * @retval 0 if a complete document has been parsed.
+ * @retval -EINVAL if the document is truncated.
+ * @retval <0 error returned by json_stream_feed() before.
+ */
+int json_stream_finish(struct json_stream *stream);
+
 #ifdef __cplusplus
 }
 #endif
@@ -31,6 +31,27 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Non-volatile Storage statistics
+ *
+ * Statistics are kept from the last nvs_mount().
+ *
+ * @param gc_count Number of sector garbage collections
+ * @param gc_time_max_us Longest time a write waited for garbage collection
+ * @param gc_time_total_us Total time writes waited for garbage collection
+ * @param bg_time_total_us Total time spent in background garbage collection
+ * @param erase_count Number of erases of each sector
+ */
+struct nvs_stats {
+	uint32_t gc_count;
+	uint32_t gc_time_max_us;
+	uint64_t gc_time_total_us;
+	uint64_t bg_time_total_us;
+#if CONFIG_NVS_STATS
+	uint32_t erase_count[CONFIG_NVS_STATS_SECTOR_COUNT];
+#endif
+};
+
 /**
  * @brief Non-volatile Storage File system structure
  *
@@ -58,6 +79,18 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_NVS_GC_BACKGROUND
+	struct k_work gc_work;
+	struct k_condvar gc_erase_done;
+	uint32_t gc_erase_addr;
+	bool gc_erasing;
+	uint32_t gc_copy_addr;
+	uint32_t gc_copy_sector;
+	uint8_t gc_copy_state;
+#endif
+#if CONFIG_NVS_STATS
+	struct nvs_stats stats;
+#endif
 };
 
 /**
@@ -168,6 +201,19 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len, ui
  */
 ssize_t nvs_calc_free_space(struct nvs_fs *fs);
 
+/**
+ * @brief nvs_stats_get
+ *
+ * Get the erase counts and garbage collection times of the file system.
+ * Requires CONFIG_NVS_STATS.
+ *
+ * @param fs Pointer to file system
+ * @param stats Pointer to the statistics to fill
+ * @retval 0 Success
+ * @retval -ERRNO errno code if error
+ */
+int nvs_stats_get(struct nvs_fs *fs, struct nvs_stats *stats);
+
 /**
  * @}
  */
@@ -4349,6 +4349,23 @@ struct k_msgq {
 	/** Message queue */
 	uint8_t flags;
 
+#if defined(CONFIG_MSGQ_LOCKFREE) || defined(__DOXYGEN__)
+	/** Sequence numbers of the slots of a lock-free queue, NULL otherwise */
+	atomic_t *lf_seq;
+	/** Position of the next slot to write */
+	atomic_t lf_tail;
+	/** Position of the next slot to read */
+	atomic_t lf_head;
+	/** Threads waiting to get from a lock-free queue, those waiting to
+	 * put are in wait_q
+	 */
+	_wait_q_t lf_get_wait_q;
+	/** Number of threads waiting, or about to wait, to put */
+	atomic_t lf_put_waiters;
+	/** Number of threads waiting, or about to wait, to get */
+	atomic_t lf_get_waiters;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_msgq)
 };
 /**
@@ -4369,12 +4386,29 @@ struct k_msgq {
 	_POLL_EVENT_OBJ_INIT(obj) \
 	}
 
+#define Z_MSGQ_LOCKFREE_INITIALIZER(obj, q_buffer, q_seq, q_msg_size, q_max_msgs) \
+	{ \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.msg_size = q_msg_size, \
+	.max_msgs = q_max_msgs, \
+	.buffer_start = q_buffer, \
+	.buffer_end = q_buffer + (q_max_msgs * q_msg_size), \
+	.read_ptr = q_buffer, \
+	.write_ptr = q_buffer, \
+	.used_msgs = 0, \
+	_POLL_EVENT_OBJ_INIT(obj) \
+	.flags = K_MSGQ_FLAG_LOCKFREE, \
+	.lf_seq = q_seq, \
+	.lf_get_wait_q = Z_WAIT_Q_INIT(&obj.lf_get_wait_q), \
+	}
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
 
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
+#define K_MSGQ_FLAG_LOCKFREE	BIT(1)
 
 /**
  * @brief Message Queue Attributes
@@ -4435,6 +4469,65 @@ struct k_msgq_attrs {
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs);
 
+#if defined(CONFIG_MSGQ_LOCKFREE) || defined(__DOXYGEN__)
+
+/**
+ * @brief Statically define and initialize a lock-free message queue.
+ *
+ * A lock-free message queue is used with the same APIs as other message
+ * queues. Threads and ISRs put and get messages without taking the queue's
+ * lock, so that producers and consumers running at the same time on
+ * different CPUs do not serialize on it; the lock and the wait queue are
+ * only used by threads that have to wait. Each slot of the ring buffer has
+ * a sequence number telling whether it holds a message, in the style of
+ * Dmitry Vyukov's bounded MPMC queue.
+ *
+ * Unlike other message queues, messages are not handed directly to a
+ * waiting thread: it is woken up and tries again, so a message put while
+ * threads are waiting can be taken by another thread first. Polling
+ * lock-free message queues with k_poll() is supported, but peeking may
+ * fail with -ENOMSG while messages are being taken concurrently.
+ *
+ * @param q_name Name of the message queue.
+ * @param q_msg_size Message size (in bytes).
+ * @param q_max_msgs Maximum number of messages that can be queued, a power
+ *	of 2.
+ * @param q_align Alignment of the message queue's ring buffer.
+ *
+ * @see K_MSGQ_DEFINE
+ */
+#define K_MSGQ_DEFINE_LOCKFREE(q_name, q_msg_size, q_max_msgs, q_align)	\
+	BUILD_ASSERT(IS_POWER_OF_TWO(q_max_msgs),				\
+		     "lock-free message queue length must be a power of 2");	\
+	static char __noinit __aligned(q_align)				\
+		_k_fifo_buf_##q_name[(q_max_msgs) * (q_msg_size)];	\
+	static atomic_t _k_msgq_seq_##q_name[(q_max_msgs)];		\
+	STRUCT_SECTION_ITERABLE(k_msgq, q_name) =			\
+	       Z_MSGQ_LOCKFREE_INITIALIZER(q_name, _k_fifo_buf_##q_name,	\
+					   _k_msgq_seq_##q_name,		\
+					   (q_msg_size), (q_max_msgs))
+
+/**
+ * @brief Initialize a lock-free message queue.
+ *
+ * This routine initializes a lock-free message queue object, prior to its
+ * first use.
+ *
+ * @param msgq Address of the message queue.
+ * @param buffer Pointer to ring buffer that holds queued messages.
+ * @param seq Array of @a max_msgs sequence numbers, one per slot of the
+ *	ring buffer.
+ * @param msg_size Message size (in bytes).
+ * @param max_msgs Maximum number of messages that can be queued, a power
+ *	of 2.
+ *
+ * @see K_MSGQ_DEFINE_LOCKFREE
+ */
+void k_msgq_lockfree_init(struct k_msgq *msgq, char *buffer, atomic_t *seq,
+			  size_t msg_size, uint32_t max_msgs);
+
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 /**
  * @brief Initialize a message queue.
  *
@@ -4583,9 +4676,11 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 				 struct k_msgq_attrs *attrs);
 
 
+static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq);
+
 static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
 {
-	return msgq->max_msgs - msgq->used_msgs;
+	return msgq->max_msgs - z_impl_k_msgq_num_used_get(msgq);
 }
 
 /**
@@ -4601,6 +4696,16 @@ __syscall uint32_t k_msgq_num_used_get(struct k_msgq *msgq);
 
 static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq)
 {
+#ifdef CONFIG_MSGQ_LOCKFREE
+	if ((msgq->flags & K_MSGQ_FLAG_LOCKFREE) != 0U) {
+		/* Read the head first, so the difference is never negative */
+		atomic_val_t head = atomic_get(&msgq->lf_head);
+		atomic_val_t tail = atomic_get(&msgq->lf_tail);
+
+		return MIN((unsigned long)tail - (unsigned long)head, msgq->max_msgs);
+	}
+#endif
+
 	return msgq->used_msgs;
 }
 
@@ -4788,6 +4893,16 @@ struct k_pipe {
 
 	uint8_t	       flags;		/**< Flags */
 
+#if defined(CONFIG_PIPES_ZERO_COPY) || defined(__DOXYGEN__)
+	struct {
+		size_t             read_size;  /**< Size of the read claim */
+		size_t             write_size; /**< Size of the write claim */
+		struct _pipe_desc *read_peer;  /**< Writer lending the read claim */
+		struct _pipe_desc *write_peer; /**< Reader lending the write claim */
+		_wait_q_t          wait_q;     /**< Lenders waiting to return */
+	} claim;			/**< Zero-copy claims */
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_pipe)
 };
 
@@ -4795,6 +4910,17 @@ struct k_pipe {
  * @cond INTERNAL_HIDDEN
  */
 #define K_PIPE_FLAG_ALLOC	BIT(0)	/** Buffer was allocated */
+#define K_PIPE_FLAG_READ_CLAIM	BIT(1)	/** Data is claimed for reading */
+#define K_PIPE_FLAG_WRITE_CLAIM	BIT(2)	/** Space is claimed for writing */
+
+#ifdef CONFIG_PIPES_ZERO_COPY
+#define Z_PIPE_CLAIM_INIT(obj)                                      \
+	.claim = {                                                  \
+		.wait_q = Z_WAIT_Q_INIT(&obj.claim.wait_q),         \
+	},
+#else
+#define Z_PIPE_CLAIM_INIT(obj)
+#endif
 
 #define Z_PIPE_INITIALIZER(obj, pipe_buffer, pipe_buffer_size)     \
 	{                                                           \
@@ -4810,6 +4936,7 @@ struct k_pipe {
 	},                                                          \
 	_POLL_EVENT_OBJ_INIT(obj)                                   \
 	.flags = 0,                                                 \
+	Z_PIPE_CLAIM_INIT(obj)                                      \
 	}
 
 /**
@@ -4968,12 +5095,137 @@ __syscall void k_pipe_flush(struct k_pipe *pipe);
  */
 __syscall void k_pipe_buffer_flush(struct k_pipe *pipe);
 
+#if defined(CONFIG_PIPES_ZERO_COPY) || defined(__DOXYGEN__)
+
+/**
+ * @brief Claim data to read from a pipe without copying it.
+ *
+ * This routine gives direct access to up to @a size bytes of data of
+ * @a pipe, which are read once k_pipe_read_finish() is called. The data is
+ * in the buffer of the first thread waiting to write to the pipe, which
+ * keeps waiting meanwhile, if the pipe's ring buffer is empty. Otherwise it
+ * is in the ring buffer. The data claimed is contiguous, so there may be
+ * less than what can be read from the pipe.
+ *
+ * Only one read claim at a time is allowed, and no other thread may read
+ * from the pipe until it is finished. Both sides of an unbuffered pipe
+ * cannot use claims, as there is no memory they can share.
+ *
+ * @note This routine is not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the address of the data.
+ * @param size Address of the maximum number of bytes to claim, set to the
+ *             number of bytes claimed.
+ * @param timeout Waiting period to wait for data to be available,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Data was claimed.
+ * @retval -EINVAL invalid parameters supplied
+ * @retval -EBUSY Data is already claimed for reading.
+ * @retval -EIO Returned without waiting; no data was claimed.
+ * @retval -EAGAIN Waiting period timed out; no data was claimed.
+ */
+int k_pipe_read_claim(struct k_pipe *pipe, void **data, size_t *size,
+		      k_timeout_t timeout);
+
+/**
+ * @brief Finish reading data claimed from a pipe.
+ *
+ * This routine reads the first @a size bytes of the data claimed by
+ * k_pipe_read_claim(), and releases the claim. The rest of the data is
+ * left in the pipe. A thread that lent its buffer returns once all its
+ * data is read, or once its waiting period is over.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes read, up to the number of bytes claimed.
+ *
+ * @retval 0 Claim was finished.
+ * @retval -EINVAL No data is claimed, or @a size exceeds what is claimed.
+ */
+int k_pipe_read_finish(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim space to write to a pipe without copying the data.
+ *
+ * This routine gives direct access to up to @a size bytes of space of
+ * @a pipe, where the data written is available to readers once
+ * k_pipe_write_finish() is called. The space is in the buffer of the first
+ * thread waiting to read from the pipe, which keeps waiting meanwhile, if
+ * any. Otherwise it is in the pipe's ring buffer. The space claimed is
+ * contiguous, so there may be less than what can be written to the pipe.
+ *
+ * Only one write claim at a time is allowed, and no other thread may write
+ * to the pipe until it is finished.
+ *
+ * @note This routine is not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the address of the space.
+ * @param size Address of the maximum number of bytes to claim, set to the
+ *             number of bytes claimed.
+ * @param timeout Waiting period to wait for space to be available,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Space was claimed.
+ * @retval -EINVAL invalid parameters supplied
+ * @retval -EBUSY Space is already claimed for writing.
+ * @retval -EIO Returned without waiting; no space was claimed.
+ * @retval -EAGAIN Waiting period timed out; no space was claimed.
+ */
+int k_pipe_write_claim(struct k_pipe *pipe, void **data, size_t *size,
+		       k_timeout_t timeout);
+
+/**
+ * @brief Finish writing data to space claimed in a pipe.
+ *
+ * This routine writes the first @a size bytes of the space claimed by
+ * k_pipe_write_claim(), and releases the claim. A thread that lent its
+ * buffer returns once it is full, or once its waiting period is over.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes written, up to the number of bytes claimed.
+ *
+ * @retval 0 Claim was finished.
+ * @retval -EINVAL No space is claimed, or @a size exceeds what is claimed.
+ */
+int k_pipe_write_finish(struct k_pipe *pipe, size_t size);
+
+#endif /* CONFIG_PIPES_ZERO_COPY */
+
 /** @} */
 
 /**
  * @cond INTERNAL_HIDDEN
  */
 
+#if defined(CONFIG_MEM_SLAB_CPU_CACHE) || defined(CONFIG_KHEAP_CPU_CACHE)
+/* Per-CPU stack of free blocks ("magazine") kept in front of a slab or
+ * heap, only ever touched by its own CPU except when it is drained.
+ */
+struct z_mem_magazine {
+	struct k_spinlock lock;
+	uint32_t count;
+	void *rounds[CONFIG_MEM_CPU_CACHE_ROUNDS];
+};
+#endif
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE_STATS
+/**
+ * @brief Statistics of the cache of free blocks of a memory slab on a CPU
+ */
+struct k_mem_slab_cache_stats {
+	/** Allocations served by the cache */
+	uint32_t hits;
+	/** Allocations that went to the slab */
+	uint32_t misses;
+	/** Refills of the cache from the slab */
+	uint32_t refills;
+	/** Flushes of the cache to the slab */
+	uint32_t flushes;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -4985,6 +5237,13 @@ struct k_mem_slab {
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	struct z_mem_magazine cache[CONFIG_MP_MAX_NUM_CPUS];
+	bool cache_bypass;
+#endif
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE_STATS
+	struct k_mem_slab_cache_stats cache_stats[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 };
@@ -5137,7 +5396,18 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	uint32_t num_used = slab->num_used;
+
+	/* Blocks held in the per-CPU caches are free */
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		num_used -= slab->cache[i].count;
+	}
+
+	return num_used;
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -5172,7 +5442,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -5202,6 +5472,24 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
  */
 int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab);
 
+#if defined(CONFIG_MEM_SLAB_CPU_CACHE_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the statistics of the cache of a memory slab on a CPU
+ *
+ * This routine gets the hits, misses, refills and flushes counted so far
+ * by the cache of free blocks kept for CPU @a cpu in front of @a slab.
+ *
+ * @param slab Address of the memory slab
+ * @param cpu Index of the CPU
+ * @param stats Pointer to memory into which to copy the statistics
+ *
+ * @retval 0 Success
+ * @retval -EINVAL Any pointer is NULL, or @a cpu is not a valid CPU index
+ */
+int k_mem_slab_cpu_cache_stats_get(struct k_mem_slab *slab, int cpu,
+				   struct k_mem_slab_cache_stats *stats);
+#endif
+
 /** @} */
 
 /**
@@ -5215,6 +5503,10 @@ struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_KHEAP_CPU_CACHE
+	struct z_mem_magazine cache[CONFIG_MP_MAX_NUM_CPUS][CONFIG_KHEAP_CPU_CACHE_CLASSES];
+	bool cache_bypass;
+#endif
 };
 
 /**
@@ -5232,6 +5524,21 @@ struct k_heap {
  */
 void k_heap_init(struct k_heap *h, void *mem, size_t bytes);
 
+/**
+ * @brief Serve small k_heap allocations from size class pages
+ *
+ * Enables the size class front end of the heap underlying @a h, see
+ * sys_heap_size_classes_enable().  Allocations of up to
+ * CONFIG_SYS_HEAP_SIZE_CLASS_MAX bytes are then served in constant
+ * time from pages of same-sized objects.  Requires
+ * CONFIG_SYS_HEAP_SIZE_CLASSES.
+ *
+ * @param h Heap to enable size classes on
+ * @retval 0 on success
+ * @retval -ENOMEM if the bookkeeping doesn't fit in the heap
+ */
+int k_heap_size_classes_enable(struct k_heap *h);
+
 /** @brief Allocate aligned memory from a k_heap
  *
  * Behaves in all ways like k_heap_alloc(), except that the returned
@@ -5291,9 +5598,11 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes,
 void k_heap_free(struct k_heap *h, void *mem);
 
 /* Hand-calculated minimum heap sizes needed to return a successful
- * 1-byte allocation.  See details in lib/os/heap.[ch]
+ * 1-byte allocation.  See details in lib/os/heap.[ch], the size class
+ * pointer in struct z_heap takes another chunk unit.
  */
-#define Z_HEAP_MIN_SIZE (sizeof(void *) > 4 ? 56 : 44)
+#define Z_HEAP_MIN_SIZE ((sizeof(void *) > 4 ? 56 : 44) + \
+			 (IS_ENABLED(CONFIG_SYS_HEAP_SIZE_CLASSES) ? 8 : 0))
 
 /**
  * @brief Define a static k_heap in the specified linker section
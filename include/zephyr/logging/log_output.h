@@ -83,6 +83,9 @@ struct log_output_control_block {
 	atomic_t offset;
 	void *ctx;
 	const char *hostname;
+	/* Dictionary-based records are framed, see log_output_dict.h */
+	bool dict_framed;
+	uint16_t dict_seq;
 };
 
 /** @brief Log_output instance structure. */
@@ -47,6 +47,39 @@ struct log_dict_output_dropped_msg_t {
 	uint16_t num_dropped_messages;
 } __packed;
 
+/** Value of the magic field of @ref log_dict_output_frame_hdr_t. */
+#define LOG_DICT_OUTPUT_FRAME_MAGIC 0x5A4CU
+
+/**
+ * Header preceding each dictionary based log message when framing is
+ * enabled, see @ref log_dict_output_framing_set.
+ */
+struct log_dict_output_frame_hdr_t {
+	/** @ref LOG_DICT_OUTPUT_FRAME_MAGIC, to find the start of a record. */
+	uint16_t magic;
+	/** Length of the message following the header. */
+	uint16_t len;
+	/** Sequence number, incremented by one for each record. */
+	uint16_t seq;
+} __packed;
+
+/** @brief Enable or disable framing of dictionary-based log messages.
+ *
+ * When enabled, each message and dropped messages indication is preceded by
+ * a @ref log_dict_output_frame_hdr_t header and is passed to the output
+ * function in a single call when it fits in the output buffer. Records can
+ * then be found in data with gaps, such as log files or UDP datagrams,
+ * and lost records detected with the sequence number.
+ *
+ * @param output Pointer to the log output instance.
+ * @param enable True to enable framing.
+ */
+static inline void log_dict_output_framing_set(const struct log_output *output,
+					       bool enable)
+{
+	output->control_block->dict_framed = enable;
+}
+
 /** @brief Process log messages v2 for dictionary-based logging.
  *
  * Function is using provided context with the buffer and output function to
@@ -2414,6 +2414,30 @@ size_t net_buf_append_bytes(struct net_buf *buf, size_t len,
 			    const void *value, k_timeout_t timeout,
 			    net_buf_allocator_cb allocate_cb, void *user_data);
 
+#if defined(CONFIG_PIPES) || defined(__DOXYGEN__)
+struct k_pipe;
+
+/**
+ * @brief Read data from a pipe to the end of the buffer
+ *
+ * @details Read up to @a len bytes from @a pipe directly into the tailroom
+ * of the buffer, as k_pipe_get() does, and increment the data length of the
+ * buffer by the number of bytes read, whatever the return value. At most
+ * the tailroom of the buffer is read.
+ *
+ * @param buf Buffer to update.
+ * @param pipe Pipe to read from.
+ * @param len Maximum number of bytes to read.
+ * @param min_xfer Minimum number of bytes to read.
+ * @param timeout Waiting period to wait for the data to be read,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return See k_pipe_get().
+ */
+int net_buf_splice_pipe(struct net_buf *buf, struct k_pipe *pipe, size_t len,
+			size_t min_xfer, k_timeout_t timeout);
+#endif
+
 /**
  * @brief Skip N number of bytes in a net_buf
  *
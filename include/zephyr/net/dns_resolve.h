@@ -240,6 +240,12 @@ struct dns_resolve_context {
 		 * cannot be used to find correct pending query.
 		 */
 		uint16_t query_hash;
+
+		/** Query slot sending the query this one waits for the
+		 * response of, when the same name and type were already being
+		 * resolved. NULL if this slot sends its own query.
+		 */
+		struct dns_pending_query *leader;
 	} queries[CONFIG_DNS_NUM_CONCUR_QUERIES];
 
 	/** Is this context in use */
@@ -352,6 +358,11 @@ int dns_resolve_cancel_with_name(struct dns_resolve_context *ctx,
  * We might send the query to multiple servers (if there are more than one
  * server configured), but we only use the result of the first received
  * response.
+ * If the same name and type are already being resolved, no other query is
+ * sent: this one gets the response to the first one and times out with it.
+ * With CONFIG_DNS_RESOLVER_CACHE, a name resolved before is answered from
+ * the cache until its TTL expires. The callback is then called before this
+ * function returns, and the DNS id is set to 0.
  *
  * @param ctx DNS context
  * @param query What the caller wants to resolve.
@@ -446,6 +457,46 @@ static inline int dns_cancel_addr_info(uint16_t dns_id)
 	return dns_resolve_cancel(dns_resolve_get_default(), dns_id);
 }
 
+/**
+ * DNS resolver cache statistics.
+ */
+struct dns_cache_stats {
+	/** Number of queries answered from the cache */
+	uint32_t hits;
+
+	/** Number of the queries answered from the cache with a name that
+	 * does not exist
+	 */
+	uint32_t negative_hits;
+
+	/** Number of queries not found in the cache */
+	uint32_t misses;
+
+	/** Number of answers dropped before they expired to make room */
+	uint32_t evictions;
+
+	/** Number of answers currently cached */
+	uint32_t entries;
+};
+
+/**
+ * @brief Flush the DNS resolver cache.
+ *
+ * @details Drops all the answers cached, so that the next queries are sent
+ * to the DNS servers. This is needed e.g. when the network changes. The
+ * statistics are kept. Requires CONFIG_DNS_RESOLVER_CACHE.
+ */
+void dns_cache_flush(void);
+
+/**
+ * @brief Get the DNS resolver cache statistics.
+ *
+ * @details Requires CONFIG_DNS_RESOLVER_CACHE.
+ *
+ * @param stats Statistics are stored here.
+ */
+void dns_cache_stats_get(struct dns_cache_stats *stats);
+
 /**
  * @}
  */
@@ -282,6 +282,16 @@ __net_socket struct net_context {
 		/** Mutex used by condition variable */
 		struct k_mutex *lock;
 	} cond;
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	/** epoll instances watching this socket */
+	sys_slist_t epoll_items;
+#endif
+
+#if defined(CONFIG_NET_SOCKETS_RTIO)
+	/** RTIO iodev the socket is attached to */
+	struct rtio_iodev *rtio_iodev;
+#endif
 #endif /* CONFIG_NET_SOCKETS */
 
 #if defined(CONFIG_NET_OFFLOAD)
@@ -1000,6 +1010,35 @@ int net_context_sendmsg(struct net_context *context,
 			k_timeout_t timeout,
 			void *user_data);
 
+/**
+ * @brief Send data held in a network buffer chain without copying it.
+ *
+ * @details The data fragments are linked into the network packet as they
+ * are, only the protocol headers are allocated. This is supported for
+ * native UDP and TCP contexts. If dst_addr is NULL, the data is sent to
+ * the peer set by net_context_connect().
+ * On success the network stack owns the buffer chain and releases it when
+ * the data has been sent. On failure the caller still owns it.
+ *
+ * @param context The network context to use.
+ * @param frags The data to send, typically allocated with
+ *        net_pkt_get_reserve_tx_data().
+ * @param dst_addr Destination address, or NULL for connected contexts.
+ * @param addrlen Length of the address.
+ * @param cb Caller-supplied callback function.
+ * @param timeout Currently this value is not used.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_sendto_buf(struct net_context *context,
+			   struct net_buf *frags,
+			   const struct sockaddr *dst_addr,
+			   socklen_t addrlen,
+			   net_context_send_cb_t cb,
+			   k_timeout_t timeout,
+			   void *user_data);
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
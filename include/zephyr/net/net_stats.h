@@ -163,6 +163,14 @@ struct net_stats_tcp {
 
 	/** Number of connection attempts for closed ports, triggering a RST. */
 	net_stats_t connrst;
+
+#if defined(CONFIG_NET_TCP_GRO)
+	/** Number of received TCP segments coalesced into a previous one. */
+	net_stats_t gro_merged;
+
+	/** Number of coalesced TCP packets passed to the TCP layer. */
+	net_stats_t gro_flushed;
+#endif
 };
 
 /**
@@ -40,6 +40,12 @@ struct zsock_pollfd {
 	short revents;
 };
 
+/** Message header for zsock_recvmmsg() and zsock_sendmmsg() */
+struct zsock_mmsghdr {
+	struct msghdr msg_hdr; /**< Message to receive or send */
+	unsigned int msg_len;  /**< Number of bytes transferred */
+};
+
 /* ZSOCK_POLL* values are compatible with Linux */
 /** zsock_poll: Poll for readability */
 #define ZSOCK_POLLIN 1
@@ -64,6 +70,8 @@ struct zsock_pollfd {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: Do not block once the first datagram was received */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 
 /* Well-known values, e.g. from Linux man 2 shutdown:
  * "The constants SHUT_RD, SHUT_WR, SHUT_RDWR have the value 0, 1, 2,
@@ -438,6 +446,164 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+/**
+ * @brief Receive multiple datagrams
+ *
+ * @details
+ * @rst
+ * Receive up to ``vlen`` datagrams into the messages of ``msgvec`` with
+ * a single call, which amortizes the socket lookup, locking and (for
+ * user mode threads) the system call overhead over the whole batch.
+ * The number of bytes received into each message is stored in its
+ * ``msg_len`` field, the source address in ``msg_name`` and
+ * ``ZSOCK_MSG_TRUNC`` is set in ``msg_flags`` if the datagram did not
+ * fit. Ancillary data is not supported, ``msg_controllen`` is set to 0.
+ *
+ * The semantics follow Linux ``recvmmsg()``: the call blocks until
+ * ``vlen`` datagrams were received, unless ``ZSOCK_MSG_WAITFORONE`` is
+ * given, in which case it returns with what is queued once the first
+ * datagram is in. If not NULL, ``timeout`` bounds the duration of the
+ * whole call instead of the ``SO_RCVTIMEO`` socket option.
+ * Only native datagram sockets are supported.
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages received, or -1 with errno set if no
+ *         datagram could be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags,
+			     struct zsock_timeval *timeout);
+
+/**
+ * @brief Send multiple messages
+ *
+ * @details
+ * @rst
+ * Send the ``vlen`` messages of ``msgvec`` with a single call, as if
+ * :c:func:`zsock_sendmsg` was called for each of them, with the socket
+ * lookup, locking and (for user mode threads) the system call overhead
+ * paid once for the whole batch. The number of bytes sent for each
+ * message is stored in its ``msg_len`` field. Sending stops at the first
+ * message which fails.
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages sent, or -1 with errno set if the first
+ *         message could not be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+struct net_buf;
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * Like zsock_recvfrom(), but instead of copying the data into a caller
+ * buffer, the network buffers holding it are returned. For datagram
+ * sockets the whole datagram is returned, for stream sockets the data
+ * of the next received segment. On success, @p frags points to a buffer
+ * chain holding exactly the returned number of bytes, which the caller
+ * must release with net_buf_unref(). Only ZSOCK_MSG_DONTWAIT is supported
+ * in @p flags.
+ *
+ * The buffers come from the network stack RX pools, so they should be
+ * released as soon as possible. Only native UDP and TCP sockets are
+ * supported, and this function cannot be called from user mode threads.
+ * Requires :kconfig:option:`CONFIG_NET_SOCKETS_ZERO_COPY`.
+ *
+ * @param sock Socket to receive from
+ * @param frags Set to the received buffer chain, or NULL at end of stream
+ * @param flags Receive flags
+ * @param src_addr Set to the source address, may be NULL
+ * @param addrlen Length of @p src_addr, value-result argument
+ *
+ * @return Number of bytes received, 0 at end of stream, -1 on error with
+ *         errno set.
+ */
+ssize_t zsock_recvfrom_zc(int sock, struct net_buf **frags, int flags,
+			  struct sockaddr *src_addr, socklen_t *addrlen);
+
+/**
+ * @brief Receive data from a connected peer without copying it
+ *
+ * @details
+ * See zsock_recvfrom_zc().
+ */
+static inline ssize_t zsock_recv_zc(int sock, struct net_buf **frags,
+				    int flags)
+{
+	return zsock_recvfrom_zc(sock, frags, flags, NULL, NULL);
+}
+
+/**
+ * @brief Send data held in network buffers without copying it
+ *
+ * @details
+ * Like zsock_sendto(), but the data is taken from a buffer chain filled
+ * by the caller, typically allocated with net_pkt_get_reserve_tx_data().
+ * The buffers are linked into the outgoing packet behind the protocol
+ * headers. On success the socket takes ownership of @p frags, on failure
+ * the caller still owns it. For datagram sockets the whole chain is sent
+ * as one datagram.
+ *
+ * Only native UDP and TCP sockets are supported, and this function
+ * cannot be called from user mode threads.
+ * Requires :kconfig:option:`CONFIG_NET_SOCKETS_ZERO_COPY`.
+ *
+ * @param sock Socket to send with
+ * @param frags Data to send
+ * @param flags Send flags
+ * @param dest_addr Destination address, NULL for connected sockets
+ * @param addrlen Length of @p dest_addr
+ *
+ * @return Number of bytes sent, -1 on error with errno set.
+ */
+ssize_t zsock_sendto_zc(int sock, struct net_buf *frags, int flags,
+			const struct sockaddr *dest_addr, socklen_t addrlen);
+
+/**
+ * @brief Send data held in network buffers to a connected peer
+ *
+ * @details
+ * See zsock_sendto_zc().
+ */
+static inline ssize_t zsock_send_zc(int sock, struct net_buf *frags,
+				    int flags)
+{
+	return zsock_sendto_zc(sock, frags, flags, NULL, 0);
+}
+
+struct k_pipe;
+
+/**
+ * @brief Send data read from a pipe
+ *
+ * @details
+ * Send up to @p len bytes read from @p pipe, taking them directly from the
+ * pipe's buffer or from the buffer of a thread waiting to write to the
+ * pipe, instead of copying them to a buffer of the caller first. The call
+ * waits for data in the pipe unless ZSOCK_MSG_DONTWAIT is given in
+ * @p flags, which are also used to send. It returns once the pipe has no
+ * more data, or the socket cannot take it. No other thread may read from
+ * the pipe meanwhile.
+ *
+ * This function cannot be called from user mode threads.
+ * Requires :kconfig:option:`CONFIG_PIPES_ZERO_COPY`.
+ *
+ * @param sock Socket to send with
+ * @param pipe Pipe to read from
+ * @param len Maximum number of bytes to send
+ * @param flags Send flags
+ *
+ * @return Number of bytes sent, -1 on error with errno set.
+ */
+ssize_t zsock_splice_pipe(int sock, struct k_pipe *pipe, size_t len, int flags);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -684,6 +850,7 @@ int zsock_getnameinfo(const struct sockaddr *addr, socklen_t addrlen,
 #if defined(CONFIG_NET_SOCKETS_POSIX_NAMES)
 
 #define pollfd zsock_pollfd
+#define mmsghdr zsock_mmsghdr
 
 /** POSIX wrapper for @ref zsock_socket */
 static inline int socket(int family, int type, int proto)
@@ -785,6 +952,21 @@ static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+/** POSIX wrapper for @ref zsock_recvmmsg */
+static inline int recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags,
+			   struct zsock_timeval *timeout)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags, timeout);
+}
+
+/** POSIX wrapper for @ref zsock_sendmmsg */
+static inline int sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 /** POSIX wrapper for @ref zsock_poll */
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
@@ -888,6 +1070,8 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 /** POSIX wrapper for @ref ZSOCK_MSG_WAITALL */
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+/** POSIX wrapper for @ref ZSOCK_MSG_WAITFORONE */
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
 
 /** POSIX wrapper for @ref ZSOCK_SHUT_RD */
 #define SHUT_RD ZSOCK_SHUT_RD
@@ -989,6 +1173,8 @@ struct ifreq {
 /* Socket options for IPPROTO_TCP level */
 /** sockopt: Disable TCP buffering (ignored, for compatibility) */
 #define TCP_NODELAY 1
+/** sockopt: Congestion control algorithm, given by name (e.g. "cubic") */
+#define TCP_CONGESTION 13
 
 /* Socket options for IPPROTO_IP level */
 /** sockopt: Set or receive the Type-Of-Service value for an outgoing packet. */
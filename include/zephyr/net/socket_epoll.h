@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @addtogroup bsd_sockets
+ * @{
+ */
+
+#include <zephyr/types.h>
+#include <zephyr/toolchain.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ZSOCK_EPOLL* values are compatible with Linux */
+/** zsock_epoll_ctl: Socket is readable */
+#define ZSOCK_EPOLLIN 0x001
+/** zsock_epoll_ctl: Compatibility value, ignored */
+#define ZSOCK_EPOLLPRI 0x002
+/** zsock_epoll_ctl: Socket is writable */
+#define ZSOCK_EPOLLOUT 0x004
+/** zsock_epoll_wait: Error condition, always reported */
+#define ZSOCK_EPOLLERR 0x008
+/** zsock_epoll_wait: Connection closed by peer, always reported */
+#define ZSOCK_EPOLLHUP 0x010
+/** zsock_epoll_ctl: Disable the socket after one event has been reported */
+#define ZSOCK_EPOLLONESHOT BIT(30)
+/** zsock_epoll_ctl: Edge triggered notification */
+#define ZSOCK_EPOLLET BIT(31)
+
+/** zsock_epoll_ctl: Add a socket to the interest set */
+#define ZSOCK_EPOLL_CTL_ADD 1
+/** zsock_epoll_ctl: Remove a socket from the interest set */
+#define ZSOCK_EPOLL_CTL_DEL 2
+/** zsock_epoll_ctl: Change the events of a socket in the interest set */
+#define ZSOCK_EPOLL_CTL_MOD 3
+
+/** User data returned with an event */
+typedef union zsock_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+} zsock_epoll_data_t;
+
+/** Event mask and user data of a socket in an epoll instance */
+struct zsock_epoll_event {
+	uint32_t events;
+	zsock_epoll_data_t data;
+};
+
+/**
+ * @brief Open an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux man page <https://man7.org/linux/man-pages/man2/epoll_create.2.html>`__
+ * for normative description. No flags are supported.
+ * This function is also exposed as ``epoll_create1()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+__syscall int zsock_epoll_create1(int flags);
+
+/**
+ * @brief Open an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux man page <https://man7.org/linux/man-pages/man2/epoll_create.2.html>`__
+ * for normative description. The size argument is ignored, but must be
+ * greater than zero.
+ * This function is also exposed as ``epoll_create()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+int zsock_epoll_create(int size);
+
+/**
+ * @brief Add, change or remove a socket in the interest set of an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux man page <https://man7.org/linux/man-pages/man2/epoll_ctl.2.html>`__
+ * for normative description. Only native network sockets can be added.
+ * This function is also exposed as ``epoll_ctl()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+__syscall int zsock_epoll_ctl(int epfd, int op, int fd,
+			      struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for events on the sockets of an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux man page <https://man7.org/linux/man-pages/man2/epoll_wait.2.html>`__
+ * for normative description. Only one thread at a time can wait on an
+ * epoll instance, other threads wait for it to return first.
+ * This function is also exposed as ``epoll_wait()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+__syscall int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			       int maxevents, int timeout);
+
+#ifdef CONFIG_NET_SOCKETS_POSIX_NAMES
+
+#define epoll_event zsock_epoll_event
+#define epoll_data_t zsock_epoll_data_t
+
+#define EPOLLIN ZSOCK_EPOLLIN
+#define EPOLLPRI ZSOCK_EPOLLPRI
+#define EPOLLOUT ZSOCK_EPOLLOUT
+#define EPOLLERR ZSOCK_EPOLLERR
+#define EPOLLHUP ZSOCK_EPOLLHUP
+#define EPOLLONESHOT ZSOCK_EPOLLONESHOT
+#define EPOLLET ZSOCK_EPOLLET
+
+#define EPOLL_CTL_ADD ZSOCK_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZSOCK_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZSOCK_EPOLL_CTL_MOD
+
+static inline int epoll_create(int size)
+{
+	return zsock_epoll_create(size);
+}
+
+static inline int epoll_create1(int flags)
+{
+	return zsock_epoll_create1(flags);
+}
+
+static inline int epoll_ctl(int epfd, int op, int fd,
+			    struct zsock_epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, fd, event);
+}
+
+static inline int epoll_wait(int epfd, struct zsock_epoll_event *events,
+			     int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+
+#endif /* CONFIG_NET_SOCKETS_POSIX_NAMES */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <syscalls/socket_epoll.h>
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_ */
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @addtogroup bsd_sockets
+ * @{
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @cond INTERNAL_HIDDEN */
+
+struct net_context;
+
+/* Submissions of one direction, served in order */
+struct zsock_rtio_queue {
+	struct rtio_mpsc q;
+	/* Submission being served, waiting for the socket */
+	struct rtio_iodev_sqe *curr;
+	/* The queue is being served, and should be looked at again */
+	bool busy;
+	bool again;
+};
+
+/* State of a socket RTIO iodev */
+struct zsock_rtio_data {
+	/* Socket the iodev is attached to, NULL if none */
+	struct net_context *ctx;
+
+	struct zsock_rtio_queue rx;
+	struct zsock_rtio_queue tx;
+
+	/* A multishot receive has reported the end of the stream */
+	bool rx_eof;
+
+	/* Serves the queues when the socket receives data */
+	struct k_work work;
+
+	/* Serves the send queue when the socket may be writable again */
+	struct k_work_poll tx_work;
+	struct k_poll_event tx_event;
+	struct k_poll_signal tx_signal;
+
+	/* Protects the fields above */
+	struct k_spinlock lock;
+};
+
+extern const struct rtio_iodev_api zsock_rtio_iodev_api;
+
+/** @endcond */
+
+/**
+ * @brief Define an RTIO iodev for a socket
+ *
+ * The iodev serves @ref RTIO_OP_RX, @ref RTIO_OP_TX and @ref RTIO_OP_TINY_TX
+ * submissions on the socket attached with zsock_rtio_iodev_attach().
+ *
+ * A receive takes one datagram, or whatever stream data is available, into
+ * the buffer of the submission. With @ref RTIO_SQE_MEMPOOL_BUFFER the buffer
+ * is taken from the memory pool of the RTIO context when data is there, and
+ * given back with rtio_cqe_get_mempool_buffer(). With @ref RTIO_SQE_MULTISHOT
+ * the receive is submitted again after each completion, until canceled. The
+ * result of a completion is the number of bytes received or sent, 0 meaning
+ * the peer closed the connection, or a negative errno code.
+ *
+ * @param name Name of the iodev
+ */
+#define ZSOCK_RTIO_IODEV_DEFINE(name)						\
+	static struct zsock_rtio_data _zsock_rtio_data_##name;			\
+	RTIO_IODEV_DEFINE(name, &zsock_rtio_iodev_api, &_zsock_rtio_data_##name)
+
+/**
+ * @brief Attach a socket to an RTIO iodev
+ *
+ * Submissions to the iodev are served on the socket from then on, until it
+ * is closed or detached. Receives and sends do not block: they are served
+ * as the network stack receives data or the socket becomes writable, so a
+ * single thread may drive many sockets through one RTIO context. Only
+ * native network sockets can be attached, and the iodev is not available
+ * to user mode threads.
+ *
+ * @param iodev Iodev defined with ZSOCK_RTIO_IODEV_DEFINE()
+ * @param sock Socket to attach
+ *
+ * @retval 0 Success
+ * @retval -EBADF @p sock is not an open native socket
+ * @retval -EBUSY The iodev or the socket is already attached
+ */
+int zsock_rtio_iodev_attach(struct rtio_iodev *iodev, int sock);
+
+/**
+ * @brief Detach the socket from an RTIO iodev
+ *
+ * Submissions still waiting on the socket complete with -ECANCELED. Closing
+ * the socket detaches it as well.
+ *
+ * @param iodev Iodev defined with ZSOCK_RTIO_IODEV_DEFINE()
+ */
+void zsock_rtio_iodev_detach(struct rtio_iodev *iodev);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_ */
@@ -84,6 +84,13 @@ extern "C" {
  * @}
  */
 
+/** @cond ignore */
+/* Number of priority classes chains wait in with the concurrent executor:
+ * above normal, normal and below normal priority.
+ */
+#define RTIO_PRIO_CLASSES 3
+/** @endcond */
+
 
 /**
  * @brief RTIO SQE Flags
@@ -375,6 +382,23 @@ struct rtio {
 
 	/* Completion queue */
 	struct rtio_mpsc cq;
+
+#ifdef CONFIG_RTIO_EXECUTOR_CONCURRENT
+	/* Lock for the executor state below */
+	struct k_spinlock exec_lock;
+
+	/* Chains waiting to be started, one FIFO per priority class */
+	sys_slist_t exec_pending[RTIO_PRIO_CLASSES];
+
+	/* Number of chains started and not yet completed */
+	uint16_t exec_inflight;
+
+	/* Set while a dispatch loop is starting chains */
+	bool exec_dispatching;
+
+	/* The iodev each chain in flight is on */
+	const struct rtio_iodev *exec_iodevs[CONFIG_RTIO_EXECUTOR_CONCURRENT_DEPTH];
+#endif
 };
 
 /** The memory partition associated with all RTIO context information */
@@ -414,6 +438,9 @@ struct rtio_iodev_sqe {
 	struct rtio_mpsc_node q;
 	struct rtio_iodev_sqe *next;
 	struct rtio *r;
+#ifdef CONFIG_RTIO_EXECUTOR_CONCURRENT
+	sys_snode_t pending;
+#endif
 };
 
 /**
@@ -670,6 +697,10 @@ static inline int rtio_block_pool_alloc(struct rtio_block_pool *pool, size_t min
 			return 0;
 		}
 
+		if (bytes <= pool->blk_size) {
+			break;
+		}
+
 		bytes -= pool->blk_size;
 	} while (bytes >= min_sz);
 
@@ -195,6 +195,21 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
  */
 size_t sys_heap_usable_size(struct sys_heap *heap, void *mem);
 
+/** @brief Serve small allocations from size class pages
+ *
+ * Makes @p heap serve allocations of up to
+ * CONFIG_SYS_HEAP_SIZE_CLASS_MAX bytes from pages of same-sized
+ * objects carved out of the heap, in constant time.  Larger
+ * allocations, and small ones when no page can be allocated, still go
+ * to the general allocator.  Must be called before the heap is shared
+ * with other contexts, typically right after sys_heap_init().
+ * Requires CONFIG_SYS_HEAP_SIZE_CLASSES.
+ *
+ * @param heap Heap to enable size classes on
+ * @return 0 on success, -ENOMEM if the bookkeeping doesn't fit in the heap
+ */
+int sys_heap_size_classes_enable(struct sys_heap *heap);
+
 /** @brief Validate heap integrity
  *
  * Validates the internal integrity of a sys_heap.  Intended for unit
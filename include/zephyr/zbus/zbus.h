@@ -79,7 +79,9 @@ struct zbus_channel {
  * field of the structure. The listeners have a callback function that is executed by the
  * bus with the index of the changed channel as argument when the notification is sent.
  * The subscribers have a message queue where the bus enqueues the index of the changed
- * channel when a notification is sent.
+ * channel when a notification is sent. The message subscribers have a FIFO where the bus
+ * enqueues a copy of the channel's message, shared by all the message subscribers of the
+ * channel.
  *
  * @see zbus_obs_set_enable function to properly change the observer's enabled field.
  *
@@ -96,6 +98,11 @@ struct zbus_observer {
 
 	/** Observer callback function. It turns the observer into a listener. */
 	void (*const callback)(const struct zbus_channel *chan);
+
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER) || defined(__DOXYGEN__)
+	/** Observer message FIFO. It turns the observer into a message subscriber. */
+	struct k_fifo *const message_fifo;
+#endif
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -243,6 +250,30 @@ k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks);
 					       .enabled = true,                                    \
 				       .queue = &_zbus_observer_queue_##_name, .callback = NULL}
 
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER) || defined(__DOXYGEN__)
+
+/**
+ * @brief Define and initialize a message subscriber.
+ *
+ * This macro defines an observer of message subscriber type. It defines a FIFO where the
+ * message subscriber will receive, asynchronously, a copy of every message published to the
+ * channels it observes, and initialize the ``struct zbus_observer`` defining the message
+ * subscriber. The copies are reference counted net_buf buffers from a pool shared by all the
+ * message subscribers, so a message is only copied once however many message subscribers
+ * receive it.
+ *
+ * @param[in] _name The message subscriber's name.
+ */
+#define ZBUS_MSG_SUBSCRIBER_DEFINE(_name)                                                          \
+	static K_FIFO_DEFINE(_zbus_observer_fifo_##_name);                                         \
+	_ZBUS_STRUCT_DECLARE(zbus_observer,                                                        \
+			     _name) = {ZBUS_OBSERVER_NAME_INIT(_name) /* Name field */             \
+					       .enabled = true,                                    \
+				       .queue = NULL, .callback = NULL,                            \
+				       .message_fifo = &_zbus_observer_fifo_##_name}
+
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
+
 /**
  * @brief Define and initialize a listener.
  *
@@ -282,6 +313,33 @@ k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks);
  */
 int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t timeout);
 
+#if defined(CONFIG_ZBUS_PUB_ISR) || defined(__DOXYGEN__)
+
+/**
+ *
+ * @brief Publish to a channel from an ISR
+ *
+ * This routine publishes a message to a channel without waiting. The message is copied to a
+ * buffer and the publishing is completed by the system work queue, which copies it to the
+ * channel and notifies the observers as zbus_chan_pub() does, without waiting for them.
+ * Messages published this way are processed in order, and message subscribers receive the
+ * buffer itself, so no further copy is made for them. The routine does not take the
+ * channel's mutex and can be called from ISRs as well as threads.
+ *
+ * @param chan The channel's reference.
+ * @param msg Reference to the message where the publish function copies the channel's
+ * message data from.
+ *
+ * @retval 0 Message queued for publishing.
+ * @retval -ENOMSG The message is invalid based on the validator function.
+ * @retval -ENOMEM No buffer available to copy the message to.
+ * @retval -EFAULT A parameter is incorrect. The function only returns this value when the
+ * CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ */
+int zbus_chan_pub_isr(const struct zbus_channel *chan, const void *msg);
+
+#endif /* CONFIG_ZBUS_PUB_ISR */
+
 /**
  * @brief Read a channel
  *
@@ -578,6 +636,33 @@ static inline const char *zbus_obs_name(const struct zbus_observer *obs)
 int zbus_sub_wait(const struct zbus_observer *sub, const struct zbus_channel **chan,
 		  k_timeout_t timeout);
 
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER) || defined(__DOXYGEN__)
+
+/**
+ * @brief Wait for a channel message.
+ *
+ * This routine makes the message subscriber to wait for a message. The message comes with the
+ * reference of the channel it was published to, and is copied to @p msg, which must be large
+ * enough for the messages of every channel the message subscriber observes.
+ *
+ * @param[in] sub The message subscriber's reference.
+ * @param[out] chan The channel's reference.
+ * @param[out] msg Reference to the memory where the message is copied to.
+ * @param[in] timeout Waiting period for a message arrival,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message received.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL The observer is not a message subscriber.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ */
+int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel **chan, void *msg,
+		      k_timeout_t timeout);
+
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
+
 #if defined(CONFIG_ZBUS_STRUCTS_ITERABLE_ACCESS) || defined(__DOXYGEN__)
 /**
  *
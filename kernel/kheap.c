@@ -5,20 +5,40 @@
  */
 
 #include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
 #include <ksched.h>
 #include <zephyr/wait_q.h>
 #include <zephyr/init.h>
 #include <zephyr/linker/linker-defs.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/math_extras.h>
+#include <string.h>
 
 void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
 {
 	z_waitq_init(&h->wait_q);
 	sys_heap_init(&h->heap, mem, bytes);
 
+#ifdef CONFIG_KHEAP_CPU_CACHE
+	(void)memset(h->cache, 0, sizeof(h->cache));
+	h->cache_bypass = false;
+#endif
+
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, h);
 }
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+int k_heap_size_classes_enable(struct k_heap *h)
+{
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	int ret = sys_heap_size_classes_enable(&h->heap);
+
+	k_spin_unlock(&h->lock, key);
+
+	return ret;
+}
+#endif
+
 static int statics_init(void)
 {
 	STRUCT_SECTION_FOREACH(k_heap, h) {
@@ -61,14 +81,149 @@ SYS_INIT_NAMED(statics_init_pre, statics_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_
 SYS_INIT_NAMED(statics_init_post, statics_init, POST_KERNEL, 0);
 #endif /* CONFIG_DEMAND_PAGING && !CONFIG_LINKER_GENERIC_SECTIONS_PRESENT_AT_BOOT */
 
+#ifdef CONFIG_KHEAP_CPU_CACHE
+#define CACHE_BATCH (CONFIG_MEM_CPU_CACHE_ROUNDS / 2)
+#define CLASS_SIZE(c) ((size_t)16 << (c))
+
+/* Smallest size class a request fits in, or -1 */
+static int alloc_class(size_t align, size_t bytes)
+{
+	if ((align > sizeof(void *)) || (bytes == 0) ||
+	    (bytes > CLASS_SIZE(CONFIG_KHEAP_CPU_CACHE_CLASSES - 1))) {
+		return -1;
+	}
+
+	return (bytes <= CLASS_SIZE(0)) ? 0 :
+		28 - u32_count_leading_zeros((uint32_t)bytes - 1);
+}
+
+/* Largest size class a free block can serve, or -1 */
+static int free_class(size_t usable)
+{
+	if ((usable < CLASS_SIZE(0)) ||
+	    (usable >= CLASS_SIZE(CONFIG_KHEAP_CPU_CACHE_CLASSES))) {
+		return -1;
+	}
+
+	return 27 - u32_count_leading_zeros((uint32_t)usable);
+}
+
+static void *cache_alloc(struct k_heap *h, int c)
+{
+	unsigned int irq = arch_irq_lock();
+	struct z_mem_magazine *mag = &h->cache[_current_cpu->id][c];
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+	void *mem = NULL;
+
+	if (mag->count > 0U) {
+		mem = mag->rounds[--mag->count];
+	}
+
+	k_spin_unlock(&mag->lock, key);
+	arch_irq_unlock(irq);
+
+	return mem;
+}
+
+/* Give every cached block back to the heap, heap lock held */
+static void cache_drain(struct k_heap *h)
+{
+	for (int i = 0; i < arch_num_cpus(); i++) {
+		for (int c = 0; c < CONFIG_KHEAP_CPU_CACHE_CLASSES; c++) {
+			struct z_mem_magazine *mag = &h->cache[i][c];
+			k_spinlock_key_t key = k_spin_lock(&mag->lock);
+
+			while (mag->count > 0U) {
+				sys_heap_free(&h->heap, mag->rounds[--mag->count]);
+			}
+
+			k_spin_unlock(&mag->lock, key);
+		}
+	}
+}
+
+static bool cache_free(struct k_heap *h, void *mem)
+{
+	void *flush[CACHE_BATCH];
+	uint32_t n = 0U;
+	int c;
+
+	if (mem == NULL) {
+		return false;
+	}
+
+	/* The size of an allocated chunk only changes when it is freed,
+	 * so it can be read without the heap lock.
+	 */
+	c = free_class(sys_heap_usable_size(&h->heap, mem));
+	if (c < 0) {
+		return false;
+	}
+
+	unsigned int irq = arch_irq_lock();
+	struct z_mem_magazine *mag = &h->cache[_current_cpu->id][c];
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+
+	/* Threads are waiting for memory, don't hold on to it */
+	if (h->cache_bypass) {
+		k_spin_unlock(&mag->lock, key);
+		arch_irq_unlock(irq);
+		return false;
+	}
+
+	if (mag->count == CONFIG_MEM_CPU_CACHE_ROUNDS) {
+		n = CACHE_BATCH;
+		mag->count -= n;
+		memcpy(flush, &mag->rounds[mag->count], n * sizeof(void *));
+	}
+	mag->rounds[mag->count++] = mem;
+
+	k_spin_unlock(&mag->lock, key);
+	arch_irq_unlock(irq);
+
+	if (n > 0U) {
+		key = k_spin_lock(&h->lock);
+		for (uint32_t i = 0U; i < n; i++) {
+			sys_heap_free(&h->heap, flush[i]);
+		}
+
+		/* Threads may have started waiting in the meantime */
+		if (IS_ENABLED(CONFIG_MULTITHREADING) && z_unpend_all(&h->wait_q) != 0) {
+			z_reschedule(&h->lock, key);
+		} else {
+			k_spin_unlock(&h->lock, key);
+		}
+	}
+
+	return true;
+}
+#endif /* CONFIG_KHEAP_CPU_CACHE */
+
 void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 			k_timeout_t timeout)
 {
 	int64_t now, end = sys_clock_timeout_end_calc(timeout);
+	size_t alloc_bytes = bytes;
 	void *ret = NULL;
 
 	end = K_TIMEOUT_EQ(timeout, K_FOREVER) ? INT64_MAX : end;
 
+#ifdef CONFIG_KHEAP_CPU_CACHE
+	int c = alloc_class(align, bytes);
+
+	if (c >= 0) {
+		ret = cache_alloc(h, c);
+		if (ret != NULL) {
+			SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
+			return ret;
+		}
+
+		/* Whole class, so that the block can be cached once freed */
+		alloc_bytes = CLASS_SIZE(c);
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
@@ -78,7 +233,23 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 	bool blocked_alloc = false;
 
 	while (ret == NULL) {
-		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+		ret = sys_heap_aligned_alloc(&h->heap, align, alloc_bytes);
+
+#ifdef CONFIG_KHEAP_CPU_CACHE
+		if (ret == NULL) {
+			/* Keep the caches from taking memory meant for
+			 * waiters (cache_free() checks this under the cache
+			 * lock taken by cache_drain()), then collect what
+			 * they hold and retry with the exact size.
+			 */
+			h->cache_bypass = true;
+			cache_drain(h);
+			ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+		}
+		if (ret != NULL) {
+			h->cache_bypass = z_waitq_head(&h->wait_q) != NULL;
+		}
+#endif
 
 		now = sys_clock_tick_get();
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
@@ -120,10 +291,22 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 
 void k_heap_free(struct k_heap *h, void *mem)
 {
+#ifdef CONFIG_KHEAP_CPU_CACHE
+	if (cache_free(h, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
+		return;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
 	sys_heap_free(&h->heap, mem);
 
+#ifdef CONFIG_KHEAP_CPU_CACHE
+	/* Woken waiters that still find no memory set it again */
+	h->cache_bypass = false;
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
 	if (IS_ENABLED(CONFIG_MULTITHREADING) && z_unpend_all(&h->wait_q) != 0) {
 		z_reschedule(&h->lock, key);
@@ -15,6 +15,7 @@
 #include <zephyr/init.h>
 #include <zephyr/sys/check.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <string.h>
 
 /**
  * @brief Initialize kernel memory slab subsystem.
@@ -73,6 +74,169 @@ out:
 SYS_INIT(init_mem_slab_module, PRE_KERNEL_1,
 	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+#define CACHE_BATCH (CONFIG_MEM_CPU_CACHE_ROUNDS / 2)
+
+/* The calling CPU's cache, interrupts must be locked */
+static inline struct z_mem_magazine *local_cache(struct k_mem_slab *slab)
+{
+	return &slab->cache[_current_cpu->id];
+}
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	unsigned int irq = arch_irq_lock();
+	struct z_mem_magazine *mag = local_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+	bool hit = mag->count > 0U;
+
+	if (hit) {
+		*mem = mag->rounds[--mag->count];
+	}
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE_STATS
+	if (hit) {
+		slab->cache_stats[_current_cpu->id].hits++;
+	} else {
+		slab->cache_stats[_current_cpu->id].misses++;
+	}
+#endif
+
+	k_spin_unlock(&mag->lock, key);
+	arch_irq_unlock(irq);
+
+	return hit;
+}
+
+/* Move up to half a magazine of free blocks to the calling CPU's
+ * cache, slab lock held.
+ */
+static void cache_refill(struct k_mem_slab *slab)
+{
+	struct z_mem_magazine *mag = local_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+	int i;
+
+	for (i = 0; (i < CACHE_BATCH) && (slab->free_list != NULL) &&
+	     (mag->count < CONFIG_MEM_CPU_CACHE_ROUNDS); i++) {
+		mag->rounds[mag->count++] = slab->free_list;
+		slab->free_list = *(char **)(slab->free_list);
+		slab->num_used++;
+	}
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE_STATS
+	if (i > 0) {
+		slab->cache_stats[_current_cpu->id].refills++;
+	}
+#endif
+
+	k_spin_unlock(&mag->lock, key);
+}
+
+/* Give every cached block back to the slab, slab lock held */
+static void cache_drain(struct k_mem_slab *slab)
+{
+	for (int i = 0; i < arch_num_cpus(); i++) {
+		struct z_mem_magazine *mag = &slab->cache[i];
+		k_spinlock_key_t key = k_spin_lock(&mag->lock);
+
+		while (mag->count > 0U) {
+			char *block = mag->rounds[--mag->count];
+
+			*(char **)block = slab->free_list;
+			slab->free_list = block;
+			slab->num_used--;
+		}
+
+		k_spin_unlock(&mag->lock, key);
+	}
+}
+
+static uint32_t cached_blocks(struct k_mem_slab *slab)
+{
+	uint32_t count = 0U;
+
+	for (int i = 0; i < arch_num_cpus(); i++) {
+		struct z_mem_magazine *mag = &slab->cache[i];
+		k_spinlock_key_t key = k_spin_lock(&mag->lock);
+
+		count += mag->count;
+		k_spin_unlock(&mag->lock, key);
+	}
+
+	return count;
+}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
+/* Return a block to the slab, or hand it over to a waiting thread.
+ * Slab lock held, returns true when a thread was made ready.
+ */
+static bool free_block_locked(struct k_mem_slab *slab, char *block)
+{
+	if (slab->free_list == NULL && IS_ENABLED(CONFIG_MULTITHREADING)) {
+		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
+
+		if (pending_thread != NULL) {
+			z_thread_return_value_set_with_data(pending_thread, 0, block);
+			z_ready_thread(pending_thread);
+			return true;
+		}
+	}
+	*(char **)block = slab->free_list;
+	slab->free_list = block;
+	slab->num_used--;
+
+	return false;
+}
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+static bool cache_free(struct k_mem_slab *slab, void *mem)
+{
+	void *flush[CACHE_BATCH];
+	uint32_t n = 0U;
+	bool resched = false;
+	unsigned int irq = arch_irq_lock();
+	struct z_mem_magazine *mag = local_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+
+	/* Threads are waiting for a block, don't hold on to it */
+	if (slab->cache_bypass) {
+		k_spin_unlock(&mag->lock, key);
+		arch_irq_unlock(irq);
+		return false;
+	}
+
+	if (mag->count == CONFIG_MEM_CPU_CACHE_ROUNDS) {
+		n = CACHE_BATCH;
+		mag->count -= n;
+		memcpy(flush, &mag->rounds[mag->count], n * sizeof(void *));
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE_STATS
+		slab->cache_stats[_current_cpu->id].flushes++;
+#endif
+	}
+	mag->rounds[mag->count++] = mem;
+
+	k_spin_unlock(&mag->lock, key);
+	arch_irq_unlock(irq);
+
+	if (n > 0U) {
+		/* Threads may have started waiting in the meantime */
+		key = k_spin_lock(&slab->lock);
+		for (uint32_t i = 0U; i < n; i++) {
+			resched |= free_block_locked(slab, flush[i]);
+		}
+
+		if (resched) {
+			z_reschedule(&slab->lock, key);
+		} else {
+			k_spin_unlock(&slab->lock, key);
+		}
+	}
+
+	return true;
+}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 		    size_t block_size, uint32_t num_blocks)
 {
@@ -88,6 +252,15 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->max_used = 0U;
 #endif
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	(void)memset(slab->cache, 0, sizeof(slab->cache));
+	slab->cache_bypass = false;
+#endif
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE_STATS
+	(void)memset(slab->cache_stats, 0, sizeof(slab->cache_stats));
+#endif
+
 	rc = create_free_list(slab);
 	if (rc < 0) {
 		goto out;
@@ -103,17 +276,45 @@ out:
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cache_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+		return 0;
+	}
+#endif
+
+	key = k_spin_lock(&slab->lock);
+
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (slab->free_list == NULL) {
+		/* Keep the caches from taking blocks meant for waiters
+		 * (cache_free() checks this under the cache lock taken
+		 * by cache_drain()), then collect what they hold.
+		 */
+		slab->cache_bypass = true;
+		cache_drain(slab);
+	}
+#endif
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
 		slab->free_list = *(char **)(slab->free_list);
 		slab->num_used++;
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		slab->cache_bypass = z_waitq_head(&slab->wait_q) != NULL;
+		if (!slab->cache_bypass) {
+			cache_refill(slab);
+		}
+#endif
+
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 		slab->max_used = MAX(slab->num_used, slab->max_used);
 #endif
@@ -147,24 +348,29 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
-	if (slab->free_list == NULL && IS_ENABLED(CONFIG_MULTITHREADING)) {
-		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cache_free(slab, *mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+#endif
 
-		if (pending_thread != NULL) {
-			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+	key = k_spin_lock(&slab->lock);
 
-			z_thread_return_value_set_with_data(pending_thread, 0, *mem);
-			z_ready_thread(pending_thread);
-			z_reschedule(&slab->lock, key);
-			return;
-		}
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+	if (free_block_locked(slab, *mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+		z_reschedule(&slab->lock, key);
+		return;
 	}
-	**(char ***) mem = slab->free_list;
-	slab->free_list = *(char **) mem;
-	slab->num_used--;
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	slab->cache_bypass = z_waitq_head(&slab->wait_q) != NULL;
+#endif
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
@@ -178,9 +384,14 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 	}
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	uint32_t num_used = slab->num_used;
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	num_used -= cached_blocks(slab);
+#endif
 
-	stats->allocated_bytes = slab->num_used * slab->block_size;
-	stats->free_bytes = (slab->num_blocks - slab->num_used) * slab->block_size;
+	stats->allocated_bytes = num_used * slab->block_size;
+	stats->free_bytes = (slab->num_blocks - num_used) * slab->block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->max_used * slab->block_size;
 #else
@@ -208,3 +419,23 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab)
 	return 0;
 }
 #endif
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE_STATS
+int k_mem_slab_cpu_cache_stats_get(struct k_mem_slab *slab, int cpu,
+				   struct k_mem_slab_cache_stats *stats)
+{
+	if ((slab == NULL) || (stats == NULL) || (cpu < 0) ||
+	    (cpu >= arch_num_cpus())) {
+		return -EINVAL;
+	}
+
+	/* The counters are updated under the lock of the CPU's cache */
+	k_spinlock_key_t key = k_spin_lock(&slab->cache[cpu].lock);
+
+	*stats = slab->cache_stats[cpu];
+
+	k_spin_unlock(&slab->cache[cpu].lock, key);
+
+	return 0;
+}
+#endif
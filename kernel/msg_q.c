@@ -32,6 +32,237 @@ static inline void handle_poll_events(struct k_msgq *msgq, uint32_t state)
 }
 #endif /* CONFIG_POLL */
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+/*
+ * Lock-free message queues are bounded MPMC rings in the style of Dmitry
+ * Vyukov's: each slot has a sequence number telling whether it can be
+ * written or read at the current position of the tail or head, which are
+ * claimed with a compare-and-swap. The sequence number of the slot at
+ * position pos is pos when the slot is free for it, and pos + 1 once it
+ * holds its message. Slot i stores its sequence number minus i, so that
+ * zero-initialized storage describes an empty queue.
+ *
+ * The lock and the wait queues are only used by threads that have to wait.
+ * Threads waiting to put pend on wait_q and those waiting to get on
+ * lf_get_wait_q. A thread counts itself in the waiters of its kind and
+ * tries again under the lock before pending; successful operations check
+ * the waiters of the other kind after updating the slot, and wake one of
+ * them up to try again. The atomic operations being sequentially
+ * consistent, either the waiter sees the update or the updater sees the
+ * waiter.
+ */
+
+static inline bool msgq_is_lockfree(struct k_msgq *msgq)
+{
+	return (msgq->flags & K_MSGQ_FLAG_LOCKFREE) != 0U;
+}
+
+static inline unsigned long msgq_lf_seq_get(struct k_msgq *msgq, uint32_t i)
+{
+	return (unsigned long)atomic_get(&msgq->lf_seq[i]) + i;
+}
+
+static inline void msgq_lf_seq_set(struct k_msgq *msgq, uint32_t i, unsigned long seq)
+{
+	(void)atomic_set(&msgq->lf_seq[i], (atomic_val_t)(seq - i));
+}
+
+static inline char *msgq_lf_slot(struct k_msgq *msgq, uint32_t i)
+{
+	return msgq->buffer_start + i * msgq->msg_size;
+}
+
+static int msgq_lf_put(struct k_msgq *msgq, const void *data)
+{
+	uint32_t mask = msgq->max_msgs - 1U;
+	unsigned long pos = (unsigned long)atomic_get(&msgq->lf_tail);
+	unsigned long seq;
+	uint32_t i;
+
+	for (;;) {
+		i = pos & mask;
+		seq = msgq_lf_seq_get(msgq, i);
+
+		if (seq == pos) {
+			if (atomic_cas(&msgq->lf_tail, (atomic_val_t)pos,
+				       (atomic_val_t)(pos + 1U))) {
+				break;
+			}
+		} else if ((long)(seq - pos) < 0) {
+			/* slot still holds the message from the previous lap */
+			return -ENOMSG;
+		} else {
+			/* another thread took the slot */
+		}
+
+		pos = (unsigned long)atomic_get(&msgq->lf_tail);
+	}
+
+	(void)memcpy(msgq_lf_slot(msgq, i), data, msgq->msg_size);
+	msgq_lf_seq_set(msgq, i, pos + 1U);
+
+	return 0;
+}
+
+static int msgq_lf_get(struct k_msgq *msgq, void *data)
+{
+	uint32_t mask = msgq->max_msgs - 1U;
+	unsigned long pos = (unsigned long)atomic_get(&msgq->lf_head);
+	unsigned long seq;
+	uint32_t i;
+
+	for (;;) {
+		i = pos & mask;
+		seq = msgq_lf_seq_get(msgq, i);
+
+		if (seq == pos + 1U) {
+			if (atomic_cas(&msgq->lf_head, (atomic_val_t)pos,
+				       (atomic_val_t)(pos + 1U))) {
+				break;
+			}
+		} else if ((long)(seq - (pos + 1U)) < 0) {
+			/* slot not written yet */
+			return -ENOMSG;
+		} else {
+			/* another thread took the message */
+		}
+
+		pos = (unsigned long)atomic_get(&msgq->lf_head);
+	}
+
+	if (data != NULL) {
+		(void)memcpy(data, msgq_lf_slot(msgq, i), msgq->msg_size);
+	}
+	msgq_lf_seq_set(msgq, i, pos + msgq->max_msgs);
+
+	return 0;
+}
+
+/* Copy the message at position head + idx without taking it, retrying if
+ * it is taken meanwhile.
+ */
+static int msgq_lf_peek_at(struct k_msgq *msgq, void *data, uint32_t idx)
+{
+	uint32_t mask = msgq->max_msgs - 1U;
+	unsigned long pos;
+	uint32_t i;
+
+	for (;;) {
+		pos = (unsigned long)atomic_get(&msgq->lf_head) + idx;
+		i = pos & mask;
+
+		if (idx >= msgq->max_msgs || msgq_lf_seq_get(msgq, i) != pos + 1U) {
+			return -ENOMSG;
+		}
+
+		(void)memcpy(data, msgq_lf_slot(msgq, i), msgq->msg_size);
+
+		if (msgq_lf_seq_get(msgq, i) == pos + 1U) {
+			return 0;
+		}
+	}
+}
+
+/* Wake up the first thread of a wait queue, or all of them */
+static void msgq_lf_wake_waiters(struct k_msgq *msgq, _wait_q_t *wait_q, atomic_t *waiters,
+				 int value, bool all)
+{
+	k_spinlock_key_t key;
+	struct k_thread *pending_thread;
+	bool woken = false;
+
+	if (atomic_get(waiters) == 0) {
+		return;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	while ((pending_thread = z_unpend_first_thread(wait_q)) != NULL) {
+		arch_thread_return_value_set(pending_thread, value);
+		z_ready_thread(pending_thread);
+		woken = true;
+
+		if (!all) {
+			break;
+		}
+	}
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+}
+
+/* Run a fast path operation until it succeeds, waiting on the given wait
+ * queue in between for at most the given timeout.
+ */
+static int msgq_lf_wait(struct k_msgq *msgq, int (*op)(struct k_msgq *msgq, void *data),
+			void *data, _wait_q_t *wait_q, atomic_t *waiters, k_timeout_t timeout)
+{
+	int64_t now, end = sys_clock_timeout_end_calc(timeout);
+	k_spinlock_key_t key;
+	int result;
+
+	for (;;) {
+		result = op(msgq, data);
+		if (result == 0 || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return result;
+		}
+
+		key = k_spin_lock(&msgq->lock);
+		atomic_inc(waiters);
+
+		result = op(msgq, data);
+		now = sys_clock_tick_get();
+		if (result == 0 || (!K_TIMEOUT_EQ(timeout, K_FOREVER) && end - now <= 0)) {
+			atomic_dec(waiters);
+			k_spin_unlock(&msgq->lock, key);
+			return result == 0 ? 0 : -EAGAIN;
+		}
+
+		result = z_pend_curr(&msgq->lock, key, wait_q,
+				     K_TIMEOUT_EQ(timeout, K_FOREVER) ? K_FOREVER :
+				     K_TICKS(end - now));
+		atomic_dec(waiters);
+		if (result != 0) {
+			/* timed out, or the queue was purged */
+			return result;
+		}
+	}
+}
+
+static int msgq_lf_put_op(struct k_msgq *msgq, void *data)
+{
+	return msgq_lf_put(msgq, data);
+}
+
+static int msgq_lf_get_op(struct k_msgq *msgq, void *data)
+{
+	return msgq_lf_get(msgq, data);
+}
+
+void k_msgq_lockfree_init(struct k_msgq *msgq, char *buffer, atomic_t *seq,
+			  size_t msg_size, uint32_t max_msgs)
+{
+	__ASSERT(IS_POWER_OF_TWO(max_msgs),
+		 "lock-free message queue length must be a power of 2");
+
+	for (uint32_t i = 0; i < max_msgs; i++) {
+		atomic_clear(&seq[i]);
+	}
+
+	k_msgq_init(msgq, buffer, msg_size, max_msgs);
+	atomic_clear(&msgq->lf_tail);
+	atomic_clear(&msgq->lf_head);
+	z_waitq_init(&msgq->lf_get_wait_q);
+	atomic_clear(&msgq->lf_put_waiters);
+	atomic_clear(&msgq->lf_get_waiters);
+	msgq->lf_seq = seq;
+	msgq->flags = K_MSGQ_FLAG_LOCKFREE;
+}
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs)
 {
@@ -43,6 +274,9 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	msgq->write_ptr = buffer;
 	msgq->used_msgs = 0;
 	msgq->flags = 0;
+#ifdef CONFIG_MSGQ_LOCKFREE
+	msgq->lf_seq = NULL;
+#endif
 	z_waitq_init(&msgq->wait_q);
 	msgq->lock = (struct k_spinlock) {};
 #ifdef CONFIG_POLL
@@ -102,6 +336,14 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 		return -EBUSY;
 	}
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+	CHECKIF(msgq_is_lockfree(msgq) && z_waitq_head(&msgq->lf_get_wait_q) != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, cleanup, msgq, -EBUSY);
+
+		return -EBUSY;
+	}
+#endif
+
 	if ((msgq->flags & K_MSGQ_FLAG_ALLOC) != 0U) {
 		k_free(msgq->buffer_start);
 		msgq->flags &= ~K_MSGQ_FLAG_ALLOC;
@@ -121,6 +363,27 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+	if (msgq_is_lockfree(msgq)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
+
+		result = msgq_lf_wait(msgq, msgq_lf_put_op, (void *)data, &msgq->wait_q,
+				      &msgq->lf_put_waiters, timeout);
+		if (result == 0) {
+#ifdef CONFIG_POLL
+			/* The poll lock orders this with pollers checking the queue */
+			handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+			msgq_lf_wake_waiters(msgq, &msgq->lf_get_wait_q,
+					     &msgq->lf_get_waiters, 0, false);
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+
+		return result;
+	}
+#endif
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
@@ -191,7 +454,7 @@ void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
 	attrs->max_msgs = msgq->max_msgs;
-	attrs->used_msgs = msgq->used_msgs;
+	attrs->used_msgs = z_impl_k_msgq_num_used_get(msgq);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -213,6 +476,23 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 	struct k_thread *pending_thread;
 	int result;
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+	if (msgq_is_lockfree(msgq)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
+
+		result = msgq_lf_wait(msgq, msgq_lf_get_op, data, &msgq->lf_get_wait_q,
+				      &msgq->lf_get_waiters, timeout);
+		if (result == 0) {
+			msgq_lf_wake_waiters(msgq, &msgq->wait_q,
+					     &msgq->lf_put_waiters, 0, false);
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+
+		return result;
+	}
+#endif
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
@@ -290,6 +570,16 @@ int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+	if (msgq_is_lockfree(msgq)) {
+		result = msgq_lf_peek_at(msgq, data, 0);
+
+		SYS_PORT_TRACING_OBJ_FUNC(k_msgq, peek, msgq, result);
+
+		return result;
+	}
+#endif
+
 	key = k_spin_lock(&msgq->lock);
 
 	if (msgq->used_msgs > 0U) {
@@ -327,6 +617,16 @@ int z_impl_k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx)
 	uint32_t byte_offset;
 	char *start_addr;
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+	if (msgq_is_lockfree(msgq)) {
+		result = msgq_lf_peek_at(msgq, data, idx);
+
+		SYS_PORT_TRACING_OBJ_FUNC(k_msgq, peek, msgq, result);
+
+		return result;
+	}
+#endif
+
 	key = k_spin_lock(&msgq->lock);
 
 	if (msgq->used_msgs > idx) {
@@ -370,6 +670,21 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 	k_spinlock_key_t key;
 	struct k_thread *pending_thread;
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+	if (msgq_is_lockfree(msgq)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_msgq, purge, msgq);
+
+		/* Messages put meanwhile may be discarded as well */
+		while (msgq_lf_get(msgq, NULL) == 0) {
+		}
+
+		/* Only the threads waiting to put fail, as with the lock */
+		msgq_lf_wake_waiters(msgq, &msgq->wait_q, &msgq->lf_put_waiters,
+				     -ENOMSG, true);
+		return;
+	}
+#endif
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, purge, msgq);
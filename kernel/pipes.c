@@ -48,6 +48,13 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 
 #if defined(CONFIG_POLL)
 	sys_dlist_init(&pipe->poll_events);
+#endif
+#if defined(CONFIG_PIPES_ZERO_COPY)
+	pipe->claim.read_size = 0U;
+	pipe->claim.write_size = 0U;
+	pipe->claim.read_peer = NULL;
+	pipe->claim.write_peer = NULL;
+	z_waitq_init(&pipe->claim.wait_q);
 #endif
 	z_object_init(pipe);
 }
@@ -155,7 +162,9 @@ int k_pipe_cleanup(struct k_pipe *pipe)
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
 	CHECKIF(z_waitq_head(&pipe->wait_q.readers) != NULL ||
-			z_waitq_head(&pipe->wait_q.writers) != NULL) {
+			z_waitq_head(&pipe->wait_q.writers) != NULL ||
+			(pipe->flags & (K_PIPE_FLAG_READ_CLAIM |
+					K_PIPE_FLAG_WRITE_CLAIM)) != 0U) {
 		k_spin_unlock(&pipe->lock, key);
 
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, cleanup, pipe, -EAGAIN);
@@ -313,6 +322,8 @@ static int pipe_return_code(size_t min_xfer, size_t bytes_remaining,
 
 /**
  * @brief Copy data from source(s) to destination(s)
+ *
+ * Either the sources or the destinations may be the pipe buffer.
  */
 
 static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
@@ -338,6 +349,17 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 		src->buffer         += bytes_copied;
 		src->bytes_to_xfer  -= bytes_copied;
 
+		if (src->thread == NULL) {
+
+			/* Reading from the pipe buffer. Update details. */
+
+			pipe->bytes_used -= bytes_copied;
+			pipe->read_index += bytes_copied;
+			if (pipe->read_index >= pipe->size) {
+				pipe->read_index -= pipe->size;
+			}
+		}
+
 		if (dest->thread == NULL) {
 
 			/* Writing to the pipe buffer. Update details. */
@@ -369,6 +391,105 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 	return num_bytes_written;
 }
 
+#ifdef CONFIG_PIPES_ZERO_COPY
+/**
+ * @brief Callback routine used to find threads waiting for a claim
+ *
+ * A thread waiting for a claim to be possible waits with an empty
+ * descriptor.
+ *
+ * @return 0 to continue walking
+ */
+static int pipe_claimant_walk_op(struct k_thread *thread, void *data)
+{
+	struct _pipe_desc *desc = (struct _pipe_desc *)thread->base.swap_data;
+
+	if (desc->bytes_to_xfer == 0U) {
+		sys_dlist_append((sys_dlist_t *)data, &desc->node);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Wake up the threads waiting for a claim to be possible
+ */
+static void pipe_claimants_wake(_wait_q_t *wait_q, bool *reschedule)
+{
+	struct _pipe_desc *desc;
+	sys_dlist_t        list;
+
+	sys_dlist_init(&list);
+
+	(void) z_sched_waitq_walk(wait_q, pipe_claimant_walk_op, &list);
+
+	while ((desc = (struct _pipe_desc *)sys_dlist_get(&list)) != NULL) {
+		z_unpend_thread(desc->thread);
+		z_ready_thread(desc->thread);
+		*reschedule = true;
+	}
+}
+
+/**
+ * @brief Wait until the buffer of a descriptor is no longer claimed
+ *
+ * A thread lending its buffer to a claim may stop waiting for the pipe
+ * when its waiting period is over, but not return before the claim ends.
+ */
+static k_spinlock_key_t pipe_lender_wait(struct k_pipe *pipe,
+					 struct _pipe_desc *desc,
+					 k_spinlock_key_t key)
+{
+	while ((pipe->claim.read_peer == desc) ||
+	       (pipe->claim.write_peer == desc)) {
+		(void) z_pend_curr(&pipe->lock, key, &pipe->claim.wait_q,
+				   K_FOREVER);
+		key = k_spin_lock(&pipe->lock);
+	}
+
+	return key;
+}
+#endif /* CONFIG_PIPES_ZERO_COPY */
+
+/**
+ * @brief Refill the pipe buffer from the waiting writer(s)
+ */
+static void pipe_refill(struct k_pipe *pipe, bool *reschedule)
+{
+	struct _pipe_desc  pipe_desc[2];
+	sys_dlist_t        src_list;
+	sys_dlist_t        pipe_list;
+
+	if (pipe->bytes_used == pipe->size) {
+		return;
+	}
+
+	/*
+	 * The pipe is not full. If there are any waiting writers,
+	 * refill the pipe.
+	 */
+
+	sys_dlist_init(&src_list);
+	sys_dlist_init(&pipe_list);
+
+	(void) pipe_waiter_list_populate(&src_list,
+					 &pipe->wait_q.writers,
+					 pipe->size - pipe->bytes_used);
+
+	(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
+					 pipe->buffer, pipe->size,
+					 pipe->write_index,
+					 pipe->read_index);
+
+	(void) pipe_write(pipe, &src_list, &pipe_list, reschedule);
+
+#ifdef CONFIG_PIPES_ZERO_COPY
+	if (pipe->bytes_used != pipe->size) {
+		pipe_claimants_wake(&pipe->wait_q.writers, reschedule);
+	}
+#endif
+}
+
 int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 		     size_t *bytes_written, size_t min_xfer,
 		      k_timeout_t timeout)
@@ -492,6 +613,9 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 	 */
 
 	key = k_spin_lock(&pipe->lock);
+#ifdef CONFIG_PIPES_ZERO_COPY
+	key = pipe_lender_wait(pipe, src_desc, key);
+#endif
 	k_spin_unlock(&pipe->lock, key);
 
 	*bytes_written = bytes_to_write - src_desc->bytes_to_xfer;
@@ -617,29 +741,7 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 		src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
 	}
 
-	if (pipe->bytes_used != pipe->size) {
-		sys_dlist_t         pipe_list;
-
-		/*
-		 * The pipe is not full. If there are any waiting writers,
-		 * refill the pipe.
-		 */
-
-		sys_dlist_init(&src_list);
-		sys_dlist_init(&pipe_list);
-
-		(void) pipe_waiter_list_populate(&src_list,
-						 &pipe->wait_q.writers,
-						 pipe->size - pipe->bytes_used);
-
-		(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
-						 pipe->buffer, pipe->size,
-						 pipe->write_index,
-						 pipe->read_index);
-
-		(void) pipe_write(pipe, &src_list,
-				  &pipe_list, &reschedule_needed);
-	}
+	pipe_refill(pipe, &reschedule_needed);
 
 	/*
 	 * The immediate success conditions below are backwards
@@ -678,6 +780,9 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 	 */
 
 	key = k_spin_lock(&pipe->lock);
+#ifdef CONFIG_PIPES_ZERO_COPY
+	key = pipe_lender_wait(pipe, dest_desc, key);
+#endif
 	k_spin_unlock(&pipe->lock, key);
 
 	*bytes_read = bytes_to_read - dest_desc->bytes_to_xfer;
@@ -801,3 +906,337 @@ size_t z_vrfy_k_pipe_write_avail(struct k_pipe *pipe)
 }
 #include <syscalls/k_pipe_write_avail_mrsh.c>
 #endif
+
+#ifdef CONFIG_PIPES_ZERO_COPY
+/**
+ * @brief Callback routine used to find the first thread that can lend its
+ * buffer to a claim
+ *
+ * @return 1 to stop further walking; 0 to continue walking
+ */
+static int pipe_lender_walk_op(struct k_thread *thread, void *data)
+{
+	struct _pipe_desc *desc = (struct _pipe_desc *)thread->base.swap_data;
+
+	if (desc->bytes_to_xfer == 0U) {
+		/* The thread is waiting for a claim itself */
+		return 0;
+	}
+
+	*(struct _pipe_desc **)data = desc;
+
+	return 1;
+}
+
+/**
+ * @brief Wait on the pipe for a claim to be possible
+ *
+ * @return false if the waiting period is over
+ */
+static bool pipe_claim_wait(struct k_pipe *pipe, k_spinlock_key_t key,
+			    _wait_q_t *wait_q, k_timeout_t timeout,
+			    int64_t end)
+{
+	struct _pipe_desc *desc = &_current->pipe_desc;
+	int64_t now = sys_clock_tick_get();
+
+	if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		if (end - now <= 0) {
+			k_spin_unlock(&pipe->lock, key);
+			return false;
+		}
+
+		timeout = K_TICKS(end - now);
+	}
+
+	/* An empty descriptor, so that the next transfer wakes us up */
+
+	desc->buffer = NULL;
+	desc->bytes_to_xfer = 0U;
+	desc->thread = _current;
+	_current->base.swap_data = desc;
+
+	(void) z_sched_wait(&pipe->lock, key, wait_q, timeout, NULL);
+
+	return true;
+}
+
+/**
+ * @brief End the claim of the buffer of a waiting thread
+ *
+ * @return true if a thread was woken up
+ */
+static bool pipe_lender_release(struct k_pipe *pipe, struct _pipe_desc *desc,
+				size_t size, _wait_q_t *wait_q)
+{
+	bool reschedule = false;
+
+	desc->buffer += size;
+	desc->bytes_to_xfer -= size;
+
+	if ((desc->bytes_to_xfer == 0U) &&
+	    (desc->thread->base.pended_on == wait_q)) {
+
+		/* The thread's request has been satisfied. */
+
+		z_unpend_thread(desc->thread);
+		z_ready_thread(desc->thread);
+		reschedule = true;
+	}
+
+	/* The thread may have stopped waiting meanwhile */
+
+	if (z_unpend_all(&pipe->claim.wait_q) != 0) {
+		reschedule = true;
+	}
+
+	return reschedule;
+}
+
+int k_pipe_read_claim(struct k_pipe *pipe, void **data, size_t *size,
+		      k_timeout_t timeout)
+{
+	int64_t            end = sys_clock_timeout_end_calc(timeout);
+	struct _pipe_desc *lender = NULL;
+	size_t             bytes_can_read;
+	k_spinlock_key_t   key;
+
+	__ASSERT(((arch_is_in_isr() == false) ||
+		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
+
+	CHECKIF((data == NULL) || (size == NULL) || (*size == 0U)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	for (;;) {
+		if ((pipe->flags & K_PIPE_FLAG_READ_CLAIM) != 0U) {
+			k_spin_unlock(&pipe->lock, key);
+			return -EBUSY;
+		}
+
+		/*
+		 * Data in the pipe buffer comes before the data of the
+		 * waiting writers, which is only read from their buffers
+		 * when the pipe buffer is empty.
+		 */
+
+		if (pipe->bytes_used != 0U) {
+			*data = &pipe->buffer[pipe->read_index];
+			bytes_can_read = (pipe->read_index < pipe->write_index) ?
+					 pipe->write_index - pipe->read_index :
+					 pipe->size - pipe->read_index;
+			break;
+		}
+
+		(void) z_sched_waitq_walk(&pipe->wait_q.writers,
+					  pipe_lender_walk_op, &lender);
+		if (lender != NULL) {
+			*data = lender->buffer;
+			bytes_can_read = lender->bytes_to_xfer;
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&pipe->lock, key);
+			return -EIO;
+		}
+
+		if (!pipe_claim_wait(pipe, key, &pipe->wait_q.readers,
+				     timeout, end)) {
+			return -EAGAIN;
+		}
+
+		key = k_spin_lock(&pipe->lock);
+	}
+
+	*size = MIN(*size, bytes_can_read);
+
+	pipe->flags |= K_PIPE_FLAG_READ_CLAIM;
+	pipe->claim.read_size = *size;
+	pipe->claim.read_peer = lender;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return 0;
+}
+
+int k_pipe_read_finish(struct k_pipe *pipe, size_t size)
+{
+	bool             reschedule_needed = false;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	CHECKIF(((pipe->flags & K_PIPE_FLAG_READ_CLAIM) == 0U) ||
+		(size > pipe->claim.read_size)) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->flags &= ~K_PIPE_FLAG_READ_CLAIM;
+
+	if (pipe->claim.read_peer != NULL) {
+		struct _pipe_desc *lender = pipe->claim.read_peer;
+
+		pipe->claim.read_peer = NULL;
+		reschedule_needed = pipe_lender_release(pipe, lender, size,
+							&pipe->wait_q.writers);
+	} else {
+
+		/* Reading from the pipe buffer. Update details. */
+
+		pipe->bytes_used -= size;
+		pipe->read_index += size;
+		if (pipe->read_index >= pipe->size) {
+			pipe->read_index -= pipe->size;
+		}
+
+		pipe_refill(pipe, &reschedule_needed);
+	}
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+int k_pipe_write_claim(struct k_pipe *pipe, void **data, size_t *size,
+		       k_timeout_t timeout)
+{
+	int64_t            end = sys_clock_timeout_end_calc(timeout);
+	struct _pipe_desc *lender = NULL;
+	size_t             bytes_can_write;
+	k_spinlock_key_t   key;
+
+	__ASSERT(((arch_is_in_isr() == false) ||
+		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
+
+	CHECKIF((data == NULL) || (size == NULL) || (*size == 0U)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	for (;;) {
+		if ((pipe->flags & K_PIPE_FLAG_WRITE_CLAIM) != 0U) {
+			k_spin_unlock(&pipe->lock, key);
+			return -EBUSY;
+		}
+
+		/*
+		 * Waiting readers get the data before the pipe buffer, as
+		 * k_pipe_put() does.
+		 */
+
+		(void) z_sched_waitq_walk(&pipe->wait_q.readers,
+					  pipe_lender_walk_op, &lender);
+		if (lender != NULL) {
+			*data = lender->buffer;
+			bytes_can_write = lender->bytes_to_xfer;
+			break;
+		}
+
+		if (pipe->bytes_used != pipe->size) {
+			*data = &pipe->buffer[pipe->write_index];
+			bytes_can_write = (pipe->write_index < pipe->read_index) ?
+					  pipe->read_index - pipe->write_index :
+					  pipe->size - pipe->write_index;
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&pipe->lock, key);
+			return -EIO;
+		}
+
+		if (!pipe_claim_wait(pipe, key, &pipe->wait_q.writers,
+				     timeout, end)) {
+			return -EAGAIN;
+		}
+
+		key = k_spin_lock(&pipe->lock);
+	}
+
+	*size = MIN(*size, bytes_can_write);
+
+	pipe->flags |= K_PIPE_FLAG_WRITE_CLAIM;
+	pipe->claim.write_size = *size;
+	pipe->claim.write_peer = lender;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return 0;
+}
+
+int k_pipe_write_finish(struct k_pipe *pipe, size_t size)
+{
+	bool             reschedule_needed = false;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	CHECKIF(((pipe->flags & K_PIPE_FLAG_WRITE_CLAIM) == 0U) ||
+		(size > pipe->claim.write_size)) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->flags &= ~K_PIPE_FLAG_WRITE_CLAIM;
+
+	if (pipe->claim.write_peer != NULL) {
+		struct _pipe_desc *lender = pipe->claim.write_peer;
+
+		pipe->claim.write_peer = NULL;
+		reschedule_needed = pipe_lender_release(pipe, lender, size,
+							&pipe->wait_q.readers);
+	} else {
+		sys_dlist_t        src_list;
+		sys_dlist_t        dest_list;
+		struct _pipe_desc  pipe_desc[2];
+
+		/* Writing to the pipe buffer. Update details. */
+
+		pipe->bytes_used += size;
+		pipe->write_index += size;
+		if (pipe->write_index >= pipe->size) {
+			pipe->write_index -= pipe->size;
+		}
+
+		/*
+		 * Readers may have started waiting since the space was
+		 * claimed. Give them the data from the pipe buffer.
+		 */
+
+		if (pipe->bytes_used != 0U) {
+			sys_dlist_init(&src_list);
+			sys_dlist_init(&dest_list);
+
+			(void) pipe_buffer_list_populate(&src_list, pipe_desc,
+							 pipe->buffer,
+							 pipe->size,
+							 pipe->read_index,
+							 pipe->write_index);
+
+			(void) pipe_waiter_list_populate(&dest_list,
+							 &pipe->wait_q.readers,
+							 pipe->bytes_used);
+
+			(void) pipe_write(pipe, &src_list, &dest_list,
+					  &reschedule_needed);
+		}
+
+		if ((pipe->bytes_used != 0U) && (size != 0U)) {
+			handle_poll_events(pipe);
+		}
+	}
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_PIPES_ZERO_COPY */
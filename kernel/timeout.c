@@ -14,7 +14,17 @@
 
 static uint64_t curr_tick;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+static bool timeout_lessthan(struct rbnode *a, struct rbnode *b);
+
+static struct rbtree timeout_tree = {
+	.lessthan_fn = timeout_lessthan,
+};
+
+static uint32_t next_order_key = 1U;
+#else
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
@@ -36,6 +46,82 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+
+/* In this mode dticks holds the absolute tick at which a queued
+ * timeout expires, so its position in the tree and its remaining
+ * time don't depend on the other entries.  Timeouts expiring on the
+ * same tick are kept in insertion order by their order_key.
+ */
+static bool timeout_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	struct _timeout *ta = CONTAINER_OF(a, struct _timeout, node);
+	struct _timeout *tb = CONTAINER_OF(b, struct _timeout, node);
+
+	if (ta->dticks != tb->dticks) {
+		return ta->dticks < tb->dticks;
+	}
+
+	return ta->order_key < tb->order_key;
+}
+
+static struct _timeout *first(void)
+{
+	struct rbnode *n = rb_get_min(&timeout_tree);
+
+	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
+}
+
+/* Ticks from curr_tick until the (queued) timeout expires */
+static k_ticks_t timeout_ticks(const struct _timeout *timeout)
+{
+	return timeout->dticks - (k_ticks_t)curr_tick;
+}
+
+static void insert_timeout(struct _timeout *to, k_ticks_t ticks)
+{
+	/* Renumber at wraparound, like the scheduler's rbtree queue.
+	 * Zero is reserved to mark a timeout that is not queued.
+	 */
+	if (next_order_key == UINT32_MAX) {
+		struct _timeout *t;
+
+		next_order_key = 1U;
+		RB_FOR_EACH_CONTAINER(&timeout_tree, t, node) {
+			t->order_key = next_order_key++;
+		}
+	}
+
+	to->dticks = (k_ticks_t)curr_tick + ticks;
+	to->order_key = next_order_key++;
+	rb_insert(&timeout_tree, &to->node);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	rb_remove(&timeout_tree, &t->node);
+	t->order_key = 0U;
+
+	if (timeout_tree.root == NULL) {
+		next_order_key = 1U;
+	}
+}
+
+/* Dequeue the first timeout once curr_tick has reached its expiry */
+static void expire_first(struct _timeout *t)
+{
+	remove_timeout(t);
+}
+
+/* Account for ticks announced short of the first timeout's expiry */
+static void advance_first(struct _timeout *t, int32_t ticks)
+{
+	ARG_UNUSED(t);
+	ARG_UNUSED(ticks);
+}
+
+#else
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -50,6 +136,41 @@ static struct _timeout *next(struct _timeout *t)
 	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
+/* Ticks from curr_tick until the (queued) timeout expires */
+static k_ticks_t timeout_ticks(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+static void insert_timeout(struct _timeout *to, k_ticks_t ticks)
+{
+	struct _timeout *t;
+
+	to->dticks = ticks;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+}
+
 static void remove_timeout(struct _timeout *t)
 {
 	if (next(t) != NULL) {
@@ -59,6 +180,21 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+/* Dequeue the first timeout once curr_tick has reached its expiry */
+static void expire_first(struct _timeout *t)
+{
+	t->dticks = 0;
+	remove_timeout(t);
+}
+
+/* Account for ticks announced short of the first timeout's expiry */
+static void advance_first(struct _timeout *t, int32_t ticks)
+{
+	t->dticks -= ticks;
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
+
 static int32_t elapsed(void)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
@@ -87,10 +223,10 @@ static int32_t next_timeout(void)
 	int32_t ret;
 
 	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	    ((int64_t)(timeout_ticks(to) - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, timeout_ticks(to) - ticks_elapsed);
 	}
 
 	return ret;
@@ -107,33 +243,20 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	__ASSERT_NO_MSG(arch_mem_coherent(to));
 #endif
 
-	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	__ASSERT(z_is_inactive_timeout(to), "");
 	to->fn = fn;
 
 	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
+		k_ticks_t ticks;
 
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
-			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
-
-			to->dticks = MAX(1, ticks);
+			ticks = MAX(1, Z_TICK_ABS(timeout.ticks) - curr_tick);
 		} else {
-			to->dticks = timeout.ticks + 1 + elapsed();
-		}
-
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
+			ticks = timeout.ticks + 1 + elapsed();
 		}
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+		insert_timeout(to, ticks);
 
 		if (to == first()) {
 			sys_clock_set_timeout(next_timeout(), false);
@@ -146,7 +269,7 @@ int z_abort_timeout(struct _timeout *to)
 	int ret = -EINVAL;
 
 	K_SPINLOCK(&timeout_lock) {
-		if (sys_dnode_is_linked(&to->node)) {
+		if (!z_is_inactive_timeout(to)) {
 			remove_timeout(to);
 			ret = 0;
 		}
@@ -158,20 +281,11 @@ int z_abort_timeout(struct _timeout *to)
 /* must be locked */
 static k_ticks_t timeout_rem(const struct _timeout *timeout)
 {
-	k_ticks_t ticks = 0;
-
 	if (z_is_inactive_timeout(timeout)) {
 		return 0;
 	}
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks - elapsed();
+	return timeout_ticks(timeout) - elapsed();
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
@@ -227,13 +341,12 @@ void sys_clock_announce(int32_t ticks)
 	struct _timeout *t = first();
 
 	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
+	     (t != NULL) && (timeout_ticks(t) <= announce_remaining);
 	     t = first()) {
-		int dt = t->dticks;
+		int dt = timeout_ticks(t);
 
 		curr_tick += dt;
-		t->dticks = 0;
-		remove_timeout(t);
+		expire_first(t);
 
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
@@ -242,7 +355,7 @@ void sys_clock_announce(int32_t ticks)
 	}
 
 	if (t != NULL) {
-		t->dticks -= announce_remaining;
+		advance_first(t, announce_remaining);
 	}
 
 	curr_tick += announce_remaining;
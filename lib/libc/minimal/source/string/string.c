@@ -97,6 +97,8 @@ char *strrchr(const char *s, int c)
 	return match;
 }
 
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SPEED)
+
 /**
  *
  * @brief Get string length
@@ -116,6 +118,8 @@ size_t strlen(const char *s)
 	return n;
 }
 
+#endif /* !CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SPEED */
+
 /**
  *
  * @brief Compare two strings
@@ -211,6 +215,8 @@ char *strncat(char *ZRESTRICT dest, const char *ZRESTRICT src,
 	return orig_dest;
 }
 
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SPEED)
+
 /**
  *
  * @brief Compare two memory areas
@@ -219,8 +225,8 @@ char *strncat(char *ZRESTRICT dest, const char *ZRESTRICT src,
  */
 int memcmp(const void *m1, const void *m2, size_t n)
 {
-	const char *c1 = m1;
-	const char *c2 = m2;
+	const unsigned char *c1 = m1;
+	const unsigned char *c2 = m2;
 
 	if (!n) {
 		return 0;
@@ -375,6 +381,8 @@ void *memset(void *buf, int c, size_t n)
 	return buf;
 }
 
+#endif /* !CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SPEED */
+
 /**
  *
  * @brief Scan byte in memory
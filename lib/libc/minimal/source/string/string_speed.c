@@ -0,0 +1,412 @@
+/* string_speed.c - speed optimized memory and string routines */
+
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#define WORD_SIZE sizeof(mem_word_t)
+#define WORD_MASK (WORD_SIZE - 1)
+
+/* Words moved per iteration of the unrolled loops */
+#define BLOCK_SIZE (4 * WORD_SIZE)
+
+/* Below this size, aligning the pointers costs more than it saves */
+#define SMALL_SIZE (2 * WORD_SIZE)
+
+/* Word with each of its bytes set to b */
+#define WORD_REPEAT(b) ((mem_word_t)-1 / 0xffU * (b))
+
+/* Non zero if one of the bytes of w is zero */
+#define WORD_HAS_ZERO(w) (((w) - WORD_REPEAT(0x01U)) & ~(w) & WORD_REPEAT(0x80U))
+
+#if defined(CONFIG_X86)
+
+/*
+ * String instructions copy and set blocks of any alignment, and are the
+ * fastest way to do so on processors with enhanced REP MOVSB/STOSB. Their
+ * start up cost makes them worth it for large blocks only.
+ */
+#define ARCH_STRING_MIN_SIZE 256
+
+static inline void arch_copy(unsigned char *d, const unsigned char *s, size_t n)
+{
+	__asm__ volatile("rep movsb"
+			 : "+D"(d), "+S"(s), "+c"(n)
+			 :
+			 : "memory");
+}
+
+static inline void arch_set(unsigned char *d, unsigned char c, size_t n)
+{
+	__asm__ volatile("rep stosb"
+			 : "+D"(d), "+c"(n)
+			 : "a"(c)
+			 : "memory");
+}
+
+#elif defined(CONFIG_ARMV7_M_ARMV8_M_MAINLINE)
+
+/*
+ * Load and store multiple move a block of four words in a single
+ * instruction each, and need word aligned addresses.
+ */
+#define ARCH_BLOCK_WORDS
+
+static inline void arch_copy_blocks(mem_word_t *d, const mem_word_t *s, size_t n)
+{
+	__asm__ volatile("1:\n\t"
+			 "ldmia %[s]!, {r3, r4, r5, r6}\n\t"
+			 "stmia %[d]!, {r3, r4, r5, r6}\n\t"
+			 "subs %[n], %[n], #16\n\t"
+			 "bne 1b\n\t"
+			 : [d] "+r"(d), [s] "+r"(s), [n] "+r"(n)
+			 :
+			 : "r3", "r4", "r5", "r6", "cc", "memory");
+}
+
+static inline void arch_set_blocks(mem_word_t *d, mem_word_t c, size_t n)
+{
+	__asm__ volatile("mov r3, %[c]\n\t"
+			 "mov r4, %[c]\n\t"
+			 "mov r5, %[c]\n\t"
+			 "mov r6, %[c]\n\t"
+			 "1:\n\t"
+			 "stmia %[d]!, {r3, r4, r5, r6}\n\t"
+			 "subs %[n], %[n], #16\n\t"
+			 "bne 1b\n\t"
+			 : [d] "+r"(d), [n] "+r"(n)
+			 : [c] "r"(c)
+			 : "r3", "r4", "r5", "r6", "cc", "memory");
+}
+
+#endif
+
+/* Copy n bytes, a non zero multiple of BLOCK_SIZE, between word aligned
+ * buffers. The destination may overlap the end of the source.
+ */
+static inline void copy_blocks(mem_word_t *d, const mem_word_t *s, size_t n)
+{
+#if defined(ARCH_BLOCK_WORDS)
+	arch_copy_blocks(d, s, n);
+#else
+	for (; n > 0; n -= BLOCK_SIZE) {
+		mem_word_t w0 = s[0];
+		mem_word_t w1 = s[1];
+		mem_word_t w2 = s[2];
+		mem_word_t w3 = s[3];
+
+		d[0] = w0;
+		d[1] = w1;
+		d[2] = w2;
+		d[3] = w3;
+		d += 4;
+		s += 4;
+	}
+#endif
+}
+
+/* Set n bytes, a non zero multiple of BLOCK_SIZE, of a word aligned buffer */
+static inline void set_blocks(mem_word_t *d, mem_word_t c, size_t n)
+{
+#if defined(ARCH_BLOCK_WORDS)
+	arch_set_blocks(d, c, n);
+#else
+	for (; n > 0; n -= BLOCK_SIZE) {
+		d[0] = c;
+		d[1] = c;
+		d[2] = c;
+		d[3] = c;
+		d += 4;
+	}
+#endif
+}
+
+/*
+ * Copy n bytes, a multiple of the word size, from a source which is not word
+ * aligned to a word aligned destination. Each destination word is merged
+ * from the two aligned source words it straddles, so that all the accesses
+ * are aligned.
+ *
+ * The last aligned source word read holds the last byte to copy, so no
+ * memory beyond the word the source ends in is ever read.
+ */
+static inline void copy_shifted(mem_word_t *d, const unsigned char *s, size_t n)
+{
+	unsigned int lshift = ((uintptr_t)s & WORD_MASK) * 8U;
+	unsigned int rshift = Z_MEM_WORD_T_WIDTH - lshift;
+	const mem_word_t *s_word = (const mem_word_t *)((uintptr_t)s & ~WORD_MASK);
+	mem_word_t prev = *(s_word++);
+
+	for (; n > 0; n -= WORD_SIZE) {
+		mem_word_t next = *(s_word++);
+
+#if defined(CONFIG_BIG_ENDIAN)
+		*(d++) = (prev << lshift) | (next >> rshift);
+#else
+		*(d++) = (prev >> lshift) | (next << rshift);
+#endif
+		prev = next;
+	}
+}
+
+/* Copy forward, the destination being allowed to overlap the end of the
+ * source.
+ */
+static void copy_forward(unsigned char *d_byte, const unsigned char *s_byte, size_t n)
+{
+#if defined(ARCH_STRING_MIN_SIZE)
+	if (n >= ARCH_STRING_MIN_SIZE) {
+		arch_copy(d_byte, s_byte, n);
+		return;
+	}
+#endif
+
+	if (n >= SMALL_SIZE) {
+		/* do byte-sized copying until the destination is word-aligned */
+
+		while (((uintptr_t)d_byte) & WORD_MASK) {
+			*(d_byte++) = *(s_byte++);
+			n--;
+		}
+
+		if ((((uintptr_t)s_byte) & WORD_MASK) == 0) {
+			size_t blocks = n & ~(BLOCK_SIZE - 1);
+
+			if (blocks > 0) {
+				copy_blocks((mem_word_t *)d_byte,
+					    (const mem_word_t *)s_byte, blocks);
+				d_byte += blocks;
+				s_byte += blocks;
+				n -= blocks;
+			}
+
+			while (n >= WORD_SIZE) {
+				*(mem_word_t *)d_byte = *(const mem_word_t *)s_byte;
+				d_byte += WORD_SIZE;
+				s_byte += WORD_SIZE;
+				n -= WORD_SIZE;
+			}
+		} else {
+			size_t words = n & ~WORD_MASK;
+
+			copy_shifted((mem_word_t *)d_byte, s_byte, words);
+			d_byte += words;
+			s_byte += words;
+			n -= words;
+		}
+	}
+
+	/* do byte-sized copying until finished */
+
+	while (n > 0) {
+		*(d_byte++) = *(s_byte++);
+		n--;
+	}
+}
+
+/**
+ *
+ * @brief Copy bytes in memory
+ *
+ * @return pointer to start of destination buffer
+ */
+
+void *memcpy(void *ZRESTRICT d, const void *ZRESTRICT s, size_t n)
+{
+	copy_forward(d, s, n);
+
+	return d;
+}
+
+/**
+ *
+ * @brief Copy bytes in memory with overlapping areas
+ *
+ * @return pointer to destination buffer <d>
+ */
+
+void *memmove(void *d, const void *s, size_t n)
+{
+	unsigned char *dest = d;
+	const unsigned char *src = s;
+
+	if ((size_t)(dest - src) >= n) {
+		/* It is safe to perform a forward-copy */
+		copy_forward(dest, src, n);
+		return d;
+	}
+
+	/*
+	 * The <src> buffer overlaps with the start of the <dest> buffer.
+	 * Copy backwards to prevent the premature corruption of <src>, by
+	 * words if both buffers have the same alignment.
+	 */
+
+	dest += n;
+	src += n;
+
+	if (n >= SMALL_SIZE &&
+	    (((uintptr_t)dest ^ (uintptr_t)src) & WORD_MASK) == 0) {
+		while (((uintptr_t)dest) & WORD_MASK) {
+			*(--dest) = *(--src);
+			n--;
+		}
+
+		while (n >= WORD_SIZE) {
+			dest -= WORD_SIZE;
+			src -= WORD_SIZE;
+			*(mem_word_t *)dest = *(const mem_word_t *)src;
+			n -= WORD_SIZE;
+		}
+	}
+
+	while (n > 0) {
+		*(--dest) = *(--src);
+		n--;
+	}
+
+	return d;
+}
+
+/**
+ *
+ * @brief Set bytes in memory
+ *
+ * @return pointer to start of buffer
+ */
+
+void *memset(void *buf, int c, size_t n)
+{
+	unsigned char *d_byte = (unsigned char *)buf;
+	unsigned char c_byte = (unsigned char)c;
+
+#if defined(ARCH_STRING_MIN_SIZE)
+	if (n >= ARCH_STRING_MIN_SIZE) {
+		arch_set(d_byte, c_byte, n);
+		return buf;
+	}
+#endif
+
+	if (n >= SMALL_SIZE) {
+		mem_word_t c_word = WORD_REPEAT(c_byte);
+		size_t blocks;
+
+		/* do byte-sized initialization until word-aligned */
+
+		while (((uintptr_t)d_byte) & WORD_MASK) {
+			*(d_byte++) = c_byte;
+			n--;
+		}
+
+		/* do word-sized initialization as long as possible */
+
+		blocks = n & ~(BLOCK_SIZE - 1);
+		if (blocks > 0) {
+			set_blocks((mem_word_t *)d_byte, c_word, blocks);
+			d_byte += blocks;
+			n -= blocks;
+		}
+
+		while (n >= WORD_SIZE) {
+			*(mem_word_t *)d_byte = c_word;
+			d_byte += WORD_SIZE;
+			n -= WORD_SIZE;
+		}
+	}
+
+	/* do byte-sized initialization until finished */
+
+	while (n > 0) {
+		*(d_byte++) = c_byte;
+		n--;
+	}
+
+	return buf;
+}
+
+/**
+ *
+ * @brief Compare two memory areas
+ *
+ * @return negative # if <m1> < <m2>, 0 if <m1> == <m2>, else positive #
+ */
+int memcmp(const void *m1, const void *m2, size_t n)
+{
+	const unsigned char *c1 = m1;
+	const unsigned char *c2 = m2;
+
+	if (n >= SMALL_SIZE &&
+	    (((uintptr_t)c1 ^ (uintptr_t)c2) & WORD_MASK) == 0) {
+		while (((uintptr_t)c1) & WORD_MASK) {
+			if (*c1 != *c2) {
+				return *c1 - *c2;
+			}
+			c1++;
+			c2++;
+			n--;
+		}
+
+		/* skip the equal words, the bytes of the first different
+		 * one are compared below
+		 */
+		while (n >= WORD_SIZE &&
+		       *(const mem_word_t *)c1 == *(const mem_word_t *)c2) {
+			c1 += WORD_SIZE;
+			c2 += WORD_SIZE;
+			n -= WORD_SIZE;
+		}
+	}
+
+	for (; n > 0; n--) {
+		if (*c1 != *c2) {
+			return *c1 - *c2;
+		}
+		c1++;
+		c2++;
+	}
+
+	return 0;
+}
+
+/**
+ *
+ * @brief Get string length
+ *
+ * @return number of bytes in string <s>
+ */
+
+size_t strlen(const char *s)
+{
+	const char *p = s;
+	const mem_word_t *p_word;
+
+	while (((uintptr_t)p) & WORD_MASK) {
+		if (*p == '\0') {
+			return p - s;
+		}
+		p++;
+	}
+
+	/*
+	 * Look for the terminator a word at a time. Aligned words never span
+	 * two pages or memory regions, so reading past the terminator within
+	 * the word holding it is harmless.
+	 */
+	p_word = (const mem_word_t *)p;
+	while (!WORD_HAS_ZERO(*p_word)) {
+		p_word++;
+	}
+
+	p = (const char *)p_word;
+	while (*p != '\0') {
+		p++;
+	}
+
+	return p - s;
+}
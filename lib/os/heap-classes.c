@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/kernel.h>
+#include <errno.h>
+#include <string.h>
+#include "heap.h"
+
+/* Size class front end.  Small allocations are served from pages
+ * carved out of the heap itself, each page holding objects of a
+ * single size class threaded on a free list, so allocation and free
+ * are a list pop and push instead of a bucket search, split and
+ * merge.  Pages with free objects sit on a per-class list.  A page
+ * whose objects are all free is kept around as the class's spare
+ * until a second one shows up, or until a regular allocation fails,
+ * and is then returned to the heap.
+ *
+ * Pages are aligned to their size, and a bitmap with one bit per
+ * page sized region of the heap tells which regions are pages, so
+ * sys_heap_free() can recognize objects in constant time.
+ */
+
+#define SC_PAGE  CONFIG_SYS_HEAP_SIZE_CLASS_PAGE_SIZE
+#define SC_STEP  16U
+#define SC_COUNT (CONFIG_SYS_HEAP_SIZE_CLASS_MAX / SC_STEP)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(SC_PAGE), "page size must be a power of two");
+
+struct sc_page {
+	sys_dnode_t node;
+	void *free;
+	uint16_t cls;
+	uint16_t used;
+};
+
+/* Objects start after the header, aligned to the class step */
+#define SC_HDR ROUND_UP(sizeof(struct sc_page), SC_STEP)
+
+BUILD_ASSERT(SC_HDR + CONFIG_SYS_HEAP_SIZE_CLASS_MAX + CHUNK_UNIT <= SC_PAGE,
+	     "page too small for the largest size class");
+
+struct z_heap_classes {
+	sys_dlist_t partial[SC_COUNT];
+	struct sc_page *spare[SC_COUNT];
+	uintptr_t base;
+	size_t npages;
+	uint32_t page_map[];
+};
+
+static inline size_t class_size(unsigned int cls)
+{
+	return SC_STEP * (cls + 1U);
+}
+
+static struct sc_page *page_of(struct z_heap_classes *sc, void *mem)
+{
+	uintptr_t addr = (uintptr_t)mem;
+	size_t idx;
+
+	if (addr < sc->base) {
+		return NULL;
+	}
+
+	idx = (addr - sc->base) / SC_PAGE;
+	if ((idx >= sc->npages) || ((sc->page_map[idx / 32U] & BIT(idx % 32U)) == 0U)) {
+		return NULL;
+	}
+
+	return (struct sc_page *)(sc->base + idx * SC_PAGE);
+}
+
+static void mark_page(struct z_heap_classes *sc, struct sc_page *pg, bool is_page)
+{
+	size_t idx = ((uintptr_t)pg - sc->base) / SC_PAGE;
+
+	if (is_page) {
+		sc->page_map[idx / 32U] |= BIT(idx % 32U);
+	} else {
+		sc->page_map[idx / 32U] &= ~BIT(idx % 32U);
+	}
+}
+
+static struct sc_page *new_page(struct sys_heap *heap, unsigned int cls)
+{
+	struct z_heap_classes *sc = heap->heap->classes;
+	/* The header of the next chunk takes the end of the page, so
+	 * that pages can sit back to back.
+	 */
+	size_t bytes = SC_PAGE - chunk_header_bytes(heap->heap);
+	struct sc_page *pg = sys_heap_aligned_alloc(heap, SC_PAGE, bytes);
+	size_t size = class_size(cls);
+	size_t count = (bytes - SC_HDR) / size;
+
+	if (pg == NULL) {
+		return NULL;
+	}
+
+	pg->cls = cls;
+	pg->used = 0U;
+	pg->free = NULL;
+	for (size_t i = count; i > 0; i--) {
+		uint8_t *obj = (uint8_t *)pg + SC_HDR + (i - 1) * size;
+
+		*(void **)obj = pg->free;
+		pg->free = obj;
+	}
+
+	mark_page(sc, pg, true);
+
+	return pg;
+}
+
+static void release_page(struct sys_heap *heap, struct sc_page *pg)
+{
+	mark_page(heap->heap->classes, pg, false);
+	sys_heap_free(heap, pg);
+}
+
+void *z_heap_class_alloc(struct sys_heap *heap, size_t bytes)
+{
+	struct z_heap_classes *sc = heap->heap->classes;
+	unsigned int cls = (bytes - 1U) / SC_STEP;
+	sys_dnode_t *node = sys_dlist_peek_head(&sc->partial[cls]);
+	struct sc_page *pg;
+	void *obj;
+
+	if (node != NULL) {
+		pg = CONTAINER_OF(node, struct sc_page, node);
+	} else {
+		pg = sc->spare[cls];
+		if (pg != NULL) {
+			sc->spare[cls] = NULL;
+		} else {
+			pg = new_page(heap, cls);
+			if (pg == NULL) {
+				return NULL;
+			}
+		}
+		sys_dlist_append(&sc->partial[cls], &pg->node);
+	}
+
+	obj = pg->free;
+	pg->free = *(void **)obj;
+	pg->used++;
+
+	if (pg->free == NULL) {
+		/* Full pages are only found again through their objects */
+		sys_dlist_remove(&pg->node);
+	}
+
+	return obj;
+}
+
+bool z_heap_class_free(struct sys_heap *heap, void *mem)
+{
+	struct z_heap_classes *sc = heap->heap->classes;
+	struct sc_page *pg = page_of(sc, mem);
+	bool was_full;
+
+	if (pg == NULL) {
+		return false;
+	}
+
+	__ASSERT(pg->used > 0U, "unexpected heap state (double-free?) for memory at %p", mem);
+
+	was_full = pg->free == NULL;
+	*(void **)mem = pg->free;
+	pg->free = mem;
+	pg->used--;
+
+	if (pg->used == 0U) {
+		if (!was_full) {
+			sys_dlist_remove(&pg->node);
+		}
+
+		if (sc->spare[pg->cls] == NULL) {
+			sc->spare[pg->cls] = pg;
+		} else {
+			release_page(heap, pg);
+		}
+	} else if (was_full) {
+		sys_dlist_append(&sc->partial[pg->cls], &pg->node);
+	}
+
+	return true;
+}
+
+size_t z_heap_class_size(struct sys_heap *heap, void *mem)
+{
+	struct sc_page *pg = page_of(heap->heap->classes, mem);
+
+	return (pg != NULL) ? class_size(pg->cls) : 0U;
+}
+
+bool z_heap_classes_trim(struct sys_heap *heap)
+{
+	struct z_heap_classes *sc = heap->heap->classes;
+	bool released = false;
+
+	for (unsigned int cls = 0U; cls < SC_COUNT; cls++) {
+		if (sc->spare[cls] != NULL) {
+			release_page(heap, sc->spare[cls]);
+			sc->spare[cls] = NULL;
+			released = true;
+		}
+	}
+
+	return released;
+}
+
+int sys_heap_size_classes_enable(struct sys_heap *heap)
+{
+	struct z_heap *h = heap->heap;
+	struct z_heap_classes *sc;
+	uintptr_t base, end;
+	size_t npages;
+
+	if (h->classes != NULL) {
+		return 0;
+	}
+
+	base = ROUND_DOWN((uintptr_t)chunk_buf(h), SC_PAGE);
+	end = ROUND_UP((uintptr_t)&chunk_buf(h)[h->end_chunk], SC_PAGE);
+	npages = (end - base) / SC_PAGE;
+
+	sc = sys_heap_alloc(heap, sizeof(*sc) +
+			    DIV_ROUND_UP(npages, 32U) * sizeof(uint32_t));
+	if (sc == NULL) {
+		return -ENOMEM;
+	}
+
+	for (unsigned int cls = 0U; cls < SC_COUNT; cls++) {
+		sys_dlist_init(&sc->partial[cls]);
+		sc->spare[cls] = NULL;
+	}
+	sc->base = base;
+	sc->npages = npages;
+	(void)memset(sc->page_map, 0, DIV_ROUND_UP(npages, 32U) * sizeof(uint32_t));
+
+	h->classes = sc;
+
+	return 0;
+}
@@ -166,6 +166,13 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 		return; /* ISO C free() semantics */
 	}
 	struct z_heap *h = heap->heap;
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	if ((h->classes != NULL) && z_heap_class_free(heap, mem)) {
+		return;
+	}
+#endif
+
 	chunkid_t c = mem_to_chunkid(h, mem);
 
 	/*
@@ -200,6 +207,15 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
 {
 	struct z_heap *h = heap->heap;
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	size_t class_sz = (h->classes != NULL) ? z_heap_class_size(heap, mem) : 0U;
+
+	if (class_sz != 0U) {
+		return class_sz;
+	}
+#endif
+
 	chunkid_t c = mem_to_chunkid(h, mem);
 	size_t addr = (size_t)mem;
 	size_t chunk_base = (size_t)&chunk_buf(h)[c];
@@ -269,8 +285,26 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 		return NULL;
 	}
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	if (heap_classes_fit(h, bytes)) {
+		mem = z_heap_class_alloc(heap, bytes);
+		if (mem != NULL) {
+			IF_ENABLED(CONFIG_MSAN, (__msan_allocated_memory(mem, bytes)));
+			return mem;
+		}
+		/* No page to be had, try a chunk of its own */
+	}
+#endif
+
 	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes);
 	chunkid_t c = alloc_chunk(h, chunk_sz);
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	if ((c == 0U) && (h->classes != NULL) && z_heap_classes_trim(heap)) {
+		c = alloc_chunk(h, chunk_sz);
+	}
+#endif
+
 	if (c == 0U) {
 		return NULL;
 	}
@@ -335,6 +369,12 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	chunksz_t padded_sz = bytes_to_chunksz(h, bytes + align - gap);
 	chunkid_t c0 = alloc_chunk(h, padded_sz);
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	if ((c0 == 0) && (h->classes != NULL) && z_heap_classes_trim(heap)) {
+		c0 = alloc_chunk(h, padded_sz);
+	}
+#endif
+
 	if (c0 == 0) {
 		return NULL;
 	}
@@ -396,6 +436,26 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 		return NULL;
 	}
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	size_t class_sz = (h->classes != NULL) ? z_heap_class_size(heap, ptr) : 0U;
+
+	if (class_sz != 0U) {
+		/* Objects can't grow in place, only move */
+		if ((bytes <= class_sz) &&
+		    ((align == 0) || (((uintptr_t)ptr & (align - 1)) == 0))) {
+			return ptr;
+		}
+
+		void *ptr2 = sys_heap_aligned_alloc(heap, align, bytes);
+
+		if (ptr2 != NULL) {
+			memcpy(ptr2, ptr, MIN(class_sz, bytes));
+			sys_heap_free(heap, ptr);
+		}
+		return ptr2;
+	}
+#endif
+
 	chunkid_t c = mem_to_chunkid(h, ptr);
 	chunkid_t rc = right_chunk(h, c);
 	size_t align_gap = (uint8_t *)ptr - (uint8_t *)chunk_mem(h, c);
@@ -517,6 +577,10 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	h->max_allocated_bytes = 0;
 #endif
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	h->classes = NULL;
+#endif
+
 	int nb_buckets = bucket_idx(h, heap_sz) + 1;
 	chunksz_t chunk0_size = chunksz(sizeof(struct z_heap) +
 				     nb_buckets * sizeof(struct z_heap_bucket));
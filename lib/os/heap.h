@@ -73,6 +73,9 @@ struct z_heap {
 	size_t free_bytes;
 	size_t allocated_bytes;
 	size_t max_allocated_bytes;
+#endif
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	struct z_heap_classes *classes;
 #endif
 	struct z_heap_bucket buckets[0];
 };
@@ -265,4 +268,20 @@ static inline bool size_too_big(struct z_heap *h, size_t bytes)
 /* For debugging */
 void heap_print_info(struct z_heap *h, bool dump_chunks);
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+/* Size class front end, see heap-classes.c.  Only valid on heaps where
+ * it has been enabled (h->classes != NULL).
+ */
+void *z_heap_class_alloc(struct sys_heap *heap, size_t bytes);
+bool z_heap_class_free(struct sys_heap *heap, void *mem);
+size_t z_heap_class_size(struct sys_heap *heap, void *mem);
+bool z_heap_classes_trim(struct sys_heap *heap);
+
+static inline bool heap_classes_fit(struct z_heap *h, size_t bytes)
+{
+	return (h->classes != NULL) && (bytes != 0U) &&
+	       (bytes <= CONFIG_SYS_HEAP_SIZE_CLASS_MAX);
+}
+#endif
+
 #endif /* ZEPHYR_INCLUDE_LIB_OS_HEAP_H_ */
@@ -438,18 +438,34 @@ static bool equivalent_types(enum json_tokens type1, enum json_tokens type2)
 	return type1 == type2;
 }
 
-static int64_t obj_parse(struct json_obj *obj,
-			 const struct json_obj_descr *descr, size_t descr_len,
-			 void *val);
+/* Number of words of a bitmap of decoded fields */
+#define DECODED_WORDS(descr_len) DIV_ROUND_UP(descr_len, 32)
+
+static int obj_parse(struct json_obj *obj,
+		     const struct json_obj_descr *descr, size_t descr_len,
+		     void *val, uint32_t *decoded);
 static int arr_parse(struct json_obj *obj,
 		     const struct json_obj_descr *elem_descr,
 		     size_t max_elements, void *field, void *val);
 
 static int arr_data_parse(struct json_obj *obj, struct json_obj_token *val);
 
-static int64_t decode_value(struct json_obj *obj,
-			    const struct json_obj_descr *descr,
-			    struct json_token *value, void *field, void *val)
+static int sub_obj_parse(struct json_obj *obj,
+			 const struct json_obj_descr *descr, size_t descr_len,
+			 void *val)
+{
+	uint32_t decoded[DECODED_WORDS(CONFIG_JSON_LIBRARY_MAX_FIELDS)];
+
+	if (descr_len > CONFIG_JSON_LIBRARY_MAX_FIELDS) {
+		return -EINVAL;
+	}
+
+	return obj_parse(obj, descr, descr_len, val, decoded);
+}
+
+static int decode_value(struct json_obj *obj,
+			const struct json_obj_descr *descr,
+			struct json_token *value, void *field, void *val)
 {
 
 	if (!equivalent_types(value->type, descr->type)) {
@@ -458,9 +474,9 @@ static int64_t decode_value(struct json_obj *obj,
 
 	switch (descr->type) {
 	case JSON_TOK_OBJECT_START:
-		return obj_parse(obj, descr->object.sub_descr,
-				 descr->object.sub_descr_len,
-				 field);
+		return sub_obj_parse(obj, descr->object.sub_descr,
+				     descr->object.sub_descr_len,
+				     field);
 	case JSON_TOK_ARRAY_START:
 		return arr_parse(obj, descr->array.element_descr,
 				 descr->array.n_elements, field, val);
@@ -634,47 +650,78 @@ static int arr_data_parse(struct json_obj *obj, struct json_obj_token *val)
 	return -EINVAL;
 }
 
-static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *descr,
-			 size_t descr_len, void *val)
+/* Find the descriptor of a key, starting with the one at index hint */
+static int find_field(const struct json_obj_descr *descr, size_t descr_len,
+		      const struct json_obj_key_value *kv, size_t hint)
+{
+	/* Keys often differ by their end only, as in "field1" and "field2",
+	 * compare the last characters before calling memcmp().
+	 */
+	char last = kv->key_len > 0 ? kv->key[kv->key_len - 1] : '\0';
+	size_t i = hint;
+	size_t n;
+
+	for (n = 0; n < descr_len; n++, i++) {
+		if (i == descr_len) {
+			i = 0;
+		}
+
+		if (kv->key_len != descr[i].field_name_len) {
+			continue;
+		}
+
+		if (kv->key_len > 0 &&
+		    (last != descr[i].field_name[kv->key_len - 1] ||
+		     memcmp(kv->key, descr[i].field_name, kv->key_len - 1))) {
+			continue;
+		}
+
+		return i;
+	}
+
+	return -ENOENT;
+}
+
+static int obj_parse(struct json_obj *obj, const struct json_obj_descr *descr,
+		     size_t descr_len, void *val, uint32_t *decoded)
 {
 	struct json_obj_key_value kv;
-	int64_t decoded_fields = 0;
-	size_t i;
+	size_t hint = 0;
+	int decoded_fields = 0;
 	int ret;
+	int i;
+
+	memset(decoded, 0, DECODED_WORDS(descr_len) * sizeof(*decoded));
 
 	while (!obj_next(obj, &kv)) {
 		if (kv.value.type == JSON_TOK_OBJECT_END) {
 			return decoded_fields;
 		}
 
-		for (i = 0; i < descr_len; i++) {
-			void *decode_field = (char *)val + descr[i].offset;
-
-			/* Field has been decoded already, skip */
-			if (decoded_fields & ((int64_t)1 << i)) {
-				continue;
-			}
-
-			/* Check if it's the i-th field */
-			if (kv.key_len != descr[i].field_name_len) {
-				continue;
-			}
-
-			if (memcmp(kv.key, descr[i].field_name,
-				   descr[i].field_name_len)) {
-				continue;
-			}
+		/* Encoders usually write the fields in the order of the
+		 * descriptor, look for the field following the last one
+		 * first.
+		 */
+		i = find_field(descr, descr_len, &kv, hint);
+		if (i < 0) {
+			continue;
+		}
 
-			/* Store the decoded value */
-			ret = decode_value(obj, &descr[i], &kv.value,
-					   decode_field, val);
-			if (ret < 0) {
-				return ret;
-			}
+		/* Field has been decoded already, skip */
+		if (decoded[i / 32] & BIT(i % 32)) {
+			continue;
+		}
 
-			decoded_fields |= (int64_t)1<<i;
-			break;
+		/* Store the decoded value */
+		ret = decode_value(obj, &descr[i], &kv.value,
+				   (char *)val + descr[i].offset, val);
+		if (ret < 0) {
+			return ret;
 		}
+
+		decoded[i / 32] |= BIT(i % 32);
+		decoded_fields++;
+		hint = i + 1;
 	}
 
 	return -EINVAL;
@@ -684,17 +731,42 @@ int64_t json_obj_parse(char *payload, size_t len,
 		       const struct json_obj_descr *descr, size_t descr_len,
 		       void *val)
 {
+	uint32_t decoded[DECODED_WORDS(64)] = { 0 };
 	struct json_obj obj;
-	int64_t ret;
+	int ret;
 
-	__ASSERT_NO_MSG(descr_len < (sizeof(ret) * CHAR_BIT - 1));
+	__ASSERT_NO_MSG(descr_len < (sizeof(int64_t) * CHAR_BIT - 1));
+
+	if (descr_len > ARRAY_SIZE(decoded) * 32) {
+		return -EINVAL;
+	}
 
 	ret = obj_init(&obj, payload, len);
 	if (ret < 0) {
 		return ret;
 	}
 
-	return obj_parse(&obj, descr, descr_len, val);
+	ret = obj_parse(&obj, descr, descr_len, val, decoded);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return ((int64_t)decoded[1] << 32) | decoded[0];
+}
+
+int json_obj_parse_fields(char *payload, size_t len,
+			  const struct json_obj_descr *descr, size_t descr_len,
+			  void *val, uint32_t *decoded)
+{
+	struct json_obj obj;
+	int ret;
+
+	ret = obj_init(&obj, payload, len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return obj_parse(&obj, descr, descr_len, val, decoded);
 }
 
 int json_arr_parse(char *payload, size_t len,
@@ -723,7 +795,14 @@ int json_arr_separate_object_parse_init(struct json_obj *json, char *payload, si
 int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_descr *descr,
 			  size_t descr_len, void *val)
 {
+	uint32_t decoded = 0;
 	struct json_token tok;
+	int ret;
+
+	/* The decoded fields are reported as a non-negative int bitmap */
+	if (descr_len > (sizeof(int) * CHAR_BIT - 1)) {
+		return -EINVAL;
+	}
 
 	if (!lexer_next(&json->lex, &tok)) {
 		return -EINVAL;
@@ -741,7 +820,399 @@ int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_
 		return -EINVAL;
 	}
 
-	return obj_parse(json, descr, descr_len, val);
+	ret = obj_parse(json, descr, descr_len, val, &decoded);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return (int)decoded;
+}
+
+enum json_stream_state {
+	/* Expecting a value */
+	STREAM_VALUE,
+	/* Expecting the first element of an array, or its end */
+	STREAM_VALUE_OR_END,
+	/* Expecting a key */
+	STREAM_KEY,
+	/* Expecting the first key of an object, or its end */
+	STREAM_KEY_OR_END,
+	/* Expecting the colon after a key */
+	STREAM_COLON,
+	/* Expecting a comma or the end of the object or array */
+	STREAM_AFTER_VALUE,
+	/* Within a key, a string, a number, true, false or null */
+	STREAM_IN_KEY,
+	STREAM_IN_STRING,
+	STREAM_IN_NUMBER,
+	STREAM_IN_LITERAL,
+	/* After the top level value */
+	STREAM_DONE,
+};
+
+/* Value being accumulated, after the key if there is one */
+static char *stream_value_start(struct json_stream *stream)
+{
+	return stream->buf + (stream->has_key ? stream->key_len + 1 : 0);
+}
+
+static size_t stream_value_len(struct json_stream *stream)
+{
+	return stream->buf + stream->buf_len - stream_value_start(stream);
+}
+
+static int stream_append(struct json_stream *stream, char chr)
+{
+	/* Keep room for the terminator */
+	if (stream->buf_len + 1 >= stream->buf_size) {
+		return -ENOMEM;
+	}
+
+	stream->buf[stream->buf_len++] = chr;
+
+	return 0;
+}
+
+static int stream_emit(struct json_stream *stream, enum json_tokens type,
+		       bool has_value)
+{
+	struct json_stream_token token = {
+		.type = type,
+		.depth = stream->depth,
+	};
+	int ret;
+
+	if (stream->has_key) {
+		token.key = stream->buf;
+		token.key_len = stream->key_len;
+	}
+
+	if (has_value) {
+		token.value = stream_value_start(stream);
+		token.value_len = stream_value_len(stream);
+		stream->buf[stream->buf_len] = '\0';
+	}
+
+	stream->buf_len = 0;
+	stream->has_key = false;
+
+	ret = stream->cb(&token, stream->user_data);
+
+	return ret < 0 ? ret : 0;
+}
+
+static int stream_value(struct json_stream *stream, enum json_tokens type,
+			bool has_value)
+{
+	int ret;
+
+	ret = stream_emit(stream, type, has_value);
+	if (ret < 0) {
+		return ret;
+	}
+
+	stream->state = stream->depth == 0 ? STREAM_DONE : STREAM_AFTER_VALUE;
+
+	return 0;
+}
+
+static bool stream_in_array(struct json_stream *stream)
+{
+	return (stream->arrays & BIT(stream->depth - 1)) != 0;
+}
+
+static int stream_open(struct json_stream *stream, enum json_tokens type)
+{
+	bool array = type == JSON_TOK_ARRAY_START;
+	int ret;
+
+	if (stream->depth == JSON_STREAM_MAX_DEPTH) {
+		return -ENOSPC;
+	}
+
+	ret = stream_emit(stream, type, false);
+	if (ret < 0) {
+		return ret;
+	}
+
+	WRITE_BIT(stream->arrays, stream->depth, array);
+	stream->depth++;
+	stream->state = array ? STREAM_VALUE_OR_END : STREAM_KEY_OR_END;
+
+	return 0;
+}
+
+static int stream_close(struct json_stream *stream, enum json_tokens type)
+{
+	if (stream->depth == 0 ||
+	    stream_in_array(stream) != (type == JSON_TOK_ARRAY_END)) {
+		return -EINVAL;
+	}
+
+	stream->depth--;
+
+	return stream_value(stream, type, false);
+}
+
+static int stream_number_end(struct json_stream *stream)
+{
+	char *value = stream_value_start(stream);
+
+	if (value[0] == '-' && stream_value_len(stream) == 1) {
+		return -EINVAL;
+	}
+
+	return stream_value(stream, JSON_TOK_NUMBER, true);
+}
+
+static int stream_literal_end(struct json_stream *stream)
+{
+	static const struct {
+		const char *text;
+		enum json_tokens type;
+	} literals[] = {
+		{ "true", JSON_TOK_TRUE },
+		{ "false", JSON_TOK_FALSE },
+		{ "null", JSON_TOK_NULL },
+	};
+	char *value = stream_value_start(stream);
+	size_t len = stream_value_len(stream);
+
+	for (size_t i = 0; i < ARRAY_SIZE(literals); i++) {
+		if (len == strlen(literals[i].text) &&
+		    !memcmp(value, literals[i].text, len)) {
+			return stream_value(stream, literals[i].type, false);
+		}
+	}
+
+	return -EINVAL;
+}
+
+/* Escapes are validated as by lexer_string(), but kept as they are */
+static int stream_string_char(struct json_stream *stream, char chr)
+{
+	int ret;
+
+	if (stream->escape == 1U) {
+		switch (chr) {
+		case '"':
+		case '\\':
+		case '/':
+		case 'b':
+		case 'f':
+		case 'n':
+		case 'r':
+		case 't':
+			stream->escape = 0U;
+			break;
+		case 'u':
+			/* Four hexadecimal digits follow */
+			stream->escape = 5U;
+			break;
+		default:
+			return -EINVAL;
+		}
+
+		return stream_append(stream, chr);
+	}
+
+	if (stream->escape > 1U) {
+		if (isxdigit((unsigned char)chr) == 0) {
+			return -EINVAL;
+		}
+
+		stream->escape = stream->escape == 2U ? 0U : stream->escape - 1U;
+
+		return stream_append(stream, chr);
+	}
+
+	if (chr == '\\') {
+		stream->escape = 1U;
+
+		return stream_append(stream, chr);
+	}
+
+	if (chr != '"') {
+		return stream_append(stream, chr);
+	}
+
+	if (stream->state == STREAM_IN_STRING) {
+		return stream_value(stream, JSON_TOK_STRING, true);
+	}
+
+	/* End of a key, terminate it and keep it for the value */
+	ret = stream_append(stream, '\0');
+	if (ret < 0) {
+		return ret;
+	}
+
+	stream->key_len = stream->buf_len - 1;
+	stream->has_key = true;
+	stream->state = STREAM_COLON;
+
+	return 0;
+}
+
+static int stream_value_char(struct json_stream *stream, char chr)
+{
+	switch (chr) {
+	case '{':
+		return stream_open(stream, JSON_TOK_OBJECT_START);
+	case '[':
+		return stream_open(stream, JSON_TOK_ARRAY_START);
+	case '"':
+		stream->state = STREAM_IN_STRING;
+		return 0;
+	case 't':
+	case 'f':
+	case 'n':
+		stream->state = STREAM_IN_LITERAL;
+		return stream_append(stream, chr);
+	default:
+		if (chr == '-' || isdigit((unsigned char)chr) != 0) {
+			stream->state = STREAM_IN_NUMBER;
+			return stream_append(stream, chr);
+		}
+
+		return -EINVAL;
+	}
+}
+
+static int stream_char(struct json_stream *stream, char chr)
+{
+	int ret;
+
+	switch (stream->state) {
+	case STREAM_IN_KEY:
+	case STREAM_IN_STRING:
+		return stream_string_char(stream, chr);
+	case STREAM_IN_NUMBER:
+		if (isdigit((unsigned char)chr) != 0 || chr == '.' ||
+		    chr == 'e' || chr == 'E' || chr == '+' || chr == '-') {
+			return stream_append(stream, chr);
+		}
+
+		/* The character after the number is handled below */
+		ret = stream_number_end(stream);
+		if (ret < 0) {
+			return ret;
+		}
+		break;
+	case STREAM_IN_LITERAL:
+		if (isalpha((unsigned char)chr) != 0) {
+			return stream_append(stream, chr);
+		}
+
+		ret = stream_literal_end(stream);
+		if (ret < 0) {
+			return ret;
+		}
+		break;
+	default:
+		break;
+	}
+
+	if (isspace((unsigned char)chr) != 0) {
+		return 0;
+	}
+
+	switch (stream->state) {
+	case STREAM_VALUE_OR_END:
+		if (chr == ']') {
+			return stream_close(stream, JSON_TOK_ARRAY_END);
+		}
+
+		__fallthrough;
+	case STREAM_VALUE:
+		return stream_value_char(stream, chr);
+	case STREAM_KEY_OR_END:
+		if (chr == '}') {
+			return stream_close(stream, JSON_TOK_OBJECT_END);
+		}
+
+		__fallthrough;
+	case STREAM_KEY:
+		if (chr != '"') {
+			return -EINVAL;
+		}
+
+		stream->state = STREAM_IN_KEY;
+		return 0;
+	case STREAM_COLON:
+		if (chr != ':') {
+			return -EINVAL;
+		}
+
+		stream->state = STREAM_VALUE;
+		return 0;
+	case STREAM_AFTER_VALUE:
+		switch (chr) {
+		case ',':
+			stream->state = stream_in_array(stream) ? STREAM_VALUE :
+								  STREAM_KEY;
+			return 0;
+		case ']':
+			return stream_close(stream, JSON_TOK_ARRAY_END);
+		case '}':
+			return stream_close(stream, JSON_TOK_OBJECT_END);
+		default:
+			return -EINVAL;
+		}
+	default:
+		return -EINVAL;
+	}
+}
+
+void json_stream_init(struct json_stream *stream, char *buf, size_t buf_size,
+		      json_stream_cb_t cb, void *user_data)
+{
+	__ASSERT_NO_MSG(buf_size > 0);
+
+	memset(stream, 0, sizeof(*stream));
+	stream->cb = cb;
+	stream->user_data = user_data;
+	stream->buf = buf;
+	stream->buf_size = buf_size;
+	stream->state = STREAM_VALUE;
+}
+
+int json_stream_feed(struct json_stream *stream, const char *data, size_t len)
+{
+	int ret;
+
+	if (stream->error < 0) {
+		return stream->error;
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		ret = stream_char(stream, data[i]);
+		if (ret < 0) {
+			stream->error = ret;
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int json_stream_finish(struct json_stream *stream)
+{
+	int ret;
+
+	/* Nothing but the end of the input ends a top level number */
+	if (stream->depth == 0 && (stream->state == STREAM_IN_NUMBER ||
+				   stream->state == STREAM_IN_LITERAL)) {
+		ret = json_stream_feed(stream, " ", 1);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (stream->error < 0) {
+		return stream->error;
+	}
+
+	return stream->state == STREAM_DONE ? 0 : -EINVAL;
 }
 
 static char escape_as(char chr)
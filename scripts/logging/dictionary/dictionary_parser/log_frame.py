@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2023 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Framed Records for Dictionary-based Logging
+
+This splits framed log data, as written by the file system and
+network backends, into log records. Corrupted data is skipped and
+lost records are reported using the sequence numbers.
+"""
+
+import struct
+
+
+# Need to keep sync with struct log_dict_output_frame_hdr_t in
+# include/zephyr/logging/log_output_dict.h.
+#
+# struct log_dict_output_frame_hdr_t {
+#     uint16_t magic;
+#     uint16_t len;
+#     uint16_t seq;
+# } __packed;
+FMT_FRAME_HDR = "HHH"
+
+# LOG_DICT_OUTPUT_FRAME_MAGIC
+FRAME_MAGIC = 0x5A4C
+
+SEQ_MASK = 0xFFFF
+
+# Longest record: message header, and the largest package and data
+# lengths of struct log_dict_output_normal_msg_hdr_t.
+MAX_RECORD_LEN = 32 + (2 ** 10 - 1) + (2 ** 12 - 1)
+
+
+class FrameDecoder():
+    """Extract log records from framed log data, fed in chunks"""
+    def __init__(self, database):
+        if database.is_tgt_little_endian():
+            endian = "<"
+        else:
+            endian = ">"
+
+        self.fmt_frame_hdr = endian + FMT_FRAME_HDR
+        self.frame_hdr_len = struct.calcsize(self.fmt_frame_hdr)
+        self.magic = struct.pack(endian + "H", FRAME_MAGIC)
+
+        self.data = b''
+        self.next_seq = None
+        self.num_skipped = 0
+
+
+    def __skip(self, num_bytes):
+        self.num_skipped += num_bytes
+        self.data = self.data[num_bytes:]
+
+
+    def __report_skipped(self):
+        if self.num_skipped > 0:
+            print(f"--- {self.num_skipped} bytes of corrupted data skipped ---")
+            self.num_skipped = 0
+
+
+    def __check_seq(self, seq):
+        if self.next_seq is not None and seq != self.next_seq:
+            if seq == 0:
+                print("--- log restarted ---")
+            else:
+                num_lost = (seq - self.next_seq) & SEQ_MASK
+                print(f"--- {num_lost} records lost ---")
+
+        self.next_seq = (seq + 1) & SEQ_MASK
+
+
+    def __is_frame_end(self, offset):
+        # A record is followed by the next one, or by the end of
+        # the data received so far.
+        following = self.data[offset:offset + len(self.magic)]
+
+        return self.magic.startswith(following)
+
+
+    def feed(self, data, final=False):
+        """Add log data and yield the records completed by it.
+
+        If final is set, no more data follows, so a record still
+        incomplete cannot be one and the search goes on after its
+        header."""
+        self.data += data
+
+        while len(self.data) > 0:
+            idx = self.data.find(self.magic)
+            if idx < 0:
+                # Keep a byte which may be the start of the next magic
+                if not final and self.data[-1:] == self.magic[:1]:
+                    self.__skip(len(self.data) - 1)
+                else:
+                    self.__skip(len(self.data))
+                break
+
+            self.__skip(idx)
+
+            if len(self.data) < self.frame_hdr_len:
+                if final:
+                    self.__skip(len(self.data))
+                break
+
+            _, rec_len, seq = struct.unpack_from(self.fmt_frame_hdr, self.data)
+            rec_end = self.frame_hdr_len + rec_len
+
+            if len(self.data) < rec_end and not final and rec_len <= MAX_RECORD_LEN:
+                break
+
+            if rec_len == 0 or len(self.data) < rec_end or \
+               not self.__is_frame_end(rec_end):
+                # Not a valid header, look for the next one
+                self.__skip(1)
+                continue
+
+            self.__report_skipped()
+            self.__check_seq(seq)
+            record = self.data[self.frame_hdr_len:rec_end]
+            self.data = self.data[rec_end:]
+
+            yield record
+
+        if final:
+            self.__report_skipped()
+
+
+    def finish(self):
+        """Yield the records left at the end of the log data"""
+        yield from self.feed(b'', final=True)
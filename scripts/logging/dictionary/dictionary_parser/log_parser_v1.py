@@ -452,7 +452,7 @@ class LogParserV1(LogParser):
             offset += struct.calcsize(self.fmt_msg_type)
 
             if msg_type == MSG_TYPE_DROPPED:
-                num_dropped = struct.unpack_from(self.fmt_dropped_cnt, logdata, offset)
+                num_dropped = struct.unpack_from(self.fmt_dropped_cnt, logdata, offset)[0]
                 offset += struct.calcsize(self.fmt_dropped_cnt)
 
                 print(f"--- {num_dropped} messages dropped ---")
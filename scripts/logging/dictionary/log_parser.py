@@ -9,15 +9,21 @@ Log Parser for Dictionary-based Logging
 
 This uses the JSON database file to decode the input binary
 log data and print the log messages.
+
+Log data can be read from files, or received as UDP datagrams from
+the network backend.
 """
 
 import argparse
 import binascii
 import logging
+import socket
+import struct
 import sys
 
 import dictionary_parser
 from dictionary_parser.log_database import LogDatabase
+from dictionary_parser.log_frame import FrameDecoder
 
 
 LOGGER_FORMAT = "%(message)s"
@@ -31,18 +37,30 @@ def parse_args():
     argparser = argparse.ArgumentParser(allow_abbrev=False)
 
     argparser.add_argument("dbfile", help="Dictionary Logging Database file")
-    argparser.add_argument("logfile", help="Log Data file")
+    argparser.add_argument("logfile", nargs="*",
+                           help="Log Data file(s), decoded in the given order")
     argparser.add_argument("--hex", action="store_true",
                            help="Log Data file is in hexadecimal strings")
     argparser.add_argument("--rawhex", action="store_true",
                            help="Log file only contains hexadecimal log data")
+    argparser.add_argument("--framed", action="store_true",
+                           help="Log data is made of framed records, as written "
+                                "by the file system and network backends")
+    argparser.add_argument("--udp", metavar="[ADDR:]PORT",
+                           help="Receive framed log data as UDP datagrams on "
+                                "this port instead of reading files")
     argparser.add_argument("--debug", action="store_true",
                            help="Print extra debugging information")
 
-    return argparser.parse_args()
+    args = argparser.parse_args()
+
+    if (args.udp is None) == (len(args.logfile) == 0):
+        argparser.error("either log data file(s) or --udp must be given")
+
+    return args
 
 
-def read_log_file(args):
+def read_log_file(args, logfile_name):
     """
     Read the log from file
     """
@@ -52,11 +70,11 @@ def read_log_file(args):
     if args.hex:
         if args.rawhex:
             # Simply log file with only hexadecimal data
-            logdata = dictionary_parser.utils.convert_hex_file_to_bin(args.logfile)
+            logdata = dictionary_parser.utils.convert_hex_file_to_bin(logfile_name)
         else:
             hexdata = ''
 
-            with open(args.logfile, "r", encoding="iso-8859-1") as hexfile:
+            with open(logfile_name, "r", encoding="iso-8859-1") as hexfile:
                 for line in hexfile.readlines():
                     hexdata += line.strip()
 
@@ -89,9 +107,9 @@ def read_log_file(args):
 
             logdata = binascii.unhexlify(hexdata[:idx])
     else:
-        logfile = open(args.logfile, "rb")
+        logfile = open(logfile_name, "rb")
         if not logfile:
-            logger.error("ERROR: Cannot open binary log data file: %s, exiting...", args.logfile)
+            logger.error("ERROR: Cannot open binary log data file: %s, exiting...", logfile_name)
             sys.exit(1)
 
         logdata = logfile.read()
@@ -101,6 +119,44 @@ def read_log_file(args):
     return logdata
 
 
+def parse_framed_log_data(log_parser, records, debug):
+    """Parse the records extracted from framed log data"""
+    ret = True
+
+    for record in records:
+        try:
+            parsed = log_parser.parse_log_data(record, debug=debug)
+        except (struct.error, TypeError, ValueError):
+            parsed = False
+
+        if not parsed:
+            # Only this record is lost, go on with the next one
+            logger.error("------ Error parsing record")
+            ret = False
+
+    return ret
+
+
+def receive_udp(args, log_parser, decoder):
+    """Parse framed log data received as UDP datagrams until interrupted"""
+    addr, _, port = args.udp.rpartition(":")
+    addr = addr.strip("[]")
+
+    family = socket.AF_INET6 if ":" in addr else socket.AF_INET
+    with socket.socket(family, socket.SOCK_DGRAM) as sock:
+        sock.bind((addr, int(port)))
+        logger.debug("# Listening on UDP port %s", port)
+
+        try:
+            while True:
+                logdata, _ = sock.recvfrom(65535)
+                if not parse_framed_log_data(log_parser, decoder.feed(logdata),
+                                             args.debug):
+                    logger.error("ERROR: there were error(s) parsing log data")
+        except KeyboardInterrupt:
+            pass
+
+
 def main():
     """Main function of log parser"""
     args = parse_args()
@@ -118,11 +174,6 @@ def main():
         logger.error("ERROR: Cannot open database file: %s, exiting...", args.dbfile)
         sys.exit(1)
 
-    logdata = read_log_file(args)
-    if logdata is None:
-        logger.error("ERROR: cannot read log from file: %s, exiting...", args.logfile)
-        sys.exit(1)
-
     log_parser = dictionary_parser.get_parser(database)
     if log_parser is not None:
         logger.debug("# Build ID: %s", database.get_build_id())
@@ -132,7 +183,33 @@ def main():
         else:
             logger.debug("# Endianness: Big")
 
-        ret = log_parser.parse_log_data(logdata, debug=args.debug)
+        if args.udp is not None:
+            receive_udp(args, log_parser, FrameDecoder(database))
+            return
+
+        decoder = FrameDecoder(database) if args.framed else None
+        ret = True
+        unframed_logdata = b''
+
+        for logfile_name in args.logfile:
+            logdata = read_log_file(args, logfile_name)
+            if logdata is None:
+                logger.error("ERROR: cannot read log from file: %s, exiting...",
+                             logfile_name)
+                sys.exit(1)
+
+            # Messages may continue from one file to the next
+            if decoder is not None:
+                ret &= parse_framed_log_data(log_parser, decoder.feed(logdata),
+                                             args.debug)
+            else:
+                unframed_logdata += logdata
+
+        if decoder is not None:
+            ret &= parse_framed_log_data(log_parser, decoder.finish(), args.debug)
+        else:
+            ret = log_parser.parse_log_data(unframed_logdata, debug=args.debug)
+
         if not ret:
             logger.error("ERROR: there were error(s) parsing log data")
             sys.exit(1)
@@ -6,6 +6,7 @@
  */
 
 #include <zephyr/drivers/flash.h>
+#include <zephyr/init.h>
 #include <string.h>
 #include <errno.h>
 #include <inttypes.h>
@@ -287,37 +288,59 @@ static int nvs_flash_block_move(struct nvs_fs *fs, uint32_t addr, size_t len)
 	return 0;
 }
 
-/* erase a sector and verify erase was OK.
- * return 0 if OK, errorcode on error.
+/* erase a sector in flash, this leaves the file system state alone and
+ * may run without holding nvs_lock.
  */
-static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
+static int nvs_flash_sector_erase(struct nvs_fs *fs, uint32_t addr)
 {
-	int rc;
 	off_t offset;
 
-	addr &= ADDR_SECT_MASK;
-
 	offset = fs->offset;
 	offset += fs->sector_size * (addr >> ADDR_SECT_SHIFT);
 
 	LOG_DBG("Erasing flash at %lx, len %d", (long int) offset,
 		fs->sector_size);
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-	nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
-#endif
-	rc = flash_erase(fs->flash_device, offset, fs->sector_size);
+	return flash_erase(fs->flash_device, offset, fs->sector_size);
+}
 
-	if (rc) {
-		return rc;
+/* count the erase of a sector and verify erase was OK.
+ * return 0 if OK, errorcode on error.
+ */
+static int nvs_flash_sector_erased(struct nvs_fs *fs, uint32_t addr)
+{
+#if CONFIG_NVS_STATS
+	if ((addr >> ADDR_SECT_SHIFT) < CONFIG_NVS_STATS_SECTOR_COUNT) {
+		fs->stats.erase_count[addr >> ADDR_SECT_SHIFT]++;
 	}
+#endif
 
 	if (nvs_flash_cmp_const(fs, addr, fs->flash_parameters->erase_value,
 			fs->sector_size)) {
-		rc = -ENXIO;
+		return -ENXIO;
 	}
 
-	return rc;
+	return 0;
+}
+
+/* erase a sector and verify erase was OK.
+ * return 0 if OK, errorcode on error.
+ */
+static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
+{
+	int rc;
+
+	addr &= ADDR_SECT_MASK;
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
+#endif
+	rc = nvs_flash_sector_erase(fs, addr);
+	if (rc) {
+		return rc;
+	}
+
+	return nvs_flash_sector_erased(fs, addr);
 }
 
 /* crc update on allocation entry */
@@ -508,6 +531,17 @@ static int nvs_prev_ate(struct nvs_fs *fs, uint32_t *addr, struct nvs_ate *ate)
 		return 0;
 	}
 
+#if CONFIG_NVS_GC_BACKGROUND
+	/* the gc'ed sector waiting for its erase only holds older copies of
+	 * what is in the other sectors, and may be erased under the reader:
+	 * it ends the filesystem as if it was already erased.
+	 */
+	if (((*addr) & ADDR_SECT_MASK) == fs->gc_erase_addr) {
+		*addr = fs->ate_wra;
+		return 0;
+	}
+#endif
+
 	/* Update the address if the close ate is valid.
 	 */
 	if (nvs_close_ate_valid(fs, &close_ate)) {
@@ -578,6 +612,105 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 	return nvs_flash_ate_wrt(fs, &gc_done_ate);
 }
 
+/* check if the ate at gc_addr in the sector being garbage collected still
+ * holds the latest data for its id: returns 1 if the data must be copied,
+ * 0 if it has been overwritten or deleted since, errcode on error.
+ */
+static int nvs_gc_ate_live(struct nvs_fs *fs, uint32_t gc_addr,
+			   const struct nvs_ate *gc_ate)
+{
+	int rc;
+	struct nvs_ate wlk_ate;
+	uint32_t wlk_addr, wlk_prev_addr;
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate->id)];
+
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		wlk_addr = fs->ate_wra;
+	}
+#else
+	wlk_addr = fs->ate_wra;
+#endif
+	do {
+		wlk_prev_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+		if (rc) {
+			return rc;
+		}
+		/* if ate with same id is reached we might need to copy.
+		 * only consider valid wlk_ate's. Something wrong might
+		 * have been written that has the same ate but is
+		 * invalid, don't consider these as a match.
+		 */
+		if ((wlk_ate.id == gc_ate->id) &&
+		    (nvs_ate_valid(fs, &wlk_ate))) {
+			break;
+		}
+	} while (wlk_addr != fs->ate_wra);
+
+	/* if walk has reached the same address as gc_addr copy is
+	 * needed unless it is a deleted item.
+	 */
+	return (wlk_prev_addr == gc_addr) && gc_ate->len;
+}
+
+/* copy the data of the ate at gc_addr to the current write location */
+static int nvs_gc_ate_move(struct nvs_fs *fs, uint32_t gc_addr,
+			   struct nvs_ate *gc_ate)
+{
+	int rc;
+	uint32_t data_addr;
+
+	LOG_DBG("Moving %d, len %d", gc_ate->id, gc_ate->len);
+
+	data_addr = (gc_addr & ADDR_SECT_MASK);
+	data_addr += gc_ate->offset;
+
+	gc_ate->offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	nvs_ate_crc8_update(gc_ate);
+
+	rc = nvs_flash_block_move(fs, data_addr, gc_ate->len);
+	if (rc) {
+		return rc;
+	}
+
+	return nvs_flash_ate_wrt(fs, gc_ate);
+}
+
+/* find the last ate of the closed sector at sec_addr, where garbage
+ * collection starts. Returns 1 if the sector is not closed.
+ */
+static int nvs_gc_start_addr(struct nvs_fs *fs, uint32_t sec_addr,
+			     uint32_t *gc_addr)
+{
+	int rc;
+	struct nvs_ate close_ate;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+	*gc_addr = sec_addr + fs->sector_size - ate_size;
+
+	rc = nvs_flash_ate_rd(fs, *gc_addr, &close_ate);
+	if (rc < 0) {
+		/* flash error */
+		return rc;
+	}
+
+	rc = nvs_ate_cmp_const(&close_ate, fs->flash_parameters->erase_value);
+	if (!rc) {
+		return 1;
+	}
+
+	if (nvs_close_ate_valid(fs, &close_ate)) {
+		*gc_addr &= ADDR_SECT_MASK;
+		*gc_addr += close_ate.offset;
+		return 0;
+	}
+
+	return nvs_recover_last_ate(fs, gc_addr);
+}
+
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
  * sector.
@@ -585,41 +718,38 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 static int nvs_gc(struct nvs_fs *fs)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate gc_ate;
+	uint32_t sec_addr, gc_addr, gc_prev_addr, stop_addr;
 	size_t ate_size;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
 	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
 	nvs_sector_advance(fs, &sec_addr);
-	gc_addr = sec_addr + fs->sector_size - ate_size;
+	stop_addr = sec_addr + fs->sector_size - 2 * ate_size;
+
+#if CONFIG_NVS_STATS
+	fs->stats.gc_count++;
+#endif
+#if CONFIG_NVS_GC_BACKGROUND
+	if ((fs->gc_copy_state == NVS_GC_COPY_DONE) &&
+	    (fs->gc_copy_sector == sec_addr)) {
+		/* all the data has already been copied ahead */
+		fs->gc_copy_state = NVS_GC_COPY_IDLE;
+		goto gc_done;
+	}
+	fs->gc_copy_state = NVS_GC_COPY_IDLE;
+#endif
 
 	/* if the sector is not closed don't do gc */
-	rc = nvs_flash_ate_rd(fs, gc_addr, &close_ate);
+	rc = nvs_gc_start_addr(fs, sec_addr, &gc_addr);
 	if (rc < 0) {
-		/* flash error */
 		return rc;
 	}
-
-	rc = nvs_ate_cmp_const(&close_ate, fs->flash_parameters->erase_value);
-	if (!rc) {
+	if (rc) {
 		goto gc_done;
 	}
 
-	stop_addr = gc_addr - ate_size;
-
-	if (nvs_close_ate_valid(fs, &close_ate)) {
-		gc_addr &= ADDR_SECT_MASK;
-		gc_addr += close_ate.offset;
-	} else {
-		rc = nvs_recover_last_ate(fs, &gc_addr);
-		if (rc) {
-			return rc;
-		}
-	}
-
 	do {
 		gc_prev_addr = gc_addr;
 		rc = nvs_prev_ate(fs, &gc_addr, &gc_ate);
@@ -631,51 +761,14 @@ static int nvs_gc(struct nvs_fs *fs)
 			continue;
 		}
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-		wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate.id)];
-
-		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
-			wlk_addr = fs->ate_wra;
+		rc = nvs_gc_ate_live(fs, gc_prev_addr, &gc_ate);
+		if (rc < 0) {
+			return rc;
 		}
-#else
-		wlk_addr = fs->ate_wra;
-#endif
-		do {
-			wlk_prev_addr = wlk_addr;
-			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-			if (rc) {
-				return rc;
-			}
-			/* if ate with same id is reached we might need to copy.
-			 * only consider valid wlk_ate's. Something wrong might
-			 * have been written that has the same ate but is
-			 * invalid, don't consider these as a match.
-			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (nvs_ate_valid(fs, &wlk_ate))) {
-				break;
-			}
-		} while (wlk_addr != fs->ate_wra);
 
-		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
-		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
+		if (rc) {
 			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
-
-			data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-			data_addr += gc_ate.offset;
-
-			gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
-			nvs_ate_crc8_update(&gc_ate);
-
-			rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
-			if (rc) {
-				return rc;
-			}
-
-			rc = nvs_flash_ate_wrt(fs, &gc_ate);
+			rc = nvs_gc_ate_move(fs, gc_prev_addr, &gc_ate);
 			if (rc) {
 				return rc;
 			}
@@ -697,6 +790,17 @@ gc_done:
 		}
 	}
 
+#if CONFIG_NVS_GC_BACKGROUND
+	/* Once mounted, leave the erase of the gc'ed sector to the work
+	 * queue. Until then its data is only older copies of what is in the
+	 * other sectors, and a restart finds the gc done ate and erases it.
+	 */
+	if (fs->ready) {
+		fs->gc_erase_addr = sec_addr;
+		return 0;
+	}
+#endif
+
 	/* Erase the gc'ed sector */
 	rc = nvs_flash_erase_sector(fs, sec_addr);
 	if (rc) {
@@ -705,6 +809,209 @@ gc_done:
 	return 0;
 }
 
+#if CONFIG_NVS_GC_BACKGROUND
+/* The background work of all the file systems is done by one work queue, so
+ * that a slow erase does not hold up the system work queue.
+ */
+static K_KERNEL_STACK_DEFINE(nvs_gc_work_q_stack, CONFIG_NVS_GC_BACKGROUND_STACK_SIZE);
+static struct k_work_q nvs_gc_work_q;
+
+static int nvs_gc_work_q_init(void)
+{
+	const struct k_work_queue_config cfg = {.name = "nvs_gc"};
+
+	k_work_queue_start(&nvs_gc_work_q, nvs_gc_work_q_stack,
+			   K_KERNEL_STACK_SIZEOF(nvs_gc_work_q_stack),
+			   CONFIG_NVS_GC_BACKGROUND_PRIO, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(nvs_gc_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+/* erase the sector left by the last garbage collection, if any */
+static int nvs_gc_erase_pending(struct nvs_fs *fs)
+{
+	int rc;
+
+	/* let the work queue finish the erase it started */
+	while (fs->gc_erasing) {
+		(void)k_condvar_wait(&fs->gc_erase_done, &fs->nvs_lock, K_FOREVER);
+	}
+
+	if (fs->gc_erase_addr == NVS_GC_NO_SECTOR) {
+		return 0;
+	}
+
+	rc = nvs_flash_erase_sector(fs, fs->gc_erase_addr);
+	if (rc) {
+		return rc;
+	}
+
+	fs->gc_erase_addr = NVS_GC_NO_SECTOR;
+	return 0;
+}
+
+/* copy ahead: the sector gc'ed when the write sector fills is the one after
+ * the empty sector that follows it. Once the write sector is half full, copy
+ * the live data of that sector to the write sector a few ate's at a time,
+ * so that nvs_gc() finds nothing left to copy.
+ */
+static bool nvs_gc_copy_wanted(struct nvs_fs *fs)
+{
+	if ((fs->sector_count < 3) ||
+	    (fs->gc_copy_state == NVS_GC_COPY_DONE) ||
+	    (fs->gc_copy_state == NVS_GC_COPY_STOPPED)) {
+		return false;
+	}
+
+	return (fs->ate_wra - fs->data_wra) < (fs->sector_size / 2);
+}
+
+static int nvs_gc_copy_slice(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_ate gc_ate;
+	uint32_t gc_prev_addr, stop_addr;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	if (fs->gc_copy_state == NVS_GC_COPY_IDLE) {
+		fs->gc_copy_sector = fs->ate_wra & ADDR_SECT_MASK;
+		nvs_sector_advance(fs, &fs->gc_copy_sector);
+		nvs_sector_advance(fs, &fs->gc_copy_sector);
+
+		rc = nvs_gc_start_addr(fs, fs->gc_copy_sector, &fs->gc_copy_addr);
+		if (rc < 0) {
+			return rc;
+		}
+
+		fs->gc_copy_state = rc ? NVS_GC_COPY_DONE : NVS_GC_COPY_ACTIVE;
+		if (rc) {
+			return 0;
+		}
+	}
+
+	stop_addr = fs->gc_copy_sector + fs->sector_size - 2 * ate_size;
+
+	for (int i = 0; i < CONFIG_NVS_GC_BACKGROUND_SLICE; i++) {
+		gc_prev_addr = fs->gc_copy_addr;
+		rc = nvs_prev_ate(fs, &fs->gc_copy_addr, &gc_ate);
+		if (rc) {
+			return rc;
+		}
+
+		if (nvs_ate_valid(fs, &gc_ate)) {
+			rc = nvs_gc_ate_live(fs, gc_prev_addr, &gc_ate);
+			if (rc < 0) {
+				return rc;
+			}
+		} else {
+			rc = 0;
+		}
+
+		if (rc) {
+			/* leave the same room as nvs_write() does, if it is
+			 * not there the rest is left to nvs_gc()
+			 */
+			if (fs->ate_wra < (fs->data_wra + nvs_al_size(fs, gc_ate.len) +
+					   ate_size)) {
+				fs->gc_copy_state = NVS_GC_COPY_STOPPED;
+				return 0;
+			}
+
+			rc = nvs_gc_ate_move(fs, gc_prev_addr, &gc_ate);
+			if (rc) {
+				return rc;
+			}
+		}
+
+		if (gc_prev_addr == stop_addr) {
+			fs->gc_copy_state = NVS_GC_COPY_DONE;
+			break;
+		}
+	}
+
+	return 0;
+}
+
+static void nvs_gc_work_handler(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+	bool resubmit = false;
+	uint32_t start, addr;
+	int rc;
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	if (!fs->ready) {
+		goto end;
+	}
+
+	start = k_cycle_get_32();
+
+	if (fs->gc_erase_addr != NVS_GC_NO_SECTOR) {
+		/* Erase without the lock. Readers do not go into the sector
+		 * while gc_erase_addr is set, and a write that needs it waits
+		 * in nvs_gc_erase_pending().
+		 */
+		addr = fs->gc_erase_addr;
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+		nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
+#endif
+		fs->gc_erasing = true;
+		k_mutex_unlock(&fs->nvs_lock);
+
+		rc = nvs_flash_sector_erase(fs, addr);
+
+		k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+		fs->gc_erasing = false;
+		k_condvar_broadcast(&fs->gc_erase_done);
+
+		if (!rc) {
+			rc = nvs_flash_sector_erased(fs, addr);
+		}
+		if (rc) {
+			/* nvs_write() retries before it needs the sector */
+			LOG_ERR("Background erase failed: %d", rc);
+			goto end;
+		}
+
+		fs->gc_erase_addr = NVS_GC_NO_SECTOR;
+	} else if (nvs_gc_copy_wanted(fs)) {
+		rc = nvs_gc_copy_slice(fs);
+		if (rc) {
+			LOG_ERR("Background copy failed: %d", rc);
+			fs->gc_copy_state = NVS_GC_COPY_STOPPED;
+		}
+	}
+
+#if CONFIG_NVS_STATS
+	fs->stats.bg_time_total_us += k_cyc_to_us_floor32(k_cycle_get_32() - start);
+#else
+	ARG_UNUSED(start);
+#endif
+
+	resubmit = nvs_gc_copy_wanted(fs);
+
+end:
+	k_mutex_unlock(&fs->nvs_lock);
+
+	if (resubmit) {
+		k_work_submit_to_queue(&nvs_gc_work_q, work);
+	}
+}
+
+/* hand over to the work queue whatever garbage collection work is left */
+static void nvs_gc_kick(struct nvs_fs *fs)
+{
+	if ((fs->gc_erase_addr != NVS_GC_NO_SECTOR) || nvs_gc_copy_wanted(fs)) {
+		k_work_submit_to_queue(&nvs_gc_work_q, &fs->gc_work);
+	}
+}
+#endif /* CONFIG_NVS_GC_BACKGROUND */
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -936,6 +1243,14 @@ int nvs_clear(struct nvs_fs *fs)
 		return -EACCES;
 	}
 
+#if CONFIG_NVS_GC_BACKGROUND
+	struct k_work_sync sync;
+
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+	fs->gc_erase_addr = NVS_GC_NO_SECTOR;
+	fs->gc_copy_state = NVS_GC_COPY_IDLE;
+#endif
+
 	for (uint16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
@@ -957,6 +1272,27 @@ int nvs_mount(struct nvs_fs *fs)
 	struct flash_pages_info info;
 	size_t write_block_size;
 
+#if CONFIG_NVS_GC_BACKGROUND
+	if (fs->ready) {
+		struct k_work_sync sync;
+
+		/* remount: stop the background work of the previous mount,
+		 * nvs_startup() erases a sector it left behind.
+		 */
+		(void)k_work_cancel_sync(&fs->gc_work, &sync);
+		fs->ready = false;
+	}
+
+	k_work_init(&fs->gc_work, nvs_gc_work_handler);
+	k_condvar_init(&fs->gc_erase_done);
+	fs->gc_erase_addr = NVS_GC_NO_SECTOR;
+	fs->gc_erasing = false;
+	fs->gc_copy_state = NVS_GC_COPY_IDLE;
+#endif
+#if CONFIG_NVS_STATS
+	memset(&fs->stats, 0, sizeof(fs->stats));
+#endif
+
 	k_mutex_init(&fs->nvs_lock);
 
 	fs->flash_parameters = flash_get_parameters(fs->flash_device);
@@ -1017,6 +1353,9 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	uint32_t wlk_addr, rd_addr;
 	uint16_t required_space = 0U; /* no space, appropriate for delete ate */
 	bool prev_found = false;
+#if CONFIG_NVS_STATS
+	uint32_t gc_start, gc_time;
+#endif
 
 	if (!fs->ready) {
 		LOG_ERR("NVS not initialized");
@@ -1122,6 +1461,17 @@ no_cached_entry:
 		}
 
 
+#if CONFIG_NVS_STATS
+		gc_start = k_cycle_get_32();
+#endif
+#if CONFIG_NVS_GC_BACKGROUND
+		/* the sector after the write sector must be empty */
+		rc = nvs_gc_erase_pending(fs);
+		if (rc) {
+			goto end;
+		}
+#endif
+
 		rc = nvs_sector_close(fs);
 		if (rc) {
 			goto end;
@@ -1132,8 +1482,16 @@ no_cached_entry:
 			goto end;
 		}
 		gc_count++;
+#if CONFIG_NVS_STATS
+		gc_time = k_cyc_to_us_floor32(k_cycle_get_32() - gc_start);
+		fs->stats.gc_time_total_us += gc_time;
+		fs->stats.gc_time_max_us = MAX(fs->stats.gc_time_max_us, gc_time);
+#endif
 	}
 	rc = len;
+#if CONFIG_NVS_GC_BACKGROUND
+	nvs_gc_kick(fs);
+#endif
 end:
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
@@ -1272,3 +1630,24 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 	}
 	return free_space;
 }
+
+int nvs_stats_get(struct nvs_fs *fs, struct nvs_stats *stats)
+{
+#if CONFIG_NVS_STATS
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	*stats = fs->stats;
+	k_mutex_unlock(&fs->nvs_lock);
+
+	return 0;
+#else
+	ARG_UNUSED(fs);
+	ARG_UNUSED(stats);
+
+	return -ENOTSUP;
+#endif
+}
@@ -30,6 +30,17 @@ extern "C" {
 
 #define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
 
+/*
+ * Background garbage collection: no sector waiting for erase, and states of
+ * the copy ahead of the next sector to garbage collect
+ */
+#define NVS_GC_NO_SECTOR 0xFFFFFFFF
+
+#define NVS_GC_COPY_IDLE 0
+#define NVS_GC_COPY_ACTIVE 1
+#define NVS_GC_COPY_DONE 2
+#define NVS_GC_COPY_STOPPED 3
+
 /* Allocation Table Entry */
 struct nvs_ate {
 	uint16_t id;	/* data id */
@@ -58,4 +58,68 @@ config LOG_BACKEND_FS_FILES_LIMIT
 	  Limit of number of files with logs. It is also limited by
 	  size of file system partition.
 
+config LOG_BACKEND_FS_WRITE_BEHIND
+	bool "Write-behind buffering"
+	help
+	  When enabled, log output is collected in a RAM buffer and written
+	  to the log file in batches instead of once per log message. The
+	  buffer is written out when it is full, when the oldest data in it
+	  reaches the maximum age, and on panic. Buffered logs are lost if
+	  the system resets before that.
+
+if LOG_BACKEND_FS_WRITE_BEHIND
+
+config LOG_BACKEND_FS_BUFFER_SIZE
+	int "Write-behind buffer size"
+	default 1024
+	range 256 65536
+	help
+	  Size of the RAM buffer (in bytes). Aligning it to the file system
+	  block or flash program size reduces the number of partial writes.
+
+config LOG_BACKEND_FS_FLUSH_TIMEOUT_MS
+	int "Maximum age of buffered log data"
+	default 1000
+	range 1 3600000
+	help
+	  Time (in milliseconds) after which buffered log data is written to
+	  the log file, even if the buffer is not full.
+
+endif # LOG_BACKEND_FS_WRITE_BEHIND
+
+choice LOG_BACKEND_FS_SYNC
+	prompt "Log file synchronization policy"
+	default LOG_BACKEND_FS_SYNC_WRITE
+	help
+	  When written data is committed to the file system. On littlefs,
+	  every commit updates the file metadata and programs flash.
+
+config LOG_BACKEND_FS_SYNC_WRITE
+	bool "After every write"
+	help
+	  Log file is synced after each write, so that no written log is
+	  lost on a reset.
+
+config LOG_BACKEND_FS_SYNC_PERIODIC
+	bool "Periodically"
+	help
+	  Log file is synced at most once per LOG_BACKEND_FS_SYNC_PERIOD_MS,
+	  when it was written to.
+
+config LOG_BACKEND_FS_SYNC_CLOSE
+	bool "When the file is closed"
+	help
+	  Log file is synced only when it is full and a new one is opened,
+	  and on panic.
+
+endchoice
+
+config LOG_BACKEND_FS_SYNC_PERIOD_MS
+	int "Log file synchronization period"
+	depends on LOG_BACKEND_FS_SYNC_PERIODIC
+	default 5000
+	range 1 3600000
+	help
+	  Maximum time (in milliseconds) written log data stays uncommitted.
+
 endif # LOG_BACKEND_FS
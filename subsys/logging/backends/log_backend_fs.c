@@ -6,6 +6,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <zephyr/kernel.h>
 #include <zephyr/logging/log_backend.h>
 #include <zephyr/logging/log_output_dict.h>
 #include <zephyr/logging/log_backend_std.h>
@@ -27,6 +28,11 @@ enum backend_fs_state {
 static struct fs_file_t file;
 static enum backend_fs_state backend_state = BACKEND_FS_NOT_INITIALIZED;
 static int file_ctr, newest, oldest;
+/* Size of the newest log file, tracked to avoid fs_tell() on every write */
+static size_t file_size;
+
+/* Serializes the log thread with the deferred flush and sync work */
+static K_MUTEX_DEFINE(fs_lock);
 
 static int allocate_new_file(struct fs_file_t *file);
 static int del_oldest_log(void);
@@ -146,14 +152,13 @@ close_dir:
 	return rc;
 }
 
-int write_log_to_file(uint8_t *data, size_t length, void *ctx)
+static bool backend_fs_ready(void)
 {
 	int rc;
-	struct fs_file_t *f = &file;
 
 	if (backend_state == BACKEND_FS_NOT_INITIALIZED) {
 		if (check_log_volumen_available()) {
-			return length;
+			return false;
 		}
 		rc = create_log_dir(CONFIG_LOG_BACKEND_FS_DIR);
 		if (!rc) {
@@ -162,55 +167,77 @@ int write_log_to_file(uint8_t *data, size_t length, void *ctx)
 		backend_state = (rc ? BACKEND_FS_CORRUPTED : BACKEND_FS_OK);
 	}
 
-	if (backend_state == BACKEND_FS_OK) {
+	return backend_state == BACKEND_FS_OK;
+}
 
-		/* Check if new data overwrites max file size.
-		 * If so, create new log file.
-		 */
-		int size = fs_tell(f);
+#if defined(CONFIG_LOG_BACKEND_FS_SYNC_PERIODIC)
+static void sync_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
 
-		if (size < 0) {
-			backend_state = BACKEND_FS_CORRUPTED;
+	k_mutex_lock(&fs_lock, K_FOREVER);
+	if ((backend_state == BACKEND_FS_OK) && (fs_sync(&file) < 0)) {
+		backend_state = BACKEND_FS_CORRUPTED;
+	}
+	k_mutex_unlock(&fs_lock);
+}
 
-			return length;
-		} else if ((size + length) > CONFIG_LOG_BACKEND_FS_FILE_SIZE) {
-			rc = allocate_new_file(f);
+static K_WORK_DELAYABLE_DEFINE(sync_work, sync_work_handler);
+#endif
 
-			if (rc < 0) {
-				goto on_error;
-			}
+static int write_chunk(uint8_t *data, size_t length)
+{
+	int rc;
+	struct fs_file_t *f = &file;
+
+	if (!backend_fs_ready()) {
+		return length;
+	}
+
+	/* Check if new data overwrites max file size.
+	 * If so, create new log file.
+	 */
+	if ((file_size + length) > CONFIG_LOG_BACKEND_FS_FILE_SIZE) {
+		rc = allocate_new_file(f);
+
+		if (rc < 0) {
+			goto on_error;
 		}
+	}
 
-		rc = fs_write(f, data, length);
-		if (rc >= 0) {
-			if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_OVERWRITE) &&
-			    (rc != length)) {
-				del_oldest_log();
+	rc = fs_write(f, data, length);
+	if (rc >= 0) {
+		file_size += rc;
 
-				return 0;
-			}
-			/* If overwrite is disabled, full memory
-			 * cause the log record abandonment.
+		if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_OVERWRITE) &&
+		    (rc != length)) {
+			del_oldest_log();
+
+			return 0;
+		}
+		/* If overwrite is disabled, full memory
+		 * cause the log record abandonment.
+		 */
+		length = rc;
+	} else {
+		rc = check_log_file_exist(newest);
+		if (rc == 0) {
+			/* file was lost somehow
+			 * try to get a new one
 			 */
-			length = rc;
-		} else {
-			rc = check_log_file_exist(newest);
-			if (rc == 0) {
-				/* file was lost somehow
-				 * try to get a new one
-				 */
-				file_ctr--;
-				rc = allocate_new_file(f);
-				if (rc < 0) {
-					goto on_error;
-				}
-			} else if (rc < 0) {
-				/* fs is corrupted*/
+			file_ctr--;
+			rc = allocate_new_file(f);
+			if (rc < 0) {
 				goto on_error;
 			}
-			length = 0;
+		} else if (rc < 0) {
+			/* fs is corrupted*/
+			goto on_error;
 		}
+		length = 0;
+	}
 
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_SYNC_WRITE)) {
 		rc = fs_sync(f);
 		if (rc < 0) {
 			/* Something is wrong */
@@ -218,6 +245,13 @@ int write_log_to_file(uint8_t *data, size_t length, void *ctx)
 		}
 	}
 
+#if defined(CONFIG_LOG_BACKEND_FS_SYNC_PERIODIC)
+	/* Has no effect if a sync is already due, so the file is synced at
+	 * most once per period.
+	 */
+	k_work_schedule(&sync_work, K_MSEC(CONFIG_LOG_BACKEND_FS_SYNC_PERIOD_MS));
+#endif
+
 	return length;
 
 on_error:
@@ -225,6 +259,110 @@ on_error:
 	return length;
 }
 
+#if defined(CONFIG_LOG_BACKEND_FS_WRITE_BEHIND)
+static uint8_t __aligned(4) staging_buf[CONFIG_LOG_BACKEND_FS_BUFFER_SIZE];
+static size_t staged;
+
+static void flush_staged(void)
+{
+	size_t pos = 0;
+
+	while (pos < staged) {
+		pos += write_chunk(staging_buf + pos, staged - pos);
+	}
+
+	staged = 0;
+}
+
+static void flush_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&fs_lock, K_FOREVER);
+	flush_staged();
+	k_mutex_unlock(&fs_lock);
+}
+
+static K_WORK_DELAYABLE_DEFINE(flush_work, flush_work_handler);
+
+static int stage_log(uint8_t *data, size_t length)
+{
+	if (!backend_fs_ready()) {
+		return length;
+	}
+
+	/* Write the staged data out first if the new chunk does not fit in
+	 * the buffer or in the current file, so that the chunks end up in the
+	 * same files as they would without buffering.
+	 */
+	if (((staged + length) > sizeof(staging_buf)) ||
+	    ((file_size + staged + length) > CONFIG_LOG_BACKEND_FS_FILE_SIZE)) {
+		flush_staged();
+	}
+
+	if (length > sizeof(staging_buf)) {
+		return write_chunk(data, length);
+	}
+
+	if (staged == 0) {
+		/* Has no effect if a flush is already due, which then
+		 * only writes this data out earlier.
+		 */
+		k_work_schedule(&flush_work,
+				K_MSEC(CONFIG_LOG_BACKEND_FS_FLUSH_TIMEOUT_MS));
+	}
+
+	memcpy(staging_buf + staged, data, length);
+	staged += length;
+
+	if (staged == sizeof(staging_buf)) {
+		flush_staged();
+	}
+
+	return length;
+}
+#endif /* CONFIG_LOG_BACKEND_FS_WRITE_BEHIND */
+
+int write_log_to_file(uint8_t *data, size_t length, void *ctx)
+{
+	int rc;
+
+	k_mutex_lock(&fs_lock, K_FOREVER);
+#if defined(CONFIG_LOG_BACKEND_FS_WRITE_BEHIND)
+	rc = stage_log(data, length);
+#else
+	rc = write_chunk(data, length);
+#endif
+	k_mutex_unlock(&fs_lock);
+
+	return rc;
+}
+
+static int flush_and_sync(void)
+{
+#if defined(CONFIG_LOG_BACKEND_FS_WRITE_BEHIND)
+	flush_staged();
+#endif
+
+	if (backend_state != BACKEND_FS_OK) {
+		return 0;
+	}
+
+	return fs_sync(&file);
+}
+
+/* Writes the buffered log data out and commits it to the file system. */
+int log_backend_fs_flush(void)
+{
+	int rc;
+
+	k_mutex_lock(&fs_lock, K_FOREVER);
+	rc = flush_and_sync();
+	k_mutex_unlock(&fs_lock);
+
+	return rc;
+}
+
 static int get_log_file_id(struct fs_dirent *ent)
 {
 	size_t len;
@@ -263,7 +401,7 @@ static int allocate_new_file(struct fs_file_t *file)
 	int curr_file_num;
 	struct fs_dirent ent;
 	char fname[MAX_PATH_LEN];
-	off_t file_size;
+	off_t size;
 
 	assert(file);
 
@@ -347,14 +485,15 @@ static int allocate_new_file(struct fs_file_t *file)
 		if (rc < 0) {
 			goto out;
 		}
-		file_size = fs_tell(file);
-		if (file_size < CONFIG_LOG_BACKEND_FS_FILE_SIZE) {
+		size = fs_tell(file);
+		if (size < CONFIG_LOG_BACKEND_FS_FILE_SIZE) {
 			/* There is space left to log to the latest file, no need to create
 			 * a new one or delete old ones at this point.
 			 */
 			if (file_ctr == 0) {
 				++file_ctr;
 			}
+			file_size = MAX(size, 0);
 			backend_state = BACKEND_FS_OK;
 			goto out;
 		} else {
@@ -412,6 +551,7 @@ static int allocate_new_file(struct fs_file_t *file)
 	}
 	++file_ctr;
 	newest = curr_file_num;
+	file_size = 0;
 
 out:
 	return rc;
@@ -456,10 +596,32 @@ LOG_OUTPUT_DEFINE(log_output, write_log_to_file, buf, MAX_FLASH_WRITE_SIZE);
 
 static void log_backend_fs_init(const struct log_backend *const backend)
 {
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT)) {
+		/* Records in the log files can be found and checked for losses
+		 * even after a torn write or with files missing.
+		 */
+		log_dict_output_framing_set(&log_output, true);
+	}
 }
 
 static void panic(struct log_backend const *const backend)
 {
+#if defined(CONFIG_LOG_BACKEND_FS_WRITE_BEHIND)
+	(void)k_work_cancel_delayable(&flush_work);
+#endif
+#if defined(CONFIG_LOG_BACKEND_FS_SYNC_PERIODIC)
+	(void)k_work_cancel_delayable(&sync_work);
+#endif
+
+	/* Write out the data which was buffered or not synced yet. The mutex
+	 * is not taken as it may be held by the thread which was interrupted,
+	 * and the system no longer runs other threads in panic mode.
+	 */
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_WRITE_BEHIND) ||
+	    !IS_ENABLED(CONFIG_LOG_BACKEND_FS_SYNC_WRITE)) {
+		(void)flush_and_sync();
+	}
+
 	/* In case of panic deinitialize backend. It is better to keep
 	 * current data rather than log new and risk of failure.
 	 */
@@ -470,7 +632,8 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 {
 	ARG_UNUSED(backend);
 
-	if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_OUTPUT_DICTIONARY)) {
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT) &&
+	    (log_format_current == LOG_OUTPUT_DICT)) {
 		log_dict_output_dropped_process(&log_output, cnt);
 	} else {
 		log_backend_std_dropped(&log_output, cnt);
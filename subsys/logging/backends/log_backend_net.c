@@ -10,6 +10,7 @@ LOG_MODULE_REGISTER(log_backend_net, CONFIG_LOG_DEFAULT_LEVEL);
 #include <zephyr/logging/log_backend.h>
 #include <zephyr/logging/log_core.h>
 #include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log_output_dict.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_context.h>
 
@@ -190,6 +191,18 @@ static void process(const struct log_backend *const backend,
 	log_output_func(&log_output_net, &msg->log, flags);
 }
 
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	if (!IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT) ||
+	    (log_format_current != LOG_OUTPUT_DICT) || panic_mode || !net_init_done) {
+		return;
+	}
+
+	log_dict_output_dropped_process(&log_output_net, cnt);
+}
+
 static int format_set(const struct log_backend *const backend, uint32_t log_type)
 {
 	log_format_current = log_type;
@@ -203,6 +216,14 @@ static void init_net(struct log_backend const *const backend)
 
 	net_sin(&server_addr)->sin_port = htons(514);
 
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT)) {
+		/* A record which fits in the output buffer is sent in one
+		 * datagram, and lost datagrams are detected with the sequence
+		 * number.
+		 */
+		log_dict_output_framing_set(&log_output_net, true);
+	}
+
 	ret = net_ipaddr_parse(CONFIG_LOG_BACKEND_NET_SERVER,
 			       sizeof(CONFIG_LOG_BACKEND_NET_SERVER) - 1,
 			       &server_addr);
@@ -223,6 +244,7 @@ const struct log_backend_api log_backend_net_api = {
 	.panic = panic,
 	.init = init_net,
 	.process = process,
+	.dropped = dropped,
 	.format_set = format_set,
 };
 
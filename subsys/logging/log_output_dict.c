@@ -11,6 +11,7 @@
 #include <zephyr/logging/log_output_dict.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/util.h>
+#include <string.h>
 
 static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
 			 void *ctx)
@@ -24,11 +25,79 @@ static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
 	} while (len != 0);
 }
 
+/* Framed records are collected in the output buffer, so that a record which
+ * fits in it is passed to the output function in a single call.
+ */
+static void buffer_append(const struct log_output *output, const uint8_t *data,
+			  size_t len)
+{
+	struct log_output_control_block *cb = output->control_block;
+
+	while (len > 0) {
+		size_t offset = atomic_get(&cb->offset);
+		size_t chunk = MIN(len, output->size - offset);
+
+		memcpy(&output->buf[offset], data, chunk);
+		atomic_set(&cb->offset, offset + chunk);
+		data += chunk;
+		len -= chunk;
+
+		if ((offset + chunk) == output->size) {
+			log_output_flush(output);
+		}
+	}
+}
+
+static void record_write(const struct log_output *output, const void *data,
+			 size_t len)
+{
+	if (output->control_block->dict_framed) {
+		buffer_append(output, data, len);
+	} else {
+		buffer_write(output->func, (uint8_t *)data, len, (void *)output);
+	}
+}
+
+/* A message with the package and data lengths at the maximum of their
+ * log_msg_desc fields (data_len is 12 bits) must fit in the frame header.
+ */
+BUILD_ASSERT(sizeof(struct log_dict_output_normal_msg_hdr_t) + Z_LOG_MSG_MAX_PACKAGE +
+	     BIT_MASK(12) <= UINT16_MAX,
+	     "Log message does not fit in a dictionary frame");
+
+static void record_start(const struct log_output *output, size_t len)
+{
+	struct log_dict_output_frame_hdr_t frame_hdr;
+
+	if (!output->control_block->dict_framed) {
+		return;
+	}
+
+	frame_hdr.magic = LOG_DICT_OUTPUT_FRAME_MAGIC;
+	frame_hdr.len = len;
+	frame_hdr.seq = output->control_block->dict_seq++;
+
+	buffer_append(output, (const uint8_t *)&frame_hdr, sizeof(frame_hdr));
+}
+
+static void record_end(const struct log_output *output)
+{
+	/* Avoid an empty write, which the network backend would send as an
+	 * empty datagram.
+	 */
+	if (atomic_get(&output->control_block->offset) > 0) {
+		log_output_flush(output);
+	}
+}
+
 void log_dict_output_msg_process(const struct log_output *output,
 				 struct log_msg *msg, uint32_t flags)
 {
 	struct log_dict_output_normal_msg_hdr_t output_hdr;
 	void *source = (void *)log_msg_get_source(msg);
+	size_t package_len, data_len;
+	uint8_t *package = log_msg_get_package(msg, &package_len);
+	uint8_t *data = log_msg_get_data(msg, &data_len);
 
 	/* Keep sync with header in struct log_msg */
 	output_hdr.type = MSG_NORMAL;
@@ -44,22 +113,19 @@ void log_dict_output_msg_process(const struct log_output *output,
 					log_const_source_id(source)) :
 				0U;
 
-	buffer_write(output->func, (uint8_t *)&output_hdr, sizeof(output_hdr),
-		     (void *)output);
+	record_start(output, sizeof(output_hdr) + package_len + data_len);
 
-	size_t len;
-	uint8_t *data = log_msg_get_package(msg, &len);
+	record_write(output, &output_hdr, sizeof(output_hdr));
 
-	if (len > 0U) {
-		buffer_write(output->func, data, len, (void *)output);
+	if (package_len > 0U) {
+		record_write(output, package, package_len);
 	}
 
-	data = log_msg_get_data(msg, &len);
-	if (len > 0U) {
-		buffer_write(output->func, data, len, (void *)output);
+	if (data_len > 0U) {
+		record_write(output, data, data_len);
 	}
 
-	log_output_flush(output);
+	record_end(output);
 }
 
 void log_dict_output_dropped_process(const struct log_output *output, uint32_t cnt)
@@ -69,6 +135,7 @@ void log_dict_output_dropped_process(const struct log_output *output, uint32_t c
 	msg.type = MSG_DROPPED_MSG;
 	msg.num_dropped_messages = MIN(cnt, 9999);
 
-	buffer_write(output->func, (uint8_t *)&msg, sizeof(msg),
-		     (void *)output);
+	record_start(output, sizeof(msg));
+	record_write(output, &msg, sizeof(msg));
+	record_end(output);
 }
@@ -683,6 +683,24 @@ size_t net_buf_linearize(void *dst, size_t dst_len, struct net_buf *src,
 	return copied;
 }
 
+#if defined(CONFIG_PIPES)
+int net_buf_splice_pipe(struct net_buf *buf, struct k_pipe *pipe, size_t len,
+			size_t min_xfer, k_timeout_t timeout)
+{
+	size_t bytes_read = 0;
+	int ret;
+
+	len = MIN(len, net_buf_tailroom(buf));
+
+	ret = k_pipe_get(pipe, net_buf_tail(buf), len, &bytes_read,
+			 MIN(min_xfer, len), timeout);
+
+	net_buf_add(buf, bytes_read);
+
+	return ret;
+}
+#endif
+
 /* This helper routine will append multiple bytes, if there is no place for
  * the data in current fragment then create new fragment and add it to
  * the buffer. It assumes that the buffer has at least one fragment.
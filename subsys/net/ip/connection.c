@@ -24,6 +24,7 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 #include <zephyr/net/udp.h>
 #include <zephyr/net/ethernet.h>
 #include <zephyr/net/socketcan.h>
+#include <zephyr/sys/hash_map.h>
 
 #include "net_private.h"
 #include "icmpv6.h"
@@ -116,6 +117,287 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+#if defined(CONFIG_NET_CONN_HASH)
+/* Connection handlers are indexed in one of three places:
+ *  - conn_exact: the ones with both addresses and both ports specified,
+ *    by a hash of their 4-tuple,
+ *  - conn_listen: the other IP ones with a local port, by that port,
+ *  - conn_other: everything else, always checked.
+ * Connections sharing a key are chained through hash_next, most recently
+ * registered first like in the conn_used list.
+ */
+enum conn_table {
+	CONN_TABLE_NONE,
+	CONN_TABLE_EXACT,
+	CONN_TABLE_LISTEN,
+	CONN_TABLE_OTHER,
+};
+
+#define NET_CONN_FULLY_SPECIFIED (NET_CONN_REMOTE_ADDR_SPEC |		\
+				  NET_CONN_LOCAL_ADDR_SPEC |		\
+				  NET_CONN_REMOTE_PORT_SPEC |		\
+				  NET_CONN_LOCAL_PORT_SPEC)
+
+/* Worst case bucket array of an open addressing map holding _n entries,
+ * a key, a value and a state per bucket. As deleted entries count in the
+ * load factor the array can grow to twice the size needed for _n.
+ */
+#define CONN_HASH_BUCKETS_SIZE(_n)					\
+	(2 * NHPOT(DIV_ROUND_UP((_n) * 100,				\
+				SYS_HASHMAP_DEFAULT_LOAD_FACTOR)) *	\
+	 3 * sizeof(uint64_t))
+
+#if defined(CONFIG_NET_TCP)
+#define CONN_HASH_TCP_SIZE CONN_HASH_BUCKETS_SIZE(CONFIG_NET_MAX_CONTEXTS)
+#else
+#define CONN_HASH_TCP_SIZE 0
+#endif
+
+/* Room for every table plus the array a table is rehashed into */
+#define CONN_HASH_HEAP_SIZE						\
+	(3 * CONN_HASH_BUCKETS_SIZE(CONFIG_NET_MAX_CONN) + 2 * CONN_HASH_TCP_SIZE)
+
+K_HEAP_DEFINE(conn_hash_heap, CONN_HASH_HEAP_SIZE);
+
+void *net_conn_hash_alloc(void *ptr, size_t size)
+{
+	if (size == 0) {
+		k_heap_free(&conn_hash_heap, ptr);
+		return NULL;
+	}
+
+	/* Open addressing maps only allocate new bucket arrays */
+	__ASSERT_NO_MSG(ptr == NULL);
+
+	return k_heap_alloc(&conn_hash_heap, size, K_NO_WAIT);
+}
+
+SYS_HASHMAP_OA_LP_DEFINE_STATIC_ADVANCED(conn_exact, sys_hash32,
+					 net_conn_hash_alloc,
+					 SYS_HASHMAP_CONFIG(CONFIG_NET_MAX_CONN,
+						SYS_HASHMAP_DEFAULT_LOAD_FACTOR));
+SYS_HASHMAP_OA_LP_DEFINE_STATIC_ADVANCED(conn_listen, sys_hash32,
+					 net_conn_hash_alloc,
+					 SYS_HASHMAP_CONFIG(CONFIG_NET_MAX_CONN,
+						SYS_HASHMAP_DEFAULT_LOAD_FACTOR));
+
+static struct net_conn *conn_other;
+static struct net_conn_lookup_stats conn_lookup_stats;
+
+static uint64_t conn_exact_key(uint16_t proto, uint8_t family,
+			       const uint8_t *remote_addr, uint16_t remote_port,
+			       const uint8_t *local_addr, uint16_t local_port)
+{
+	struct {
+		uint8_t remote_addr[NET_IPV6_ADDR_SIZE];
+		uint8_t local_addr[NET_IPV6_ADDR_SIZE];
+		uint16_t remote_port;
+		uint16_t local_port;
+		uint16_t proto;
+		uint16_t family;
+	} tuple = { 0 };
+	size_t addr_len = family == AF_INET6 ? NET_IPV6_ADDR_SIZE :
+					       NET_IPV4_ADDR_SIZE;
+
+	memcpy(tuple.remote_addr, remote_addr, addr_len);
+	memcpy(tuple.local_addr, local_addr, addr_len);
+	tuple.remote_port = remote_port;
+	tuple.local_port = local_port;
+	tuple.proto = proto;
+	tuple.family = family;
+
+	return sys_hash32(&tuple, sizeof(tuple));
+}
+
+static uint64_t conn_listen_key(uint16_t proto, uint8_t family,
+				uint16_t local_port)
+{
+	return ((uint64_t)family << 32) | ((uint32_t)proto << 16) | local_port;
+}
+
+static const uint8_t *conn_raw_addr(struct sockaddr *addr)
+{
+	if (addr->sa_family == AF_INET6) {
+		return (const uint8_t *)&net_sin6(addr)->sin6_addr;
+	}
+
+	return (const uint8_t *)&net_sin(addr)->sin_addr;
+}
+
+static struct sys_hashmap *conn_hash_map(uint8_t table)
+{
+	return table == CONN_TABLE_EXACT ? &conn_exact : &conn_listen;
+}
+
+static void conn_hash_add(struct net_conn *conn)
+{
+	struct net_conn *head = NULL;
+	struct sys_hashmap *map;
+	uint64_t value;
+
+	if ((conn->family == AF_INET || conn->family == AF_INET6) &&
+	    (conn->flags & NET_CONN_FULLY_SPECIFIED) == NET_CONN_FULLY_SPECIFIED) {
+		conn->hash_table = CONN_TABLE_EXACT;
+		conn->hash_key = conn_exact_key(conn->proto, conn->family,
+				conn_raw_addr(&conn->remote_addr),
+				net_sin(&conn->remote_addr)->sin_port,
+				conn_raw_addr(&conn->local_addr),
+				net_sin(&conn->local_addr)->sin_port);
+	} else if ((conn->family == AF_INET || conn->family == AF_INET6) &&
+		   (conn->flags & NET_CONN_LOCAL_PORT_SPEC)) {
+		conn->hash_table = CONN_TABLE_LISTEN;
+		conn->hash_key = conn_listen_key(conn->proto, conn->family,
+				net_sin(&conn->local_addr)->sin_port);
+	} else {
+		conn->hash_table = CONN_TABLE_OTHER;
+	}
+
+	if (conn->hash_table != CONN_TABLE_OTHER) {
+		map = conn_hash_map(conn->hash_table);
+
+		if (sys_hashmap_get(map, conn->hash_key, &value)) {
+			head = (struct net_conn *)(uintptr_t)value;
+		}
+
+		if (sys_hashmap_insert(map, conn->hash_key, (uintptr_t)conn,
+				       NULL) >= 0) {
+			conn->hash_next = head;
+			return;
+		}
+
+		/* Out of table memory, fall back to the list always checked */
+		NET_WARN("Cannot index connection handler %p", conn);
+		conn->hash_table = CONN_TABLE_OTHER;
+	}
+
+	conn->hash_next = conn_other;
+	conn_other = conn;
+}
+
+static void conn_hash_del(struct net_conn *conn)
+{
+	struct net_conn **prev;
+	struct net_conn *head = NULL;
+	struct sys_hashmap *map = NULL;
+	uint64_t value;
+
+	if (conn->hash_table == CONN_TABLE_OTHER) {
+		prev = &conn_other;
+	} else if (conn->hash_table != CONN_TABLE_NONE) {
+		map = conn_hash_map(conn->hash_table);
+		if (!sys_hashmap_get(map, conn->hash_key, &value)) {
+			return;
+		}
+
+		head = (struct net_conn *)(uintptr_t)value;
+		prev = &head;
+	} else {
+		return;
+	}
+
+	while (*prev != NULL && *prev != conn) {
+		prev = &(*prev)->hash_next;
+	}
+
+	if (*prev == NULL) {
+		return;
+	}
+
+	*prev = conn->hash_next;
+	conn->hash_table = CONN_TABLE_NONE;
+
+	if (map == NULL) {
+		return;
+	}
+
+	if (head == NULL) {
+		(void)sys_hashmap_remove(map, conn->hash_key, NULL);
+	} else {
+		(void)sys_hashmap_insert(map, conn->hash_key, (uintptr_t)head,
+					 NULL);
+	}
+}
+
+/* Candidates for a received IP packet: the exact 4-tuple chain, then the
+ * listeners on the destination port, then the unindexed connections.
+ */
+struct conn_lookup {
+	struct net_conn *chains[3];
+	int chain;
+	uint32_t probes;
+};
+
+static struct net_conn *conn_lookup_next(struct conn_lookup *lookup,
+					 struct net_conn *conn)
+{
+	if (conn != NULL) {
+		conn = conn->hash_next;
+	}
+
+	while (conn == NULL && lookup->chain < ARRAY_SIZE(lookup->chains)) {
+		conn = lookup->chains[lookup->chain++];
+	}
+
+	if (conn != NULL) {
+		lookup->probes++;
+	}
+
+	return conn;
+}
+
+static struct net_conn *conn_lookup_first(struct conn_lookup *lookup,
+					  struct net_pkt *pkt,
+					  union net_ip_header *ip_hdr,
+					  uint8_t proto,
+					  uint16_t src_port, uint16_t dst_port)
+{
+	uint8_t family = net_pkt_family(pkt);
+	const uint8_t *src, *dst;
+	uint64_t value;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		src = ip_hdr->ipv6->src;
+		dst = ip_hdr->ipv6->dst;
+	} else {
+		src = ip_hdr->ipv4->src;
+		dst = ip_hdr->ipv4->dst;
+	}
+
+	memset(lookup, 0, sizeof(*lookup));
+
+	k_mutex_lock(&conn_lock, K_FOREVER);
+
+	if (sys_hashmap_get(&conn_exact,
+			    conn_exact_key(proto, family, src, src_port,
+					   dst, dst_port),
+			    &value)) {
+		lookup->chains[0] = (struct net_conn *)(uintptr_t)value;
+	}
+
+	if (sys_hashmap_get(&conn_listen,
+			    conn_listen_key(proto, family, dst_port),
+			    &value)) {
+		lookup->chains[1] = (struct net_conn *)(uintptr_t)value;
+	}
+
+	lookup->chains[2] = conn_other;
+
+	k_mutex_unlock(&conn_lock);
+
+	return conn_lookup_next(lookup, NULL);
+}
+
+void net_conn_lookup_stats_get(struct net_conn_lookup_stats *stats)
+{
+	k_mutex_lock(&conn_lock, K_FOREVER);
+	*stats = conn_lookup_stats;
+	k_mutex_unlock(&conn_lock);
+}
+#else
+#define conn_hash_add(...)
+#define conn_hash_del(...)
+#endif /* CONFIG_NET_CONN_HASH */
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -141,6 +423,7 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+	conn_hash_add(conn);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -397,6 +680,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_del(conn);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -622,6 +906,11 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	bool raw_pkt_delivered = false;
 	bool raw_pkt_continue = false;
 	struct net_conn *conn;
+#if defined(CONFIG_NET_CONN_HASH)
+	struct conn_lookup lookup;
+	bool use_hash = IS_ENABLED(CONFIG_NET_IP) &&
+			(pkt_family == AF_INET || pkt_family == AF_INET6);
+#endif
 
 	if (IS_ENABLED(CONFIG_NET_IP)) {
 		/* If we receive a packet with multicast destination address, we might
@@ -639,7 +928,16 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+#if defined(CONFIG_NET_CONN_HASH)
+	for (conn = use_hash ? conn_lookup_first(&lookup, pkt, ip_hdr, proto,
+						 src_port, dst_port) :
+			       SYS_SLIST_PEEK_HEAD_CONTAINER(&conn_used, conn, node);
+	     conn != NULL;
+	     conn = use_hash ? conn_lookup_next(&lookup, conn) :
+			       SYS_SLIST_PEEK_NEXT_CONTAINER(conn, node)) {
+#else
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+#endif
 		/* Is the candidate connection matching the packet's interface? */
 		if (conn->context != NULL &&
 		    net_context_is_bound_to_iface(conn->context) &&
@@ -784,6 +1082,12 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	} /* loop end */
 
+#if defined(CONFIG_NET_CONN_HASH)
+	if (use_hash) {
+		net_conn_lookup_stats_update(&conn_lookup_stats, lookup.probes);
+	}
+#endif
+
 	if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && pkt_family == AF_PACKET) {
 		if (raw_pkt_continue) {
 			/* When there is open connection different than
@@ -79,8 +79,58 @@ struct net_conn {
 
 	/** Flags for the connection */
 	uint8_t flags;
+
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Next connection in the same lookup table chain */
+	struct net_conn *hash_next;
+
+	/** Key of the chain in the lookup table */
+	uint64_t hash_key;
+
+	/** Lookup table the connection is linked to */
+	uint8_t hash_table;
+#endif
+};
+
+#if defined(CONFIG_NET_CONN_HASH)
+/**
+ * @brief Connection lookup statistics.
+ *
+ * A probe is one connection compared against the received packet.
+ */
+struct net_conn_lookup_stats {
+	/** Number of lookups done */
+	uint32_t lookups;
+
+	/** Total number of probes over all the lookups */
+	uint32_t probes;
+
+	/** Longest lookup seen */
+	uint32_t max_probes;
 };
 
+static inline void net_conn_lookup_stats_update(struct net_conn_lookup_stats *stats,
+						uint32_t probes)
+{
+	stats->lookups++;
+	stats->probes += probes;
+	stats->max_probes = MAX(stats->max_probes, probes);
+}
+
+/**
+ * @brief Get the lookup statistics of the connection handlers.
+ *
+ * @param stats Where to copy the statistics.
+ */
+void net_conn_lookup_stats_get(struct net_conn_lookup_stats *stats);
+
+/**
+ * @brief Allocator for the connection lookup tables, to be used as the
+ * sys_hashmap allocator function.
+ */
+void *net_conn_hash_alloc(void *ptr, size_t size);
+#endif /* CONFIG_NET_CONN_HASH */
+
 /**
  * @brief Register a callback to be called when a net packet
  * is received corresponding to received packet.
@@ -365,6 +365,11 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt)
 	case IPPROTO_TCP:
 		proto_hdr.tcp = net_tcp_input(pkt, &tcp_access);
 		if (proto_hdr.tcp) {
+			if (net_tcp_gro_receive(pkt) == NET_OK) {
+				/* Held for coalescing, passed on later */
+				return NET_OK;
+			}
+
 			verdict = NET_OK;
 		}
 		break;
@@ -693,6 +693,11 @@ enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback)
 	case IPPROTO_TCP:
 		proto_hdr.tcp = net_tcp_input(pkt, &tcp_access);
 		if (proto_hdr.tcp) {
+			if (net_tcp_gro_receive(pkt) == NET_OK) {
+				/* Held for coalescing, passed on later */
+				return NET_OK;
+			}
+
 			verdict = NET_OK;
 		}
 		break;
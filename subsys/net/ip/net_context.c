@@ -1346,6 +1346,7 @@ static int context_setup_udp_packet(struct net_context *context,
 				    const void *buf,
 				    size_t len,
 				    const struct msghdr *msg,
+				    struct net_buf *frags,
 				    const struct sockaddr *dst_addr,
 				    socklen_t addrlen)
 {
@@ -1387,6 +1388,12 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
+	if (frags) {
+		/* The data follows the headers as it is */
+		net_pkt_append_buffer(pkt, net_buf_ref(frags));
+		return 0;
+	}
+
 	ret = context_write_data(pkt, buf, len, msg);
 	if (ret) {
 		return ret;
@@ -1475,7 +1482,8 @@ static int context_sendto(struct net_context *context,
 			  net_context_send_cb_t cb,
 			  k_timeout_t timeout,
 			  void *user_data,
-			  bool sendto)
+			  bool sendto,
+			  struct net_buf *frags)
 {
 	const struct msghdr *msghdr = NULL;
 	struct net_if *iface;
@@ -1683,12 +1691,17 @@ static int context_sendto(struct net_context *context,
 		}
 	}
 
+	if (frags) {
+		len = net_buf_frags_len(frags);
+	}
+
 	iface = net_context_get_iface(context);
 	if (iface && !net_if_is_up(iface)) {
 		return -ENETDOWN;
 	}
 
-	pkt = context_alloc_pkt(context, len, PKT_WAIT_TIME);
+	/* Only the headers need a buffer when sending caller's fragments */
+	pkt = context_alloc_pkt(context, frags ? 0 : len, PKT_WAIT_TIME);
 	if (!pkt) {
 		NET_ERR("Failed to allocate net_pkt");
 		return -ENOBUFS;
@@ -1696,7 +1709,7 @@ static int context_sendto(struct net_context *context,
 
 	tmp_len = net_pkt_available_payload_buffer(
 				pkt, net_context_get_proto(context));
-	if (tmp_len < len) {
+	if (!frags && tmp_len < len) {
 		if (net_context_get_type(context) == SOCK_DGRAM) {
 			NET_ERR("Available payload buffer (%zu) is not enough for requested DGRAM (%zu)",
 				tmp_len, len);
@@ -1750,7 +1763,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_proto(context) == IPPROTO_UDP) {
 		ret = context_setup_udp_packet(context, pkt, buf, len, msghdr,
-					       dst_addr, addrlen);
+					       frags, dst_addr, addrlen);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1761,9 +1774,19 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_proto(context) == IPPROTO_TCP) {
 
-		ret = context_write_data(pkt, buf, len, msghdr);
-		if (ret < 0) {
-			goto fail;
+		if (frags) {
+			/* TCP adds the headers itself, queue only the data */
+			if (pkt->buffer) {
+				net_pkt_frag_unref(pkt->buffer);
+				pkt->buffer = NULL;
+			}
+
+			net_pkt_append_buffer(pkt, net_buf_ref(frags));
+		} else {
+			ret = context_write_data(pkt, buf, len, msghdr);
+			if (ret < 0) {
+				goto fail;
+			}
 		}
 
 		net_pkt_cursor_init(pkt);
@@ -1867,7 +1890,7 @@ int net_context_send(struct net_context *context,
 	}
 
 	ret = context_sendto(context, buf, len, &context->remote,
-			     addrlen, cb, timeout, user_data, false);
+			     addrlen, cb, timeout, user_data, false, NULL);
 unlock:
 	k_mutex_unlock(&context->lock);
 
@@ -1886,7 +1909,7 @@ int net_context_sendmsg(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, msghdr, 0, NULL, 0,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true, NULL);
 
 	k_mutex_unlock(&context->lock);
 
@@ -1907,8 +1930,61 @@ int net_context_sendto(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, buf, len, dst_addr, addrlen,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true, NULL);
+
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+
+int net_context_sendto_buf(struct net_context *context,
+			   struct net_buf *frags,
+			   const struct sockaddr *dst_addr,
+			   socklen_t addrlen,
+			   net_context_send_cb_t cb,
+			   k_timeout_t timeout,
+			   void *user_data)
+{
+	int ret;
+
+	if (frags == NULL) {
+		return -EINVAL;
+	}
+
+	if ((net_context_get_proto(context) != IPPROTO_UDP &&
+	     net_context_get_proto(context) != IPPROTO_TCP) ||
+	    (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	     net_if_is_ip_offloaded(net_context_get_iface(context)))) {
+		return -EOPNOTSUPP;
+	}
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (dst_addr == NULL) {
+		if (!(context->flags & NET_CONTEXT_REMOTE_ADDR_SET) ||
+		    !net_sin(&context->remote)->sin_port) {
+			ret = -EDESTADDRREQ;
+			goto unlock;
+		}
+
+		dst_addr = &context->remote;
+
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    net_context_get_family(context) == AF_INET6) {
+			addrlen = sizeof(struct sockaddr_in6);
+		} else {
+			addrlen = sizeof(struct sockaddr_in);
+		}
+	}
 
+	ret = context_sendto(context, NULL, 0, dst_addr, addrlen,
+			     cb, timeout, user_data, true, frags);
+	if (ret >= 0) {
+		/* The packet holds its own reference to the data now */
+		net_buf_unref(frags);
+	}
+
+unlock:
 	k_mutex_unlock(&context->lock);
 
 	return ret;
@@ -335,11 +335,21 @@ int net_send_data(struct net_pkt *pkt)
 	if (status < 0) {
 		return status;
 	} else if (status > 0) {
+		int tc = net_rx_priority2tc(net_pkt_priority(pkt));
+
 		/* Packet is destined back to us so send it directly
 		 * to RX processing.
 		 */
 		NET_DBG("Loopback pkt %p back to us", pkt);
 		processing_data(pkt, true);
+
+		/* Not received through an RX queue, which would pass on
+		 * the coalesced TCP segments at the end of its batch.
+		 */
+		if (IS_ENABLED(CONFIG_NET_TCP_GRO)) {
+			net_tcp_gro_flush(tc);
+		}
+
 		return 0;
 	}
 
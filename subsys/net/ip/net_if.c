@@ -209,6 +209,230 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
+static inline bool tso_hw_capable(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	return net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET) &&
+	       (net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TSO);
+#else
+	ARG_UNUSED(iface);
+
+	return false;
+#endif
+}
+
+#if defined(CONFIG_NET_TCP_TSO)
+/* Largest IP and TCP header of a large send packet we can cut */
+#define TSO_HDR_MAX_LEN 128
+/* TCP flags that only the last segment carries (FIN and PSH) */
+#define TSO_LAST_SEG_FLAGS (BIT(0) | BIT(3))
+#define TSO_ALLOC_TIMEOUT K_MSEC(100)
+
+/* Cut the first len bytes off the buffer chain and return them as a
+ * chain of their own. Only a buffer straddling the cut is copied.
+ */
+static struct net_buf *tso_split(struct net_pkt *pkt, struct net_buf **chain,
+				 size_t len)
+{
+	struct net_buf *head = *chain, *buf = *chain, *prev = NULL;
+	struct net_buf *copy = NULL;
+
+	while (buf && len >= buf->len) {
+		len -= buf->len;
+		prev = buf;
+		buf = buf->frags;
+	}
+
+	if (buf && len > 0) {
+		copy = net_pkt_get_frag(pkt, len, TSO_ALLOC_TIMEOUT);
+		if (!copy) {
+			return NULL;
+		}
+
+		if (net_buf_tailroom(copy) < len) {
+			net_buf_unref(copy);
+			return NULL;
+		}
+
+		net_buf_add_mem(copy, buf->data, len);
+		net_buf_pull(buf, len);
+	}
+
+	if (prev) {
+		prev->frags = copy;
+	} else {
+		head = copy;
+	}
+
+	*chain = buf;
+
+	return head;
+}
+
+static void tso_hdr_update(uint8_t *hdr, struct net_pkt *pkt, size_t ip_len,
+			   size_t len, uint32_t seq, uint8_t flags)
+{
+	struct net_tcp_hdr *tcp_hdr = (struct net_tcp_hdr *)(hdr + ip_len);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		struct net_ipv4_hdr *ipv4_hdr = (struct net_ipv4_hdr *)hdr;
+
+		ipv4_hdr->len = htons(len);
+		ipv4_hdr->chksum = 0U;
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		struct net_ipv6_hdr *ipv6_hdr = (struct net_ipv6_hdr *)hdr;
+
+		ipv6_hdr->len = htons(len - sizeof(struct net_ipv6_hdr));
+	}
+
+	sys_put_be32(seq, tcp_hdr->seq);
+	tcp_hdr->flags = flags;
+	tcp_hdr->chksum = 0U;
+}
+
+/* Software segmentation of a TCP large send packet. The IP and TCP headers
+ * are read once and reused as a template for every segment, only the
+ * lengths, sequence number, flags and checksums are updated. The payload
+ * buffers are moved to the segments without copying.
+ */
+static int net_if_tso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	uint16_t mss = net_pkt_tso_mss(pkt);
+	uint8_t hdr[TSO_HDR_MAX_LEN];
+	struct net_tcp_hdr *tcp_hdr;
+	struct net_buf *data;
+	size_t hdr_len, len;
+	uint32_t seq;
+	uint8_t flags;
+	int sent = 0;
+	int ret;
+
+	net_pkt_cursor_init(pkt);
+
+	if (ip_len + sizeof(*tcp_hdr) > sizeof(hdr) ||
+	    net_pkt_read(pkt, hdr, ip_len + sizeof(*tcp_hdr))) {
+		return -EINVAL;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)(hdr + ip_len);
+	hdr_len = ip_len + (tcp_hdr->offset >> 4) * 4U;
+
+	if (hdr_len < ip_len + sizeof(*tcp_hdr) || hdr_len > sizeof(hdr) ||
+	    net_pkt_read(pkt, tcp_hdr->optdata,
+			 hdr_len - ip_len - sizeof(*tcp_hdr))) {
+		return -EINVAL;
+	}
+
+	len = net_pkt_get_len(pkt) - hdr_len;
+	seq = sys_get_be32(tcp_hdr->seq);
+	flags = tcp_hdr->flags;
+
+	/* Detach the payload, pkt keeps only the headers from now on and
+	 * serves as the attribute source of the segments.
+	 */
+	data = pkt->buffer;
+	pkt->buffer = tso_split(pkt, &data, hdr_len);
+	if (!pkt->buffer) {
+		pkt->buffer = data;
+		return -ENOBUFS;
+	}
+
+	while (len > 0) {
+		size_t seg_len = MIN(len, mss);
+		struct net_buf *payload, *frag;
+		struct net_pkt *seg;
+
+		if (seg_len < len) {
+			payload = tso_split(pkt, &data, seg_len);
+		} else {
+			payload = data;
+			data = NULL;
+		}
+
+		if (!payload) {
+			ret = -ENOBUFS;
+			goto fail;
+		}
+
+		seg = net_pkt_shallow_clone(pkt, TSO_ALLOC_TIMEOUT);
+		if (!seg) {
+			net_buf_unref(payload);
+			ret = -ENOBUFS;
+			goto fail;
+		}
+
+		net_pkt_frag_unref(seg->buffer);
+		seg->buffer = NULL;
+		net_pkt_set_tso_mss(seg, 0U);
+
+		frag = net_pkt_get_frag(seg, hdr_len, TSO_ALLOC_TIMEOUT);
+		if (!frag || net_buf_tailroom(frag) < hdr_len) {
+			if (frag) {
+				net_buf_unref(frag);
+			}
+
+			net_buf_unref(payload);
+			net_pkt_unref(seg);
+			ret = -ENOBUFS;
+			goto fail;
+		}
+
+		len -= seg_len;
+
+		tso_hdr_update(hdr, pkt, ip_len, hdr_len + seg_len, seq,
+			       len > 0 ? flags & ~TSO_LAST_SEG_FLAGS : flags);
+		net_buf_add_mem(frag, hdr, hdr_len);
+
+		net_pkt_append_buffer(seg, frag);
+		net_pkt_append_buffer(seg, payload);
+		net_pkt_cursor_init(seg);
+
+		if (net_if_need_calc_tx_checksum(iface)) {
+			tcp_hdr = (struct net_tcp_hdr *)(frag->data + ip_len);
+
+#if defined(CONFIG_NET_IPV4)
+			if (net_pkt_family(seg) == AF_INET) {
+				NET_IPV4_HDR(seg)->chksum =
+					net_calc_chksum_ipv4(seg);
+			}
+#endif
+
+			tcp_hdr->chksum = net_calc_chksum_tcp(seg);
+		}
+
+		ret = net_if_l2(iface)->send(iface, seg);
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			goto fail;
+		}
+
+		sent += ret;
+		seq += seg_len;
+	}
+
+	net_pkt_unref(pkt);
+
+	return sent;
+
+fail:
+	if (data) {
+		net_buf_unref(data);
+	}
+
+	return ret;
+}
+#else
+static inline int net_if_tso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return -ENOTSUP;
+}
+#endif /* CONFIG_NET_TCP_TSO */
+
 static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct net_linkaddr ll_dst = {
@@ -217,6 +441,7 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 	struct net_linkaddr_storage ll_dst_storage;
 	struct net_context *context;
 	uint32_t create_time;
+	bool tso_sw;
 	int status;
 
 	/* We collect send statistics for each socket priority if enabled */
@@ -245,6 +470,7 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 	}
 
 	context = net_pkt_context(pkt);
+	tso_sw = net_pkt_tso_mss(pkt) > 0U && !tso_hw_capable(iface);
 
 	if (net_if_flag_is_set(iface, NET_IF_LOWER_UP)) {
 		if (IS_ENABLED(CONFIG_NET_TCP) &&
@@ -263,7 +489,18 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 			}
 		}
 
-		status = net_if_l2(iface)->send(iface, pkt);
+		if (tso_sw) {
+			/* The segments are sent in place of pkt, which is
+			 * released on success. Keep it for the statistics.
+			 */
+			if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
+				net_pkt_ref(pkt);
+			}
+
+			status = net_if_tso_send(iface, pkt);
+		} else {
+			status = net_if_l2(iface)->send(iface, pkt);
+		}
 
 		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
 			uint32_t end_tick = k_cycle_get_32();
@@ -294,6 +531,10 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 
 				net_pkt_unref(pkt);
 			}
+
+			if (tso_sw) {
+				net_pkt_unref(pkt);
+			}
 		}
 
 	} else {
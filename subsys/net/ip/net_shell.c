@@ -264,6 +264,7 @@ static struct ethernet_capabilities eth_hw_caps[] = {
 	EC(ETHERNET_QBV,                  "IEEE 802.1Qbv (scheduled traffic)"),
 	EC(ETHERNET_QBU,                  "IEEE 802.1Qbu (frame preemption)"),
 	EC(ETHERNET_TXTIME,               "TXTIME"),
+	EC(ETHERNET_HW_TSO,               "TCP segmentation offload"),
 	EC(ETHERNET_PROMISC_MODE,         "Promiscuous mode"),
 	EC(ETHERNET_PRIORITY_QUEUES,      "Priority queues"),
 	EC(ETHERNET_HW_FILTERING,         "MAC address filtering"),
@@ -291,7 +292,8 @@ static const char *iface_flags2str(struct net_if *iface)
 	static char str[sizeof("POINTOPOINT") + sizeof("PROMISC") +
 			sizeof("NO_AUTO_START") + sizeof("SUSPENDED") +
 			sizeof("MCAST_FORWARD") + sizeof("IPv4") +
-			sizeof("IPv6") + sizeof("NO_ND") + sizeof("NO_MLD")];
+			sizeof("IPv6") + sizeof("NO_ND") + sizeof("NO_MLD") +
+			sizeof("GRO")];
 	int pos = 0;
 
 	if (net_if_flag_is_set(iface, NET_IF_POINTOPOINT)) {
@@ -337,6 +339,11 @@ static const char *iface_flags2str(struct net_if *iface)
 				"NO_MLD,");
 	}
 
+	if (net_if_flag_is_set(iface, NET_IF_GRO)) {
+		pos += snprintk(str + pos, sizeof(str) - pos,
+				"GRO,");
+	}
+
 	/* get rid of last ',' character */
 	str[pos - 1] = '\0';
 
@@ -1303,6 +1310,11 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	   GET_STAT(iface, tcp.conndrop),
 	   GET_STAT(iface, tcp.connrst));
 	PR("TCP pkt drop   %d\n", GET_STAT(iface, tcp.drop));
+#if defined(CONFIG_NET_TCP_GRO)
+	PR("TCP GRO merged %d\tflushed\t%d\n",
+	   GET_STAT(iface, tcp.gro_merged),
+	   GET_STAT(iface, tcp.gro_flushed));
+#endif
 #endif
 
 	PR("Bytes received %u\n", GET_STAT(iface, bytes.received));
@@ -2019,6 +2031,17 @@ static int cmd_net_capture_disable(const struct shell *sh, size_t argc,
 	return 0;
 }
 
+#if defined(CONFIG_NET_CONN_HASH)
+static void conn_lookup_stats_print(const struct shell *sh, const char *name,
+				    struct net_conn_lookup_stats *stats)
+{
+	uint32_t avg = stats->lookups ? stats->probes * 10U / stats->lookups : 0U;
+
+	PR("%-8s %10u %9u.%u %11u\n", name, stats->lookups, avg / 10U,
+	   avg % 10U, stats->max_probes);
+}
+#endif
+
 static int cmd_net_conn(const struct shell *sh, size_t argc, char *argv[])
 {
 	ARG_UNUSED(argc);
@@ -2090,6 +2113,20 @@ static int cmd_net_conn(const struct shell *sh, size_t argc, char *argv[])
 
 #endif
 
+#if defined(CONFIG_NET_CONN_HASH)
+	struct net_conn_lookup_stats stats;
+
+	PR("\nLookup      Lookups  Avg probes  Max probes\n");
+
+	net_conn_lookup_stats_get(&stats);
+	conn_lookup_stats_print(sh, "Handler", &stats);
+
+#if defined(CONFIG_NET_NATIVE_TCP)
+	net_tcp_lookup_stats_get(&stats);
+	conn_lookup_stats_print(sh, "TCP", &stats);
+#endif
+#endif /* CONFIG_NET_CONN_HASH */
+
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 	count = 0;
 
@@ -2298,6 +2335,54 @@ static int cmd_net_dns_query(const struct shell *sh, size_t argc,
 	return 0;
 }
 
+static int cmd_net_dns_cache(const struct shell *sh, size_t argc,
+			     char *argv[])
+{
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	struct dns_cache_stats stats;
+	uint32_t total;
+#endif
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	dns_cache_stats_get(&stats);
+	total = stats.hits + stats.misses;
+
+	PR("DNS cache entries : %u / %d\n", stats.entries,
+	   CONFIG_DNS_RESOLVER_CACHE_MAX_ENTRIES);
+	PR("Hits              : %u (%u negative)\n", stats.hits,
+	   stats.negative_hits);
+	PR("Misses            : %u\n", stats.misses);
+	PR("Hit rate          : %u%%\n",
+	   total ? (uint32_t)((uint64_t)stats.hits * 100U / total) : 0U);
+	PR("Evictions         : %u\n", stats.evictions);
+#else
+	PR_INFO("Set %s to enable %s support.\n", "CONFIG_DNS_RESOLVER_CACHE",
+		"DNS cache");
+#endif
+
+	return 0;
+}
+
+static int cmd_net_dns_cache_flush(const struct shell *sh, size_t argc,
+				   char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	dns_cache_flush();
+	PR("DNS cache flushed.\n");
+#else
+	PR_INFO("Set %s to enable %s support.\n", "CONFIG_DNS_RESOLVER_CACHE",
+		"DNS cache");
+#endif
+
+	return 0;
+}
+
 static int cmd_net_dns(const struct shell *sh, size_t argc, char *argv[])
 {
 #if defined(CONFIG_DNS_RESOLVER)
@@ -6252,7 +6337,16 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_capture,
 	SHELL_SUBCMD_SET_END
 );
 
+SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_dns_cache,
+	SHELL_CMD(flush, NULL, "Drop all the answers cached.",
+		  cmd_net_dns_cache_flush),
+	SHELL_SUBCMD_SET_END
+);
+
 SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_dns,
+	SHELL_CMD(cache, &net_cmd_dns_cache,
+		  "Show DNS cache statistics.",
+		  cmd_net_dns_cache),
 	SHELL_CMD(cancel, NULL, "Cancel all pending requests.",
 		  cmd_net_dns_cancel),
 	SHELL_CMD(query, NULL,
@@ -152,6 +152,11 @@ static inline void stats(struct net_if *iface)
 		NET_INFO("TCP conn drop  %d\tconnrst\t%d",
 			 GET_STAT(iface, tcp.conndrop),
 			 GET_STAT(iface, tcp.connrst));
+#if defined(CONFIG_NET_TCP_GRO)
+		NET_INFO("TCP GRO merged %d\tflushed\t%d",
+			 GET_STAT(iface, tcp.gro_merged),
+			 GET_STAT(iface, tcp.gro_flushed));
+#endif
 #endif
 
 		NET_INFO("Bytes received %u", GET_STAT(iface, bytes.received));
@@ -258,6 +258,21 @@ static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 {
 	UPDATE_STAT(iface, stats.tcp.rexmit++);
 }
+
+#if defined(CONFIG_NET_TCP_GRO)
+static inline void net_stats_update_tcp_gro_merged(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.tcp.gro_merged++);
+}
+
+static inline void net_stats_update_tcp_gro_flushed(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.tcp.gro_flushed++);
+}
+#else
+#define net_stats_update_tcp_gro_merged(iface)
+#define net_stats_update_tcp_gro_flushed(iface)
+#endif /* CONFIG_NET_TCP_GRO */
 #else
 #define net_stats_update_tcp_sent(iface, bytes)
 #define net_stats_update_tcp_resent(iface, bytes)
@@ -273,6 +288,8 @@ static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 #define net_stats_update_tcp_seg_ackerr(iface)
 #define net_stats_update_tcp_seg_rsterr(iface)
 #define net_stats_update_tcp_seg_rexmit(iface)
+#define net_stats_update_tcp_gro_merged(iface)
+#define net_stats_update_tcp_gro_flushed(iface)
 #endif /* CONFIG_NET_STATISTICS_TCP */
 
 static inline void net_stats_update_per_proto_recv(struct net_if *iface,
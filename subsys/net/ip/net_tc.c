@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "tcp_internal.h"
 
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
@@ -239,6 +240,8 @@ static void net_tc_rx_stats_priority_setup(struct net_if *iface,
 #if NET_TC_RX_COUNT > 0
 static void tc_rx_handler(struct k_fifo *fifo)
 {
+	int tc = ARRAY_INDEX(rx_classes,
+			     CONTAINER_OF(fifo, struct net_traffic_class, fifo));
 	struct net_pkt *pkt;
 
 	while (1) {
@@ -248,6 +251,11 @@ static void tc_rx_handler(struct k_fifo *fifo)
 		}
 
 		net_process_rx_packet(pkt);
+
+		/* End of the RX batch, pass on the coalesced TCP segments */
+		if (IS_ENABLED(CONFIG_NET_TCP_GRO) && k_fifo_is_empty(fifo)) {
+			net_tcp_gro_flush(tc);
+		}
 	}
 }
 #endif
@@ -25,6 +25,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include "net_stats.h"
 #include "net_private.h"
 #include "tcp_internal.h"
+#include <zephyr/sys/hash_map.h>
 
 #define ACK_TIMEOUT_MS CONFIG_NET_TCP_ACK_TIMEOUT
 #define ACK_TIMEOUT K_MSEC(ACK_TIMEOUT_MS)
@@ -66,6 +67,22 @@ static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MUTEX_DEFINE(tcp_lock);
 
+#ifdef CONFIG_NET_CONN_HASH
+/* Connections with both endpoints set, by a hash of the endpoints */
+SYS_HASHMAP_OA_LP_DEFINE_STATIC_ADVANCED(tcp_conns_hash, sys_hash32,
+					 net_conn_hash_alloc,
+					 SYS_HASHMAP_CONFIG(CONFIG_NET_MAX_CONTEXTS,
+						SYS_HASHMAP_DEFAULT_LOAD_FACTOR));
+
+static struct net_conn_lookup_stats tcp_lookup_stats;
+
+static void tcp_conn_hash_add(struct tcp *conn);
+static void tcp_conn_hash_del(struct tcp *conn);
+#else
+#define tcp_conn_hash_add(...)
+#define tcp_conn_hash_del(...)
+#endif
+
 K_MEM_SLAB_DEFINE_STATIC(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
@@ -466,6 +483,7 @@ static int tcp_conn_unref(struct tcp *conn)
 	(void)k_work_cancel_delayable(&conn->persist_timer);
 	(void)k_work_cancel_delayable(&conn->ack_timer);
 
+	tcp_conn_hash_del(conn);
 	sys_slist_find_and_remove(&tcp_conns, &conn->next);
 
 	memset(conn, 0, sizeof(*conn));
@@ -673,7 +691,7 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 }
 
 static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+			      struct net_pkt *pkt, ssize_t len, bool syn)
 {
 	uint8_t options_buf[40]; /* TCP header max options size is 40 */
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
@@ -683,8 +701,14 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* These are only negotiated in SYN segments, keep them when later
+	 * segments carry other options such as SACK blocks.
+	 */
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+		recv_options->sack_perm_found = false;
+	}
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -732,6 +756,22 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 			recv_options->window = opt;
 			recv_options->wnd_found = true;
+			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = syn;
+			break;
+		case NET_TCP_SACK_OPT:
+			if (opt_len < 2 + NET_TCP_SACK_BLOCK_SIZE ||
+			    ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
 			break;
 		default:
 			continue;
@@ -907,7 +947,7 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 }
 
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -921,11 +961,7 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + opts_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
 	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
@@ -1005,6 +1041,57 @@ static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 	return net_pkt_set_data(pkt, &mss_opt_access);
 }
 
+#ifdef CONFIG_NET_TCP_SACK
+/* Build the SACK option for an outgoing segment into opts and return its
+ * length. SYN segments advertise SACK-permitted, a SYN-ACK only if the
+ * peer did so. Pure ACKs report the out-of-order receive queue, if there
+ * is one; as that queue only holds contiguous data there is never more
+ * than one block.
+ */
+static size_t tcp_sack_opt_get(struct tcp *conn, uint8_t flags,
+			       struct net_pkt *data, uint8_t *opts)
+{
+	uint32_t start, end;
+
+	if (flags & SYN) {
+		if ((flags & ACK) && !conn->recv_options.sack_perm_found) {
+			return 0;
+		}
+
+		opts[0] = NET_TCP_NOP_OPT;
+		opts[1] = NET_TCP_NOP_OPT;
+		opts[2] = NET_TCP_SACK_PERM_OPT;
+		opts[3] = NET_TCP_SACK_PERM_SIZE;
+
+		return 4;
+	}
+
+	if (!conn->recv_options.sack_perm_found || data != NULL ||
+	    (flags & (ACK | RST)) != ACK ||
+	    !CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT ||
+	    net_pkt_is_empty(conn->queue_recv_data)) {
+		return 0;
+	}
+
+	start = tcp_get_seq(conn->queue_recv_data->buffer);
+	end = start + net_pkt_get_len(conn->queue_recv_data);
+	if (!net_tcp_seq_greater(start, conn->ack)) {
+		return 0;
+	}
+
+	opts[0] = NET_TCP_NOP_OPT;
+	opts[1] = NET_TCP_NOP_OPT;
+	opts[2] = NET_TCP_SACK_OPT;
+	opts[3] = 2 + NET_TCP_SACK_BLOCK_SIZE;
+	UNALIGNED_PUT(htonl(start), (uint32_t *)&opts[4]);
+	UNALIGNED_PUT(htonl(end), (uint32_t *)&opts[8]);
+
+	return 4 + NET_TCP_SACK_BLOCK_SIZE;
+}
+#else
+#define tcp_sack_opt_get(...) 0
+#endif /* CONFIG_NET_TCP_SACK */
+
 static bool is_destination_local(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
@@ -1032,13 +1119,20 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
 	size_t alloc_len = sizeof(struct tcphdr);
+	size_t opts_len = 0;
+	uint8_t sack_opt[4 + NET_TCP_SACK_BLOCK_SIZE];
+	size_t sack_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
 	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
+		opts_len += NET_TCP_MSS_SIZE;
 	}
 
+	sack_len = tcp_sack_opt_get(conn, flags, data, sack_opt);
+	opts_len += sack_len;
+	alloc_len += opts_len;
+
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1046,6 +1140,11 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	}
 
 	if (data) {
+		if (net_pkt_get_len(data) > conn_mss(conn)) {
+			/* Large send, cut into segments by net_if or L2 */
+			net_pkt_set_tso_mss(pkt, conn_mss(conn));
+		}
+
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
@@ -1057,7 +1156,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
@@ -1071,6 +1170,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+	if (sack_len > 0) {
+		ret = net_pkt_write(pkt, sack_opt, sack_len);
+		if (ret < 0) {
+			tcp_pkt_unref(pkt);
+			goto out;
+		}
+	}
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1137,6 +1244,160 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	return net_pkt_copy(to, from, len);
 }
 
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+static const struct tcp_ca_ops *tcp_ca_default;
+
+static const struct tcp_ca_ops *tcp_ca_find(const char *name, size_t len)
+{
+	STRUCT_SECTION_FOREACH(tcp_ca_ops, ops) {
+		if (strlen(ops->name) == len &&
+		    strncmp(ops->name, name, len) == 0) {
+			return ops;
+		}
+	}
+
+	return NULL;
+}
+
+static void tcp_ca_init(struct tcp *conn)
+{
+	uint16_t mss = conn_mss(conn);
+
+	/* Initial window, RFC 5681 chapter 3.1 */
+	if (mss > 2190) {
+		conn->ca.cwnd = 2 * mss;
+	} else if (mss > 1095) {
+		conn->ca.cwnd = 3 * mss;
+	} else {
+		conn->ca.cwnd = 4 * mss;
+	}
+
+	conn->ca.ssthresh = conn->send_win_max;
+	conn->ca.in_recovery = false;
+
+	conn->ca.ops->init(conn);
+}
+
+/* Three duplicate ACKs seen, enter fast recovery (RFC 6582) */
+static void tcp_ca_fast_retransmit(struct tcp *conn)
+{
+	conn->ca.ssthresh = conn->ca.ops->ssthresh(conn);
+	conn->ca.cwnd = MIN(conn->ca.ssthresh + 3 * conn_mss(conn),
+			    conn->send_win_max);
+	conn->ca.recover = conn->seq + conn->unacked_len;
+	conn->ca.in_recovery = true;
+}
+
+/* Every additional duplicate ACK in fast recovery means a segment has
+ * left the network, so inflate the window to let new data out.
+ */
+static void tcp_ca_dup_ack(struct tcp *conn)
+{
+	if (conn->ca.in_recovery) {
+		conn->ca.cwnd = MIN(conn->ca.cwnd + conn_mss(conn),
+				    conn->send_win_max);
+	}
+}
+
+static void tcp_ca_timeout(struct tcp *conn)
+{
+	conn->ca.ssthresh = conn->ca.ops->ssthresh(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	conn->ca.in_recovery = false;
+}
+
+/* Called once conn->seq has been advanced past acked_len newly acked
+ * bytes. Returns true on a partial acknowledgment during fast recovery,
+ * in which case the first unacknowledged segment has to be resent.
+ */
+static bool tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	uint16_t mss = conn_mss(conn);
+
+	if (conn->ca.in_recovery) {
+		if (net_tcp_seq_cmp(conn->seq, conn->ca.recover) >= 0) {
+			/* Full acknowledgment, deflate the window */
+			conn->ca.cwnd = conn->ca.ssthresh;
+			conn->ca.in_recovery = false;
+
+			return false;
+		}
+
+		/* Partial acknowledgment, deflate by the amount acked */
+		conn->ca.cwnd -= MIN(acked_len, conn->ca.cwnd - mss);
+		if (acked_len >= mss) {
+			conn->ca.cwnd += mss;
+		}
+
+		return true;
+	}
+
+	if (conn->ca.cwnd < conn->ca.ssthresh) {
+		/* Slow start */
+		conn->ca.cwnd += MIN(acked_len, mss);
+	} else {
+		conn->ca.ops->cong_avoid(conn, acked_len);
+	}
+
+	conn->ca.cwnd = MIN(conn->ca.cwnd, conn->send_win_max);
+
+	return false;
+}
+
+static bool tcp_ca_in_recovery(struct tcp *conn)
+{
+	return conn->ca.in_recovery;
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	const struct tcp_ca_ops *ops;
+
+	ops = tcp_ca_find(value, strnlen(value, len));
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	/* Keep cwnd and ssthresh, only the algorithm state is reset */
+	conn->ca.ops = ops;
+	ops->init(conn);
+
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	size_t name_len = strlen(conn->ca.ops->name);
+
+	if (*len < name_len + 1) {
+		return -EINVAL;
+	}
+
+	memcpy(value, conn->ca.ops->name, name_len + 1);
+	*len = name_len + 1;
+
+	return 0;
+}
+
+/* Usable send window: the peer's receive window limited by cwnd */
+static uint16_t tcp_send_window(struct tcp *conn)
+{
+	return MIN(conn->send_win, conn->ca.cwnd);
+}
+#else
+#define tcp_ca_init(...)
+#define tcp_ca_fast_retransmit(...)
+#define tcp_ca_dup_ack(...)
+#define tcp_ca_timeout(...)
+#define tcp_ca_pkts_acked(...) false
+#define tcp_ca_in_recovery(...) false
+
+static uint16_t tcp_send_window(struct tcp *conn)
+{
+	return conn->send_win;
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_AVOIDANCE */
+
 static bool tcp_window_full(struct tcp *conn)
 {
 	bool window_full = (conn->send_data_total >= conn->send_win);
@@ -1158,10 +1419,11 @@ static int tcp_unsent_len(struct tcp *conn)
 	}
 
 	unsent_len = conn->send_data_total - conn->unacked_len;
-	if (conn->unacked_len >= conn->send_win) {
+	if (conn->unacked_len >= tcp_send_window(conn)) {
 		unsent_len = 0;
 	} else {
-		unsent_len = MIN(unsent_len, conn->send_win - conn->unacked_len);
+		unsent_len = MIN(unsent_len,
+				 tcp_send_window(conn) - conn->unacked_len);
 	}
  out:
 	NET_DBG("unsent_len=%d", unsent_len);
@@ -1169,40 +1431,43 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* Send len bytes of the send_data queue, starting at offset, in a single
+ * segment.
+ */
+static int tcp_send_segment(struct tcp *conn, int offset, int len,
+			    bool resend)
 {
-	int ret = 0;
-	int len;
 	struct net_pkt *pkt;
+	int ret;
 
-	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
-	if (len == 0) {
-		NET_DBG("conn: %p no data to send", conn);
-		ret = -ENODATA;
-		goto out;
+	if (IS_ENABLED(CONFIG_NET_TCP_TSO) && len > conn_mss(conn)) {
+		/* The data of a large send packet is not bound by the
+		 * interface MTU.
+		 */
+		pkt = tcp_pkt_alloc(conn, 0);
+		if (pkt && net_pkt_alloc_buffer(pkt, len, 0,
+						TCP_PKT_ALLOC_TIMEOUT) < 0) {
+			tcp_pkt_unref(pkt);
+			pkt = NULL;
+		}
+	} else {
+		pkt = tcp_pkt_alloc(conn, len);
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
+	ret = tcp_pkt_peek(pkt, conn->send_data, offset, len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + offset);
 	if (ret == 0) {
-		conn->unacked_len += len;
-
-		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+		if (resend) {
 			net_stats_update_tcp_resent(conn->iface, len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
@@ -1217,12 +1482,290 @@ static int tcp_send_data(struct tcp *conn)
 	 */
 	tcp_pkt_unref(pkt);
 
+	return ret;
+}
+
+#ifdef CONFIG_NET_TCP_TSO
+/* Largest amount of data to send in one packet. Data to a local address
+ * does not pass a network interface and is never sent as a large send
+ * packet.
+ */
+static int tcp_send_max_len(struct tcp *conn)
+{
+	int mss = conn_mss(conn);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && conn->dst.sa.sa_family == AF_INET &&
+	    (net_ipv4_is_addr_loopback(&conn->dst.sin.sin_addr) ||
+	     net_ipv4_is_my_addr(&conn->dst.sin.sin_addr))) {
+		return mss;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && conn->dst.sa.sa_family == AF_INET6 &&
+	    (net_ipv6_is_addr_loopback(&conn->dst.sin6.sin6_addr) ||
+	     net_ipv6_is_my_addr(&conn->dst.sin6.sin6_addr))) {
+		return mss;
+	}
+
+	return MAX(mss, ROUND_DOWN(CONFIG_NET_TCP_TSO_MAX_SIZE, mss));
+}
+#else
+#define tcp_send_max_len(conn) conn_mss(conn)
+#endif /* CONFIG_NET_TCP_TSO */
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret = 0;
+	int len;
+
+	len = MIN3(conn->send_data_total - conn->unacked_len,
+		   tcp_send_window(conn) - conn->unacked_len,
+		   tcp_send_max_len(conn));
+	if (len == 0) {
+		NET_DBG("conn: %p no data to send", conn);
+		ret = -ENODATA;
+		goto out;
+	}
+
+	ret = tcp_send_segment(conn, conn->unacked_len, len,
+			       conn->data_mode == TCP_DATA_MODE_RESEND);
+	if (ret == -ENOBUFS && len > conn_mss(conn)) {
+		/* Not enough buffers for a large send, fall back to MSS */
+		len = conn_mss(conn);
+		ret = tcp_send_segment(conn, conn->unacked_len, len,
+				       conn->data_mode == TCP_DATA_MODE_RESEND);
+	}
+
+	if (ret == -ENOBUFS) {
+		goto out;
+	}
+
+	if (ret == 0) {
+		conn->unacked_len += len;
+	}
+
 	conn_send_data_dump(conn);
 
  out:
 	return ret;
 }
 
+#ifdef CONFIG_NET_TCP_SACK
+/* Add the range [start, end) reported by the peer to the scoreboard,
+ * merging it with the blocks it overlaps or touches.
+ */
+static void tcp_sack_add(struct tcp *conn, uint32_t start, uint32_t end,
+			 uint32_t ack)
+{
+	struct tcp_sack_block *sb = conn->sacked;
+	uint32_t snd_nxt = conn->seq + conn->unacked_len;
+	int i;
+
+	/* Ignore D-SACK and blocks outside of the data in flight */
+	if (!net_tcp_seq_greater(end, start) ||
+	    !net_tcp_seq_greater(start, ack) ||
+	    net_tcp_seq_greater(end, snd_nxt)) {
+		return;
+	}
+
+	for (i = 0; i < conn->sacked_cnt; ) {
+		if (net_tcp_seq_cmp(sb[i].start, end) > 0 ||
+		    net_tcp_seq_cmp(start, sb[i].end) > 0) {
+			i++;
+			continue;
+		}
+
+		if (net_tcp_seq_greater(start, sb[i].start)) {
+			start = sb[i].start;
+		}
+
+		if (net_tcp_seq_greater(sb[i].end, end)) {
+			end = sb[i].end;
+		}
+
+		conn->sacked_cnt--;
+		memmove(&sb[i], &sb[i + 1],
+			(conn->sacked_cnt - i) * sizeof(*sb));
+	}
+
+	for (i = 0; i < conn->sacked_cnt; i++) {
+		if (net_tcp_seq_greater(sb[i].start, start)) {
+			break;
+		}
+	}
+
+	/* When the scoreboard is full the highest blocks are forgotten, the
+	 * holes below them matter the most.
+	 */
+	if (i == NET_TCP_SACK_MAX_BLOCKS) {
+		return;
+	}
+
+	if (conn->sacked_cnt == NET_TCP_SACK_MAX_BLOCKS) {
+		conn->sacked_cnt--;
+	}
+
+	memmove(&sb[i + 1], &sb[i], (conn->sacked_cnt - i) * sizeof(*sb));
+	sb[i].start = start;
+	sb[i].end = end;
+	conn->sacked_cnt++;
+}
+
+/* Update the scoreboard from an incoming ACK: forget what the cumulative
+ * ack covers and merge in the SACK blocks it carries.
+ */
+static void tcp_sack_update(struct tcp *conn, struct net_pkt *pkt,
+			    size_t opts_len, uint32_t ack)
+{
+	uint8_t options_buf[40]; /* TCP header max options size is 40 */
+	uint8_t *options;
+	uint8_t opt_len;
+	size_t i, j;
+	int n = 0;
+
+	if (!conn->recv_options.sack_perm_found) {
+		return;
+	}
+
+	for (i = 0; i < conn->sacked_cnt; i++) {
+		if (!net_tcp_seq_greater(conn->sacked[i].end, ack)) {
+			continue;
+		}
+
+		conn->sacked[n] = conn->sacked[i];
+		if (net_tcp_seq_greater(ack, conn->sacked[n].start)) {
+			conn->sacked[n].start = ack;
+		}
+
+		n++;
+	}
+
+	conn->sacked_cnt = n;
+
+	if (opts_len == 0) {
+		return;
+	}
+
+	options = tcp_options_get(pkt, opts_len, options_buf,
+				  sizeof(options_buf));
+	if (!options) {
+		return;
+	}
+
+	/* The option list was validated by tcp_options_check() */
+	for (i = 0; i + 1 < opts_len; i += opt_len) {
+		if (options[i] == NET_TCP_END_OPT) {
+			break;
+		} else if (options[i] == NET_TCP_NOP_OPT) {
+			opt_len = 1;
+			continue;
+		}
+
+		opt_len = options[i + 1];
+		if (opt_len < 2) {
+			break;
+		}
+
+		if (options[i] != NET_TCP_SACK_OPT) {
+			continue;
+		}
+
+		for (j = i + 2; j + NET_TCP_SACK_BLOCK_SIZE <= i + opt_len;
+		     j += NET_TCP_SACK_BLOCK_SIZE) {
+			tcp_sack_add(conn,
+				     ntohl(UNALIGNED_GET((uint32_t *)&options[j])),
+				     ntohl(UNALIGNED_GET((uint32_t *)&options[j + 4])),
+				     ack);
+		}
+	}
+}
+
+/* The retransmission timer expired, the receiver may have reneged on the
+ * data it SACKed so forget the scoreboard (RFC 2018 chapter 8).
+ */
+static void tcp_sack_clear(struct tcp *conn)
+{
+	conn->sacked_cnt = 0;
+	conn->sack_rexmit = conn->seq;
+}
+
+/* Fast recovery starts, consider all the holes again */
+static void tcp_sack_recovery_start(struct tcp *conn)
+{
+	conn->sack_rexmit = conn->seq;
+}
+
+/* Resend up to one MSS of the first hole below the highest SACKed
+ * sequence that has not been resent in this recovery yet. Returns
+ * -ENODATA if there is no such hole.
+ */
+static int tcp_sack_retransmit(struct tcp *conn)
+{
+	uint32_t seq = conn->sack_rexmit;
+	int offset, len, ret;
+	int i;
+
+	if (net_tcp_seq_greater(conn->seq, seq)) {
+		seq = conn->seq;
+	}
+
+	for (i = 0; i < conn->sacked_cnt; i++) {
+		if (net_tcp_seq_cmp(seq, conn->sacked[i].start) < 0) {
+			break;
+		}
+
+		if (net_tcp_seq_cmp(seq, conn->sacked[i].end) < 0) {
+			seq = conn->sacked[i].end;
+		}
+	}
+
+	if (i == conn->sacked_cnt) {
+		return -ENODATA;
+	}
+
+	offset = seq - conn->seq;
+	len = MIN(conn->sacked[i].start - seq, conn_mss(conn));
+	if (offset + len > conn->unacked_len) {
+		return -ENODATA;
+	}
+
+	NET_DBG("conn: %p resending hole seq %u len %d", conn, seq, len);
+
+	ret = tcp_send_segment(conn, offset, len, true);
+	if (ret == 0) {
+		conn->sack_rexmit = seq + len;
+	}
+
+	return ret;
+}
+#else
+#define tcp_sack_update(...)
+#define tcp_sack_clear(...)
+#define tcp_sack_recovery_start(...)
+#define tcp_sack_retransmit(...) -ENODATA
+#endif /* CONFIG_NET_TCP_SACK */
+
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+/* Resend the first unacknowledged segment. Only a single segment is sent,
+ * also when large sends are enabled (RFC 5681, chapter 3.2).
+ */
+static void tcp_fast_retransmit(struct tcp *conn)
+{
+	int len;
+
+	/* With SACK information only the missing data is resent */
+	if (tcp_sack_retransmit(conn) != -ENODATA) {
+		return;
+	}
+
+	len = MIN(conn->unacked_len, conn_mss(conn));
+	if (len <= 0) {
+		return;
+	}
+
+	(void)tcp_send_segment(conn, 0, len, true);
+}
+#endif
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1306,6 +1849,11 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+	if (conn->data_mode == TCP_DATA_MODE_SEND) {
+		tcp_ca_timeout(conn);
+		tcp_sack_clear(conn);
+	}
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -1485,6 +2033,9 @@ static struct tcp *tcp_conn_alloc(void)
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	conn->dup_ack_cnt = 0;
 #endif
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	conn->ca.ops = tcp_ca_default;
+#endif
 
 	/* The ISN value will be set when we get the connection attempt or
 	 * when trying to create a connection.
@@ -1541,6 +2092,124 @@ out:
 	return ret;
 }
 
+#ifdef CONFIG_NET_CONN_HASH
+static uint64_t tcp_conn_hash_key(union tcp_endpoint *src,
+				  union tcp_endpoint *dst)
+{
+	uint8_t buf[2 * sizeof(union tcp_endpoint)];
+	size_t len = tcp_endpoint_len(src->sa.sa_family);
+
+	memcpy(buf, src, len);
+	memcpy(buf + len, dst, len);
+
+	return sys_hash32(buf, 2 * len);
+}
+
+/* Called with tcp_lock held */
+static void tcp_conn_hash_del(struct tcp *conn)
+{
+	struct tcp *head, **prev;
+	uint64_t value;
+
+	if (!conn->hashed ||
+	    !sys_hashmap_get(&tcp_conns_hash, conn->hash_key, &value)) {
+		return;
+	}
+
+	head = (struct tcp *)(uintptr_t)value;
+
+	for (prev = &head; *prev != NULL; prev = &(*prev)->hash_next) {
+		if (*prev == conn) {
+			*prev = conn->hash_next;
+			break;
+		}
+	}
+
+	if (head == NULL) {
+		(void)sys_hashmap_remove(&tcp_conns_hash, conn->hash_key, NULL);
+	} else {
+		(void)sys_hashmap_insert(&tcp_conns_hash, conn->hash_key,
+					 (uintptr_t)head, NULL);
+	}
+
+	conn->hashed = false;
+}
+
+/* Index the connection once both of its endpoints are known */
+static void tcp_conn_hash_add(struct tcp *conn)
+{
+	struct tcp *head = NULL;
+	uint64_t value;
+	int ret;
+
+	k_mutex_lock(&tcp_lock, K_FOREVER);
+
+	tcp_conn_hash_del(conn);
+
+	conn->hash_key = tcp_conn_hash_key(&conn->src, &conn->dst);
+
+	if (sys_hashmap_get(&tcp_conns_hash, conn->hash_key, &value)) {
+		head = (struct tcp *)(uintptr_t)value;
+	}
+
+	ret = sys_hashmap_insert(&tcp_conns_hash, conn->hash_key,
+				 (uintptr_t)conn, NULL);
+	if (ret < 0) {
+		NET_ERR("conn: %p cannot be indexed (%d)", conn, ret);
+	} else {
+		conn->hash_next = head;
+		conn->hashed = true;
+	}
+
+	k_mutex_unlock(&tcp_lock);
+}
+
+static struct tcp *tcp_conn_search(struct net_pkt *pkt)
+{
+	union tcp_endpoint src, dst;
+	struct tcp *conn = NULL;
+	uint32_t probes = 0U;
+	uint64_t value;
+
+	if (tcp_endpoint_set(&src, pkt, TCP_EP_DST) < 0 ||
+	    tcp_endpoint_set(&dst, pkt, TCP_EP_SRC) < 0) {
+		return NULL;
+	}
+
+	k_mutex_lock(&tcp_lock, K_FOREVER);
+
+	if (sys_hashmap_get(&tcp_conns_hash, tcp_conn_hash_key(&src, &dst),
+			    &value)) {
+		conn = (struct tcp *)(uintptr_t)value;
+	}
+
+	for ( ; conn != NULL; conn = conn->hash_next) {
+		size_t len = tcp_endpoint_len(src.sa.sa_family);
+
+		probes++;
+
+		if (!memcmp(&conn->src, &src, len) &&
+		    !memcmp(&conn->dst, &dst, len)) {
+			break;
+		}
+	}
+
+	net_conn_lookup_stats_update(&tcp_lookup_stats, probes);
+
+	k_mutex_unlock(&tcp_lock);
+
+	return conn;
+}
+
+void net_tcp_lookup_stats_get(struct net_conn_lookup_stats *stats)
+{
+	k_mutex_lock(&tcp_lock, K_FOREVER);
+	*stats = tcp_lookup_stats;
+	k_mutex_unlock(&tcp_lock);
+}
+
+#else /* CONFIG_NET_CONN_HASH */
+
 static bool tcp_endpoint_cmp(union tcp_endpoint *ep, struct net_pkt *pkt,
 			     enum pkt_addr which)
 {
@@ -1574,6 +2243,7 @@ static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 
 	return found ? conn : NULL;
 }
+#endif /* CONFIG_NET_CONN_HASH */
 
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
 
@@ -1757,6 +2427,8 @@ static struct tcp *tcp_conn_new(struct net_pkt *pkt)
 		net_sprint_addr(conn->dst.sa.sa_family,
 				(const void *)&conn->dst.sin.sin_addr));
 
+	tcp_conn_hash_add(conn);
+
 	memcpy(&context->remote, &conn->dst, sizeof(context->remote));
 	context->flags |= NET_CONTEXT_REMOTE_ADDR_SET;
 
@@ -2122,8 +2794,9 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto next_state;
 	}
 
-	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+	if (tcp_options_len &&
+	    !tcp_options_check(&conn->recv_options, pkt, tcp_options_len,
+			       th_flags(th) & SYN)) {
 		NET_DBG("DROP: Invalid TCP option list");
 		tcp_out(conn, RST);
 		do_close = true;
@@ -2208,6 +2881,7 @@ next_state:
 			tcp_send_timer_cancel(conn);
 			next = TCP_ESTABLISHED;
 			tcp_conn_ref(conn);
+			tcp_ca_init(conn);
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
 
@@ -2261,6 +2935,7 @@ next_state:
 
 			next = TCP_ESTABLISHED;
 			tcp_conn_ref(conn);
+			tcp_ca_init(conn);
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
 			tcp_out(conn, ACK);
@@ -2312,6 +2987,10 @@ next_state:
 			break;
 		}
 
+		if (th) {
+			tcp_sack_update(conn, pkt, tcp_options_len, th_ack(th));
+		}
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -2323,6 +3002,7 @@ next_state:
 					 */
 					conn->dup_ack_cnt = MIN(conn->dup_ack_cnt + 1,
 						DUPLICATE_ACK_RETRANSMIT_TRHESHOLD + 1);
+					tcp_ca_dup_ack(conn);
 				}
 			} else {
 				conn->dup_ack_cnt = 0;
@@ -2330,16 +3010,19 @@ next_state:
 
 			/* Only do fast retransmit when not already in a resend state */
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
+			    !tcp_ca_in_recovery(conn) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
 				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
-
-				conn->unacked_len = 0;
-
-				(void)tcp_send_data(conn);
-
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+				tcp_ca_fast_retransmit(conn);
+				tcp_sack_recovery_start(conn);
+				tcp_fast_retransmit(conn);
+			} else if (tcp_ca_in_recovery(conn)) {
+				/* Repair the next SACK hole, otherwise send new
+				 * data the inflated window allows.
+				 */
+				if (tcp_sack_retransmit(conn) == -ENODATA) {
+					(void)tcp_send_queued_data(conn);
+				}
 			}
 		}
 #endif
@@ -2381,6 +3064,12 @@ next_state:
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+			if (tcp_ca_pkts_acked(conn, len_acked)) {
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+				tcp_fast_retransmit(conn);
+#endif
+			}
+
 			conn_send_data_dump(conn);
 
 			if (!k_work_delayable_remaining_get(
@@ -2975,6 +3664,8 @@ int net_tcp_connect(struct net_context *context,
 		net_sprint_addr(conn->dst.sa.sa_family,
 				(const void *)&conn->dst.sin.sin_addr));
 
+	tcp_conn_hash_add(conn);
+
 	net_context_set_state(context, NET_CONTEXT_CONNECTING);
 
 	ret = net_conn_register(net_context_get_proto(context),
@@ -3130,7 +3821,9 @@ int net_tcp_finalize(struct net_pkt *pkt)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+	/* Segments of a large send packet are checksummed when it is cut */
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) &&
+	    net_pkt_tso_mss(pkt) == 0U) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 	}
 
@@ -3496,6 +4189,13 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_NODELAY:
 		ret = set_tcp_nodelay(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+		ret = set_tcp_congestion(conn, value, len);
+#else
+		ret = -ENOPROTOOPT;
+#endif
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -3521,6 +4221,13 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_NODELAY:
 		ret = get_tcp_nodelay(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+		ret = get_tcp_congestion(conn, value, len);
+#else
+		ret = -ENOPROTOOPT;
+#endif
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -3588,6 +4295,13 @@ void net_tcp_init(void)
 		tcp_fin_timeout_ms += tcp_fin_timeout_ms >> 1;
 	}
 
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	tcp_ca_default = tcp_ca_find(CONFIG_NET_TCP_CONGESTION_DEFAULT,
+				     strlen(CONFIG_NET_TCP_CONGESTION_DEFAULT));
+	NET_ASSERT(tcp_ca_default != NULL, "Unknown TCP congestion algorithm %s",
+		   CONFIG_NET_TCP_CONGESTION_DEFAULT);
+#endif
+
 	k_thread_name_set(&tcp_work_q.thread, "tcp_work");
 	NET_DBG("Workq started. Thread ID: %p", &tcp_work_q.thread);
 }
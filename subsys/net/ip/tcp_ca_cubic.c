@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion control, RFC 8312. Only the window growth above
+ * ssthresh and the multiplicative decrease differ from NewReno, slow
+ * start and fast recovery are handled by the generic layer in tcp.c.
+ *
+ * Windows are kept in bytes and time in milliseconds. Without an RTT
+ * estimate the Reno friendly region is tracked by counting acked
+ * bytes, the same way Reno grows its window.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+
+#include "tcp_internal.h"
+
+/* beta_cubic = 0.7 and C = 0.4, both scaled by 10 */
+#define CUBIC_BETA 7U
+#define CUBIC_C 4U
+
+/* Bound |t - K| so that the cubic term cannot overflow */
+#define CUBIC_MAX_DELTA_MS 30000
+
+static uint32_t cubic_root(uint64_t a)
+{
+	uint64_t x = 0U;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		uint64_t b;
+
+		x <<= 1;
+		b = 3U * x * (x + 1U) + 1U;
+		if ((a >> s) >= b) {
+			a -= b << s;
+			x++;
+		}
+	}
+
+	return (uint32_t)x;
+}
+
+static void cubic_init(struct tcp *conn)
+{
+	memset(&conn->ca.cubic, 0, sizeof(conn->ca.cubic));
+}
+
+static uint32_t cubic_ssthresh(struct tcp *conn)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t cwnd = conn->ca.cwnd;
+
+	cubic->epoch_start = 0U;
+
+	/* Fast convergence, release bandwidth to newer flows faster */
+	if (cwnd < cubic->w_last_max) {
+		cubic->w_last_max = cwnd;
+		cubic->w_max = cwnd * (10U + CUBIC_BETA) / 20U;
+	} else {
+		cubic->w_last_max = cwnd;
+		cubic->w_max = cwnd;
+	}
+
+	return MAX(cwnd * CUBIC_BETA / 10U, 2U * conn_mss(conn));
+}
+
+static void cubic_cong_avoid(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint16_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t now = k_uptime_get_32();
+	int64_t delta;
+	int64_t target;
+	uint32_t inc;
+
+	if (cubic->epoch_start == 0U) {
+		cubic->epoch_start = MAX(now, 1U);
+		cubic->w_est = cwnd;
+
+		if (cwnd < cubic->w_max) {
+			/* K = cbrt((W_max - cwnd) / C), in segments and
+			 * seconds, RFC 8312 equation (2)
+			 */
+			cubic->k = cubic_root((uint64_t)(cubic->w_max - cwnd) *
+					      10U * NSEC_PER_SEC /
+					      (CUBIC_C * mss));
+			cubic->w_origin = cubic->w_max;
+		} else {
+			cubic->k = 0U;
+			cubic->w_origin = cwnd;
+		}
+	}
+
+	/* W_cubic(t) = C * (t - K)^3 + W_max, RFC 8312 equation (1) */
+	delta = (int64_t)(now - cubic->epoch_start) - cubic->k;
+	delta = CLAMP(delta, -CUBIC_MAX_DELTA_MS, CUBIC_MAX_DELTA_MS);
+	target = (int64_t)cubic->w_origin +
+		 (int64_t)CUBIC_C * delta * delta * delta / 10 * mss /
+		 (int64_t)NSEC_PER_SEC;
+
+	/* Reno friendly window, grows by 3 * (1 - beta) / (1 + beta)
+	 * segments per window of acked data, RFC 8312 equation (4)
+	 */
+	cubic->w_est += MAX(1U, (uint32_t)((uint64_t)3U * (10U - CUBIC_BETA) *
+					   mss * acked_len /
+					   ((10U + CUBIC_BETA) * cubic->w_est)));
+
+	if (target > cwnd) {
+		/* Reach the target within about one round-trip time, but
+		 * grow no faster than 1.5 times per round-trip time.
+		 */
+		inc = (uint32_t)MIN((uint64_t)(target - cwnd) * acked_len / cwnd,
+				    acked_len / 2U);
+	} else {
+		/* Plateau around W_max, grow very slowly */
+		inc = (uint32_t)mss * acked_len / (100U * cwnd);
+	}
+
+	conn->ca.cwnd = MAX(cwnd + MAX(inc, 1U), cubic->w_est);
+}
+
+TCP_CA_DEFINE(cubic, cubic_init, cubic_ssthresh, cubic_cong_avoid);
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* NewReno congestion control, RFC 5681 and RFC 6582. Slow start and
+ * fast recovery are handled by the generic layer in tcp.c.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+
+#include "tcp_internal.h"
+
+static void newreno_init(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+static uint32_t newreno_ssthresh(struct tcp *conn)
+{
+	/* Half of the data in flight, RFC 5681 equation (4) */
+	return MAX((uint32_t)conn->unacked_len / 2U, 2U * conn_mss(conn));
+}
+
+static void newreno_cong_avoid(struct tcp *conn, uint32_t acked_len)
+{
+	uint16_t mss = conn_mss(conn);
+
+	ARG_UNUSED(acked_len);
+
+	/* About one MSS per round-trip time, RFC 5681 equation (3) */
+	conn->ca.cwnd += MAX(1U, (uint32_t)mss * mss / conn->ca.cwnd);
+}
+
+TCP_CA_DEFINE(newreno, newreno_init, newreno_ssthresh, newreno_cong_avoid);
@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Software generic receive offload (GRO) for TCP.
+ *
+ * While more packets are waiting in the RX queue, in-order data segments
+ * of a connection are appended to the first pending segment of that
+ * connection instead of being passed to TCP one at a time. The pending
+ * packets are passed on when the RX queue runs empty, when a segment of
+ * the connection cannot be merged, or when a packet is full.
+ *
+ * Only segments with plain ACK (and PSH) flags, no IP options or
+ * extension headers, and the same TCP options as the pending segment
+ * are merged. The checksums have been verified before a segment gets
+ * here. The IPv4 header checksum of a coalesced packet is computed
+ * again for its new length, the TCP checksum is not updated.
+ *
+ * Each RX traffic class has its own flows, so that the RX queue threads
+ * only contend with each other on the pending packets of their own queue.
+ * Whoever passes packets to IP outside of the RX queue threads, as the
+ * loopback path does, flushes the pending packets of the traffic class of
+ * the packets when done.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_tcp_gro, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_if.h>
+
+#include "net_private.h"
+#include "connection.h"
+#include "net_stats.h"
+#include "tcp_internal.h"
+
+struct tcp_gro_flow {
+	/* Coalesced packet, NULL if the slot is unused */
+	struct net_pkt *pkt;
+	/* Sequence number the next merged segment must start with */
+	uint32_t next_seq;
+	/* Length of the IP and TCP headers of pkt */
+	uint16_t hdr_len;
+	/* Number of segments in pkt */
+	uint8_t segs;
+};
+
+struct tcp_gro_queue {
+	struct k_mutex lock;
+	struct tcp_gro_flow flows[CONFIG_NET_TCP_GRO_MAX_FLOWS];
+	/* Slot flushed next when all are used */
+	uint8_t evict;
+};
+
+#define GRO_QUEUE_INITIALIZER(i, _) \
+	{ .lock = Z_MUTEX_INITIALIZER(gro_queues[i].lock) }
+
+static struct tcp_gro_queue gro_queues[NET_TC_RX_COUNT] = {
+	LISTIFY(NET_TC_RX_COUNT, GRO_QUEUE_INITIALIZER, (,))
+};
+
+static inline size_t gro_ip_len(struct net_pkt *pkt)
+{
+	return net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+}
+
+static inline struct net_tcp_hdr *gro_tcp_hdr(struct net_pkt *pkt)
+{
+	return (struct net_tcp_hdr *)(pkt->frags->data + gro_ip_len(pkt));
+}
+
+static inline size_t gro_hdr_len(struct net_pkt *pkt)
+{
+	return gro_ip_len(pkt) + (gro_tcp_hdr(pkt)->offset >> 4) * 4U;
+}
+
+static bool gro_same_flow(struct net_pkt *a, struct net_pkt *b)
+{
+	struct net_tcp_hdr *tha = gro_tcp_hdr(a);
+	struct net_tcp_hdr *thb = gro_tcp_hdr(b);
+
+	if (net_pkt_iface(a) != net_pkt_iface(b) ||
+	    net_pkt_family(a) != net_pkt_family(b) ||
+	    tha->src_port != thb->src_port ||
+	    tha->dst_port != thb->dst_port) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(a) == AF_INET) {
+		return !memcmp(NET_IPV4_HDR(a)->src, NET_IPV4_HDR(b)->src,
+			       sizeof(struct in_addr)) &&
+		       !memcmp(NET_IPV4_HDR(a)->dst, NET_IPV4_HDR(b)->dst,
+			       sizeof(struct in_addr));
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(a) == AF_INET6) {
+		return !memcmp(NET_IPV6_HDR(a)->src, NET_IPV6_HDR(b)->src,
+			       sizeof(struct in6_addr)) &&
+		       !memcmp(NET_IPV6_HDR(a)->dst, NET_IPV6_HDR(b)->dst,
+			       sizeof(struct in6_addr));
+	}
+
+	return false;
+}
+
+static struct tcp_gro_flow *gro_flow_find(struct tcp_gro_queue *queue,
+					   struct net_pkt *pkt)
+{
+	for (int i = 0; i < ARRAY_SIZE(queue->flows); i++) {
+		if (queue->flows[i].pkt != NULL &&
+		    gro_same_flow(queue->flows[i].pkt, pkt)) {
+			return &queue->flows[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Can the segment be held or appended to a pending one at all */
+static bool gro_pkt_mergeable(struct net_pkt *pkt)
+{
+	struct net_tcp_hdr *th = gro_tcp_hdr(pkt);
+	size_t hdr_len;
+
+	if (net_pkt_ip_opts_len(pkt) != 0U ||
+	    (th->flags & ~PSH) != ACK) {
+		return false;
+	}
+
+	hdr_len = gro_hdr_len(pkt);
+
+	return pkt->frags->len >= hdr_len && net_pkt_get_len(pkt) > hdr_len;
+}
+
+/* Update the IP payload length of a coalesced packet */
+static bool gro_ip_len_add(struct net_pkt *pkt, size_t len)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		struct net_ipv4_hdr *hdr = NET_IPV4_HDR(pkt);
+
+		if (ntohs(hdr->len) + len > UINT16_MAX) {
+			return false;
+		}
+
+		hdr->len = htons(ntohs(hdr->len) + len);
+		return true;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		struct net_ipv6_hdr *hdr = NET_IPV6_HDR(pkt);
+
+		if (ntohs(hdr->len) + len > UINT16_MAX) {
+			return false;
+		}
+
+		hdr->len = htons(ntohs(hdr->len) + len);
+		return true;
+	}
+
+	return false;
+}
+
+static bool gro_flow_append(struct tcp_gro_flow *flow, struct net_pkt *pkt)
+{
+	struct net_tcp_hdr *head = gro_tcp_hdr(flow->pkt);
+	struct net_tcp_hdr *th = gro_tcp_hdr(pkt);
+	size_t hdr_len = gro_hdr_len(pkt);
+	size_t len = net_pkt_get_len(pkt) - hdr_len;
+	struct net_buf *buf;
+
+	if (flow->segs >= CONFIG_NET_TCP_GRO_MAX_SEGS ||
+	    hdr_len != flow->hdr_len ||
+	    sys_get_be32(th->seq) != flow->next_seq ||
+	    (int32_t)(sys_get_be32(th->ack) - sys_get_be32(head->ack)) < 0 ||
+	    memcmp(head->optdata, th->optdata,
+		   hdr_len - gro_ip_len(pkt) - sizeof(*th))) {
+		return false;
+	}
+
+	if (!gro_ip_len_add(flow->pkt, len)) {
+		return false;
+	}
+
+	/* The coalesced segment acknowledges and advertises what the
+	 * last merged one did.
+	 */
+	memcpy(head->ack, th->ack, sizeof(head->ack));
+	memcpy(head->wnd, th->wnd, sizeof(head->wnd));
+	head->flags |= th->flags & PSH;
+
+	buf = pkt->buffer;
+	pkt->buffer = NULL;
+
+	net_buf_pull(buf, hdr_len);
+	if (buf->len == 0U) {
+		buf = net_buf_frag_del(NULL, buf);
+	}
+
+	if (buf != NULL) {
+		net_pkt_frag_add(flow->pkt, buf);
+	}
+
+	net_pkt_unref(pkt);
+
+	flow->next_seq += len;
+	flow->segs++;
+
+	return true;
+}
+
+static void gro_flow_flush(struct tcp_gro_flow *flow)
+{
+	struct net_pkt *pkt = flow->pkt;
+	struct net_if *iface = net_pkt_iface(pkt);
+	union net_proto_header proto_hdr;
+	union net_ip_header ip;
+
+	flow->pkt = NULL;
+
+	if (flow->segs > 1U) {
+		net_stats_update_tcp_gro_flushed(iface);
+
+#if defined(CONFIG_NET_IPV4)
+		if (net_pkt_family(pkt) == AF_INET) {
+			NET_IPV4_HDR(pkt)->chksum = 0U;
+			NET_IPV4_HDR(pkt)->chksum = net_calc_chksum_ipv4(pkt);
+		}
+#endif
+	}
+
+	/* Leave the cursor where net_tcp_input() would have */
+	net_pkt_cursor_init(pkt);
+	net_pkt_skip(pkt, gro_ip_len(pkt) + sizeof(struct net_tcp_hdr));
+
+	proto_hdr.tcp = gro_tcp_hdr(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		ip.ipv4 = NET_IPV4_HDR(pkt);
+	} else {
+		ip.ipv6 = NET_IPV6_HDR(pkt);
+	}
+
+	if (net_conn_input(pkt, &ip, IPPROTO_TCP, &proto_hdr) == NET_DROP) {
+		if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		    net_pkt_family(pkt) == AF_INET) {
+			net_stats_update_ipv4_drop(iface);
+		} else {
+			net_stats_update_ipv6_drop(iface);
+		}
+
+		net_pkt_unref(pkt);
+	}
+}
+
+static void gro_flush_all(struct tcp_gro_queue *queue)
+{
+	for (int i = 0; i < ARRAY_SIZE(queue->flows); i++) {
+		if (queue->flows[i].pkt != NULL) {
+			gro_flow_flush(&queue->flows[i]);
+		}
+	}
+}
+
+static void gro_flow_start(struct tcp_gro_queue *queue, struct net_pkt *pkt)
+{
+	struct tcp_gro_flow *flow = NULL;
+
+	for (int i = 0; i < ARRAY_SIZE(queue->flows); i++) {
+		if (queue->flows[i].pkt == NULL) {
+			flow = &queue->flows[i];
+			break;
+		}
+	}
+
+	if (flow == NULL) {
+		flow = &queue->flows[queue->evict];
+		queue->evict = (queue->evict + 1U) % ARRAY_SIZE(queue->flows);
+
+		gro_flow_flush(flow);
+	}
+
+	flow->pkt = pkt;
+	flow->hdr_len = gro_hdr_len(pkt);
+	flow->next_seq = sys_get_be32(gro_tcp_hdr(pkt)->seq) +
+			 net_pkt_get_len(pkt) - flow->hdr_len;
+	flow->segs = 1U;
+}
+
+enum net_verdict net_tcp_gro_receive(struct net_pkt *pkt)
+{
+	enum net_verdict verdict = NET_CONTINUE;
+	struct tcp_gro_queue *queue;
+	struct tcp_gro_flow *flow;
+	bool mergeable;
+
+	if (!net_if_flag_is_set(net_pkt_iface(pkt), NET_IF_GRO)) {
+		return NET_CONTINUE;
+	}
+
+	queue = &gro_queues[net_rx_priority2tc(net_pkt_priority(pkt))];
+
+	k_mutex_lock(&queue->lock, K_FOREVER);
+
+	if (pkt->frags->len < gro_ip_len(pkt) + sizeof(struct net_tcp_hdr)) {
+		/* Cannot match the flow, keep the ordering safe */
+		gro_flush_all(queue);
+		goto out;
+	}
+
+	mergeable = gro_pkt_mergeable(pkt);
+
+	flow = gro_flow_find(queue, pkt);
+	if (flow != NULL) {
+		if (mergeable && gro_flow_append(flow, pkt)) {
+			net_stats_update_tcp_gro_merged(net_pkt_iface(flow->pkt));
+
+			if ((gro_tcp_hdr(flow->pkt)->flags & PSH) ||
+			    flow->segs >= CONFIG_NET_TCP_GRO_MAX_SEGS) {
+				gro_flow_flush(flow);
+			}
+
+			verdict = NET_OK;
+			goto out;
+		}
+
+		/* Segments of a connection must reach TCP in order */
+		gro_flow_flush(flow);
+	}
+
+	if (mergeable && !(gro_tcp_hdr(pkt)->flags & PSH)) {
+		gro_flow_start(queue, pkt);
+		verdict = NET_OK;
+	}
+
+out:
+	k_mutex_unlock(&queue->lock);
+
+	return verdict;
+}
+
+void net_tcp_gro_flush(int tc)
+{
+	struct tcp_gro_queue *queue = &gro_queues[tc];
+
+	k_mutex_lock(&queue->lock, K_FOREVER);
+	gro_flush_all(queue);
+	k_mutex_unlock(&queue->lock);
+}
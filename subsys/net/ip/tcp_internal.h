@@ -32,6 +32,7 @@ extern "C" {
 
 enum tcp_conn_option {
 	TCP_OPT_NODELAY	= 1,
+	TCP_OPT_CONGESTION = 2,
 };
 
 /**
@@ -88,6 +89,15 @@ static inline void net_tcp_foreach(net_tcp_cb_t cb, void *user_data)
 }
 #endif
 
+/**
+ * @brief Get the lookup statistics of the TCP connection table.
+ *
+ * @param stats Where to copy the statistics.
+ */
+#if defined(CONFIG_NET_NATIVE_TCP) && defined(CONFIG_NET_CONN_HASH)
+void net_tcp_lookup_stats_get(struct net_conn_lookup_stats *stats);
+#endif
+
 /**
  * @brief Initialize TCP parts of a context
  *
@@ -281,6 +291,44 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 }
 #endif
 
+/**
+ * @brief Coalesce a received TCP segment with the pending segments of
+ *        its connection
+ *
+ * @param pkt Network packet, with its TCP checksum already verified
+ *
+ * @return NET_OK if the packet was held or merged and will be passed on
+ *         later, NET_CONTINUE if it must be passed to the connection
+ *         handlers now
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+enum net_verdict net_tcp_gro_receive(struct net_pkt *pkt);
+#else
+static inline enum net_verdict net_tcp_gro_receive(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return NET_CONTINUE;
+}
+#endif
+
+/**
+ * @brief Pass the coalesced TCP packets of an RX traffic class to the
+ *        connection handlers
+ *
+ * Called at the end of an RX batch, when the RX queue is empty.
+ *
+ * @param tc RX traffic class of the packets
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+void net_tcp_gro_flush(int tc);
+#else
+static inline void net_tcp_gro_flush(int tc)
+{
+	ARG_UNUSED(tc);
+}
+#endif
+
 /**
  * @brief Enqueue a single packet for transmission
  *
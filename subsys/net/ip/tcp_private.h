@@ -209,22 +209,94 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* Four SACK blocks fill up the 40 bytes of option space */
+#define NET_TCP_SACK_MAX_BLOCKS   4
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+};
+
+#ifdef CONFIG_NET_TCP_SACK
+/* A range of sequence numbers [start, end) held by the receiver */
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
+#endif
+
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+struct tcp;
+
+/* Congestion control algorithm. The generic layer in tcp.c implements
+ * slow start, fast retransmit and NewReno fast recovery, and consults
+ * these hooks for the algorithm specific parts.
+ */
+struct tcp_ca_ops {
+	/* Name used with the TCP_CONGESTION socket option */
+	const char *name;
+	/* Reset private state, cwnd and ssthresh are already set */
+	void (*init)(struct tcp *conn);
+	/* Return the new slow start threshold after a loss */
+	uint32_t (*ssthresh)(struct tcp *conn);
+	/* Grow cwnd above ssthresh after acked_len new bytes were acked */
+	void (*cong_avoid)(struct tcp *conn, uint32_t acked_len);
+};
+
+#define TCP_CA_NAME_MAX 16
+
+#define TCP_CA_DEFINE(_name, _init, _ssthresh, _cong_avoid)		\
+	static const STRUCT_SECTION_ITERABLE(tcp_ca_ops,		\
+					     tcp_ca_##_name) = {	\
+		.name = #_name,						\
+		.init = _init,						\
+		.ssthresh = _ssthresh,					\
+		.cong_avoid = _cong_avoid,				\
+	}
+
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+struct tcp_ca_cubic {
+	uint32_t w_max;       /* window before the last reduction */
+	uint32_t w_last_max;  /* w_max before that, for fast convergence */
+	uint32_t w_origin;    /* plateau of the current cubic function */
+	uint32_t w_est;       /* Reno friendly window estimate */
+	uint32_t epoch_start; /* uptime (ms) of the congestion avoidance start */
+	uint32_t k;           /* time (ms) to reach w_origin */
+};
+#endif
+
+struct tcp_ca {
+	const struct tcp_ca_ops *ops;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t recover; /* highest sequence sent when recovery started */
+	bool in_recovery;
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+	struct tcp_ca_cubic cubic;
+#endif
 };
+#endif /* CONFIG_NET_TCP_CONGESTION_AVOIDANCE */
 
 struct tcp { /* TCP connection */
 	sys_snode_t next;
+#ifdef CONFIG_NET_CONN_HASH
+	struct tcp *hash_next; /* next connection with the same hash key */
+	uint64_t hash_key;
+#endif
 	struct net_context *context;
 	struct net_pkt *send_data;
 	struct net_pkt *queue_recv_data;
@@ -271,18 +343,30 @@ struct tcp { /* TCP connection */
 	uint16_t recv_win;
 	uint16_t send_win_max;
 	uint16_t send_win;
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	struct tcp_ca ca;
+#endif
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 	uint16_t rto;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	uint8_t dup_ack_cnt;
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+	/* Scoreboard of the ranges SACKed by the peer, sorted and disjoint */
+	struct tcp_sack_block sacked[NET_TCP_SACK_MAX_BLOCKS];
+	uint32_t sack_rexmit; /* next sequence to consider for retransmission */
+	uint8_t sacked_cnt;
 #endif
 	uint8_t zwp_retries;
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
 	bool tcp_nodelay : 1;
+#ifdef CONFIG_NET_CONN_HASH
+	bool hashed : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
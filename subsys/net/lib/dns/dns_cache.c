@@ -0,0 +1,308 @@
+/** @file
+ * @brief DNS resolver cache
+ *
+ * Answers of the DNS servers, kept for as long as their TTL allows.
+ */
+
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/dns_resolve.h>
+#include "dns_cache.h"
+
+union dns_cache_addr {
+	struct in_addr in;
+	struct in6_addr in6;
+};
+
+/* Answer cached for a name and query type. An answer without addresses
+ * tells that the name does not exist.
+ */
+struct dns_cache_entry {
+	/** Uptime in milliseconds at which the answer expires */
+	int64_t expiry;
+
+	/** Value of dns_cache_clock when the answer was last used */
+	uint32_t last_used;
+
+	/** Query type */
+	enum dns_query_type type;
+
+	/** Number of addresses */
+	uint8_t count;
+
+	/** Addresses of the answer, of the family given by the query type */
+	union dns_cache_addr addr[CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRESSES];
+
+	/** Name resolved, empty if the entry is free */
+	char query[CONFIG_DNS_RESOLVER_CACHE_MAX_NAME_LEN + 1];
+};
+
+static struct dns_cache_entry dns_cache[CONFIG_DNS_RESOLVER_CACHE_MAX_ENTRIES];
+static struct dns_cache_stats dns_cache_stats;
+static uint32_t dns_cache_clock;
+static K_MUTEX_DEFINE(dns_cache_lock);
+
+/* Must be invoked with the cache lock held */
+static bool dns_cache_entry_valid(struct dns_cache_entry *entry, int64_t now)
+{
+	if (entry->query[0] == '\0') {
+		return false;
+	}
+
+	if (entry->expiry <= now) {
+		entry->query[0] = '\0';
+		return false;
+	}
+
+	return true;
+}
+
+/* Must be invoked with the cache lock held */
+static struct dns_cache_entry *dns_cache_lookup(const char *query,
+						enum dns_query_type type)
+{
+	int64_t now = k_uptime_get();
+
+	for (int i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		struct dns_cache_entry *entry = &dns_cache[i];
+
+		if (!dns_cache_entry_valid(entry, now)) {
+			continue;
+		}
+
+		/* Names are case insensitive, see RFC 4343 */
+		if (entry->type == type &&
+		    strncasecmp(entry->query, query, sizeof(entry->query)) == 0) {
+			entry->last_used = ++dns_cache_clock;
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Take a free entry, or the least recently used one.
+ *
+ * Must be invoked with the cache lock held.
+ */
+static struct dns_cache_entry *dns_cache_alloc(void)
+{
+	struct dns_cache_entry *lru = &dns_cache[0];
+	int64_t now = k_uptime_get();
+
+	for (int i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		struct dns_cache_entry *entry = &dns_cache[i];
+
+		if (!dns_cache_entry_valid(entry, now)) {
+			return entry;
+		}
+
+		if ((int32_t)(entry->last_used - lru->last_used) < 0) {
+			lru = entry;
+		}
+	}
+
+	NET_DBG("Evicting %s type %d", lru->query, lru->type);
+
+	dns_cache_stats.evictions++;
+
+	return lru;
+}
+
+/* Start a new answer for a query, replacing what was cached. Returns NULL
+ * if the answer is not to be cached.
+ *
+ * Must be invoked with the cache lock held.
+ */
+static struct dns_cache_entry *dns_cache_replace(const char *query,
+						 enum dns_query_type type,
+						 uint32_t ttl)
+{
+	struct dns_cache_entry *entry;
+
+	entry = dns_cache_lookup(query, type);
+
+	/* Answers with zero TTL must not be cached, see RFC 1035 3.2.1 */
+	if (ttl == 0U) {
+		if (entry != NULL) {
+			entry->query[0] = '\0';
+		}
+
+		return NULL;
+	}
+
+	if (entry == NULL) {
+		entry = dns_cache_alloc();
+		strcpy(entry->query, query);
+		entry->type = type;
+		entry->last_used = ++dns_cache_clock;
+	}
+
+	entry->count = 0U;
+	entry->expiry = k_uptime_get() + (int64_t)ttl * MSEC_PER_SEC;
+
+	return entry;
+}
+
+int dns_cache_find(const char *query, enum dns_query_type type,
+		   dns_resolve_cb_t cb, void *user_data)
+{
+	union dns_cache_addr addr[CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRESSES];
+	struct dns_addrinfo info = { 0 };
+	struct dns_cache_entry *entry;
+	int count;
+
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+
+	entry = dns_cache_lookup(query, type);
+	if (entry == NULL) {
+		dns_cache_stats.misses++;
+		k_mutex_unlock(&dns_cache_lock);
+		return -ENOENT;
+	}
+
+	dns_cache_stats.hits++;
+	if (entry->count == 0U) {
+		dns_cache_stats.negative_hits++;
+	}
+
+	/* The callback is called without the lock held, on a copy */
+	count = entry->count;
+	memcpy(addr, entry->addr, count * sizeof(addr[0]));
+
+	k_mutex_unlock(&dns_cache_lock);
+
+	NET_DBG("%s type %d found in cache (%d addresses)", query, type,
+		count);
+
+	if (count == 0) {
+		cb(DNS_EAI_NODATA, NULL, user_data);
+		return 0;
+	}
+
+	for (int i = 0; i < count; i++) {
+		if (type == DNS_QUERY_TYPE_A) {
+			net_ipaddr_copy(&net_sin(&info.ai_addr)->sin_addr,
+					&addr[i].in);
+			info.ai_family = AF_INET;
+			info.ai_addr.sa_family = AF_INET;
+			info.ai_addrlen = sizeof(struct sockaddr_in);
+		} else {
+#if defined(CONFIG_NET_IPV6)
+			net_ipaddr_copy(&net_sin6(&info.ai_addr)->sin6_addr,
+					&addr[i].in6);
+			info.ai_family = AF_INET6;
+			info.ai_addr.sa_family = AF_INET6;
+			info.ai_addrlen = sizeof(struct sockaddr_in6);
+#endif
+		}
+
+		cb(DNS_EAI_INPROGRESS, &info, user_data);
+	}
+
+	cb(DNS_EAI_ALLDONE, NULL, user_data);
+
+	return 0;
+}
+
+void dns_cache_add(const char *query, enum dns_query_type type,
+		   const struct dns_addrinfo *info, uint32_t ttl, bool first)
+{
+	struct dns_cache_entry *entry;
+
+	if (strlen(query) > CONFIG_DNS_RESOLVER_CACHE_MAX_NAME_LEN) {
+		return;
+	}
+
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+
+	if (first) {
+		entry = dns_cache_replace(query, type, ttl);
+	} else {
+		entry = dns_cache_lookup(query, type);
+		if (entry != NULL) {
+			/* The answer expires with its first address */
+			entry->expiry = MIN(entry->expiry, k_uptime_get() +
+					    (int64_t)ttl * MSEC_PER_SEC);
+		}
+	}
+
+	if (entry == NULL || entry->count >= ARRAY_SIZE(entry->addr)) {
+		goto unlock;
+	}
+
+	if (info->ai_family == AF_INET) {
+		net_ipaddr_copy(&entry->addr[entry->count].in,
+				&net_sin(&info->ai_addr)->sin_addr);
+	} else {
+#if defined(CONFIG_NET_IPV6)
+		net_ipaddr_copy(&entry->addr[entry->count].in6,
+				&net_sin6(&info->ai_addr)->sin6_addr);
+#endif
+	}
+
+	entry->count++;
+
+unlock:
+	k_mutex_unlock(&dns_cache_lock);
+}
+
+void dns_cache_add_negative(const char *query, enum dns_query_type type,
+			    struct dns_msg_t *dns_msg)
+{
+	uint32_t ttl;
+
+	if (strlen(query) > CONFIG_DNS_RESOLVER_CACHE_MAX_NAME_LEN) {
+		return;
+	}
+
+	if (dns_unpack_negative_ttl(dns_msg, &ttl) < 0) {
+		ttl = CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL;
+	}
+
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+	(void)dns_cache_replace(query, type, ttl);
+	k_mutex_unlock(&dns_cache_lock);
+}
+
+void dns_cache_flush(void)
+{
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		dns_cache[i].query[0] = '\0';
+	}
+
+	k_mutex_unlock(&dns_cache_lock);
+}
+
+void dns_cache_stats_get(struct dns_cache_stats *stats)
+{
+	int64_t now = k_uptime_get();
+
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+
+	*stats = dns_cache_stats;
+	stats->entries = 0U;
+
+	for (int i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		if (dns_cache_entry_valid(&dns_cache[i], now)) {
+			stats->entries++;
+		}
+	}
+
+	k_mutex_unlock(&dns_cache_lock);
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _DNS_CACHE_H_
+#define _DNS_CACHE_H_
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <zephyr/net/dns_resolve.h>
+
+#include "dns_pack.h"
+
+/**
+ * @brief Answer a query from the cache.
+ *
+ * @details The callback is called with the cached answer, in the same way
+ * as for an answer of a DNS server.
+ *
+ * @param query Name to resolve.
+ * @param type Type of the query.
+ * @param cb Callback getting the answer.
+ * @param user_data User data given to the callback.
+ *
+ * @retval 0 if the query was answered.
+ * @retval -ENOENT if there is no valid answer cached.
+ */
+int dns_cache_find(const char *query, enum dns_query_type type,
+		   dns_resolve_cb_t cb, void *user_data);
+
+/**
+ * @brief Cache an address of the answer to a query.
+ *
+ * @param query Name resolved.
+ * @param type Type of the query.
+ * @param info Address to cache.
+ * @param ttl TTL of the address in seconds.
+ * @param first True for the first address of the answer, which replaces
+ *        the answer cached before.
+ */
+void dns_cache_add(const char *query, enum dns_query_type type,
+		   const struct dns_addrinfo *info, uint32_t ttl, bool first);
+
+/**
+ * @brief Cache that the name of a query does not exist.
+ *
+ * @details The TTL is the one of the SOA record of the response, or
+ * CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL if there is none.
+ *
+ * @param query Name that does not exist.
+ * @param type Type of the query.
+ * @param dns_msg Negative response, answer_offset pointing past the answers.
+ */
+void dns_cache_add_negative(const char *query, enum dns_query_type type,
+			    struct dns_msg_t *dns_msg);
+
+#endif /* _DNS_CACHE_H_ */
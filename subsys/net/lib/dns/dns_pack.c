@@ -177,6 +177,53 @@ int dns_unpack_answer(struct dns_msg_t *dns_msg, int dname_ptr, uint32_t *ttl,
 	return 0;
 }
 
+int dns_unpack_negative_ttl(struct dns_msg_t *dns_msg, uint32_t *ttl)
+{
+	uint16_t offset = dns_msg->answer_offset;
+	int count = dns_header_nscount(dns_msg->msg);
+	uint32_t minimum;
+	uint16_t len;
+	uint8_t *rr;
+	int dname_len;
+
+	for (int i = 0; i < count; i++) {
+		rr = dns_msg->msg + offset;
+
+		dname_len = skip_fqdn(rr, dns_msg->msg_size - offset);
+		if (dname_len < 0) {
+			return dname_len;
+		}
+
+		/* type + class + ttl + rdlength, see RFC-1035 4.1.3 */
+		if (offset + dname_len + 2 + 2 + 4 + 2 > dns_msg->msg_size) {
+			return -EINVAL;
+		}
+
+		len = dns_answer_rdlength(dname_len, rr);
+		rr += dname_len + 2 + 2 + 4 + 2;
+		if (rr + len > dns_msg->msg + dns_msg->msg_size) {
+			return -EINVAL;
+		}
+
+		/* The SOA RDATA ends with the MINIMUM field, the TTL of the
+		 * negative responses, see RFC 2308 4. SOA Minimum Field.
+		 */
+		if (dns_answer_type(dname_len, dns_msg->msg + offset) ==
+		    DNS_RR_TYPE_SOA && len >= sizeof(minimum)) {
+			minimum = ntohl(UNALIGNED_GET((uint32_t *)
+						      (rr + len - sizeof(minimum))));
+			*ttl = MIN((uint32_t)dns_answer_ttl(dname_len,
+							    dns_msg->msg + offset),
+				   minimum);
+			return 0;
+		}
+
+		offset = rr + len - dns_msg->msg;
+	}
+
+	return -ENOENT;
+}
+
 int dns_unpack_response_header(struct dns_msg_t *msg, int src_id)
 {
 	uint8_t *dns_header;
@@ -89,6 +89,7 @@ enum dns_rr_type {
 	DNS_RR_TYPE_INVALID = 0,
 	DNS_RR_TYPE_A	= 1,		/* IPv4  */
 	DNS_RR_TYPE_CNAME = 5,		/* CNAME */
+	DNS_RR_TYPE_SOA = 6,		/* SOA   */
 	DNS_RR_TYPE_PTR = 12,		/* PTR   */
 	DNS_RR_TYPE_TXT = 16,		/* TXT   */
 	DNS_RR_TYPE_AAAA = 28,		/* IPv6  */
@@ -347,6 +348,21 @@ int dns_msg_pack_qname(uint16_t *len, uint8_t *buf, uint16_t size,
 int dns_unpack_answer(struct dns_msg_t *dns_msg, int dname_ptr, uint32_t *ttl,
 		      enum dns_rr_type *type);
 
+/**
+ * @brief Unpacks the TTL of a negative response
+ *
+ * @details Looks for the SOA record in the authority section, following
+ *          the answers, and computes the TTL of the negative response from
+ *          it as described in RFC 2308, 5. Caching Negative Answers.
+ *
+ * @param dns_msg Structure, answer_offset pointing past the answers.
+ * @param ttl TTL of the negative response.
+ * @retval 0 on success
+ * @retval -ENOENT if there is no SOA record
+ * @retval -EINVAL if the message is malformed
+ */
+int dns_unpack_negative_ttl(struct dns_msg_t *dns_msg, uint32_t *ttl);
+
 /**
  * @brief Unpacks the header's response.
  *
@@ -26,6 +26,7 @@ LOG_MODULE_REGISTER(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 #include <zephyr/net/dns_resolve.h>
 #include "dns_pack.h"
 #include "dns_internal.h"
+#include "dns_cache.h"
 
 #define DNS_SERVER_COUNT CONFIG_DNS_RESOLVER_MAX_SERVERS
 #define SERVER_COUNT     (DNS_SERVER_COUNT + DNS_MAX_MCAST_SERVERS)
@@ -441,6 +442,84 @@ static void release_query(struct dns_pending_query *pending_query)
 	}
 }
 
+/* Callback of a query slot whose caller canceled the query, kept for the
+ * slots waiting for its response.
+ */
+static void detached_query_cb(enum dns_resolve_status status,
+			      struct dns_addrinfo *info,
+			      void *user_data)
+{
+	ARG_UNUSED(status);
+	ARG_UNUSED(info);
+	ARG_UNUSED(user_data);
+}
+
+/* Must be invoked with context lock held */
+static bool query_has_followers(struct dns_resolve_context *ctx,
+				struct dns_pending_query *pending_query)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (ctx->queries[i].leader == pending_query &&
+		    ctx->queries[i].cb != NULL &&
+		    ctx->queries[i].query != NULL) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Invoke the callbacks of a query slot and of the slots waiting for its
+ * response.
+ *
+ * Must be invoked with context lock held.
+ */
+static void invoke_query_callbacks(struct dns_resolve_context *ctx,
+				   int status,
+				   struct dns_addrinfo *info,
+				   int query_idx)
+{
+	struct dns_pending_query *pending_query = &ctx->queries[query_idx];
+	int i;
+
+	invoke_query_callback(status, info, pending_query);
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (ctx->queries[i].leader == pending_query) {
+			invoke_query_callback(status, info, &ctx->queries[i]);
+		}
+	}
+}
+
+/* Release a query slot and the slots waiting for its response.
+ *
+ * Must be invoked with context lock held.
+ */
+static void release_queries(struct dns_resolve_context *ctx, int query_idx)
+{
+	struct dns_pending_query *pending_query = &ctx->queries[query_idx];
+	struct dns_pending_query *leader = pending_query->leader;
+	int i;
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (ctx->queries[i].leader == pending_query) {
+			ctx->queries[i].leader = NULL;
+			release_query(&ctx->queries[i]);
+		}
+	}
+
+	pending_query->leader = NULL;
+	release_query(pending_query);
+
+	/* A canceled query is only kept for the ones waiting for it */
+	if (leader != NULL && leader->cb == detached_query_cb &&
+	    !query_has_followers(ctx, leader)) {
+		release_query(leader);
+	}
+}
+
 /* Must be invoked with context lock held */
 static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 				 uint16_t dns_id,
@@ -460,6 +539,30 @@ static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 	return -ENOENT;
 }
 
+/* Find a query in progress for the same name and type, that is sending
+ * its own query.
+ *
+ * Must be invoked with context lock held.
+ */
+static int get_slot_by_query(struct dns_resolve_context *ctx,
+			     const char *query,
+			     enum dns_query_type query_type)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (ctx->queries[i].cb != NULL &&
+		    ctx->queries[i].query != NULL &&
+		    ctx->queries[i].leader == NULL &&
+		    ctx->queries[i].query_type == query_type &&
+		    strcmp(ctx->queries[i].query, query) == 0) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
 /* Unit test needs to be able to call this function */
 #if !defined(CONFIG_NET_TEST)
 static
@@ -472,7 +575,9 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		     uint16_t *query_hash)
 {
 	struct dns_addrinfo info = { 0 };
-	uint32_t ttl; /* RR ttl, so far it is not passed to caller */
+	uint32_t ttl; /* RR ttl */
+	uint32_t answer_ttl = UINT32_MAX; /* lowest ttl of the answer */
+	bool nxdomain;
 	uint8_t *src, *addr;
 	const char *query_name;
 	int address_size;
@@ -515,6 +620,8 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		goto quit;
 	}
 
+	nxdomain = (ret == DNS_HEADER_NAMEERROR);
+
 	if (dns_header_qdcount(dns_msg->msg) != 1) {
 		/* For mDNS (when dns_id == 0) the query count is 0 */
 		if (*dns_id > 0) {
@@ -556,6 +663,8 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 			goto quit;
 		}
 
+		answer_ttl = MIN(answer_ttl, ttl);
+
 		switch (dns_msg->response_type) {
 		case DNS_RESPONSE_IP:
 			if (*query_idx >= 0) {
@@ -633,8 +742,15 @@ query_known:
 			src = dns_msg->msg + dns_msg->response_position;
 			memcpy(addr, src, address_size);
 
-			invoke_query_callback(DNS_EAI_INPROGRESS, &info,
-					      &ctx->queries[*query_idx]);
+			if (IS_ENABLED(CONFIG_DNS_RESOLVER_CACHE) &&
+			    ctx->queries[*query_idx].query != NULL) {
+				dns_cache_add(ctx->queries[*query_idx].query,
+					      ctx->queries[*query_idx].query_type,
+					      &info, answer_ttl, items == 0);
+			}
+
+			invoke_query_callbacks(ctx, DNS_EAI_INPROGRESS, &info,
+					       *query_idx);
 			items++;
 			break;
 
@@ -702,6 +818,13 @@ query_known:
 
 	if (items == 0) {
 		ret = DNS_EAI_NODATA;
+
+		if (IS_ENABLED(CONFIG_DNS_RESOLVER_CACHE) && nxdomain &&
+		    ctx->queries[*query_idx].query != NULL) {
+			dns_cache_add_negative(ctx->queries[*query_idx].query,
+					       ctx->queries[*query_idx].query_type,
+					       dns_msg);
+		}
 	} else {
 		ret = DNS_EAI_ALLDONE;
 	}
@@ -736,6 +859,7 @@ static int dns_read(struct dns_resolve_context *ctx,
 
 	dns_msg.msg = dns_data->data;
 	dns_msg.msg_size = data_len;
+	dns_msg.response_type = DNS_RESPONSE_INVALID;
 
 	ret = dns_validate_msg(ctx, &dns_msg, dns_id, &query_idx,
 			       dns_cname, query_hash);
@@ -748,10 +872,10 @@ static int dns_read(struct dns_resolve_context *ctx,
 		goto quit;
 	}
 
-	invoke_query_callback(ret, NULL, &ctx->queries[query_idx]);
+	invoke_query_callbacks(ctx, ret, NULL, query_idx);
 
 	/* Marks the end of the results */
-	release_query(&ctx->queries[query_idx]);
+	release_queries(ctx, query_idx);
 
 	net_pkt_unref(pkt);
 
@@ -853,10 +977,10 @@ quit:
 		goto free_buf;
 	}
 
-	invoke_query_callback(ret, NULL, &ctx->queries[i]);
+	invoke_query_callbacks(ctx, ret, NULL, i);
 
 	/* Marks the end of the results */
-	release_query(&ctx->queries[i]);
+	release_queries(ctx, i);
 
 free_buf:
 	if (dns_data) {
@@ -951,9 +1075,9 @@ static int dns_write(struct dns_resolve_context *ctx,
 /* Must be invoked with context lock held */
 static void dns_resolve_cancel_slot(struct dns_resolve_context *ctx, int slot)
 {
-	invoke_query_callback(DNS_EAI_CANCELED, NULL, &ctx->queries[slot]);
+	invoke_query_callbacks(ctx, DNS_EAI_CANCELED, NULL, slot);
 
-	release_query(&ctx->queries[slot]);
+	release_queries(ctx, slot);
 }
 
 /* Must be invoked with context lock held */
@@ -971,7 +1095,8 @@ static void dns_resolve_cancel_all(struct dns_resolve_context *ctx)
 static int dns_resolve_cancel_with_hash(struct dns_resolve_context *ctx,
 					uint16_t dns_id,
 					uint16_t query_hash,
-					const char *query_name)
+					const char *query_name,
+					bool timeout)
 {
 	int ret = 0;
 	int i;
@@ -996,6 +1121,15 @@ static int dns_resolve_cancel_with_hash(struct dns_resolve_context *ctx,
 		query_name, ctx->queries[i].query_type,
 		query_hash);
 
+	/* Other queries waiting for the response keep the slot until the
+	 * response arrives or the query times out.
+	 */
+	if (!timeout && query_has_followers(ctx, &ctx->queries[i])) {
+		invoke_query_callback(DNS_EAI_CANCELED, NULL, &ctx->queries[i]);
+		ctx->queries[i].cb = detached_query_cb;
+		goto unlock;
+	}
+
 	dns_resolve_cancel_slot(ctx, i);
 
 unlock:
@@ -1049,7 +1183,7 @@ int dns_resolve_cancel_with_name(struct dns_resolve_context *ctx,
 	}
 
 	return dns_resolve_cancel_with_hash(ctx, dns_id, query_hash,
-					    query_name);
+					    query_name, false);
 }
 
 int dns_resolve_cancel(struct dns_resolve_context *ctx, uint16_t dns_id)
@@ -1100,7 +1234,8 @@ static void query_timeout(struct k_work *work)
 	(void)dns_resolve_cancel_with_hash(pending_query->ctx,
 					   pending_query->id,
 					   pending_query->query_hash,
-					   pending_query->query);
+					   pending_query->query,
+					   true);
 
 	k_mutex_unlock(&pending_query->ctx->lock);
 }
@@ -1118,6 +1253,7 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	struct net_buf *dns_qname = NULL;
 	struct sockaddr addr;
 	int ret, i = -1, j = 0;
+	int leader;
 	int failure = 0;
 	bool mdns_query = false;
 	uint8_t hop_limit;
@@ -1182,6 +1318,15 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	}
 
 try_resolve:
+	if (IS_ENABLED(CONFIG_DNS_RESOLVER_CACHE) &&
+	    dns_cache_find(query, type, cb, user_data) == 0) {
+		if (dns_id) {
+			*dns_id = 0U;
+		}
+
+		return 0;
+	}
+
 	k_mutex_lock(&ctx->lock, K_FOREVER);
 
 	if (ctx->state != DNS_RESOLVE_CONTEXT_ACTIVE) {
@@ -1195,6 +1340,8 @@ try_resolve:
 		goto fail;
 	}
 
+	leader = get_slot_by_query(ctx, query, type);
+
 	ctx->queries[i].cb = cb;
 	ctx->queries[i].timeout = tout;
 	ctx->queries[i].query = query;
@@ -1202,9 +1349,32 @@ try_resolve:
 	ctx->queries[i].user_data = user_data;
 	ctx->queries[i].ctx = ctx;
 	ctx->queries[i].query_hash = 0;
+	ctx->queries[i].leader = NULL;
 
 	k_work_init_delayable(&ctx->queries[i].timer, query_timeout);
 
+	/* Rather than sending the same query again, wait for the response
+	 * to the one in progress.
+	 */
+	if (leader >= 0) {
+		ctx->queries[i].leader = &ctx->queries[leader];
+		ctx->queries[i].query_hash = ctx->queries[leader].query_hash;
+		ctx->queries[i].id = sys_rand32_get();
+
+		if (dns_id) {
+			*dns_id = ctx->queries[i].id;
+		}
+
+		NET_DBG("[%u] waiting for query [%u] of %s", i, leader, query);
+
+		ret = k_work_reschedule(&ctx->queries[i].timer, tout);
+		if (ret >= 0) {
+			ret = 0;
+		}
+
+		goto quit;
+	}
+
 	dns_data = net_buf_alloc(&dns_msg_pool, ctx->buf_timeout);
 	if (!dns_data) {
 		ret = -ENOMEM;
@@ -1302,7 +1472,7 @@ try_resolve:
 quit:
 	if (ret < 0) {
 		if (i >= 0) {
-			release_query(&ctx->queries[i]);
+			release_queries(ctx, i);
 		}
 
 		if (dns_id) {
@@ -1471,6 +1641,11 @@ int dns_resolve_reconfigure(struct dns_resolve_context *ctx,
 		}
 	}
 
+	/* Answers of the previous servers might not be valid anymore */
+	if (IS_ENABLED(CONFIG_DNS_RESOLVER_CACHE)) {
+		dns_cache_flush();
+	}
+
 	err = dns_resolve_init_locked(ctx, servers, servers_sa);
 
 unlock:
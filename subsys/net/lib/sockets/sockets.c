@@ -270,6 +270,9 @@ int zsock_close_ctx(struct net_context *ctx)
 
 	zsock_flush_queue(ctx);
 
+	zsock_epoll_ctx_close(ctx);
+	zsock_rtio_ctx_close(ctx);
+
 	SET_ERRNO(net_context_put(ctx));
 
 	return 0;
@@ -372,6 +375,8 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 		net_context_ref(new_ctx);
 
 		(void)k_condvar_signal(&parent->cond.recv);
+
+		zsock_epoll_notify(parent);
 	}
 
 }
@@ -429,6 +434,9 @@ unlock:
 
 	/* Wake reader if it was sleeping */
 	(void)k_condvar_signal(&ctx->cond.recv);
+
+	zsock_epoll_notify(ctx);
+	zsock_rtio_notify(ctx);
 }
 
 int zsock_shutdown_ctx(struct net_context *ctx, int how)
@@ -765,6 +773,13 @@ static int send_check_and_wait(struct net_context *ctx, int status,
 	return 0;
 
 out:
+	if (status == -EAGAIN) {
+		/* Edge triggered epoll waiters learn about the socket
+		 * becoming writable again from here on.
+		 */
+		zsock_epoll_notify(ctx);
+	}
+
 	errno = -status;
 	return -1;
 }
@@ -783,9 +798,10 @@ static void timeout_recalc(uint64_t end, k_timeout_t *timeout)
 	}
 }
 
-ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
-			 int flags,
-			 const struct sockaddr *dest_addr, socklen_t addrlen)
+/* Send either len bytes of buf or the buffer chain frags */
+static ssize_t sock_sendto(struct net_context *ctx, const void *buf, size_t len,
+			   struct net_buf *frags, int flags,
+			   const struct sockaddr *dest_addr, socklen_t addrlen)
 {
 	k_timeout_t timeout = K_FOREVER;
 	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
@@ -813,7 +829,11 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 	}
 
 	while (1) {
-		if (dest_addr) {
+		if (frags) {
+			status = net_context_sendto_buf(ctx, frags, dest_addr,
+							addrlen, NULL, timeout,
+							ctx->user_data);
+		} else if (dest_addr) {
 			status = net_context_sendto(ctx, buf, len, dest_addr,
 						    addrlen, NULL, timeout,
 						    ctx->user_data);
@@ -841,6 +861,13 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 	return status;
 }
 
+ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
+			 int flags,
+			 const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	return sock_sendto(ctx, buf, len, NULL, flags, dest_addr, addrlen);
+}
+
 ssize_t z_impl_zsock_sendto(int sock, const void *buf, size_t len, int flags,
 			   const struct sockaddr *dest_addr, socklen_t addrlen)
 {
@@ -1016,6 +1043,179 @@ fail:
 #include <syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int z_impl_zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	void *obj;
+	ssize_t ret;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	/* The whole batch is sent with one socket lookup and locking */
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ret = vtable->sendmsg(obj, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+	}
+
+	k_mutex_unlock(lock);
+
+	/* An error is only reported if nothing was sent */
+	return (i == 0 && vlen > 0) ? -1 : i;
+}
+
+#ifdef CONFIG_USERSPACE
+/* Copy a message vector and the iovec arrays it points to from user
+ * mode. Unlike for zsock_sendmsg(), the data buffers, addresses and
+ * ancillary data are only validated, not copied, to keep the cost of
+ * a large batch down.
+ */
+static struct zsock_mmsghdr *mmsg_copy_from_user(struct zsock_mmsghdr *msgvec,
+						 unsigned int vlen, bool write,
+						 struct iovec **iov_buf)
+{
+	struct zsock_mmsghdr *msgvec_copy;
+	struct iovec *iov = NULL;
+	size_t iov_count = 0;
+	size_t size;
+	unsigned int i;
+
+	*iov_buf = NULL;
+
+	if (size_mul_overflow(vlen, sizeof(*msgvec), &size)) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	msgvec_copy = z_user_alloc_from_copy(msgvec, size);
+	if (!msgvec_copy) {
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		if (size_add_overflow(iov_count,
+				      msgvec_copy[i].msg_hdr.msg_iovlen,
+				      &iov_count)) {
+			errno = EINVAL;
+			goto fail;
+		}
+	}
+
+	if (iov_count > 0) {
+		if (size_mul_overflow(iov_count, sizeof(*iov), &size)) {
+			errno = EINVAL;
+			goto fail;
+		}
+
+		iov = z_thread_malloc(size);
+		if (!iov) {
+			errno = ENOMEM;
+			goto fail;
+		}
+	}
+
+	*iov_buf = iov;
+
+	for (i = 0; i < vlen; i++) {
+		struct msghdr *msg = &msgvec_copy[i].msg_hdr;
+
+		if (msg->msg_iovlen > 0) {
+			if (z_user_from_copy(iov, msg->msg_iov,
+					     msg->msg_iovlen * sizeof(*iov))) {
+				errno = EFAULT;
+				goto fail;
+			}
+
+			msg->msg_iov = iov;
+			iov += msg->msg_iovlen;
+		}
+
+		for (size_t j = 0; j < msg->msg_iovlen; j++) {
+			if (Z_SYSCALL_MEMORY(msg->msg_iov[j].iov_base,
+					     msg->msg_iov[j].iov_len, write)) {
+				errno = EFAULT;
+				goto fail;
+			}
+		}
+
+		if (msg->msg_name &&
+		    Z_SYSCALL_MEMORY(msg->msg_name, msg->msg_namelen, write)) {
+			errno = EFAULT;
+			goto fail;
+		}
+
+		if (write) {
+			/* Ancillary data is not received */
+			msg->msg_control = NULL;
+			msg->msg_controllen = 0;
+		} else if (msg->msg_control &&
+			   Z_SYSCALL_MEMORY_READ(msg->msg_control,
+						 msg->msg_controllen)) {
+			errno = EFAULT;
+			goto fail;
+		}
+	}
+
+	return msgvec_copy;
+
+fail:
+	k_free(*iov_buf);
+	k_free(msgvec_copy);
+	*iov_buf = NULL;
+
+	return NULL;
+}
+
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct zsock_mmsghdr *msgvec_copy;
+	struct iovec *iov_buf;
+	int ret;
+
+	if (vlen == 0) {
+		return 0;
+	}
+
+	msgvec_copy = mmsg_copy_from_user(msgvec, vlen, false, &iov_buf);
+	if (!msgvec_copy) {
+		return -1;
+	}
+
+	ret = z_impl_zsock_sendmmsg(sock, msgvec_copy, vlen, flags);
+
+	for (int i = 0; i < ret; i++) {
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_len,
+				      &msgvec_copy[i].msg_len,
+				      sizeof(msgvec[i].msg_len)));
+	}
+
+	k_free(iov_buf);
+	k_free(msgvec_copy);
+
+	return ret;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
 				 enum net_ip_protocol proto,
 				 struct sockaddr *addr,
@@ -1179,6 +1379,48 @@ int zsock_wait_data(struct net_context *ctx, k_timeout_t *timeout)
 	return 0;
 }
 
+static int sock_get_src_addr(struct net_context *ctx, struct net_pkt *pkt,
+			     struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		/*
+		 * Packets from offloaded IP stack do not have IP
+		 * headers, so src address cannot be figured out at this
+		 * point. The best we can do is returning remote address
+		 * if that was set using connect() call.
+		 */
+		if (ctx->flags & NET_CONTEXT_REMOTE_ADDR_SET) {
+			memcpy(src_addr, &ctx->remote,
+			       MIN(*addrlen, sizeof(ctx->remote)));
+		} else {
+			return -ENOTSUP;
+		}
+	} else {
+		int rv;
+
+		rv = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
+					   src_addr, *addrlen);
+		if (rv < 0) {
+			LOG_ERR("sock_get_pkt_src_addr %d", rv);
+			return rv;
+		}
+	}
+
+	/* addrlen is a value-result argument, set to actual
+	 * size of source address
+	 */
+	if (src_addr->sa_family == AF_INET) {
+		*addrlen = sizeof(struct sockaddr_in);
+	} else if (src_addr->sa_family == AF_INET6) {
+		*addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 				       void *buf,
 				       size_t max_len,
@@ -1229,42 +1471,11 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 	net_pkt_cursor_backup(pkt, &backup);
 
 	if (src_addr && addrlen) {
-		if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
-		    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
-			/*
-			 * Packets from offloaded IP stack do not have IP
-			 * headers, so src address cannot be figured out at this
-			 * point. The best we can do is returning remote address
-			 * if that was set using connect() call.
-			 */
-			if (ctx->flags & NET_CONTEXT_REMOTE_ADDR_SET) {
-				memcpy(src_addr, &ctx->remote,
-				       MIN(*addrlen, sizeof(ctx->remote)));
-			} else {
-				errno = ENOTSUP;
-				goto fail;
-			}
-		} else {
-			int rv;
+		int rv;
 
-			rv = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
-						   src_addr, *addrlen);
-			if (rv < 0) {
-				errno = -rv;
-				LOG_ERR("sock_get_pkt_src_addr %d", rv);
-				goto fail;
-			}
-		}
-
-		/* addrlen is a value-result argument, set to actual
-		 * size of source address
-		 */
-		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
-		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
-		} else {
-			errno = ENOTSUP;
+		rv = sock_get_src_addr(ctx, pkt, src_addr, addrlen);
+		if (rv < 0) {
+			errno = -rv;
 			goto fail;
 		}
 	}
@@ -1478,6 +1689,389 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* Read one received datagram into the iovec array of msg */
+static ssize_t sock_recv_pkt_msg(struct net_context *ctx, struct net_pkt *pkt,
+				 struct msghdr *msg, int flags)
+{
+	size_t recv_len, read_len = 0;
+
+	msg->msg_flags = 0;
+	msg->msg_controllen = 0;
+
+	if (msg->msg_name && msg->msg_namelen > 0) {
+		int ret;
+
+		ret = sock_get_src_addr(ctx, pkt, msg->msg_name,
+					&msg->msg_namelen);
+		if (ret < 0) {
+			return ret;
+		}
+	} else {
+		msg->msg_namelen = 0;
+	}
+
+	recv_len = net_pkt_remaining_data(pkt);
+
+	for (size_t i = 0; i < msg->msg_iovlen && read_len < recv_len; i++) {
+		size_t len = MIN(msg->msg_iov[i].iov_len, recv_len - read_len);
+
+		if (net_pkt_read(pkt, msg->msg_iov[i].iov_base, len)) {
+			return -ENOBUFS;
+		}
+
+		read_len += len;
+	}
+
+	if (read_len < recv_len) {
+		msg->msg_flags |= ZSOCK_MSG_TRUNC;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	return (flags & ZSOCK_MSG_TRUNC) ? recv_len : read_len;
+}
+
+static int zsock_recvmmsg_ctx(struct net_context *ctx,
+			      struct zsock_mmsghdr *msgvec, unsigned int vlen,
+			      int flags, struct zsock_timeval *tv)
+{
+	k_timeout_t timeout = K_FOREVER;
+	unsigned int count = 0;
+	uint64_t end;
+	int ret = 0;
+
+	if (net_context_get_type(ctx) != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (flags & ~(ZSOCK_MSG_DONTWAIT | ZSOCK_MSG_TRUNC |
+		      ZSOCK_MSG_WAITFORONE)) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else if (tv) {
+		timeout = K_USEC(tv->tv_sec * 1000000ULL + tv->tv_usec);
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	end = sys_clock_timeout_end_calc(timeout);
+
+	while (count < vlen) {
+		struct net_pkt *pkt;
+
+		pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		if (!pkt) {
+			if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				ret = -EAGAIN;
+				break;
+			}
+
+			ret = zsock_wait_data(ctx, &timeout);
+			if (ret < 0) {
+				break;
+			}
+
+			timeout_recalc(end, &timeout);
+			continue;
+		}
+
+		ret = sock_recv_pkt_msg(ctx, pkt, &msgvec[count].msg_hdr, flags);
+		net_pkt_unref(pkt);
+
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count++].msg_len = ret;
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			timeout = K_NO_WAIT;
+		} else {
+			timeout_recalc(end, &timeout);
+		}
+	}
+
+	/* An error is only reported if nothing was received */
+	if (count == 0 && vlen > 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return count;
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags,
+			  struct zsock_timeval *timeout)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_recvmmsg_ctx(obj, msgvec, vlen, flags, timeout);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags,
+					struct zsock_timeval *timeout)
+{
+	struct zsock_mmsghdr *msgvec_copy;
+	struct zsock_timeval timeout_copy;
+	struct iovec *iov_buf;
+	int ret;
+
+	if (timeout) {
+		Z_OOPS(z_user_from_copy(&timeout_copy, timeout,
+					sizeof(timeout_copy)));
+	}
+
+	if (vlen == 0) {
+		return 0;
+	}
+
+	msgvec_copy = mmsg_copy_from_user(msgvec, vlen, true, &iov_buf);
+	if (!msgvec_copy) {
+		return -1;
+	}
+
+	ret = z_impl_zsock_recvmmsg(sock, msgvec_copy, vlen, flags,
+				    timeout ? &timeout_copy : NULL);
+
+	for (int i = 0; i < ret; i++) {
+		struct zsock_mmsghdr *msg = &msgvec_copy[i];
+
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_len, &msg->msg_len,
+				      sizeof(msg->msg_len)));
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_hdr.msg_namelen,
+				      &msg->msg_hdr.msg_namelen,
+				      sizeof(msg->msg_hdr.msg_namelen)));
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_hdr.msg_controllen,
+				      &msg->msg_hdr.msg_controllen,
+				      sizeof(msg->msg_hdr.msg_controllen)));
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_hdr.msg_flags,
+				      &msg->msg_hdr.msg_flags,
+				      sizeof(msg->msg_hdr.msg_flags)));
+	}
+
+	k_free(iov_buf);
+	k_free(msgvec_copy);
+
+	return ret;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_SOCKETS_ZERO_COPY)
+/* Take the buffers of pkt, dropping the headers in front of the cursor */
+static struct net_buf *sock_pkt_detach_data(struct net_pkt *pkt)
+{
+	size_t offset = net_pkt_get_current_offset(pkt);
+	struct net_buf *buf = pkt->buffer;
+
+	pkt->buffer = NULL;
+
+	while (buf != NULL && offset >= buf->len) {
+		offset -= buf->len;
+		buf = net_buf_frag_del(NULL, buf);
+	}
+
+	if (buf != NULL) {
+		net_buf_pull(buf, offset);
+	}
+
+	return buf;
+}
+
+static ssize_t zsock_recvfrom_zc_ctx(struct net_context *ctx,
+				     struct net_buf **frags, int flags,
+				     struct sockaddr *src_addr,
+				     socklen_t *addrlen)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	size_t recv_len;
+	int ret;
+
+	*frags = NULL;
+
+	if (flags & ~ZSOCK_MSG_DONTWAIT) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (sock_type == SOCK_STREAM) {
+		if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+			errno = ENOTCONN;
+			return -1;
+		}
+
+		if (sock_is_error(ctx)) {
+			errno = POINTER_TO_INT(ctx->user_data);
+			return -1;
+		}
+
+		if (sock_is_eof(ctx)) {
+			return 0;
+		}
+	} else if (sock_type != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+	if (pkt == NULL) {
+		if (sock_is_error(ctx)) {
+			errno = POINTER_TO_INT(ctx->user_data);
+			return -1;
+		}
+
+		if (sock_type == SOCK_STREAM && sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		errno = EAGAIN;
+		return -1;
+	}
+
+	if (sock_type == SOCK_DGRAM && src_addr && addrlen) {
+		ret = sock_get_src_addr(ctx, pkt, src_addr, addrlen);
+		if (ret < 0) {
+			net_pkt_unref(pkt);
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	if (sock_type == SOCK_STREAM && net_pkt_eof(pkt)) {
+		sock_set_eof(ctx);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	*frags = sock_pkt_detach_data(pkt);
+	net_pkt_unref(pkt);
+
+	recv_len = (*frags != NULL) ? net_buf_frags_len(*frags) : 0;
+
+	if (sock_type == SOCK_STREAM) {
+		net_context_update_recv_wnd(ctx, recv_len);
+	}
+
+	return recv_len;
+}
+
+/* Get the context of a native socket, with its lock held */
+static struct net_context *zc_get_ctx(int sock, struct k_mutex **lock)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+
+	ctx = get_sock_vtable(sock, &vtable, lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return NULL;
+	}
+
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return NULL;
+	}
+
+	(void)k_mutex_lock(*lock, K_FOREVER);
+
+	return ctx;
+}
+
+ssize_t zsock_recvfrom_zc(int sock, struct net_buf **frags, int flags,
+			  struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	if (frags == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ctx = zc_get_ctx(sock, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	ret = zsock_recvfrom_zc_ctx(ctx, frags, flags, src_addr, addrlen);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+ssize_t zsock_sendto_zc(int sock, struct net_buf *frags, int flags,
+			const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	if (frags == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ctx = zc_get_ctx(sock, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	ret = sock_sendto(ctx, NULL, 0, frags, flags, dest_addr, addrlen);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_ZERO_COPY */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -1935,6 +2529,19 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 		case TCP_NODELAY:
 			ret = net_tcp_get_option(ctx, TCP_OPT_NODELAY, optval, optlen);
 			return ret;
+
+		case TCP_CONGESTION: {
+			size_t len = *optlen;
+
+			ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION, optval, &len);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			*optlen = len;
+			return 0;
+		}
 		}
 
 		break;
@@ -2233,6 +2840,16 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			ret = net_tcp_set_option(ctx,
 						 TCP_OPT_NODELAY, optval, optlen);
 			return ret;
+
+		case TCP_CONGESTION:
+			ret = net_tcp_set_option(ctx,
+						 TCP_OPT_CONGESTION, optval, optlen);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			return 0;
 		}
 		break;
 
@@ -0,0 +1,651 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* epoll() style event interface for native sockets.
+ *
+ * Each epoll instance keeps the sockets registered with it in a static
+ * item array. An item is linked into the epoll_items list of its
+ * net_context, so the socket receive callbacks can put the item on the
+ * ready list of the instance and wake up the waiter. zsock_epoll_wait()
+ * only looks at the ready list, so its cost does not depend on the number
+ * of sockets registered.
+ *
+ * TCP sockets do not get a callback when the send window opens again.
+ * Items waiting for EPOLLOUT on such a socket are kept on a separate list
+ * and zsock_epoll_wait() waits on their TCP transmit semaphore as well.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/syscall_handler.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_epoll.h>
+
+#include "sockets_internal.h"
+#include "../../ip/tcp_internal.h"
+
+#define EPOLL_ALWAYS_REPORTED (ZSOCK_EPOLLERR | ZSOCK_EPOLLHUP)
+#define EPOLL_EVENTS_MASK (ZSOCK_EPOLLIN | ZSOCK_EPOLLPRI | ZSOCK_EPOLLOUT | \
+			   EPOLL_ALWAYS_REPORTED)
+#define EPOLL_FLAGS_MASK (ZSOCK_EPOLLET | ZSOCK_EPOLLONESHOT)
+
+struct epoll_item {
+	/* Node in the ready list of the instance */
+	sys_dnode_t ready_node;
+	/* Node in the list of items waiting for the socket to be writable */
+	sys_dnode_t out_node;
+	/* Node in the epoll_items list of the socket */
+	sys_snode_t ctx_node;
+	struct epoll_instance *ep;
+	struct net_context *ctx;
+	uint32_t events;
+	zsock_epoll_data_t data;
+	/* Events are reported, cleared after an ONESHOT item has fired */
+	bool armed;
+};
+
+struct epoll_instance {
+	struct epoll_item items[CONFIG_NET_SOCKETS_EPOLL_MAX_FDS];
+	sys_dlist_t ready;
+	sys_dlist_t out_wait;
+	struct k_poll_signal signal;
+	/* Serializes the waiters, protects wait_events and wait_items */
+	struct k_mutex wait_lock;
+	struct k_poll_event wait_events[CONFIG_NET_SOCKETS_EPOLL_MAX_FDS + 1];
+	struct epoll_item *wait_items[CONFIG_NET_SOCKETS_EPOLL_MAX_FDS + 1];
+	bool in_use;
+};
+
+static struct epoll_instance epoll_instances[CONFIG_NET_SOCKETS_EPOLL_MAX];
+
+/* Protects the item lists of all the instances and sockets */
+static struct k_spinlock epoll_lock;
+
+static const struct fd_op_vtable epoll_fd_op_vtable;
+
+static inline bool epoll_item_in_use(struct epoll_item *item)
+{
+	return item->ctx != NULL;
+}
+
+static bool epoll_ctx_is_tcp(struct net_context *ctx)
+{
+	return IS_ENABLED(CONFIG_NET_NATIVE_TCP) &&
+	       net_context_get_type(ctx) == SOCK_STREAM &&
+	       !net_if_is_ip_offloaded(net_context_get_iface(ctx));
+}
+
+/* Semaphore signalling that a TCP socket may become writable, or NULL if
+ * there is nothing to wait for.
+ */
+static struct k_sem *epoll_out_sem(struct net_context *ctx)
+{
+	if (!epoll_ctx_is_tcp(ctx) || sock_is_eof(ctx) || sock_is_error(ctx)) {
+		return NULL;
+	}
+
+	switch (net_context_get_state(ctx)) {
+	case NET_CONTEXT_CONNECTING:
+		return net_tcp_conn_sem_get(ctx);
+	case NET_CONTEXT_CONNECTED:
+		return net_tcp_tx_sem_get(ctx);
+	default:
+		return NULL;
+	}
+}
+
+/* Current events of the socket, same conditions as poll() */
+static uint32_t epoll_eval(struct net_context *ctx)
+{
+	uint32_t revents = 0U;
+
+	if (!k_fifo_is_empty(&ctx->recv_q) || sock_is_eof(ctx)) {
+		revents |= ZSOCK_EPOLLIN;
+	}
+
+	if (epoll_ctx_is_tcp(ctx)) {
+		if (net_context_get_state(ctx) == NET_CONTEXT_CONNECTED &&
+		    !sock_is_eof(ctx) &&
+		    k_sem_count_get(net_tcp_tx_sem_get(ctx)) > 0U) {
+			revents |= ZSOCK_EPOLLOUT;
+		}
+	} else {
+		revents |= ZSOCK_EPOLLOUT;
+	}
+
+	if (sock_is_error(ctx)) {
+		revents |= ZSOCK_EPOLLERR;
+	}
+
+	if (sock_is_eof(ctx)) {
+		revents |= ZSOCK_EPOLLHUP;
+	}
+
+	return revents;
+}
+
+static void epoll_item_ready(struct epoll_item *item)
+{
+	if (!item->armed) {
+		return;
+	}
+
+	if (sys_dnode_is_linked(&item->out_node)) {
+		sys_dlist_remove(&item->out_node);
+	}
+
+	if (!sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_append(&item->ep->ready, &item->ready_node);
+	}
+
+	k_poll_signal_raise(&item->ep->signal, 0);
+}
+
+static void epoll_item_free(struct epoll_item *item)
+{
+	if (sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_remove(&item->ready_node);
+	}
+
+	if (sys_dnode_is_linked(&item->out_node)) {
+		sys_dlist_remove(&item->out_node);
+	}
+
+	item->ctx = NULL;
+	item->armed = false;
+}
+
+static struct epoll_item *epoll_item_find(struct epoll_instance *ep,
+					  struct net_context *ctx)
+{
+	struct epoll_item *item;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->epoll_items, item, ctx_node) {
+		if (item->ep == ep) {
+			return item;
+		}
+	}
+
+	return NULL;
+}
+
+static struct epoll_item *epoll_item_alloc(struct epoll_instance *ep,
+					   struct net_context *ctx)
+{
+	for (int i = 0; i < ARRAY_SIZE(ep->items); i++) {
+		struct epoll_item *item = &ep->items[i];
+
+		if (!epoll_item_in_use(item)) {
+			sys_dnode_init(&item->ready_node);
+			sys_dnode_init(&item->out_node);
+			item->ep = ep;
+			item->ctx = ctx;
+			sys_slist_prepend(&ctx->epoll_items, &item->ctx_node);
+
+			return item;
+		}
+	}
+
+	return NULL;
+}
+
+void zsock_epoll_notify(struct net_context *ctx)
+{
+	k_spinlock_key_t key = k_spin_lock(&epoll_lock);
+	struct epoll_item *item;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->epoll_items, item, ctx_node) {
+		epoll_item_ready(item);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+}
+
+void zsock_epoll_ctx_close(struct net_context *ctx)
+{
+	k_spinlock_key_t key = k_spin_lock(&epoll_lock);
+	struct epoll_item *item;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->epoll_items, item, ctx_node) {
+		epoll_item_free(item);
+	}
+
+	sys_slist_init(&ctx->epoll_items);
+
+	k_spin_unlock(&epoll_lock, key);
+}
+
+static int epoll_close_op(void *obj)
+{
+	struct epoll_instance *ep = obj;
+	k_spinlock_key_t key = k_spin_lock(&epoll_lock);
+
+	for (int i = 0; i < ARRAY_SIZE(ep->items); i++) {
+		struct epoll_item *item = &ep->items[i];
+
+		if (epoll_item_in_use(item)) {
+			sys_slist_find_and_remove(&item->ctx->epoll_items,
+						  &item->ctx_node);
+			epoll_item_free(item);
+		}
+	}
+
+	ep->in_use = false;
+
+	k_spin_unlock(&epoll_lock, key);
+
+	return 0;
+}
+
+static ssize_t epoll_read_op(void *obj, void *buf, size_t sz)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t epoll_write_op(void *obj, const void *buf, size_t sz)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static int epoll_ioctl_op(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(request);
+	ARG_UNUSED(args);
+
+	errno = EOPNOTSUPP;
+	return -1;
+}
+
+static const struct fd_op_vtable epoll_fd_op_vtable = {
+	.read = epoll_read_op,
+	.write = epoll_write_op,
+	.close = epoll_close_op,
+	.ioctl = epoll_ioctl_op,
+};
+
+int z_impl_zsock_epoll_create1(int flags)
+{
+	struct epoll_instance *ep = NULL;
+	k_spinlock_key_t key;
+	int fd;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	key = k_spin_lock(&epoll_lock);
+
+	for (int i = 0; i < ARRAY_SIZE(epoll_instances); i++) {
+		if (!epoll_instances[i].in_use) {
+			ep = &epoll_instances[i];
+			ep->in_use = true;
+			break;
+		}
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	if (ep == NULL) {
+		z_free_fd(fd);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	sys_dlist_init(&ep->ready);
+	sys_dlist_init(&ep->out_wait);
+	k_poll_signal_init(&ep->signal);
+	k_mutex_init(&ep->wait_lock);
+
+	z_finalize_fd(fd, ep, &epoll_fd_op_vtable);
+
+	return fd;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_create1(int flags)
+{
+	return z_impl_zsock_epoll_create1(flags);
+}
+#include <syscalls/zsock_epoll_create1_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int zsock_epoll_create(int size)
+{
+	if (size <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return zsock_epoll_create1(0);
+}
+
+int z_impl_zsock_epoll_ctl(int epfd, int op, int fd,
+			   struct zsock_epoll_event *event)
+{
+	struct epoll_instance *ep;
+	struct net_context *ctx;
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	/* Only native sockets report their events to the instance */
+	ctx = z_get_fd_obj(fd, (const struct fd_op_vtable *)&sock_fd_op_vtable,
+			   EPERM);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if (op != ZSOCK_EPOLL_CTL_DEL && event == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	key = k_spin_lock(&epoll_lock);
+
+	item = epoll_item_find(ep, ctx);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		if (item != NULL) {
+			ret = -EEXIST;
+			break;
+		}
+
+		item = epoll_item_alloc(ep, ctx);
+		if (item == NULL) {
+			ret = -ENOSPC;
+			break;
+		}
+
+		__fallthrough;
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		item->events = event->events &
+			       (EPOLL_EVENTS_MASK | EPOLL_FLAGS_MASK);
+		item->data = event->data;
+		item->armed = true;
+
+		/* Let the next wait find out the current state */
+		epoll_item_ready(item);
+		break;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		sys_slist_find_and_remove(&ctx->epoll_items, &item->ctx_node);
+		epoll_item_free(item);
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_ctl(int epfd, int op, int fd,
+					 struct zsock_epoll_event *event)
+{
+	struct zsock_epoll_event event_copy;
+
+	if (event == NULL) {
+		return z_impl_zsock_epoll_ctl(epfd, op, fd, NULL);
+	}
+
+	K_OOPS(z_user_from_copy(&event_copy, event, sizeof(event_copy)));
+
+	return z_impl_zsock_epoll_ctl(epfd, op, fd, &event_copy);
+}
+#include <syscalls/zsock_epoll_ctl_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+/* Report the events of the items on the ready list. Level triggered items
+ * that are still ready go back to the tail of the list, so each item is
+ * looked at once and the other sockets are not starved.
+ */
+static int epoll_collect(struct epoll_instance *ep,
+			 struct zsock_epoll_event *events, int maxevents)
+{
+	k_spinlock_key_t key = k_spin_lock(&epoll_lock);
+	sys_dnode_t *last = sys_dlist_peek_tail(&ep->ready);
+	sys_dnode_t *node;
+	int count = 0;
+
+	while (count < maxevents &&
+	       (node = sys_dlist_peek_head(&ep->ready)) != NULL) {
+		struct epoll_item *item =
+			CONTAINER_OF(node, struct epoll_item, ready_node);
+		uint32_t revents;
+
+		sys_dlist_remove(node);
+
+		revents = epoll_eval(item->ctx) &
+			  (item->events | EPOLL_ALWAYS_REPORTED);
+
+		if (revents != 0U) {
+			events[count].events = revents;
+			events[count].data = item->data;
+			count++;
+
+			if (item->events & ZSOCK_EPOLLONESHOT) {
+				item->armed = false;
+			} else if (!(item->events & ZSOCK_EPOLLET)) {
+				sys_dlist_append(&ep->ready, node);
+			}
+		}
+
+		if (item->armed && (item->events & ZSOCK_EPOLLOUT) &&
+		    !(revents & ZSOCK_EPOLLOUT) &&
+		    !sys_dnode_is_linked(&item->out_node) &&
+		    epoll_out_sem(item->ctx) != NULL) {
+			sys_dlist_append(&ep->out_wait, &item->out_node);
+		}
+
+		if (node == last) {
+			break;
+		}
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	return count;
+}
+
+static int epoll_prepare(struct epoll_instance *ep)
+{
+	k_spinlock_key_t key = k_spin_lock(&epoll_lock);
+	struct epoll_item *item;
+	int nevents = 0;
+
+	k_poll_event_init(&ep->wait_events[nevents++], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &ep->signal);
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&ep->out_wait, item, out_node) {
+		struct k_sem *sem = epoll_out_sem(item->ctx);
+
+		if (sem == NULL) {
+			continue;
+		}
+
+		k_poll_event_init(&ep->wait_events[nevents], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, sem);
+		ep->wait_items[nevents] = item;
+		nevents++;
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	return nevents;
+}
+
+static void epoll_update(struct epoll_instance *ep, int nevents)
+{
+	k_spinlock_key_t key = k_spin_lock(&epoll_lock);
+
+	for (int i = 1; i < nevents; i++) {
+		struct epoll_item *item = ep->wait_items[i];
+
+		/* The item may have been removed while waiting */
+		if (ep->wait_events[i].state != K_POLL_STATE_NOT_READY &&
+		    sys_dnode_is_linked(&item->out_node)) {
+			epoll_item_ready(item);
+		}
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+}
+
+int z_impl_zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			    int maxevents, int timeout)
+{
+	struct epoll_instance *ep;
+	k_timeout_t tmo;
+	uint64_t end;
+	int count;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (timeout < 0) {
+		tmo = K_FOREVER;
+	} else {
+		tmo = K_MSEC(timeout);
+	}
+
+	end = sys_clock_timeout_end_calc(tmo);
+
+	(void)k_mutex_lock(&ep->wait_lock, K_FOREVER);
+
+	while (true) {
+		int nevents;
+		int ret;
+
+		/* Anything made ready after this point raises the signal
+		 * again, so it cannot be missed by k_poll() below.
+		 */
+		k_poll_signal_reset(&ep->signal);
+
+		count = epoll_collect(ep, events, maxevents);
+		if (count > 0 || K_TIMEOUT_EQ(tmo, K_NO_WAIT)) {
+			break;
+		}
+
+		nevents = epoll_prepare(ep);
+
+		ret = k_poll(ep->wait_events, nevents, tmo);
+		if (ret == -EAGAIN) {
+			break;
+		}
+
+		epoll_update(ep, nevents);
+
+		if (!K_TIMEOUT_EQ(tmo, K_FOREVER)) {
+			int64_t remaining = end - sys_clock_tick_get();
+
+			if (remaining <= 0) {
+				tmo = K_NO_WAIT;
+			} else {
+				tmo = Z_TIMEOUT_TICKS(remaining);
+			}
+		}
+	}
+
+	k_mutex_unlock(&ep->wait_lock);
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_wait(int epfd,
+					  struct zsock_epoll_event *events,
+					  int maxevents, int timeout)
+{
+	struct zsock_epoll_event *events_copy;
+	size_t events_size;
+	int ret;
+
+	if (maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (size_mul_overflow(maxevents, sizeof(struct zsock_epoll_event),
+			      &events_size)) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	K_OOPS(Z_SYSCALL_MEMORY_WRITE(events, events_size));
+
+	events_copy = z_thread_malloc(events_size);
+	if (events_copy == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	ret = z_impl_zsock_epoll_wait(epfd, events_copy, maxevents, timeout);
+	if (ret > 0) {
+		K_OOPS(z_user_to_copy(events, events_copy,
+					  ret * sizeof(struct zsock_epoll_event)));
+	}
+
+	k_free(events_copy);
+
+	return ret;
+}
+#include <syscalls/zsock_epoll_wait_mrsh.c>
+#endif /* CONFIG_USERSPACE */
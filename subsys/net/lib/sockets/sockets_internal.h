@@ -20,6 +20,13 @@ int zsock_poll_internal(struct zsock_pollfd *fds, int nfds, k_timeout_t timeout)
 
 int zsock_wait_data(struct net_context *ctx, k_timeout_t *timeout);
 
+ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
+			 int flags, const struct sockaddr *dest_addr,
+			 socklen_t addrlen);
+ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
+			   int flags, struct sockaddr *src_addr,
+			   socklen_t *addrlen);
+
 static inline void sock_set_flag(struct net_context *ctx, uintptr_t mask,
 				 uintptr_t flag)
 {
@@ -47,6 +54,22 @@ static inline bool net_socket_is_tls(void *obj)
 }
 #endif
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+void zsock_epoll_notify(struct net_context *ctx);
+void zsock_epoll_ctx_close(struct net_context *ctx);
+#else
+#define zsock_epoll_notify(ctx)
+#define zsock_epoll_ctx_close(ctx)
+#endif
+
+#if defined(CONFIG_NET_SOCKETS_RTIO)
+void zsock_rtio_notify(struct net_context *ctx);
+void zsock_rtio_ctx_close(struct net_context *ctx);
+#else
+#define zsock_rtio_notify(ctx)
+#define zsock_rtio_ctx_close(ctx)
+#endif
+
 #define sock_is_eof(ctx) sock_get_flag(ctx, SOCK_EOF)
 #define sock_set_eof(ctx) sock_set_flag(ctx, SOCK_EOF, SOCK_EOF)
 #define sock_is_nonblock(ctx) sock_get_flag(ctx, SOCK_NONBLOCK)
@@ -76,6 +99,8 @@ struct socket_op_vtable {
 			   socklen_t *addrlen);
 };
 
+extern const struct socket_op_vtable sock_fd_op_vtable;
+
 size_t msghdr_non_empty_iov_count(const struct msghdr *msg);
 
 #endif /* _SOCKETS_INTERNAL_H_ */
@@ -25,3 +25,50 @@ static inline int z_vrfy_zsock_gethostname(char *buf, size_t len)
 }
 #include <syscalls/zsock_gethostname_mrsh.c>
 #endif
+
+#if defined(CONFIG_PIPES_ZERO_COPY)
+ssize_t zsock_splice_pipe(int sock, struct k_pipe *pipe, size_t len, int flags)
+{
+	k_timeout_t timeout = (flags & ZSOCK_MSG_DONTWAIT) ? K_NO_WAIT : K_FOREVER;
+	size_t spliced = 0;
+
+	while (spliced < len) {
+		size_t size = len - spliced;
+		ssize_t sent;
+		void *data;
+		int ret;
+
+		/* Only the first read waits for data */
+		ret = k_pipe_read_claim(pipe, &data, &size,
+					spliced == 0 ? timeout : K_NO_WAIT);
+		if (ret < 0) {
+			if (spliced > 0) {
+				break;
+			}
+
+			errno = (ret == -EIO) ? EAGAIN : -ret;
+			return -1;
+		}
+
+		sent = zsock_send(sock, data, size, flags);
+
+		(void)k_pipe_read_finish(pipe, sent < 0 ? 0 : sent);
+
+		if (sent < 0) {
+			if (spliced > 0) {
+				break;
+			}
+
+			return -1;
+		}
+
+		spliced += sent;
+
+		if (sent < size) {
+			break;
+		}
+	}
+
+	return spliced;
+}
+#endif /* CONFIG_PIPES_ZERO_COPY */
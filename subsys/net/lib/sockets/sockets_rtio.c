@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* RTIO iodev serving receives and sends on a native socket.
+ *
+ * Each direction has a queue of submissions, served in order by whichever
+ * thread gets to it first: the thread submitting, or the network stack
+ * when the socket receive callback reports new data (through the system
+ * work queue for TCP). A submission the socket cannot serve without
+ * blocking stays at the head of its queue until then.
+ *
+ * TCP sockets do not get a callback when the send window opens again. A
+ * send that would block is retried from the system work queue when the
+ * TCP transmit semaphore becomes available, or after a while for other
+ * sockets.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_rtio.h>
+
+#include "sockets_internal.h"
+#include "../../ip/tcp_internal.h"
+
+#define ZSOCK_RTIO_TX_RETRY K_MSEC(10)
+
+typedef int (*zsock_rtio_op_t)(struct zsock_rtio_data *data, struct net_context *ctx,
+			       struct rtio_iodev_sqe *iodev_sqe);
+
+static bool zsock_rtio_ctx_is_tcp(struct net_context *ctx)
+{
+	return IS_ENABLED(CONFIG_NET_NATIVE_TCP) &&
+	       net_context_get_type(ctx) == SOCK_STREAM &&
+	       !net_if_is_ip_offloaded(net_context_get_iface(ctx));
+}
+
+static void zsock_rtio_complete(struct rtio_iodev_sqe *iodev_sqe, int result)
+{
+	if (result < 0) {
+		rtio_iodev_sqe_err(iodev_sqe, result);
+	} else {
+		rtio_iodev_sqe_ok(iodev_sqe, result);
+	}
+}
+
+/* Receive into the buffer of a submission without blocking, -EAGAIN if
+ * there is nothing to receive yet.
+ */
+static int zsock_rtio_recv(struct zsock_rtio_data *data, struct net_context *ctx,
+			   struct rtio_iodev_sqe *iodev_sqe)
+{
+	bool multishot = (iodev_sqe->sqe.flags & RTIO_SQE_MULTISHOT) != 0;
+	struct net_pkt *pkt = k_fifo_peek_head(&ctx->recv_q);
+	uint8_t *buf;
+	uint32_t buf_len;
+	ssize_t len;
+	int rc;
+
+	if (pkt == NULL) {
+		if (!sock_is_error(ctx) && !sock_is_eof(ctx)) {
+			return -EAGAIN;
+		}
+
+		/* A multishot receive reports the end of the stream once,
+		 * then waits to be canceled.
+		 */
+		if (multishot && data->rx_eof) {
+			return -EAGAIN;
+		}
+		data->rx_eof = multishot;
+
+		return sock_is_error(ctx) ? -POINTER_TO_INT(ctx->user_data) : 0;
+	}
+
+	rc = rtio_sqe_rx_buf(iodev_sqe, 1, MAX(net_pkt_remaining_data(pkt), 1),
+			     &buf, &buf_len);
+	if (rc < 0) {
+		/* A multishot receive waits for buffers to be released,
+		 * which is noticed with the next data received.
+		 */
+		return multishot ? -EAGAIN : rc;
+	}
+
+	len = zsock_recvfrom_ctx(ctx, buf, buf_len, ZSOCK_MSG_DONTWAIT, NULL, NULL);
+
+	return len < 0 ? -errno : len;
+}
+
+/* Send the data of a submission without blocking, -EAGAIN if the socket
+ * is not writable.
+ */
+static int zsock_rtio_send(struct zsock_rtio_data *data, struct net_context *ctx,
+			   struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct rtio_sqe *sqe = &iodev_sqe->sqe;
+	ssize_t len;
+
+	ARG_UNUSED(data);
+
+	if (sqe->op == RTIO_OP_TINY_TX) {
+		len = zsock_sendto_ctx(ctx, sqe->tiny_buf, sqe->tiny_buf_len,
+				       ZSOCK_MSG_DONTWAIT, NULL, 0);
+	} else {
+		len = zsock_sendto_ctx(ctx, sqe->buf, sqe->buf_len,
+				       ZSOCK_MSG_DONTWAIT, NULL, 0);
+	}
+
+	return len < 0 ? -errno : len;
+}
+
+/* Serve the submissions of a queue until one has to wait for the socket.
+ * Returns true if one is waiting.
+ */
+static bool zsock_rtio_serve(struct zsock_rtio_data *data, struct zsock_rtio_queue *queue,
+			     zsock_rtio_op_t op)
+{
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
+	bool waiting = false;
+
+	if (queue->busy) {
+		/* Let the thread serving the queue know there is more */
+		queue->again = true;
+		k_spin_unlock(&data->lock, key);
+		return false;
+	}
+
+	queue->busy = true;
+
+	for (;;) {
+		struct net_context *ctx = data->ctx;
+		struct rtio_iodev_sqe *iodev_sqe;
+		int rc;
+
+		queue->again = false;
+
+		if (queue->curr == NULL) {
+			struct rtio_mpsc_node *node = rtio_mpsc_pop(&queue->q);
+
+			if (node == NULL) {
+				break;
+			}
+
+			queue->curr = CONTAINER_OF(node, struct rtio_iodev_sqe, q);
+		}
+
+		iodev_sqe = queue->curr;
+
+		/* The socket may be closed while the op runs, keep the context
+		 * from being released under it.
+		 */
+		if (ctx != NULL) {
+			(void)net_context_ref(ctx);
+		}
+
+		k_spin_unlock(&data->lock, key);
+
+		if (ctx == NULL || FIELD_GET(RTIO_SQE_CANCELED, iodev_sqe->sqe.flags)) {
+			rc = -ECANCELED;
+		} else {
+			rc = op(data, ctx, iodev_sqe);
+		}
+
+		if (ctx != NULL) {
+			(void)net_context_unref(ctx);
+		}
+
+		key = k_spin_lock(&data->lock);
+
+		if (rc == -EAGAIN) {
+			if (queue->again) {
+				continue;
+			}
+
+			waiting = true;
+			break;
+		}
+
+		queue->curr = NULL;
+		k_spin_unlock(&data->lock, key);
+
+		/* A multishot receive is submitted again from here */
+		zsock_rtio_complete(iodev_sqe, rc);
+
+		key = k_spin_lock(&data->lock);
+	}
+
+	queue->busy = false;
+	k_spin_unlock(&data->lock, key);
+
+	return waiting;
+}
+
+static void zsock_rtio_serve_tx(struct zsock_rtio_data *data)
+{
+	struct net_context *ctx;
+	k_spinlock_key_t key;
+
+	if (!zsock_rtio_serve(data, &data->tx, zsock_rtio_send)) {
+		return;
+	}
+
+	key = k_spin_lock(&data->lock);
+	ctx = data->ctx;
+	if (ctx == NULL) {
+		k_spin_unlock(&data->lock, key);
+		return;
+	}
+
+	(void)net_context_ref(ctx);
+	k_spin_unlock(&data->lock, key);
+
+	if (zsock_rtio_ctx_is_tcp(ctx)) {
+		k_poll_event_init(&data->tx_event, K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, net_tcp_tx_sem_get(ctx));
+	} else {
+		k_poll_event_init(&data->tx_event, K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &data->tx_signal);
+	}
+
+	(void)k_work_poll_submit(&data->tx_work, &data->tx_event, 1, ZSOCK_RTIO_TX_RETRY);
+	(void)net_context_unref(ctx);
+}
+
+static void zsock_rtio_work_handler(struct k_work *work)
+{
+	struct zsock_rtio_data *data = CONTAINER_OF(work, struct zsock_rtio_data, work);
+
+	(void)zsock_rtio_serve(data, &data->rx, zsock_rtio_recv);
+	zsock_rtio_serve_tx(data);
+}
+
+static void zsock_rtio_tx_work_handler(struct k_work *work)
+{
+	struct k_work_poll *tx_work = CONTAINER_OF(work, struct k_work_poll, work);
+	struct zsock_rtio_data *data = CONTAINER_OF(tx_work, struct zsock_rtio_data, tx_work);
+
+	zsock_rtio_serve_tx(data);
+}
+
+static void zsock_rtio_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct zsock_rtio_data *data = iodev_sqe->sqe.iodev->data;
+	struct zsock_rtio_queue *queue;
+
+	if (data->ctx == NULL) {
+		rtio_iodev_sqe_err(iodev_sqe, -EBADF);
+		return;
+	}
+
+	switch (iodev_sqe->sqe.op) {
+	case RTIO_OP_RX:
+		queue = &data->rx;
+		break;
+	case RTIO_OP_TX:
+	case RTIO_OP_TINY_TX:
+		queue = &data->tx;
+		break;
+	default:
+		rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+		return;
+	}
+
+	rtio_mpsc_push(&queue->q, &iodev_sqe->q);
+
+	if (k_is_in_isr()) {
+		k_work_submit(&data->work);
+	} else if (queue == &data->rx) {
+		(void)zsock_rtio_serve(data, queue, zsock_rtio_recv);
+	} else {
+		zsock_rtio_serve_tx(data);
+	}
+}
+
+const struct rtio_iodev_api zsock_rtio_iodev_api = {
+	.submit = zsock_rtio_submit,
+};
+
+void zsock_rtio_notify(struct net_context *ctx)
+{
+	struct rtio_iodev *iodev = ctx->rtio_iodev;
+
+	if (iodev != NULL) {
+		struct zsock_rtio_data *data = iodev->data;
+
+		/* Datagrams are received right away in the context of the
+		 * network stack. Receiving stream data updates the TCP window,
+		 * which is left to the work queue.
+		 */
+		if (!zsock_rtio_ctx_is_tcp(ctx) && !k_is_in_isr()) {
+			(void)zsock_rtio_serve(data, &data->rx, zsock_rtio_recv);
+		} else {
+			k_work_submit(&data->work);
+		}
+	}
+}
+
+int zsock_rtio_iodev_attach(struct rtio_iodev *iodev, int sock)
+{
+	struct zsock_rtio_data *data = iodev->data;
+	struct net_context *ctx;
+	k_spinlock_key_t key;
+
+	ctx = z_get_fd_obj(sock, (const struct fd_op_vtable *)&sock_fd_op_vtable, EBADF);
+	if (ctx == NULL) {
+		return -EBADF;
+	}
+
+	key = k_spin_lock(&data->lock);
+
+	if (data->ctx != NULL || ctx->rtio_iodev != NULL) {
+		k_spin_unlock(&data->lock, key);
+		return -EBUSY;
+	}
+
+	rtio_mpsc_init(&data->rx.q);
+	rtio_mpsc_init(&data->tx.q);
+	data->rx.curr = NULL;
+	data->tx.curr = NULL;
+	data->rx_eof = false;
+	k_work_init(&data->work, zsock_rtio_work_handler);
+	k_work_poll_init(&data->tx_work, zsock_rtio_tx_work_handler);
+	k_poll_signal_init(&data->tx_signal);
+
+	data->ctx = ctx;
+	ctx->rtio_iodev = iodev;
+
+	k_spin_unlock(&data->lock, key);
+
+	return 0;
+}
+
+void zsock_rtio_iodev_detach(struct rtio_iodev *iodev)
+{
+	struct zsock_rtio_data *data = iodev->data;
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+	if (data->ctx == NULL) {
+		k_spin_unlock(&data->lock, key);
+		return;
+	}
+
+	data->ctx->rtio_iodev = NULL;
+	data->ctx = NULL;
+
+	k_spin_unlock(&data->lock, key);
+
+	(void)k_work_poll_cancel(&data->tx_work);
+
+	/* Without a socket whatever is left completes as canceled */
+	(void)zsock_rtio_serve(data, &data->rx, zsock_rtio_recv);
+	(void)zsock_rtio_serve(data, &data->tx, zsock_rtio_send);
+}
+
+void zsock_rtio_ctx_close(struct net_context *ctx)
+{
+	struct rtio_iodev *iodev = ctx->rtio_iodev;
+
+	if (iodev != NULL) {
+		zsock_rtio_iodev_detach(iodev);
+	}
+}
@@ -45,6 +45,211 @@ static void rtio_executor_op(struct rtio_iodev_sqe *iodev_sqe)
 	}
 }
 
+/**
+ * @brief Start a chain, either handled by the executor or by its iodev
+ */
+static inline void rtio_executor_start(struct rtio_iodev_sqe *iodev_sqe)
+{
+	if (iodev_sqe->sqe.iodev == NULL) {
+		rtio_executor_op(iodev_sqe);
+	} else {
+		rtio_iodev_submit(iodev_sqe);
+	}
+}
+
+#ifdef CONFIG_RTIO_EXECUTOR_CONCURRENT
+
+/**
+ * @brief Priority class of a chain, 0 being the first served
+ */
+static inline int rtio_executor_prio_class(const struct rtio_iodev_sqe *iodev_sqe)
+{
+	if (iodev_sqe->sqe.prio > RTIO_PRIO_NORM) {
+		return 0;
+	} else if (iodev_sqe->sqe.prio == RTIO_PRIO_NORM) {
+		return 1;
+	}
+
+	return 2;
+}
+
+/**
+ * @brief Find the slot of a chain in flight on an iodev
+ *
+ * @retval -1 No chain of the context is in flight on the iodev
+ */
+static int rtio_executor_iodev_slot(struct rtio *r, const struct rtio_iodev *iodev)
+{
+	for (int i = 0; i < r->exec_inflight; i++) {
+		if (r->exec_iodevs[i] == iodev) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Queue a chain until the executor can start it
+ */
+static void rtio_executor_queue(struct rtio *r, struct rtio_iodev_sqe *iodev_sqe)
+{
+	k_spinlock_key_t key = k_spin_lock(&r->exec_lock);
+
+	sys_slist_append(&r->exec_pending[rtio_executor_prio_class(iodev_sqe)],
+			 &iodev_sqe->pending);
+
+	k_spin_unlock(&r->exec_lock, key);
+}
+
+/**
+ * @brief Take the next chain to start
+ *
+ * That is the oldest chain of the highest priority class whose iodev has no
+ * chain of the same context in flight. Chains for a busy iodev are skipped,
+ * leaving its queue in order without blocking the other iodevs.
+ *
+ * Must be called with the executor lock held.
+ *
+ * @retval NULL Nothing can be started
+ */
+static struct rtio_iodev_sqe *rtio_executor_next(struct rtio *r)
+{
+	if (r->exec_inflight >= CONFIG_RTIO_EXECUTOR_CONCURRENT_DEPTH) {
+		return NULL;
+	}
+
+	for (int i = 0; i < RTIO_PRIO_CLASSES; i++) {
+		sys_snode_t *node, *prev = NULL;
+
+		SYS_SLIST_FOR_EACH_NODE(&r->exec_pending[i], node) {
+			struct rtio_iodev_sqe *iodev_sqe =
+				CONTAINER_OF(node, struct rtio_iodev_sqe, pending);
+			const struct rtio_iodev *iodev = iodev_sqe->sqe.iodev;
+
+			if (iodev == NULL || rtio_executor_iodev_slot(r, iodev) < 0) {
+				sys_slist_remove(&r->exec_pending[i], prev, node);
+				r->exec_iodevs[r->exec_inflight++] = iodev;
+				return iodev_sqe;
+			}
+			prev = node;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Start queued chains while there is room for them
+ *
+ * Completions of synchronous iodevs and callbacks come back from within the
+ * start of a chain and dispatch again. Only the outermost dispatch runs the
+ * loop, the nested ones leave the chains they made ready to it, so the stack
+ * does not grow with the number of chains.
+ */
+static void rtio_executor_dispatch(struct rtio *r)
+{
+	struct rtio_iodev_sqe *iodev_sqe;
+	k_spinlock_key_t key = k_spin_lock(&r->exec_lock);
+
+	if (r->exec_dispatching) {
+		k_spin_unlock(&r->exec_lock, key);
+		return;
+	}
+
+	r->exec_dispatching = true;
+
+	for (iodev_sqe = rtio_executor_next(r); iodev_sqe != NULL;
+	     iodev_sqe = rtio_executor_next(r)) {
+		k_spin_unlock(&r->exec_lock, key);
+		rtio_executor_start(iodev_sqe);
+		key = k_spin_lock(&r->exec_lock);
+	}
+
+	/* Cleared with the lock held since the last check, whatever completes
+	 * from now on dispatches itself
+	 */
+	r->exec_dispatching = false;
+
+	k_spin_unlock(&r->exec_lock, key);
+}
+
+/**
+ * @brief Release the slot of a chain in flight on an iodev
+ */
+static void rtio_executor_release(struct rtio *r, const struct rtio_iodev *iodev)
+{
+	int slot = rtio_executor_iodev_slot(r, iodev);
+
+	__ASSERT(slot >= 0, "Expected a chain in flight on iodev %p", iodev);
+	r->exec_iodevs[slot] = r->exec_iodevs[--r->exec_inflight];
+}
+
+/**
+ * @brief Move a chain in flight to its next submission
+ *
+ * The chain gives up its slot and the next submission waits ahead of the
+ * chains of its priority class, so it is only handed to its iodev once no
+ * other chain of the context is in flight there.
+ */
+static void rtio_executor_chain_next(struct rtio *r, const struct rtio_iodev *iodev,
+				     struct rtio_iodev_sqe *next)
+{
+	k_spinlock_key_t key = k_spin_lock(&r->exec_lock);
+
+	rtio_executor_release(r, iodev);
+	sys_slist_prepend(&r->exec_pending[rtio_executor_prio_class(next)], &next->pending);
+
+	k_spin_unlock(&r->exec_lock, key);
+
+	rtio_executor_dispatch(r);
+}
+
+/**
+ * @brief Release the slot of a completed chain and start what now can be
+ */
+static void rtio_executor_chain_done(struct rtio *r, const struct rtio_iodev *iodev)
+{
+	k_spinlock_key_t key = k_spin_lock(&r->exec_lock);
+
+	rtio_executor_release(r, iodev);
+
+	k_spin_unlock(&r->exec_lock, key);
+
+	rtio_executor_dispatch(r);
+}
+
+#else
+
+static inline void rtio_executor_queue(struct rtio *r, struct rtio_iodev_sqe *iodev_sqe)
+{
+	ARG_UNUSED(r);
+
+	rtio_executor_start(iodev_sqe);
+}
+
+static inline void rtio_executor_dispatch(struct rtio *r)
+{
+	ARG_UNUSED(r);
+}
+
+static inline void rtio_executor_chain_next(struct rtio *r, const struct rtio_iodev *iodev,
+					    struct rtio_iodev_sqe *next)
+{
+	ARG_UNUSED(r);
+	ARG_UNUSED(iodev);
+
+	rtio_iodev_submit(next);
+}
+
+static inline void rtio_executor_chain_done(struct rtio *r, const struct rtio_iodev *iodev)
+{
+	ARG_UNUSED(r);
+	ARG_UNUSED(iodev);
+}
+
+#endif /* CONFIG_RTIO_EXECUTOR_CONCURRENT */
+
 /**
  * @brief Submit operations in the queue to iodevs
  *
@@ -62,9 +267,7 @@ void rtio_executor_submit(struct rtio *r)
 
 		iodev_sqe->r = r;
 
-		if (iodev_sqe->sqe.iodev == NULL) {
-			rtio_executor_op(iodev_sqe);
-		} else {
+		if (iodev_sqe->sqe.iodev != NULL) {
 			struct rtio_iodev_sqe *curr = iodev_sqe, *next;
 
 			/* Link up transaction or queue list if needed */
@@ -90,12 +293,14 @@ void rtio_executor_submit(struct rtio *r)
 
 			curr->next = NULL;
 			curr->r = r;
-
-			rtio_iodev_submit(iodev_sqe);
 		}
 
+		rtio_executor_queue(r, iodev_sqe);
+
 		node = rtio_mpsc_pop(&r->sq);
 	}
+
+	rtio_executor_dispatch(r);
 }
 
 /**
@@ -132,6 +337,7 @@ static inline void rtio_executor_done(struct rtio_iodev_sqe *iodev_sqe, int resu
 	const bool is_multishot = FIELD_GET(RTIO_SQE_MULTISHOT, iodev_sqe->sqe.flags) == 1;
 	const bool is_canceled = FIELD_GET(RTIO_SQE_CANCELED, iodev_sqe->sqe.flags) == 1;
 	struct rtio *r = iodev_sqe->r;
+	const struct rtio_iodev *iodev = iodev_sqe->sqe.iodev;
 	struct rtio_iodev_sqe *curr = iodev_sqe, *next;
 	void *userdata;
 	uint32_t sqe_flags, cqe_flags;
@@ -162,7 +368,9 @@ static inline void rtio_executor_done(struct rtio_iodev_sqe *iodev_sqe, int resu
 
 	/* Curr should now be the last sqe in the transaction if that is what completed */
 	if (sqe_flags & RTIO_SQE_CHAINED) {
-		rtio_iodev_submit(curr);
+		rtio_executor_chain_next(r, iodev, curr);
+	} else {
+		rtio_executor_chain_done(r, iodev);
 	}
 }
 
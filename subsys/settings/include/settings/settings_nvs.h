@@ -46,6 +46,18 @@ struct settings_nvs {
 
 	uint16_t cache_next;
 #endif
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	/* Hash of each stored name, indexed by NVS ID - NVS_NAMECNT_ID - 1,
+	 * chained from index_head[] by hash value.
+	 */
+	struct {
+		uint16_t name_hash;
+		uint16_t next;
+	} index[CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE];
+
+	uint16_t index_head[CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE];
+	uint8_t index_state;
+#endif
 };
 
 /* register nvs to be a source of settings */
@@ -24,6 +24,80 @@ sys_slist_t settings_handlers;
 
 K_MUTEX_DEFINE(settings_lock);
 
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+/* Static handlers sorted by name, equal names kept in section order */
+static struct settings_handler_static *handler_index[CONFIG_SETTINGS_HANDLER_INDEX_SIZE];
+static size_t handler_index_cnt;
+static bool handler_index_valid;
+
+/* Compare a handler name with the first len characters of name */
+static int settings_index_cmp(const char *hname, const char *name, size_t len)
+{
+	int rc = strncmp(hname, name, len);
+
+	if (rc == 0 && hname[len] != '\0') {
+		rc = 1;
+	}
+
+	return rc;
+}
+
+/* Index of the first handler whose name sorts after the first len
+ * characters of name.
+ */
+static size_t settings_index_upper(const char *name, size_t len)
+{
+	size_t lo = 0, hi = handler_index_cnt;
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+
+		if (settings_index_cmp(handler_index[mid]->name, name, len) <= 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static struct settings_handler_static *settings_index_find(const char *name,
+							   size_t len)
+{
+	size_t i = settings_index_upper(name, len);
+
+	/* The last of equal names wins, as in the section walk */
+	if (i > 0 && settings_index_cmp(handler_index[i - 1]->name, name, len) == 0) {
+		return handler_index[i - 1];
+	}
+
+	return NULL;
+}
+
+static void settings_index_init(void)
+{
+	handler_index_cnt = 0;
+	handler_index_valid = false;
+
+	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
+		size_t i;
+
+		if (handler_index_cnt == ARRAY_SIZE(handler_index)) {
+			LOG_WRN("Too many static handlers for the index");
+			return;
+		}
+
+		i = settings_index_upper(ch->name, strlen(ch->name));
+		memmove(&handler_index[i + 1], &handler_index[i],
+			(handler_index_cnt - i) * sizeof(handler_index[0]));
+		handler_index[i] = ch;
+		handler_index_cnt++;
+	}
+
+	handler_index_valid = true;
+}
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
 
 void settings_store_init(void);
 
@@ -32,6 +106,9 @@ void settings_init(void)
 #if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
 	sys_slist_init(&settings_handlers);
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	settings_index_init();
+#endif
 	settings_store_init();
 }
 
@@ -40,10 +117,19 @@ int settings_register(struct settings_handler *handler)
 {
 	int rc = 0;
 
-	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
-		if (strcmp(handler->name, ch->name) == 0) {
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	if (handler_index_valid) {
+		if (settings_index_find(handler->name, strlen(handler->name))) {
 			return -EEXIST;
 		}
+	} else
+#endif
+	{
+		STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
+			if (strcmp(handler->name, ch->name) == 0) {
+				return -EEXIST;
+			}
+		}
 	}
 
 	k_mutex_lock(&settings_lock, K_FOREVER);
@@ -134,6 +220,35 @@ int settings_name_next(const char *name, const char **next)
 	return rc;
 }
 
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+/* Look up each leading run of name components in the index, the longest
+ * one found is the best match.
+ */
+static struct settings_handler_static *settings_index_lookup(const char *name,
+							     const char **next)
+{
+	struct settings_handler_static *bestmatch = NULL;
+	struct settings_handler_static *ch;
+	const char *comp = name;
+	const char *tmpnext;
+	size_t len;
+
+	do {
+		len = settings_name_next(comp, &tmpnext);
+		ch = settings_index_find(name, (comp - name) + len);
+		if (ch) {
+			bestmatch = ch;
+			if (next) {
+				*next = tmpnext;
+			}
+		}
+		comp = tmpnext;
+	} while (comp);
+
+	return bestmatch;
+}
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
+
 struct settings_handler_static *settings_parse_and_lookup(const char *name,
 							const char **next)
 {
@@ -145,21 +260,28 @@ struct settings_handler_static *settings_parse_and_lookup(const char *name,
 		*next = NULL;
 	}
 
-	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
-		if (!settings_name_steq(name, ch->name, &tmpnext)) {
-			continue;
-		}
-		if (!bestmatch) {
-			bestmatch = ch;
-			if (next) {
-				*next = tmpnext;
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	if (handler_index_valid) {
+		bestmatch = settings_index_lookup(name, next);
+	} else
+#endif
+	{
+		STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
+			if (!settings_name_steq(name, ch->name, &tmpnext)) {
+				continue;
 			}
-			continue;
-		}
-		if (settings_name_steq(ch->name, bestmatch->name, NULL)) {
-			bestmatch = ch;
-			if (next) {
-				*next = tmpnext;
+			if (!bestmatch) {
+				bestmatch = ch;
+				if (next) {
+					*next = tmpnext;
+				}
+				continue;
+			}
+			if (settings_name_steq(ch->name, bestmatch->name, NULL)) {
+				bestmatch = ch;
+				if (next) {
+					*next = tmpnext;
+				}
 			}
 		}
 	}
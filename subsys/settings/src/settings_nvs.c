@@ -118,6 +118,151 @@ static uint16_t settings_nvs_cache_match(struct settings_nvs *cf, const char *na
 }
 #endif /* CONFIG_SETTINGS_NVS_NAME_CACHE */
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+#define NVS_INDEX_SIZE CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE
+
+/* Index states: not built yet, usable, or too small for the stored names */
+#define NVS_INDEX_EMPTY 0
+#define NVS_INDEX_READY 1
+#define NVS_INDEX_DISABLED 2
+
+/* index[].next of a free entry, and end of a hash chain */
+#define NVS_INDEX_FREE 0xffff
+#define NVS_INDEX_END 0xfffe
+
+static void settings_nvs_index_reset(struct settings_nvs *cf)
+{
+	for (int i = 0; i < NVS_INDEX_SIZE; i++) {
+		cf->index[i].next = NVS_INDEX_FREE;
+		cf->index_head[i] = NVS_INDEX_END;
+	}
+
+	if (cf->last_name_id - NVS_NAMECNT_ID > NVS_INDEX_SIZE) {
+		LOG_WRN("Too many names for the NVS name index");
+		cf->index_state = NVS_INDEX_DISABLED;
+	}
+}
+
+static void settings_nvs_index_add(struct settings_nvs *cf, const char *name,
+				   uint16_t name_id)
+{
+	uint16_t slot = name_id - NVS_NAMECNT_ID - 1;
+	uint16_t name_hash;
+	uint16_t *head;
+
+	if (slot >= NVS_INDEX_SIZE) {
+		if (cf->index_state == NVS_INDEX_READY) {
+			LOG_WRN("Too many names for the NVS name index");
+		}
+		cf->index_state = NVS_INDEX_DISABLED;
+		return;
+	}
+
+	if (cf->index[slot].next != NVS_INDEX_FREE) {
+		return;
+	}
+
+	name_hash = crc16_ccitt(0xffff, name, strlen(name));
+	head = &cf->index_head[name_hash % NVS_INDEX_SIZE];
+
+	cf->index[slot].name_hash = name_hash;
+	cf->index[slot].next = *head;
+	*head = slot;
+}
+
+static void settings_nvs_index_del(struct settings_nvs *cf, uint16_t name_id)
+{
+	uint16_t slot = name_id - NVS_NAMECNT_ID - 1;
+	uint16_t *link;
+
+	if ((slot >= NVS_INDEX_SIZE) || (cf->index[slot].next == NVS_INDEX_FREE)) {
+		return;
+	}
+
+	link = &cf->index_head[cf->index[slot].name_hash % NVS_INDEX_SIZE];
+	while (*link != slot) {
+		link = &cf->index[*link].next;
+	}
+
+	*link = cf->index[slot].next;
+	cf->index[slot].next = NVS_INDEX_FREE;
+}
+
+/* Build the index from the stored names, unless settings_nvs_load() has
+ * already done it while going through them.
+ */
+static void settings_nvs_index_build(struct settings_nvs *cf, char *rdname,
+				     size_t len)
+{
+	uint16_t name_id;
+	ssize_t rc;
+
+	settings_nvs_index_reset(cf);
+	if (cf->index_state == NVS_INDEX_DISABLED) {
+		return;
+	}
+
+	for (name_id = NVS_NAMECNT_ID + 1; name_id <= cf->last_name_id; name_id++) {
+		rc = nvs_read(&cf->cf_nvs, name_id, rdname, len);
+		if (rc <= 0) {
+			continue;
+		}
+
+		rdname[rc] = '\0';
+		settings_nvs_index_add(cf, rdname, name_id);
+	}
+
+	cf->index_state = NVS_INDEX_READY;
+}
+
+static uint16_t settings_nvs_index_match(struct settings_nvs *cf, const char *name,
+					 char *rdname, size_t len)
+{
+	uint16_t name_hash = crc16_ccitt(0xffff, name, strlen(name));
+	uint16_t slot, name_id;
+	int rc;
+
+	for (slot = cf->index_head[name_hash % NVS_INDEX_SIZE];
+	     slot != NVS_INDEX_END; slot = cf->index[slot].next) {
+		if (cf->index[slot].name_hash != name_hash) {
+			continue;
+		}
+
+		name_id = slot + NVS_NAMECNT_ID + 1;
+		rc = nvs_read(&cf->cf_nvs, name_id, rdname, len);
+		if (rc < 0) {
+			continue;
+		}
+
+		rdname[rc] = '\0';
+
+		if (strcmp(name, rdname)) {
+			continue;
+		}
+
+		return name_id;
+	}
+
+	return NVS_NAMECNT_ID;
+}
+
+/* Lowest name ID without a stored name, as the scan in settings_nvs_save()
+ * would pick.
+ */
+static uint16_t settings_nvs_index_free_id(struct settings_nvs *cf)
+{
+	uint16_t slot;
+
+	for (slot = 0; slot < cf->last_name_id - NVS_NAMECNT_ID; slot++) {
+		if (cf->index[slot].next == NVS_INDEX_FREE) {
+			return slot + NVS_NAMECNT_ID + 1;
+		}
+	}
+
+	return cf->last_name_id + 1;
+}
+#endif /* CONFIG_SETTINGS_NVS_NAME_INDEX */
+
 static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg)
 {
@@ -129,12 +274,25 @@ static int settings_nvs_load(struct settings_store *cs,
 	ssize_t rc1, rc2;
 	uint16_t name_id = NVS_NAMECNT_ID;
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	bool index_build = (cf->index_state == NVS_INDEX_EMPTY);
+
+	if (index_build) {
+		settings_nvs_index_reset(cf);
+	}
+#endif
+
 	name_id = cf->last_name_id + 1;
 
 	while (1) {
 
 		name_id--;
 		if (name_id == NVS_NAMECNT_ID) {
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+			if (index_build && (cf->index_state == NVS_INDEX_EMPTY)) {
+				cf->index_state = NVS_INDEX_READY;
+			}
+#endif
 			break;
 		}
 
@@ -163,6 +321,9 @@ static int settings_nvs_load(struct settings_store *cs,
 			}
 			nvs_delete(&cf->cf_nvs, name_id);
 			nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+			settings_nvs_index_del(cf, name_id);
+#endif
 			continue;
 		}
 
@@ -174,6 +335,11 @@ static int settings_nvs_load(struct settings_store *cs,
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 		settings_nvs_cache_add(cf, name, name_id);
 #endif
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+		if (index_build) {
+			settings_nvs_index_add(cf, name, name_id);
+		}
+#endif
 
 		ret = settings_call_set_handler(
 			name, rc2,
@@ -202,6 +368,24 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	/* Find out if we are doing a delete */
 	delete = ((value == NULL) || (val_len == 0));
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	if (cf->index_state == NVS_INDEX_EMPTY) {
+		settings_nvs_index_build(cf, rdname, sizeof(rdname));
+	}
+
+	if (cf->index_state == NVS_INDEX_READY) {
+		name_id = settings_nvs_index_match(cf, name, rdname, sizeof(rdname));
+		if (name_id != NVS_NAMECNT_ID) {
+			write_name_id = name_id;
+			write_name = false;
+		} else {
+			write_name_id = settings_nvs_index_free_id(cf);
+			write_name = true;
+		}
+		goto found;
+	}
+#endif
+
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 	name_id = settings_nvs_cache_match(cf, name, rdname, sizeof(rdname));
 	if (name_id != NVS_NAMECNT_ID) {
@@ -269,6 +453,9 @@ found:
 		rc = nvs_delete(&cf->cf_nvs, name_id);
 
 		if (rc >= 0) {
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+			settings_nvs_index_del(cf, name_id);
+#endif
 			rc = nvs_delete(&cf->cf_nvs, name_id +
 					NVS_NAME_ID_OFFSET);
 		}
@@ -298,6 +485,9 @@ found:
 		if (rc < 0) {
 			return rc;
 		}
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+		settings_nvs_index_add(cf, name, write_name_id);
+#endif
 	}
 
 	/* update the last_name_id and write to flash if required*/
@@ -338,6 +528,10 @@ int settings_nvs_backend_init(struct settings_nvs *cf)
 		cf->last_name_id = last_name_id;
 	}
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	cf->index_state = NVS_INDEX_EMPTY;
+#endif
+
 	LOG_DBG("Initialized");
 	return 0;
 }
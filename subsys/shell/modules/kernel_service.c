@@ -76,6 +76,7 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 	const char *tname;
 	int ret;
 	char state_str[32];
+	int64_t timeout;
 
 #ifdef CONFIG_THREAD_RUNTIME_STATS
 	k_thread_runtime_stats_t rt_stats_thread;
@@ -88,11 +89,17 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 		      (thread == k_current_get()) ? "*" : " ",
 		      thread,
 		      tname ? tname : "NA");
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	/* dticks holds the absolute expiry tick in this mode */
+	timeout = k_thread_timeout_remaining_ticks(thread);
+#else
+	timeout = thread->base.timeout.dticks;
+#endif
 	/* Cannot use lld as it's less portable. */
 	shell_print(sh, "\toptions: 0x%x, priority: %d timeout: %" PRId64,
 		      thread->base.user_options,
 		      thread->base.prio,
-		      (int64_t)thread->base.timeout.dticks);
+		      timeout);
 	shell_print(sh, "\tstate: %s, entry: %p",
 		    k_thread_state_str(thread, state_str, sizeof(state_str)),
 		    thread->entry.pEntry);
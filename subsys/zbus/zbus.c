@@ -7,8 +7,13 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/zbus/zbus.h>
+#if defined(CONFIG_ZBUS_MSG_BUF)
+#include <zephyr/net/buf.h>
+#endif
 LOG_MODULE_REGISTER(zbus, CONFIG_ZBUS_LOG_LEVEL);
 
+struct net_buf;
+
 k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks)
 {
 	int64_t now_ticks = sys_clock_tick_get();
@@ -16,6 +21,86 @@ k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks)
 	return K_TICKS((k_ticks_t)MAX(end_ticks - now_ticks, 0));
 }
 
+#if defined(CONFIG_ZBUS_MSG_BUF)
+/* Message copies, with the channel's reference as user data. The data of a copy is reference
+ * counted, so every message subscriber of the channel gets its own buffer sharing it.
+ */
+NET_BUF_POOL_VAR_DEFINE(_zbus_msg_pool, CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_SIZE,
+			CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_DATA_SIZE,
+			sizeof(struct zbus_channel *), NULL);
+
+static struct net_buf *_zbus_msg_buf_alloc(const struct zbus_channel *chan, const void *msg,
+					   k_timeout_t timeout)
+{
+	struct net_buf *buf = net_buf_alloc_len(&_zbus_msg_pool, chan->message_size, timeout);
+
+	if (buf == NULL) {
+		return NULL;
+	}
+
+	net_buf_add_mem(buf, msg, chan->message_size);
+	memcpy(net_buf_user_data(buf), &chan, sizeof(chan));
+
+	return buf;
+}
+
+static inline void _zbus_msg_buf_release(struct net_buf *buf)
+{
+	if (buf != NULL) {
+		net_buf_unref(buf);
+	}
+}
+#else
+#define _zbus_msg_buf_release(_buf) ARG_UNUSED(_buf)
+#endif /* CONFIG_ZBUS_MSG_BUF */
+
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
+static int _zbus_notify_msg_subscriber(const struct zbus_channel *chan,
+				       const struct zbus_observer *obs, struct net_buf **msg_buf,
+				       uint64_t end_ticks)
+{
+	struct net_buf *buf;
+
+	/* The channel's message is copied once, for the first message subscriber */
+	if (*msg_buf == NULL) {
+		*msg_buf = _zbus_msg_buf_alloc(chan, chan->message,
+					       _zbus_timeout_remainder(end_ticks));
+		if (*msg_buf == NULL) {
+			return -ENOMEM;
+		}
+	}
+
+	buf = net_buf_clone(*msg_buf, _zbus_timeout_remainder(end_ticks));
+	if (buf == NULL) {
+		return -ENOMEM;
+	}
+
+	memcpy(net_buf_user_data(buf), &chan, sizeof(chan));
+	net_buf_put(obs->message_fifo, buf);
+
+	return 0;
+}
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
+
+static inline int _zbus_notify_subscriber(const struct zbus_channel *chan,
+					  const struct zbus_observer *obs,
+					  struct net_buf **msg_buf, uint64_t end_ticks)
+{
+	if (obs->queue != NULL) {
+		return k_msgq_put(obs->queue, &chan, _zbus_timeout_remainder(end_ticks));
+	}
+
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
+	if (obs->message_fifo != NULL) {
+		return _zbus_notify_msg_subscriber(chan, obs, msg_buf, end_ticks);
+	}
+#else
+	ARG_UNUSED(msg_buf);
+#endif
+
+	return 0;
+}
+
 #if (CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE > 0)
 static inline void _zbus_notify_runtime_listeners(const struct zbus_channel *chan)
 {
@@ -34,7 +119,7 @@ static inline void _zbus_notify_runtime_listeners(const struct zbus_channel *cha
 }
 
 static inline int _zbus_notify_runtime_subscribers(const struct zbus_channel *chan,
-						   uint64_t end_ticks)
+						   struct net_buf **msg_buf, uint64_t end_ticks)
 {
 	__ASSERT(chan != NULL, "chan is required");
 
@@ -45,9 +130,8 @@ static inline int _zbus_notify_runtime_subscribers(const struct zbus_channel *ch
 
 		__ASSERT(obs_nd != NULL, "observer node is NULL");
 
-		if (obs_nd->obs->enabled && (obs_nd->obs->queue != NULL)) {
-			err = k_msgq_put(obs_nd->obs->queue, &chan,
-					 _zbus_timeout_remainder(end_ticks));
+		if (obs_nd->obs->enabled && (obs_nd->obs->callback == NULL)) {
+			err = _zbus_notify_subscriber(chan, obs_nd->obs, msg_buf, end_ticks);
 
 			_ZBUS_ASSERT(err == 0,
 				     "could not deliver notification to observer %s. Error code %d",
@@ -63,7 +147,12 @@ static inline int _zbus_notify_runtime_subscribers(const struct zbus_channel *ch
 }
 #endif /* CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE */
 
-static int _zbus_notify_observers(const struct zbus_channel *chan, uint64_t end_ticks)
+/* Notify the observers of a channel. Message subscribers get a copy of the channel's message in
+ * a buffer, which is made the first time one is needed unless @p msg_buf already points to one.
+ * The caller releases the buffer.
+ */
+static int _zbus_notify_observers(const struct zbus_channel *chan, uint64_t end_ticks,
+				  struct net_buf **msg_buf)
 {
 	int last_error = 0, err;
 	/* Notify static listeners */
@@ -79,8 +168,8 @@ static int _zbus_notify_observers(const struct zbus_channel *chan, uint64_t end_
 
 	/* Notify static subscribers */
 	for (const struct zbus_observer *const *obs = chan->observers; *obs != NULL; ++obs) {
-		if ((*obs)->enabled && ((*obs)->queue != NULL)) {
-			err = k_msgq_put((*obs)->queue, &chan, _zbus_timeout_remainder(end_ticks));
+		if ((*obs)->enabled && ((*obs)->callback == NULL)) {
+			err = _zbus_notify_subscriber(chan, *obs, msg_buf, end_ticks);
 			_ZBUS_ASSERT(err == 0, "could not deliver notification to observer %s.",
 				     _ZBUS_OBS_NAME(*obs));
 			if (err) {
@@ -92,7 +181,7 @@ static int _zbus_notify_observers(const struct zbus_channel *chan, uint64_t end_
 	}
 
 #if CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE > 0
-	err = _zbus_notify_runtime_subscribers(chan, end_ticks);
+	err = _zbus_notify_runtime_subscribers(chan, msg_buf, end_ticks);
 	if (err) {
 		last_error = err;
 	}
@@ -104,6 +193,7 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
 {
 	int err;
 	uint64_t end_ticks = sys_clock_timeout_end_calc(timeout);
+	struct net_buf *msg_buf = NULL;
 
 	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
@@ -120,13 +210,69 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
 
 	memcpy(chan->message, msg, chan->message_size);
 
-	err = _zbus_notify_observers(chan, end_ticks);
+	err = _zbus_notify_observers(chan, end_ticks, &msg_buf);
 
 	k_mutex_unlock(chan->mutex);
 
+	_zbus_msg_buf_release(msg_buf);
+
 	return err;
 }
 
+#if defined(CONFIG_ZBUS_PUB_ISR)
+static void _zbus_pub_isr_work_handler(struct k_work *work);
+
+static K_FIFO_DEFINE(_zbus_pub_isr_fifo);
+static K_WORK_DEFINE(_zbus_pub_isr_work, _zbus_pub_isr_work_handler);
+
+static void _zbus_pub_isr_work_handler(struct k_work *work)
+{
+	struct net_buf *msg_buf;
+
+	ARG_UNUSED(work);
+
+	while ((msg_buf = net_buf_get(&_zbus_pub_isr_fifo, K_NO_WAIT)) != NULL) {
+		const struct zbus_channel *chan;
+
+		memcpy(&chan, net_buf_user_data(msg_buf), sizeof(chan));
+
+		(void)k_mutex_lock(chan->mutex, K_FOREVER);
+
+		memcpy(chan->message, msg_buf->data, chan->message_size);
+
+		/* Message subscribers get the buffer the message was published in */
+		(void)_zbus_notify_observers(chan, sys_clock_timeout_end_calc(K_NO_WAIT),
+					     &msg_buf);
+
+		k_mutex_unlock(chan->mutex);
+
+		net_buf_unref(msg_buf);
+	}
+}
+
+int zbus_chan_pub_isr(const struct zbus_channel *chan, const void *msg)
+{
+	struct net_buf *msg_buf;
+
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(msg != NULL, "msg is required");
+
+	if (chan->validator != NULL && !chan->validator(msg, chan->message_size)) {
+		return -ENOMSG;
+	}
+
+	msg_buf = _zbus_msg_buf_alloc(chan, msg, K_NO_WAIT);
+	if (msg_buf == NULL) {
+		return -ENOMEM;
+	}
+
+	net_buf_put(&_zbus_pub_isr_fifo, msg_buf);
+	k_work_submit(&_zbus_pub_isr_work);
+
+	return 0;
+}
+#endif /* CONFIG_ZBUS_PUB_ISR */
+
 int zbus_chan_read(const struct zbus_channel *chan, void *msg, k_timeout_t timeout)
 {
 	int err;
@@ -149,6 +295,7 @@ int zbus_chan_notify(const struct zbus_channel *chan, k_timeout_t timeout)
 {
 	int err;
 	uint64_t end_ticks = sys_clock_timeout_end_calc(timeout);
+	struct net_buf *msg_buf = NULL;
 
 	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
@@ -158,10 +305,12 @@ int zbus_chan_notify(const struct zbus_channel *chan, k_timeout_t timeout)
 		return err;
 	}
 
-	err = _zbus_notify_observers(chan, end_ticks);
+	err = _zbus_notify_observers(chan, end_ticks, &msg_buf);
 
 	k_mutex_unlock(chan->mutex);
 
+	_zbus_msg_buf_release(msg_buf);
+
 	return err;
 }
 
@@ -202,3 +351,32 @@ int zbus_sub_wait(const struct zbus_observer *sub, const struct zbus_channel **c
 
 	return k_msgq_get(sub->queue, chan, timeout);
 }
+
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
+int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel **chan, void *msg,
+		      k_timeout_t timeout)
+{
+	struct net_buf *buf;
+
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
+	_ZBUS_ASSERT(sub != NULL, "sub is required");
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(msg != NULL, "msg is required");
+
+	if (sub->message_fifo == NULL) {
+		return -EINVAL;
+	}
+
+	buf = net_buf_get(sub->message_fifo, timeout);
+	if (buf == NULL) {
+		return K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? -ENOMSG : -EAGAIN;
+	}
+
+	memcpy(chan, net_buf_user_data(buf), sizeof(*chan));
+	memcpy(msg, buf->data, buf->len);
+
+	net_buf_unref(buf);
+
+	return 0;
+}
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/data/json.h>
+#include <string.h>
+
+/* This benchmark measures the parsing throughput of the JSON library, for
+ * an object of 48 numbers, booleans and strings as sent by LwM2M or cloud
+ * services:
+ *
+ * - json_obj_parse() with the keys in the order of the descriptor, as
+ *   written by json_obj_encode(), and in the reverse order,
+ * - the streaming parser, given the document in chunks of 16 and 256 bytes.
+ *
+ * The time per document and the number of bytes parsed per second are
+ * reported.
+ */
+
+#define N_FIELDS 16
+#define ITERATIONS 200
+#define PAYLOAD_SIZE 2048
+
+#define NUM_FIELD(i, _) int32_t num##i
+#define BOOL_FIELD(i, _) bool flag##i
+#define STR_FIELD(i, _) char *str##i
+
+struct payload {
+	LISTIFY(N_FIELDS, NUM_FIELD, (;));
+	LISTIFY(N_FIELDS, BOOL_FIELD, (;));
+	LISTIFY(N_FIELDS, STR_FIELD, (;));
+};
+
+#define NUM_DESCR(i, _) JSON_OBJ_DESCR_PRIM(struct payload, num##i, JSON_TOK_NUMBER)
+#define BOOL_DESCR(i, _) JSON_OBJ_DESCR_PRIM(struct payload, flag##i, JSON_TOK_TRUE)
+#define STR_DESCR(i, _) JSON_OBJ_DESCR_PRIM(struct payload, str##i, JSON_TOK_STRING)
+
+static const struct json_obj_descr payload_descr[] = {
+	LISTIFY(N_FIELDS, NUM_DESCR, (,)),
+	LISTIFY(N_FIELDS, BOOL_DESCR, (,)),
+	LISTIFY(N_FIELDS, STR_DESCR, (,)),
+};
+
+static struct json_obj_descr reversed_descr[ARRAY_SIZE(payload_descr)];
+
+static char ordered[PAYLOAD_SIZE];
+static char reversed[PAYLOAD_SIZE];
+static char work[PAYLOAD_SIZE];
+static struct payload value;
+
+static void report(const char *name, uint64_t cycles, size_t len)
+{
+	uint64_t ns = timing_cycles_to_ns(cycles);
+
+	printk("%-20s: %8u cycles , %8u ns , %8u bytes/s\n", name,
+	       (uint32_t)(cycles / ITERATIONS), (uint32_t)(ns / ITERATIONS),
+	       ns == 0 ? 0 : (uint32_t)((uint64_t)len * ITERATIONS * NSEC_PER_SEC / ns));
+}
+
+static void bench_obj_parse(const char *name, const char *json)
+{
+	size_t len = strlen(json);
+	uint64_t cycles = 0;
+	timing_t start, end;
+	int64_t ret;
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		/* Parsing terminates the strings in place */
+		memcpy(work, json, len);
+
+		start = timing_counter_get();
+		ret = json_obj_parse(work, len, payload_descr,
+				     ARRAY_SIZE(payload_descr), &value);
+		end = timing_counter_get();
+
+		if (ret != BIT64_MASK(ARRAY_SIZE(payload_descr))) {
+			printk("%s: parsing failed (%lld)\n", name, (long long)ret);
+			return;
+		}
+
+		cycles += timing_cycles_get(&start, &end);
+	}
+
+	report(name, cycles, len);
+}
+
+static int stream_cb(const struct json_stream_token *token, void *user_data)
+{
+	size_t *tokens = user_data;
+
+	(*tokens)++;
+
+	return 0;
+}
+
+static void bench_stream(const char *name, const char *json, size_t chunk_size)
+{
+	size_t len = strlen(json);
+	uint64_t cycles = 0;
+	struct json_stream stream;
+	timing_t start, end;
+	size_t tokens;
+	char buf[64];
+	int ret;
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		tokens = 0;
+
+		start = timing_counter_get();
+
+		json_stream_init(&stream, buf, sizeof(buf), stream_cb, &tokens);
+		for (size_t pos = 0; pos < len; pos += chunk_size) {
+			(void)json_stream_feed(&stream, json + pos,
+					       MIN(chunk_size, len - pos));
+		}
+		ret = json_stream_finish(&stream);
+
+		end = timing_counter_get();
+
+		/* One token per field, and the start and end of the object */
+		if (ret < 0 || tokens != ARRAY_SIZE(payload_descr) + 2) {
+			printk("%s: parsing failed (%d)\n", name, ret);
+			return;
+		}
+
+		cycles += timing_cycles_get(&start, &end);
+	}
+
+	report(name, cycles, len);
+}
+
+#define INIT_FIELDS(i, _)				\
+	value.num##i = 1000 * i - 7;			\
+	value.flag##i = (i % 3) == 0;			\
+	value.str##i = "value-" #i
+
+static int encode(const struct json_obj_descr *descr, char *buf)
+{
+	LISTIFY(N_FIELDS, INIT_FIELDS, (;));
+
+	return json_obj_encode_buf(descr, ARRAY_SIZE(payload_descr), &value,
+				   buf, PAYLOAD_SIZE);
+}
+
+int main(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(payload_descr); i++) {
+		reversed_descr[i] = payload_descr[ARRAY_SIZE(payload_descr) - 1 - i];
+	}
+
+	if (encode(payload_descr, ordered) < 0 ||
+	    encode(reversed_descr, reversed) < 0) {
+		printk("encoding failed\n");
+		return 0;
+	}
+
+	printk("document of %u bytes, %u fields\n", (uint32_t)strlen(ordered),
+	       (uint32_t)ARRAY_SIZE(payload_descr));
+
+	timing_init();
+	timing_start();
+
+	bench_obj_parse("obj_parse ordered", ordered);
+	bench_obj_parse("obj_parse reversed", reversed);
+	bench_stream("stream 16 B chunks", ordered, 16);
+	bench_stream("stream 256 B chunks", ordered, 256);
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
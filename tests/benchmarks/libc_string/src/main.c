@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <string.h>
+
+/* This benchmark measures the memory and string functions of the C library,
+ * for sizes from 1 byte to 4 KiB and every alignment of the buffers within
+ * a word:
+ *
+ * - memcpy, memmove and memcmp for each misalignment of the source relative
+ *   to the destination, averaged over all the alignments of the destination,
+ * - memset for each alignment of the destination,
+ * - strlen for each alignment of the string.
+ *
+ * The number of cycles per call is reported, one row per size and one
+ * column per alignment.
+ */
+
+#define MAX_SIZE 4096
+#define ALIGNMENTS sizeof(uintptr_t)
+#define ITERATIONS 32
+
+static uint8_t __aligned(sizeof(uintptr_t)) src_buf[MAX_SIZE + ALIGNMENTS + 1];
+static uint8_t __aligned(sizeof(uintptr_t)) dest_buf[MAX_SIZE + ALIGNMENTS + 1];
+
+static const size_t sizes[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024,
+				2048, 4096 };
+
+enum bench_func {
+	BENCH_MEMCPY,
+	BENCH_MEMMOVE,
+	BENCH_MEMSET,
+	BENCH_MEMCMP,
+	BENCH_STRLEN,
+};
+
+static const char *const bench_names[] = {
+	[BENCH_MEMCPY] = "memcpy",
+	[BENCH_MEMMOVE] = "memmove",
+	[BENCH_MEMSET] = "memset",
+	[BENCH_MEMCMP] = "memcmp",
+	[BENCH_STRLEN] = "strlen",
+};
+
+/* Keeps the compiler from dropping the calls whose results are unused */
+static volatile size_t sink;
+
+static uint32_t bench_one(enum bench_func func, uint8_t *dest, uint8_t *src,
+			  size_t size)
+{
+	timing_t start, end;
+	size_t result = 0;
+
+	if (func == BENCH_MEMCMP) {
+		memset(dest, 'x', size);
+		memset(src, 'x', size);
+	} else if (func == BENCH_STRLEN) {
+		memset(src, 'x', size);
+		src[size] = '\0';
+	}
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		switch (func) {
+		case BENCH_MEMCPY:
+			memcpy(dest, src, size);
+			break;
+		case BENCH_MEMMOVE:
+			memmove(dest, src, size);
+			break;
+		case BENCH_MEMSET:
+			memset(dest, i, size);
+			break;
+		case BENCH_MEMCMP:
+			result += memcmp(dest, src, size);
+			break;
+		case BENCH_STRLEN:
+			result += strlen((const char *)src);
+			break;
+		}
+	}
+
+	end = timing_counter_get();
+
+	sink = result;
+
+	return (uint32_t)(timing_cycles_get(&start, &end) / ITERATIONS);
+}
+
+static void bench(enum bench_func func)
+{
+	printk("%s: cycles per call\n", bench_names[func]);
+	printk("    size");
+	for (int align = 0; align < ALIGNMENTS; align++) {
+		printk("  +%-6d", align);
+	}
+	printk("\n");
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		printk("%8u", (uint32_t)sizes[i]);
+
+		for (int align = 0; align < ALIGNMENTS; align++) {
+			uint64_t cycles = 0;
+
+			if (func == BENCH_MEMSET || func == BENCH_STRLEN) {
+				cycles = bench_one(func, dest_buf + align,
+						   src_buf + align, sizes[i]);
+			} else {
+				/* All the destination alignments, with the
+				 * source misaligned by align relative to it
+				 */
+				for (int d = 0; d < ALIGNMENTS; d++) {
+					int s = (d + align) % ALIGNMENTS;
+
+					cycles += bench_one(func, dest_buf + d,
+							    src_buf + s, sizes[i]);
+				}
+
+				cycles /= ALIGNMENTS;
+			}
+
+			printk("  %7u", (uint32_t)cycles);
+		}
+
+		printk("\n");
+	}
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	bench(BENCH_MEMCPY);
+	bench(BENCH_MEMMOVE);
+	bench(BENCH_MEMSET);
+	bench(BENCH_MEMCMP);
+	bench(BENCH_STRLEN);
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+/* This is a throughput benchmark of message queues with several producers
+ * and one consumer, comparing a queue taking its lock with a lock-free one.
+ * For 1 to MAX_PRODUCERS producers, and each queue:
+ *
+ * 1. The producers are started, each putting its share of N_MSGS messages,
+ *    waiting whenever the queue is full.
+ * 2. The main thread gets all the messages, waiting whenever the queue is
+ *    empty.
+ *
+ * The time per message, from the start of the producers to the last
+ * message received, and the number of messages per second are reported.
+ */
+
+#define N_MSGS 10000
+#define MAX_PRODUCERS 4
+#define MSG_SIZE 16
+#define QUEUE_LEN 64
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+struct msg {
+	uint32_t seq;
+	uint32_t payload[MSG_SIZE / sizeof(uint32_t) - 1];
+};
+
+K_MSGQ_DEFINE(locked_msgq, sizeof(struct msg), QUEUE_LEN, 4);
+K_MSGQ_DEFINE_LOCKFREE(lockfree_msgq, sizeof(struct msg), QUEUE_LEN, 4);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_PRODUCERS, STACK_SIZE);
+static struct k_thread threads[MAX_PRODUCERS];
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *q = p1;
+	uint32_t count = POINTER_TO_UINT(p2);
+	struct msg msg = { 0 };
+
+	for (msg.seq = 0; msg.seq < count; msg.seq++) {
+		(void)k_msgq_put(q, &msg, K_FOREVER);
+	}
+}
+
+static void bench(const char *name, struct k_msgq *q, int n_producers)
+{
+	struct msg msg;
+	timing_t start, end;
+	uint64_t cycles, ns;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < n_producers; i++) {
+		/* The first producer puts what is left of the division */
+		uint32_t count = N_MSGS / n_producers +
+				 (i == 0 ? N_MSGS % n_producers : 0);
+
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, producer,
+				q, UINT_TO_POINTER(count), NULL,
+				k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < N_MSGS; i++) {
+		if (k_msgq_get(q, &msg, K_MSEC(1000)) != 0) {
+			printk("%s: stalled after %d messages\n", name, i);
+			return;
+		}
+	}
+
+	end = timing_counter_get();
+
+	for (int i = 0; i < n_producers; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	cycles = timing_cycles_get(&start, &end);
+	ns = timing_cycles_to_ns(cycles);
+
+	printk("%-8s %dp  : %8u cycles , %8u ns , %8u msgs/s\n", name, n_producers,
+	       (uint32_t)(cycles / N_MSGS), (uint32_t)(ns / N_MSGS),
+	       ns == 0 ? 0 : (uint32_t)((uint64_t)N_MSGS * NSEC_PER_SEC / ns));
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	for (int n = 1; n <= MAX_PRODUCERS; n++) {
+		bench("locked", &locked_msgq, n);
+		bench("lockfree", &lockfree_msgq, n);
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
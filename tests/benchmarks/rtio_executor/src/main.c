@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/rtio/rtio.h>
+
+#include "rtio_iodev_test.h"
+
+/* Latency of a periodic high priority request, standing for an IMU
+ * sample, submitted while a burst of low priority requests, standing for
+ * bulk flash reads, is in progress.  See README.rst.
+ */
+
+#define N_BULK 16
+#define N_IMU 8
+#define IMU_PERIOD_MS 25
+
+#define IMU_USERDATA ((void *)1)
+
+RTIO_DEFINE(r_bench, N_BULK + 2, N_BULK + 2);
+
+RTIO_IODEV_TEST_DEFINE(iodev_imu);
+RTIO_IODEV_TEST_DEFINE(iodev_flash);
+
+static void submit_nop(struct rtio_iodev *iodev, uint8_t prio, void *userdata)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r_bench);
+
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_nop(sqe, iodev, userdata);
+	sqe->prio = prio;
+	rtio_submit(&r_bench, 0);
+}
+
+/* Consume completions until the one of the IMU request, returns the
+ * number of bulk completions seen on the way.
+ */
+static int wait_imu(void)
+{
+	int bulk = 0;
+
+	for (;;) {
+		struct rtio_cqe *cqe = rtio_cqe_consume(&r_bench);
+		void *userdata;
+
+		if (cqe == NULL) {
+			k_msleep(1);
+			continue;
+		}
+
+		userdata = cqe->userdata;
+		rtio_cqe_release(&r_bench, cqe);
+
+		if (userdata == IMU_USERDATA) {
+			return bulk;
+		}
+		bulk++;
+	}
+}
+
+static void bench(const char *name, struct rtio_iodev *imu, struct rtio_iodev *flash)
+{
+	uint32_t total = 0U, max = 0U;
+	int bulk = 0;
+
+	for (int i = 0; i < N_BULK; i++) {
+		submit_nop(flash, RTIO_PRIO_LOW, NULL);
+	}
+
+	for (int i = 0; i < N_IMU; i++) {
+		int64_t start = k_uptime_get();
+		uint32_t latency;
+
+		submit_nop(imu, RTIO_PRIO_HIGH, IMU_USERDATA);
+		bulk += wait_imu();
+
+		latency = (uint32_t)(k_uptime_get() - start);
+		total += latency;
+		max = MAX(max, latency);
+
+		k_msleep(IMU_PERIOD_MS - MIN(latency, IMU_PERIOD_MS));
+	}
+
+	while (bulk < N_BULK) {
+		struct rtio_cqe cqe;
+
+		bulk += rtio_cqe_copy_out(&r_bench, &cqe, 1, K_FOREVER);
+	}
+
+	printk("%s imu latency: avg %u ms , max %u ms\n", name, total / N_IMU, max);
+}
+
+ZTEST(rtio_executor, test_latency)
+{
+	rtio_iodev_test_init(&iodev_imu);
+	rtio_iodev_test_init(&iodev_flash);
+
+	bench("shared", &iodev_flash, &iodev_flash);
+	bench("separate", &iodev_imu, &iodev_flash);
+
+	printk("fin\n");
+}
+
+ZTEST_SUITE(rtio_executor, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/storage/flash_map.h>
+
+/* This is a benchmark of the NVS settings backend against the number of
+ * stored settings.  For each number of settings it:
+ *
+ * 1. Saves new values for N_RUNS pseudo-random existing settings.
+ * 2. Saves N_RUNS settings under a new name, deleting each one again.
+ * 3. Loads all the settings N_LOADS times.
+ *
+ * and reports the average time of each operation.
+ */
+
+#define N_RUNS 50
+#define N_LOADS 4
+#define SETTINGS_PARTITION DT_FIXED_PARTITION_ID(DT_CHOSEN(zephyr_settings_partition))
+
+static const int n_keys[] = { 16, 128, 512 };
+
+static uint32_t rand_state = 0x2545f491;
+static uint32_t set_cnt;
+
+static uint32_t next_rand(void)
+{
+	/* Deterministic LCG, so each variant sees the same pattern */
+	rand_state = rand_state * 1103515245U + 12345U;
+	return rand_state >> 8;
+}
+
+static int bench_set(const char *name, size_t len, settings_read_cb read_cb,
+		     void *cb_arg)
+{
+	uint32_t val;
+
+	if (read_cb(cb_arg, &val, sizeof(val)) == sizeof(val)) {
+		set_cnt++;
+	}
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bench, "bench", NULL, bench_set, NULL, NULL);
+
+static void print_stats(const char *op, int n, uint64_t cycles, uint32_t runs)
+{
+	printk("%-8s %4d keys: %8u cycles , %8u ns\n", op, n,
+	       (uint32_t)(cycles / runs),
+	       (uint32_t)timing_cycles_to_ns_avg(cycles, runs));
+}
+
+static int save_key(int i, uint32_t val)
+{
+	char name[24];
+
+	snprintf(name, sizeof(name), "bench/%d", i);
+	return settings_save_one(name, &val, sizeof(val));
+}
+
+static void bench(int n)
+{
+	uint64_t update_cycles = 0U, new_cycles = 0U, load_cycles = 0U;
+	timing_t start, end;
+	int rc;
+
+	for (int i = 0; i < N_RUNS; i++) {
+		int key = next_rand() % n;
+
+		start = timing_counter_get();
+		rc = save_key(key, i);
+		end = timing_counter_get();
+		update_cycles += timing_cycles_get(&start, &end);
+
+		if (rc) {
+			printk("update of key %d failed (%d)\n", key, rc);
+			return;
+		}
+	}
+
+	for (int i = 0; i < N_RUNS; i++) {
+		start = timing_counter_get();
+		rc = settings_save_one("bench/new", &i, sizeof(i));
+		end = timing_counter_get();
+		new_cycles += timing_cycles_get(&start, &end);
+
+		if (rc) {
+			printk("save of new key failed (%d)\n", rc);
+			return;
+		}
+
+		(void)settings_delete("bench/new");
+	}
+
+	for (int i = 0; i < N_LOADS; i++) {
+		set_cnt = 0U;
+
+		start = timing_counter_get();
+		rc = settings_load();
+		end = timing_counter_get();
+		load_cycles += timing_cycles_get(&start, &end);
+
+		if (rc || (set_cnt != n)) {
+			printk("load failed (%d), %u of %d keys\n", rc, set_cnt, n);
+			return;
+		}
+	}
+
+	print_stats("update", n, update_cycles, N_RUNS);
+	print_stats("new", n, new_cycles, N_RUNS);
+	print_stats("load", n, load_cycles, N_LOADS);
+}
+
+int main(void)
+{
+	const struct flash_area *fa;
+	int stored = 0;
+	int rc;
+
+	rc = flash_area_open(SETTINGS_PARTITION, &fa);
+	if (rc == 0) {
+		rc = flash_area_erase(fa, 0, fa->fa_size);
+		flash_area_close(fa);
+	}
+
+	if (rc == 0) {
+		rc = settings_subsys_init();
+	}
+
+	if (rc) {
+		printk("cannot initialize settings (%d)\n", rc);
+		return 0;
+	}
+
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < ARRAY_SIZE(n_keys); i++) {
+		for (; stored < n_keys[i]; stored++) {
+			rc = save_key(stored, stored);
+			if (rc) {
+				printk("cannot store key %d (%d)\n", stored, rc);
+				return 0;
+			}
+		}
+
+		bench(n_keys[i]);
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_epoll.h>
+
+/* This is a microbenchmark of waiting for one ready socket among many,
+ * comparing poll() with epoll_wait().  For each number of watched
+ * sockets it:
+ *
+ * 1. Sends one datagram over loopback to a pseudo-random socket of the
+ *    set and sleeps until the network stack has delivered it.
+ * 2. Measures a non-blocking poll() on all the sockets plus the scan of
+ *    the returned events for the ready one.
+ * 3. Measures a non-blocking epoll_wait() on an epoll instance watching
+ *    the same sockets.
+ *
+ * Neither call consumes the datagram, it is received afterwards.
+ */
+
+#define N_RUNS 100
+#define MAX_SOCKS CONFIG_NET_SOCKETS_EPOLL_MAX_FDS
+#define BASE_PORT 10000
+
+static const int n_socks[] = { 8, 64, MAX_SOCKS };
+
+static int socks[MAX_SOCKS];
+static struct pollfd pollfds[MAX_SOCKS];
+static int sender;
+
+static uint32_t rand_state = 0x2545f491;
+
+static uint32_t next_rand(void)
+{
+	/* Deterministic LCG, so each set size sees the same pattern */
+	rand_state = rand_state * 1103515245U + 12345U;
+	return rand_state >> 8;
+}
+
+static void print_stats(const char *op, int n, uint64_t cycles)
+{
+	printk("%-8s %3d fds: %8u cycles , %8u ns\n", op, n,
+	       (uint32_t)(cycles / N_RUNS),
+	       (uint32_t)timing_cycles_to_ns_avg(cycles, N_RUNS));
+}
+
+static struct sockaddr_in6 sock_addr(int i)
+{
+	struct sockaddr_in6 addr = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(BASE_PORT + i),
+		.sin6_addr = IN6ADDR_LOOPBACK_INIT,
+	};
+
+	return addr;
+}
+
+static int setup(void)
+{
+	sender = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	if (sender < 0) {
+		printk("cannot create sender socket (%d)\n", errno);
+		return -1;
+	}
+
+	for (int i = 0; i < MAX_SOCKS; i++) {
+		struct sockaddr_in6 addr = sock_addr(i);
+
+		socks[i] = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+		if (socks[i] < 0) {
+			printk("cannot create socket %d (%d)\n", i, errno);
+			return -1;
+		}
+
+		if (bind(socks[i], (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+			printk("cannot bind socket %d (%d)\n", i, errno);
+			return -1;
+		}
+
+		pollfds[i].fd = socks[i];
+		pollfds[i].events = POLLIN;
+	}
+
+	return 0;
+}
+
+static void bench(int n)
+{
+	struct epoll_event event;
+	timing_t start, end;
+	uint64_t poll_cycles = 0U, epoll_cycles = 0U;
+	int epfd;
+
+	epfd = epoll_create1(0);
+	if (epfd < 0) {
+		printk("cannot create epoll instance (%d)\n", errno);
+		return;
+	}
+
+	for (int i = 0; i < n; i++) {
+		event.events = EPOLLIN;
+		event.data.u32 = i;
+
+		if (epoll_ctl(epfd, EPOLL_CTL_ADD, socks[i], &event) < 0) {
+			printk("cannot add socket %d (%d)\n", i, errno);
+			goto out;
+		}
+	}
+
+	for (int i = 0; i < N_RUNS; i++) {
+		int target = next_rand() % n;
+		struct sockaddr_in6 addr = sock_addr(target);
+		int found = -1;
+		char buf[4];
+		int ret;
+
+		ret = sendto(sender, "ping", sizeof(buf), 0,
+			     (struct sockaddr *)&addr, sizeof(addr));
+		if (ret < 0) {
+			printk("send failed (%d)\n", errno);
+			goto out;
+		}
+
+		/* Let the stack deliver the datagram */
+		k_msleep(1);
+
+		start = timing_counter_get();
+		ret = poll(pollfds, n, 0);
+		for (int j = 0; ret > 0 && j < n; j++) {
+			if (pollfds[j].revents & POLLIN) {
+				found = j;
+				break;
+			}
+		}
+		end = timing_counter_get();
+		poll_cycles += timing_cycles_get(&start, &end);
+
+		if (found != target) {
+			printk("poll did not report socket %d\n", target);
+		}
+
+		start = timing_counter_get();
+		ret = epoll_wait(epfd, &event, 1, 0);
+		end = timing_counter_get();
+		epoll_cycles += timing_cycles_get(&start, &end);
+
+		if (ret != 1 || event.data.u32 != target) {
+			printk("epoll_wait did not report socket %d\n", target);
+		}
+
+		(void)recv(socks[target], buf, sizeof(buf), 0);
+	}
+
+	print_stats("poll", n, poll_cycles);
+	print_stats("epoll", n, epoll_cycles);
+
+out:
+	close(epfd);
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	if (setup() < 0) {
+		return 0;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(n_socks); i++) {
+		bench(n_socks[i]);
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
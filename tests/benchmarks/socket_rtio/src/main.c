@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_rtio.h>
+
+/* This is a loopback throughput benchmark of a UDP socket pair, driven by
+ * a single thread, comparing blocking send()/recv() with RTIO. It:
+ *
+ * 1. Sends N_DGRAMS datagrams with send() and receives each with a
+ *    blocking recv() before sending the next.
+ * 2. Sends the same datagrams as RTIO writes, keeping up to WINDOW of
+ *    them in flight, received by one multishot read taking buffers from
+ *    the memory pool of the RTIO context.
+ *
+ * The time per datagram, from the first send to the last receive, is
+ * reported for both.
+ */
+
+#define N_DGRAMS 1000
+#define DGRAM_SIZE 256
+#define WINDOW 8
+#define PORT 10000
+
+RTIO_DEFINE_WITH_MEMPOOL(r, WINDOW + 1, 2 * WINDOW, WINDOW, DGRAM_SIZE, 4);
+
+ZSOCK_RTIO_IODEV_DEFINE(tx_iodev);
+ZSOCK_RTIO_IODEV_DEFINE(rx_iodev);
+
+static uint8_t tx_buf[DGRAM_SIZE];
+static uint8_t rx_buf[DGRAM_SIZE];
+static int tx_sock;
+static int rx_sock;
+
+static void print_stats(const char *op, int n, uint64_t cycles)
+{
+	printk("%-8s: %8u cycles , %8u ns\n", op,
+	       (uint32_t)(cycles / n),
+	       (uint32_t)timing_cycles_to_ns_avg(cycles, n));
+}
+
+static int setup(void)
+{
+	struct sockaddr_in6 addr = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(PORT),
+		.sin6_addr = IN6ADDR_LOOPBACK_INIT,
+	};
+
+	rx_sock = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	tx_sock = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	if (rx_sock < 0 || tx_sock < 0) {
+		printk("cannot create sockets (%d)\n", errno);
+		return -1;
+	}
+
+	if (bind(rx_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    connect(tx_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("cannot connect sockets (%d)\n", errno);
+		return -1;
+	}
+
+	for (int i = 0; i < sizeof(tx_buf); i++) {
+		tx_buf[i] = i;
+	}
+
+	return 0;
+}
+
+static void bench_blocking(void)
+{
+	timing_t start, end;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < N_DGRAMS; i++) {
+		if (send(tx_sock, tx_buf, sizeof(tx_buf), 0) < 0 ||
+		    recv(rx_sock, rx_buf, sizeof(rx_buf), 0) < 0) {
+			printk("blocking transfer failed (%d)\n", errno);
+			return;
+		}
+	}
+
+	end = timing_counter_get();
+
+	print_stats("blocking", N_DGRAMS, timing_cycles_get(&start, &end));
+}
+
+static void bench_rtio(void)
+{
+	struct rtio_sqe *rx_sqe;
+	struct rtio_cqe cqe;
+	timing_t start, end;
+	int submitted = 0, received = 0;
+
+	if (zsock_rtio_iodev_attach(&tx_iodev, tx_sock) < 0 ||
+	    zsock_rtio_iodev_attach(&rx_iodev, rx_sock) < 0) {
+		printk("cannot attach sockets\n");
+		return;
+	}
+
+	start = timing_counter_get();
+
+	rx_sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_read_multishot(rx_sqe, &rx_iodev, RTIO_PRIO_NORM, &rx_iodev);
+
+	while (received < N_DGRAMS) {
+		/* Keep the window full, without overrunning the receiver */
+		while (submitted < N_DGRAMS && submitted - received < WINDOW) {
+			struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+
+			if (sqe == NULL) {
+				break;
+			}
+
+			rtio_sqe_prep_write(sqe, &tx_iodev, RTIO_PRIO_NORM, tx_buf,
+					    sizeof(tx_buf), &tx_iodev);
+			submitted++;
+		}
+
+		rtio_submit(&r, 0);
+
+		if (rtio_cqe_copy_out(&r, &cqe, 1, K_MSEC(100)) != 1) {
+			printk("rtio transfer stalled after %d datagrams\n", received);
+			break;
+		}
+
+		if (cqe.result < 0) {
+			printk("rtio transfer failed (%d)\n", cqe.result);
+			break;
+		}
+
+		if (cqe.userdata == &rx_iodev) {
+			uint8_t *buf;
+			uint32_t buf_len;
+
+			if (rtio_cqe_get_mempool_buffer(&r, &cqe, &buf, &buf_len) == 0) {
+				rtio_release_buffer(&r, buf, buf_len);
+			}
+			received++;
+		}
+	}
+
+	end = timing_counter_get();
+
+	if (received == N_DGRAMS) {
+		print_stats("rtio", N_DGRAMS, timing_cycles_get(&start, &end));
+	}
+
+	rtio_sqe_cancel(rx_sqe);
+	zsock_rtio_iodev_detach(&rx_iodev);
+	zsock_rtio_iodev_detach(&tx_iodev);
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	if (setup() < 0) {
+		return 0;
+	}
+
+	bench_blocking();
+	bench_rtio();
+
+	close(tx_sock);
+	close(rx_sock);
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/socket.h>
+
+/* This is a benchmark of UDP echo round trips over loopback with batched
+ * socket calls. For each batch size it:
+ *
+ * 1. Sends a batch of datagrams to the echo server with sendmmsg().
+ * 2. Lets the echo server thread receive the queued datagrams with one
+ *    recvmmsg() call and send them back with one sendmmsg() call.
+ * 3. Receives the echoed batch with recvmmsg().
+ *
+ * The time for N_PACKETS datagrams is measured and reported per packet
+ * and as a packet rate.
+ */
+
+#define N_PACKETS 3200
+#define MAX_BATCH 32
+#define PAYLOAD_LEN 64
+#define SERVER_PORT 4242
+#define CLIENT_PORT 4243
+
+#define SERVER_STACK_SIZE 2048
+/* Same priority as main(), so that queueing a datagram for the other
+ * side does not switch to it right away
+ */
+#define SERVER_PRIORITY CONFIG_MAIN_THREAD_PRIORITY
+
+static const int batch_sizes[] = { 1, 8, MAX_BATCH };
+
+struct batch {
+	struct mmsghdr msgs[MAX_BATCH];
+	struct iovec iov[MAX_BATCH];
+	struct sockaddr_in6 addr[MAX_BATCH];
+	uint8_t data[MAX_BATCH][PAYLOAD_LEN];
+};
+
+static struct batch client_batch;
+static struct batch server_batch;
+static int client_sock;
+static int server_sock;
+static volatile int batch_size;
+
+K_THREAD_STACK_DEFINE(server_stack, SERVER_STACK_SIZE);
+static struct k_thread server_thread;
+
+static struct sockaddr_in6 sock_addr(uint16_t port)
+{
+	struct sockaddr_in6 addr = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(port),
+		.sin6_addr = IN6ADDR_LOOPBACK_INIT,
+	};
+
+	return addr;
+}
+
+static void batch_init(struct batch *b)
+{
+	for (int i = 0; i < MAX_BATCH; i++) {
+		memset(b->data[i], i, sizeof(b->data[i]));
+		b->iov[i].iov_base = b->data[i];
+		b->iov[i].iov_len = sizeof(b->data[i]);
+		b->msgs[i].msg_hdr.msg_iov = &b->iov[i];
+		b->msgs[i].msg_hdr.msg_iovlen = 1;
+		b->msgs[i].msg_hdr.msg_name = &b->addr[i];
+		b->msgs[i].msg_hdr.msg_namelen = sizeof(b->addr[i]);
+	}
+}
+
+static void server(void *p1, void *p2, void *p3)
+{
+	struct batch *b = &server_batch;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		int n;
+
+		for (int i = 0; i < MAX_BATCH; i++) {
+			b->iov[i].iov_len = sizeof(b->data[i]);
+			b->msgs[i].msg_hdr.msg_namelen = sizeof(b->addr[i]);
+		}
+
+		n = recvmmsg(server_sock, b->msgs, batch_size, MSG_WAITFORONE,
+			     NULL);
+		if (n < 0) {
+			printk("server recvmmsg failed (%d)\n", errno);
+			return;
+		}
+
+		/* Echo back exactly what was received, to its sender */
+		for (int i = 0; i < n; i++) {
+			b->iov[i].iov_len = b->msgs[i].msg_len;
+		}
+
+		if (sendmmsg(server_sock, b->msgs, n, 0) != n) {
+			printk("server sendmmsg failed (%d)\n", errno);
+			return;
+		}
+	}
+}
+
+static int setup(void)
+{
+	struct sockaddr_in6 addr;
+
+	client_sock = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	server_sock = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	if (client_sock < 0 || server_sock < 0) {
+		printk("cannot create sockets (%d)\n", errno);
+		return -1;
+	}
+
+	addr = sock_addr(CLIENT_PORT);
+	if (bind(client_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("cannot bind client socket (%d)\n", errno);
+		return -1;
+	}
+
+	addr = sock_addr(SERVER_PORT);
+	if (bind(server_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("cannot bind server socket (%d)\n", errno);
+		return -1;
+	}
+
+	batch_init(&client_batch);
+	batch_init(&server_batch);
+
+	return 0;
+}
+
+static int bench(int n)
+{
+	struct batch *b = &client_batch;
+	timing_t start, end;
+	uint64_t cycles, ns;
+	int ret;
+
+	batch_size = n;
+
+	start = timing_counter_get();
+
+	for (int sent = 0; sent < N_PACKETS; sent += n) {
+		int received = 0;
+
+		for (int i = 0; i < n; i++) {
+			b->addr[i] = sock_addr(SERVER_PORT);
+			b->msgs[i].msg_hdr.msg_namelen = sizeof(b->addr[i]);
+		}
+
+		ret = sendmmsg(client_sock, b->msgs, n, 0);
+		if (ret != n) {
+			printk("client sendmmsg failed (%d)\n", errno);
+			return -1;
+		}
+
+		while (received < n) {
+			ret = recvmmsg(client_sock, b->msgs + received,
+				       n - received, MSG_WAITFORONE, NULL);
+			if (ret < 0) {
+				printk("client recvmmsg failed (%d)\n", errno);
+				return -1;
+			}
+
+			received += ret;
+		}
+	}
+
+	end = timing_counter_get();
+
+	cycles = timing_cycles_get(&start, &end);
+	ns = timing_cycles_to_ns(cycles);
+
+	printk("batch %2d: %8u cycles , %8u ns , %8u packets/s\n", n,
+	       (uint32_t)(cycles / N_PACKETS),
+	       (uint32_t)(ns / N_PACKETS),
+	       ns ? (uint32_t)((uint64_t)N_PACKETS * NSEC_PER_SEC / ns) : 0U);
+
+	return 0;
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	if (setup() < 0) {
+		return 0;
+	}
+
+	batch_size = 1;
+
+	k_thread_create(&server_thread, server_stack,
+			K_THREAD_STACK_SIZEOF(server_stack), server,
+			NULL, NULL, NULL, SERVER_PRIORITY, 0, K_NO_WAIT);
+
+	for (int i = 0; i < ARRAY_SIZE(batch_sizes); i++) {
+		if (bench(batch_sizes[i]) < 0) {
+			break;
+		}
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
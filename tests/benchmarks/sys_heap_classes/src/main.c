@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/timing/timing.h>
+
+/* This is a benchmark of the sys_heap size class front end against the
+ * general allocator.  On two heaps of the same size, one of them with
+ * size classes enabled, it:
+ *
+ * 1. Runs N_OPS operations on random slots, allocating 16 to 64 bytes
+ *    into empty slots and freeing full ones, and reports the average
+ *    time of an allocation and of a free.
+ * 2. Runs N_OPS operations of a mix of small objects and larger blocks
+ *    that keeps the heap close to full, then frees the larger blocks and
+ *    reports the largest block that can be allocated, along with the
+ *    number of allocations that failed.
+ */
+
+#define HEAP_SIZE (16 * 1024)
+#define N_OPS 20000
+#define N_SLOTS 256
+#define SMALL_MAX 64
+#define LARGE_MIN 128
+#define LARGE_MAX 1024
+
+static uint8_t heap_mem[2][HEAP_SIZE] __aligned(8);
+static struct sys_heap heaps[2];
+static const char *const names[2] = { "default", "classes" };
+
+static void *slots[N_SLOTS];
+static bool large[N_SLOTS];
+
+static uint32_t rand_state;
+
+static uint32_t next_rand(void)
+{
+	/* Deterministic LCG, so both heaps see the same pattern */
+	rand_state = rand_state * 1103515245U + 12345U;
+	return rand_state >> 8;
+}
+
+static void free_all(struct sys_heap *heap)
+{
+	for (int i = 0; i < N_SLOTS; i++) {
+		sys_heap_free(heap, slots[i]);
+		slots[i] = NULL;
+	}
+}
+
+static void bench_speed(int h)
+{
+	struct sys_heap *heap = &heaps[h];
+	uint64_t alloc_cycles = 0U, free_cycles = 0U;
+	uint32_t allocs = 0U, frees = 0U;
+	timing_t start, end;
+
+	rand_state = 0x2545f491;
+
+	for (int i = 0; i < N_OPS; i++) {
+		/* Only half of the slots, so most allocations succeed */
+		int s = next_rand() % (N_SLOTS / 2);
+
+		if (slots[s] == NULL) {
+			size_t bytes = 16 + next_rand() % (SMALL_MAX - 15);
+
+			start = timing_counter_get();
+			slots[s] = sys_heap_alloc(heap, bytes);
+			end = timing_counter_get();
+			alloc_cycles += timing_cycles_get(&start, &end);
+			allocs++;
+		} else {
+			start = timing_counter_get();
+			sys_heap_free(heap, slots[s]);
+			end = timing_counter_get();
+			free_cycles += timing_cycles_get(&start, &end);
+			frees++;
+			slots[s] = NULL;
+		}
+	}
+
+	free_all(heap);
+
+	printk("%s alloc: %8u cycles , %8u ns\n", names[h],
+	       (uint32_t)(alloc_cycles / allocs),
+	       (uint32_t)timing_cycles_to_ns_avg(alloc_cycles, allocs));
+	printk("%s free: %8u cycles , %8u ns\n", names[h],
+	       (uint32_t)(free_cycles / frees),
+	       (uint32_t)timing_cycles_to_ns_avg(free_cycles, frees));
+}
+
+static void bench_fragmentation(int h)
+{
+	struct sys_heap *heap = &heaps[h];
+	uint32_t failed = 0U;
+	size_t largest;
+	void *p;
+
+	rand_state = 0x5bd1e995;
+
+	for (int i = 0; i < N_OPS; i++) {
+		int s = next_rand() % N_SLOTS;
+
+		if (slots[s] != NULL) {
+			/* Keep the heap full: free only one time in four */
+			if ((next_rand() % 4) == 0) {
+				sys_heap_free(heap, slots[s]);
+				slots[s] = NULL;
+			}
+			continue;
+		}
+
+		large[s] = (next_rand() % 8) == 0;
+		if (large[s]) {
+			slots[s] = sys_heap_alloc(heap, LARGE_MIN +
+						  next_rand() % (LARGE_MAX - LARGE_MIN));
+		} else {
+			slots[s] = sys_heap_alloc(heap, 16 + next_rand() % (SMALL_MAX - 15));
+		}
+
+		if (slots[s] == NULL) {
+			failed++;
+		}
+	}
+
+	for (int s = 0; s < N_SLOTS; s++) {
+		if (large[s]) {
+			sys_heap_free(heap, slots[s]);
+			slots[s] = NULL;
+		}
+	}
+
+	for (largest = HEAP_SIZE; largest > 0; largest -= 8) {
+		p = sys_heap_alloc(heap, largest);
+		if (p != NULL) {
+			sys_heap_free(heap, p);
+			break;
+		}
+	}
+
+	free_all(heap);
+
+	printk("%s largest free: %6u bytes , %6u failed allocs\n", names[h],
+	       (uint32_t)largest, failed);
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	for (int h = 0; h < ARRAY_SIZE(heaps); h++) {
+		sys_heap_init(&heaps[h], heap_mem[h], HEAP_SIZE);
+	}
+
+	if (sys_heap_size_classes_enable(&heaps[1]) != 0) {
+		printk("cannot enable size classes\n");
+		return 0;
+	}
+
+	for (int h = 0; h < ARRAY_SIZE(heaps); h++) {
+		bench_speed(h);
+	}
+
+	for (int h = 0; h < ARRAY_SIZE(heaps); h++) {
+		bench_fragmentation(h);
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
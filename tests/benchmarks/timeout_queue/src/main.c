@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timeout_q.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/drivers/timer/system_timer.h>
+
+/* This is a timeout queue microbenchmark, measuring the cost of the
+ * kernel's low level timeout primitives as a function of the number
+ * of timeouts already pending.  For each queue depth it:
+ *
+ * 1. Arms that many "background" timeouts at pseudo-random expiries
+ *    far enough in the future that none of them fires during the run.
+ * 2. Measures z_add_timeout() and z_abort_timeout() of one extra
+ *    timeout landing at a random position in the queue.
+ * 3. Measures sys_clock_announce() of a single tick that expires one
+ *    timeout at the head of the queue.
+ *
+ * Step 3 drives sys_clock_announce() directly with interrupts locked,
+ * so the kernel's notion of uptime runs ahead of the timer driver by
+ * one tick per iteration.  That's harmless here but means this
+ * program should not be combined with other tests.
+ */
+
+#define N_RUNS 100
+#define MAX_PENDING 1000
+
+/* Background timeouts expire in [FAR_TICKS, 2 * FAR_TICKS) */
+#define FAR_TICKS 100000
+
+static const int n_pending[] = { 10, 100, MAX_PENDING };
+
+static struct _timeout pending[MAX_PENDING];
+static struct _timeout probe;
+static volatile int fired;
+
+static uint32_t rand_state = 0x2545f491;
+
+static uint32_t next_rand(void)
+{
+	/* Deterministic LCG, so each backend sees the same queue */
+	rand_state = rand_state * 1103515245U + 12345U;
+	return rand_state >> 8;
+}
+
+static void pending_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static void probe_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	fired++;
+}
+
+static k_timeout_t far_timeout(void)
+{
+	return K_TICKS(FAR_TICKS + (next_rand() % FAR_TICKS));
+}
+
+static void print_stats(const char *op, int n, uint64_t cycles)
+{
+	printk("%-8s %4d pending: %8u cycles , %8u ns\n", op, n,
+	       (uint32_t)(cycles / N_RUNS),
+	       (uint32_t)timing_cycles_to_ns_avg(cycles, N_RUNS));
+}
+
+static void bench(int n)
+{
+	timing_t start, end;
+	uint64_t add_cycles = 0U, abort_cycles = 0U, announce_cycles = 0U;
+
+	for (int i = 0; i < n; i++) {
+		z_init_timeout(&pending[i]);
+		z_add_timeout(&pending[i], pending_fn, far_timeout());
+	}
+
+	for (int i = 0; i < N_RUNS; i++) {
+		k_timeout_t to = far_timeout();
+		unsigned int key = irq_lock();
+
+		z_init_timeout(&probe);
+
+		start = timing_counter_get();
+		z_add_timeout(&probe, probe_fn, to);
+		end = timing_counter_get();
+		add_cycles += timing_cycles_get(&start, &end);
+
+		start = timing_counter_get();
+		z_abort_timeout(&probe);
+		end = timing_counter_get();
+		abort_cycles += timing_cycles_get(&start, &end);
+
+		irq_unlock(key);
+	}
+
+	for (int i = 0; i < N_RUNS; i++) {
+		unsigned int key = irq_lock();
+		int prev = fired;
+
+		/* An absolute expiry in the past lands on the next tick */
+		z_add_timeout(&probe, probe_fn, K_TIMEOUT_ABS_TICKS(0));
+
+		start = timing_counter_get();
+		sys_clock_announce(1);
+		end = timing_counter_get();
+		announce_cycles += timing_cycles_get(&start, &end);
+
+		irq_unlock(key);
+
+		if (fired != prev + 1) {
+			printk("probe timeout did not fire\n");
+		}
+	}
+
+	for (int i = 0; i < n; i++) {
+		z_abort_timeout(&pending[i]);
+	}
+
+	print_stats("insert", n, add_cycles);
+	print_stats("abort", n, abort_cycles);
+	print_stats("announce", n, announce_cycles);
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	printk("timeout queue backend: %s\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_SCALABLE) ? "scalable" : "dumb");
+
+	for (int i = 0; i < ARRAY_SIZE(n_pending); i++) {
+		bench(n_pending[i]);
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
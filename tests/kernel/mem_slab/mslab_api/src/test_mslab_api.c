@@ -338,3 +338,62 @@ ZTEST(mslab_api, test_mslab_pending)
 	/* Free memory block */
 	k_mem_slab_free(&kmslab, &b);
 }
+
+/**
+ * @brief Verify the statistics of the per-CPU cache of a memory slab
+ *
+ * @details Allocate blocks until the cache of the CPU has been refilled
+ * twice, then free them until it is flushed once, checking the counters
+ * reported by @see k_mem_slab_cpu_cache_stats_get().
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+ZTEST(mslab_api, test_mslab_cpu_cache_stats)
+{
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE_STATS
+	static char __aligned(BLK_ALIGN)
+		cslab_buf[BLK_SIZE * 2 * CONFIG_MEM_CPU_CACHE_ROUNDS];
+	static struct k_mem_slab cslab;
+	const uint32_t batch = CONFIG_MEM_CPU_CACHE_ROUNDS / 2;
+	void *block[CONFIG_MEM_CPU_CACHE_ROUNDS / 2 + 2];
+	struct k_mem_slab_cache_stats stats;
+	uint32_t i;
+
+	zassert_equal(k_mem_slab_init(&cslab, cslab_buf, BLK_SIZE,
+				      2 * CONFIG_MEM_CPU_CACHE_ROUNDS), 0);
+
+	zassert_equal(k_mem_slab_cpu_cache_stats_get(&cslab, -1, &stats),
+		      -EINVAL);
+	zassert_equal(k_mem_slab_cpu_cache_stats_get(&cslab, arch_num_cpus(),
+						     &stats), -EINVAL);
+
+	/* The test runs on one CPU only, see prj.conf */
+	zassert_equal(k_mem_slab_cpu_cache_stats_get(&cslab, 0, &stats), 0);
+	zassert_equal(stats.hits + stats.misses + stats.refills + stats.flushes,
+		      0, "Counters of a new slab not zero");
+
+	/* A miss refills the cache, which serves the next batch allocations */
+	for (i = 0; i < ARRAY_SIZE(block); i++) {
+		zassert_equal(k_mem_slab_alloc(&cslab, &block[i], K_NO_WAIT), 0);
+	}
+
+	zassert_equal(k_mem_slab_cpu_cache_stats_get(&cslab, 0, &stats), 0);
+	zassert_equal(stats.misses, 2, "misses %u", stats.misses);
+	zassert_equal(stats.refills, 2, "refills %u", stats.refills);
+	zassert_equal(stats.hits, batch, "hits %u", stats.hits);
+	zassert_equal(stats.flushes, 0, "flushes %u", stats.flushes);
+
+	/* The cache holds a batch of blocks, freeing more fills it up and
+	 * then makes it flush half of them.
+	 */
+	for (i = 0; i < ARRAY_SIZE(block); i++) {
+		k_mem_slab_free(&cslab, &block[i]);
+	}
+
+	zassert_equal(k_mem_slab_cpu_cache_stats_get(&cslab, 0, &stats), 0);
+	zassert_equal(stats.flushes, 1, "flushes %u", stats.flushes);
+	zassert_equal(k_mem_slab_num_used_get(&cslab), 0);
+#else
+	ztest_test_skip();
+#endif
+}
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#ifdef CONFIG_MSGQ_LOCKFREE
+
+#define LF_LEN 4
+#define N_PRODUCERS 4
+#define N_MSGS_PER_PRODUCER 500
+
+K_MSGQ_DEFINE_LOCKFREE(lf_msgq, sizeof(uint32_t), LF_LEN, 4);
+
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+extern struct k_thread tdata;
+
+static K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, N_PRODUCERS, STACK_SIZE);
+static struct k_thread producer_threads[N_PRODUCERS];
+static uint8_t received[N_PRODUCERS][N_MSGS_PER_PRODUCER];
+
+static int isr_result;
+
+static void lf_reset(void)
+{
+	k_msgq_purge(&lf_msgq);
+	zassert_equal(k_msgq_num_used_get(&lf_msgq), 0);
+}
+
+static void isr_put(const void *param)
+{
+	uint32_t msg = POINTER_TO_UINT(param);
+
+	isr_result = k_msgq_put(&lf_msgq, &msg, K_NO_WAIT);
+}
+
+static void isr_put_thread(void *p1, void *p2, void *p3)
+{
+	k_msleep(TIMEOUT_MS >> 1);
+	irq_offload(isr_put, UINT_TO_POINTER(MSG0));
+}
+
+static void put_thread(void *p1, void *p2, void *p3)
+{
+	uint32_t msg = MSG1;
+
+	zassert_equal(k_msgq_put(&lf_msgq, &msg, TIMEOUT), (int)POINTER_TO_INT(p1));
+}
+
+static void get_thread(void *p1, void *p2, void *p3)
+{
+	uint32_t msg = 0;
+
+	zassert_equal(k_msgq_get(&lf_msgq, &msg, TIMEOUT), 0);
+	zassert_equal(msg, MSG0);
+}
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	uint32_t id = POINTER_TO_UINT(p1);
+
+	for (uint32_t i = 0; i < N_MSGS_PER_PRODUCER; i++) {
+		uint32_t msg = (id << 16) | i;
+
+		zassert_equal(k_msgq_put(&lf_msgq, &msg, K_FOREVER), 0);
+	}
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test putting and getting messages of a lock-free message queue
+ * @see K_MSGQ_DEFINE_LOCKFREE(), k_msgq_put(), k_msgq_get(), k_msgq_peek_at()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_lockfree_put_get)
+{
+	struct k_msgq_attrs attrs;
+	uint32_t msg;
+
+	lf_reset();
+
+	/* Several laps around the ring, to check the sequence numbers */
+	for (uint32_t lap = 0; lap < 3; lap++) {
+		for (uint32_t i = 0; i < LF_LEN; i++) {
+			msg = lap * LF_LEN + i;
+			zassert_equal(k_msgq_put(&lf_msgq, &msg, K_NO_WAIT), 0);
+		}
+
+		zassert_equal(k_msgq_put(&lf_msgq, &msg, K_NO_WAIT), -ENOMSG);
+		zassert_equal(k_msgq_put(&lf_msgq, &msg, K_MSEC(10)), -EAGAIN);
+		zassert_equal(k_msgq_num_used_get(&lf_msgq), LF_LEN);
+		zassert_equal(k_msgq_num_free_get(&lf_msgq), 0);
+
+		k_msgq_get_attrs(&lf_msgq, &attrs);
+		zassert_equal(attrs.used_msgs, LF_LEN);
+		zassert_equal(attrs.max_msgs, LF_LEN);
+		zassert_equal(attrs.msg_size, sizeof(uint32_t));
+
+		for (uint32_t i = 0; i < LF_LEN; i++) {
+			zassert_equal(k_msgq_peek_at(&lf_msgq, &msg, i), 0);
+			zassert_equal(msg, lap * LF_LEN + i);
+		}
+		zassert_equal(k_msgq_peek_at(&lf_msgq, &msg, LF_LEN), -ENOMSG);
+
+		for (uint32_t i = 0; i < LF_LEN; i++) {
+			zassert_equal(k_msgq_peek(&lf_msgq, &msg), 0);
+			zassert_equal(msg, lap * LF_LEN + i);
+			zassert_equal(k_msgq_get(&lf_msgq, &msg, K_NO_WAIT), 0);
+			zassert_equal(msg, lap * LF_LEN + i);
+		}
+
+		zassert_equal(k_msgq_get(&lf_msgq, &msg, K_NO_WAIT), -ENOMSG);
+		zassert_equal(k_msgq_get(&lf_msgq, &msg, K_MSEC(10)), -EAGAIN);
+		zassert_equal(k_msgq_peek(&lf_msgq, &msg), -ENOMSG);
+		zassert_equal(k_msgq_num_free_get(&lf_msgq), LF_LEN);
+	}
+}
+
+/**
+ * @brief Test a lock-free message queue initialized at runtime
+ * @see k_msgq_lockfree_init()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_lockfree_init)
+{
+	static struct k_msgq q;
+	static char __aligned(4) buffer[2 * MSG_SIZE];
+	static atomic_t seq[2];
+	uint32_t msg = MSG0;
+
+	k_msgq_lockfree_init(&q, buffer, seq, MSG_SIZE, 2);
+
+	zassert_equal(k_msgq_put(&q, &msg, K_NO_WAIT), 0);
+	msg = MSG1;
+	zassert_equal(k_msgq_put(&q, &msg, K_NO_WAIT), 0);
+	zassert_equal(k_msgq_put(&q, &msg, K_NO_WAIT), -ENOMSG);
+
+	zassert_equal(k_msgq_get(&q, &msg, K_NO_WAIT), 0);
+	zassert_equal(msg, MSG0);
+
+	/* Initializing again empties the queue */
+	k_msgq_lockfree_init(&q, buffer, seq, MSG_SIZE, 2);
+	zassert_equal(k_msgq_num_used_get(&q), 0);
+	zassert_equal(k_msgq_get(&q, &msg, K_NO_WAIT), -ENOMSG);
+}
+
+/**
+ * @brief Test a message put from an ISR waking up a thread waiting to get it
+ * @see k_msgq_put(), k_msgq_get()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_lockfree_isr_put)
+{
+	uint32_t msg = 0;
+
+	lf_reset();
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, isr_put_thread, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	zassert_equal(k_msgq_get(&lf_msgq, &msg, K_FOREVER), 0);
+	zassert_equal(isr_result, 0);
+	zassert_equal(msg, MSG0);
+
+	k_thread_join(&tdata, K_FOREVER);
+}
+
+/**
+ * @brief Test threads waiting to put into a full lock-free message queue
+ * @see k_msgq_put(), k_msgq_get(), k_msgq_purge()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_lockfree_wait_put)
+{
+	uint32_t msg;
+
+	lf_reset();
+
+	for (uint32_t i = 0; i < LF_LEN; i++) {
+		msg = i;
+		zassert_equal(k_msgq_put(&lf_msgq, &msg, K_NO_WAIT), 0);
+	}
+
+	/* Getting a message lets the waiting thread put its own */
+	k_thread_create(&tdata, tstack, STACK_SIZE, put_thread, INT_TO_POINTER(0), NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	zassert_equal(k_msgq_get(&lf_msgq, &msg, K_NO_WAIT), 0);
+	zassert_equal(msg, 0);
+	k_thread_join(&tdata, K_FOREVER);
+
+	zassert_equal(k_msgq_num_used_get(&lf_msgq), LF_LEN);
+	zassert_equal(k_msgq_peek_at(&lf_msgq, &msg, LF_LEN - 1), 0);
+	zassert_equal(msg, MSG1);
+
+	/* Purging fails the waiting thread */
+	k_thread_create(&tdata, tstack, STACK_SIZE, put_thread, INT_TO_POINTER(-ENOMSG),
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	k_msgq_purge(&lf_msgq);
+	k_thread_join(&tdata, K_FOREVER);
+
+	zassert_equal(k_msgq_num_used_get(&lf_msgq), 0);
+}
+
+/**
+ * @brief Test a thread waiting to get from an empty lock-free message queue
+ *
+ * @details Purging the queue only fails the threads waiting to put, the
+ * thread keeps waiting and gets the message put after the purge.
+ *
+ * @see k_msgq_get(), k_msgq_purge()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_lockfree_wait_get)
+{
+	uint32_t msg = MSG0;
+
+	lf_reset();
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, get_thread, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 2);
+
+	k_msgq_purge(&lf_msgq);
+	k_msleep(TIMEOUT_MS >> 2);
+
+	zassert_equal(k_msgq_put(&lf_msgq, &msg, K_NO_WAIT), 0);
+	k_thread_join(&tdata, K_FOREVER);
+
+	zassert_equal(k_msgq_num_used_get(&lf_msgq), 0);
+}
+
+/**
+ * @brief Test several producers putting into a lock-free message queue
+ *
+ * @details Each message is received exactly once, and the messages of each
+ * producer in the order they were put.
+ *
+ * @see k_msgq_put(), k_msgq_get()
+ */
+ZTEST(msgq_api, test_msgq_lockfree_producers)
+{
+	uint32_t next[N_PRODUCERS] = { 0 };
+	uint32_t msg;
+
+	lf_reset();
+	memset(received, 0, sizeof(received));
+
+	for (int i = 0; i < N_PRODUCERS; i++) {
+		k_thread_create(&producer_threads[i], producer_stacks[i], STACK_SIZE,
+				producer, UINT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int n = 0; n < N_PRODUCERS * N_MSGS_PER_PRODUCER; n++) {
+		uint32_t id, i;
+
+		zassert_equal(k_msgq_get(&lf_msgq, &msg, K_MSEC(1000)), 0,
+			      "missing message after %d", n);
+
+		id = msg >> 16;
+		i = msg & 0xffff;
+		zassert_true(id < N_PRODUCERS && i < N_MSGS_PER_PRODUCER, "bad message %x", msg);
+		zassert_equal(received[id][i], 0, "message %x received twice", msg);
+		zassert_equal(i, next[id], "message %x out of order", msg);
+		received[id][i] = 1;
+		next[id]++;
+	}
+
+	zassert_equal(k_msgq_get(&lf_msgq, &msg, K_NO_WAIT), -ENOMSG);
+
+	for (int i = 0; i < N_PRODUCERS; i++) {
+		k_thread_join(&producer_threads[i], K_FOREVER);
+	}
+}
+
+/**
+ * @}
+ */
+
+#endif /* CONFIG_MSGQ_LOCKFREE */
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for zero-copy pipe claims
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <zephyr/ztest.h>
+
+#ifdef CONFIG_PIPES_ZERO_COPY
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define CLAIM_PIPE_LEN	8
+#define XFER_LEN	16
+
+K_PIPE_DEFINE(claim_pipe, CLAIM_PIPE_LEN, 4);
+K_PIPE_DEFINE(claim_nobuf_pipe, 0, 4);
+
+static K_THREAD_STACK_DEFINE(claim_stack, STACK_SIZE);
+static struct k_thread claim_thread;
+
+static const unsigned char claim_data[XFER_LEN] = "0123456789abcdef";
+static unsigned char lender_buf[XFER_LEN];
+static k_timeout_t lender_timeout;
+static size_t lender_bytes;
+static volatile int lender_ret;
+static volatile bool lender_done;
+
+static void lender_put(void *p1, void *p2, void *p3)
+{
+	(void)memcpy(lender_buf, claim_data, sizeof(lender_buf));
+	lender_ret = k_pipe_put(p1, lender_buf, sizeof(lender_buf),
+				&lender_bytes, sizeof(lender_buf),
+				lender_timeout);
+	lender_done = true;
+}
+
+static void lender_get(void *p1, void *p2, void *p3)
+{
+	(void)memset(lender_buf, 0, sizeof(lender_buf));
+	lender_ret = k_pipe_get(p1, lender_buf, sizeof(lender_buf),
+				&lender_bytes, sizeof(lender_buf),
+				lender_timeout);
+	lender_done = true;
+}
+
+static void delayed_put(void *p1, void *p2, void *p3)
+{
+	size_t written;
+
+	k_msleep(20);
+	lender_ret = k_pipe_put(p1, (void *)claim_data, 4, &written, 4,
+				K_NO_WAIT);
+	lender_done = true;
+}
+
+static void start_thread(k_thread_entry_t entry, struct k_pipe *pipe,
+			 k_timeout_t timeout)
+{
+	lender_done = false;
+	lender_ret = 1;
+	lender_timeout = timeout;
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE, entry,
+			pipe, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(10);
+}
+
+static void reset_pipe(struct k_pipe *pipe)
+{
+	k_pipe_flush(pipe);
+	zassert_equal(k_pipe_read_avail(pipe), 0);
+}
+
+/**
+ * @brief Test claiming data and space in the pipe buffer
+ * @see k_pipe_read_claim(), k_pipe_write_claim()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_claim_buffer)
+{
+	unsigned char buf[CLAIM_PIPE_LEN];
+	size_t size;
+	void *data;
+
+	reset_pipe(&claim_pipe);
+
+	size = 5;
+	zassert_equal(k_pipe_write_claim(&claim_pipe, &data, &size, K_NO_WAIT), 0);
+	zassert_equal(size, 5);
+	size = 1;
+	zassert_equal(k_pipe_write_claim(&claim_pipe, &data, &size, K_NO_WAIT),
+		      -EBUSY);
+	zassert_equal(k_pipe_write_finish(&claim_pipe, 6), -EINVAL);
+
+	(void)memcpy(data, claim_data, 5);
+	zassert_equal(k_pipe_write_finish(&claim_pipe, 5), 0);
+	zassert_equal(k_pipe_write_finish(&claim_pipe, 0), -EINVAL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 5);
+
+	/* Claims are contiguous: only the space up to the end of the buffer */
+	size = CLAIM_PIPE_LEN;
+	zassert_equal(k_pipe_read_claim(&claim_pipe, &data, &size, K_NO_WAIT), 0);
+	zassert_equal(size, 5);
+	zassert_mem_equal(data, claim_data, 5);
+	zassert_equal(k_pipe_read_finish(&claim_pipe, 3), 0);
+
+	size = CLAIM_PIPE_LEN;
+	zassert_equal(k_pipe_write_claim(&claim_pipe, &data, &size, K_NO_WAIT), 0);
+	zassert_equal(size, CLAIM_PIPE_LEN - 5);
+	(void)memcpy(data, &claim_data[5], size);
+	zassert_equal(k_pipe_write_finish(&claim_pipe, size), 0);
+
+	size = CLAIM_PIPE_LEN;
+	zassert_equal(k_pipe_write_claim(&claim_pipe, &data, &size, K_NO_WAIT), 0);
+	zassert_equal(size, 3);
+	(void)memcpy(data, &claim_data[8], size);
+	zassert_equal(k_pipe_write_finish(&claim_pipe, size), 0);
+
+	size = 1;
+	zassert_equal(k_pipe_write_claim(&claim_pipe, &data, &size, K_NO_WAIT), -EIO);
+	zassert_equal(k_pipe_write_claim(&claim_pipe, &data, &size, K_MSEC(10)),
+		      -EAGAIN);
+
+	/* Claimed data and copied data are read in order */
+	zassert_equal(k_pipe_get(&claim_pipe, buf, sizeof(buf), &size, sizeof(buf),
+				 K_NO_WAIT), 0);
+	zassert_mem_equal(buf, &claim_data[3], sizeof(buf));
+
+	size = 1;
+	zassert_equal(k_pipe_read_claim(&claim_pipe, &data, &size, K_NO_WAIT), -EIO);
+	zassert_equal(k_pipe_read_claim(&claim_pipe, &data, &size, K_MSEC(10)),
+		      -EAGAIN);
+	zassert_equal(k_pipe_read_finish(&claim_pipe, 0), -EINVAL);
+}
+
+/**
+ * @brief Test claiming the data of a thread waiting to write
+ * @see k_pipe_read_claim(), k_pipe_read_finish()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_claim_lent_by_writer)
+{
+	size_t size;
+	void *data;
+
+	start_thread(lender_put, &claim_nobuf_pipe, K_FOREVER);
+
+	/* The data is read from the writer's buffer */
+	size = 10;
+	zassert_equal(k_pipe_read_claim(&claim_nobuf_pipe, &data, &size, K_NO_WAIT), 0);
+	zassert_equal_ptr(data, lender_buf);
+	zassert_equal(size, 10);
+	zassert_equal(k_pipe_read_finish(&claim_nobuf_pipe, size), 0);
+	k_msleep(10);
+	zassert_false(lender_done);
+
+	size = XFER_LEN;
+	zassert_equal(k_pipe_read_claim(&claim_nobuf_pipe, &data, &size, K_NO_WAIT), 0);
+	zassert_equal_ptr(data, &lender_buf[10]);
+	zassert_equal(size, XFER_LEN - 10);
+	zassert_equal(k_pipe_read_finish(&claim_nobuf_pipe, size), 0);
+
+	k_thread_join(&claim_thread, K_FOREVER);
+	zassert_equal(lender_ret, 0);
+	zassert_equal(lender_bytes, XFER_LEN);
+}
+
+/**
+ * @brief Test claiming the buffer of a thread waiting to read
+ * @see k_pipe_write_claim(), k_pipe_write_finish()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_claim_lent_by_reader)
+{
+	size_t size;
+	void *data;
+
+	start_thread(lender_get, &claim_nobuf_pipe, K_FOREVER);
+
+	size = XFER_LEN;
+	zassert_equal(k_pipe_write_claim(&claim_nobuf_pipe, &data, &size, K_NO_WAIT), 0);
+	zassert_equal_ptr(data, lender_buf);
+	zassert_equal(size, XFER_LEN);
+	(void)memcpy(data, claim_data, size);
+	zassert_equal(k_pipe_write_finish(&claim_nobuf_pipe, size), 0);
+
+	k_thread_join(&claim_thread, K_FOREVER);
+	zassert_equal(lender_ret, 0);
+	zassert_equal(lender_bytes, XFER_LEN);
+	zassert_mem_equal(lender_buf, claim_data, XFER_LEN);
+}
+
+/**
+ * @brief Test a thread waiting to write whose waiting period ends while its
+ * data is claimed
+ * @see k_pipe_read_claim(), k_pipe_read_finish()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_claim_lender_timeout)
+{
+	size_t size;
+	void *data;
+
+	start_thread(lender_put, &claim_nobuf_pipe, K_MSEC(30));
+
+	size = 4;
+	zassert_equal(k_pipe_read_claim(&claim_nobuf_pipe, &data, &size, K_NO_WAIT), 0);
+	zassert_equal_ptr(data, lender_buf);
+
+	/* The writer does not return before the claim ends */
+	k_msleep(50);
+	zassert_false(lender_done);
+
+	zassert_equal(k_pipe_read_finish(&claim_nobuf_pipe, size), 0);
+	k_thread_join(&claim_thread, K_FOREVER);
+	zassert_equal(lender_ret, -EAGAIN);
+	zassert_equal(lender_bytes, 4);
+}
+
+/**
+ * @brief Test waiting for data to claim
+ * @see k_pipe_read_claim()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_claim_wait)
+{
+	size_t size;
+	void *data;
+
+	reset_pipe(&claim_pipe);
+
+	start_thread(delayed_put, &claim_pipe, K_NO_WAIT);
+
+	size = CLAIM_PIPE_LEN;
+	zassert_equal(k_pipe_read_claim(&claim_pipe, &data, &size, K_MSEC(100)), 0);
+	zassert_equal(size, 4);
+	zassert_mem_equal(data, claim_data, 4);
+	zassert_equal(k_pipe_read_finish(&claim_pipe, size), 0);
+
+	k_thread_join(&claim_thread, K_FOREVER);
+	zassert_equal(lender_ret, 0);
+}
+
+#endif /* CONFIG_PIPES_ZERO_COPY */
+
+/**
+ * @}
+ */
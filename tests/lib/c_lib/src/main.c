@@ -614,6 +614,106 @@ ZTEST(test_c_lib, test_memmove)
 		     "memmove failed");
 }
 
+#define ALIGN_BUF_SIZE 256
+
+static unsigned char align_src[ALIGN_BUF_SIZE];
+static unsigned char align_dest[ALIGN_BUF_SIZE];
+
+static void align_fill(unsigned char *buf, unsigned char seed)
+{
+	for (int i = 0; i < ALIGN_BUF_SIZE; i++) {
+		buf[i] = (unsigned char)(i * 7 + seed);
+	}
+}
+
+static bool align_check(const unsigned char *buf, int start, int n,
+			const unsigned char *expected, unsigned char seed)
+{
+	for (int i = 0; i < ALIGN_BUF_SIZE; i++) {
+		unsigned char c = (i >= start && i < start + n) ?
+				  expected[i - start] : (unsigned char)(i * 7 + seed);
+
+		if (buf[i] != c) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Test memory and string functions for all alignments
+ *
+ * @details Word at a time implementations have different code paths
+ * depending on the alignment of the buffers and their size.
+ *
+ * @see memcpy(), memmove(), memset(), memcmp(), strlen().
+ */
+ZTEST(test_c_lib, test_mem_alignments)
+{
+	static const int sizes[] = { 0, 1, 3, 7, 8, 9, 15, 16, 17, 31, 32, 33,
+				     63, 64, 65, 100 };
+	unsigned char set[ALIGN_BUF_SIZE];
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		int n = sizes[i];
+
+		for (int s_off = 0; s_off < 8; s_off++) {
+			for (int d_off = 0; d_off < 8; d_off++) {
+				unsigned char *src = align_src + 16 + s_off;
+				unsigned char *dest = align_dest + 16 + d_off;
+
+				align_fill(align_src, 0);
+				align_fill(align_dest, 1);
+				zassert_equal(memcpy(dest, src, n), dest, NULL);
+				zassert_true(align_check(align_dest, 16 + d_off, n,
+							 src, 1),
+					     "memcpy %d bytes %d->%d failed", n,
+					     s_off, d_off);
+
+				zassert_equal(memcmp(dest, src, n), 0, NULL);
+				if (n > 0) {
+					dest[n - 1] ^= 0x80;
+					zassert_true((memcmp(dest, src, n) > 0) ==
+						     (dest[n - 1] > src[n - 1]),
+						     "memcmp %d bytes failed", n);
+				}
+
+				/* overlapping moves, in both directions */
+				align_fill(align_dest, 1);
+				memcpy(set, align_dest + 8 + s_off, n);
+				zassert_equal(memmove(dest, align_dest + 8 + s_off, n),
+					      dest, NULL);
+				zassert_true(align_check(align_dest, 16 + d_off, n,
+							 set, 1),
+					     "memmove %d bytes %d->%d failed", n,
+					     s_off, d_off);
+
+				align_fill(align_dest, 1);
+				memcpy(set, align_dest + 24 + s_off, n);
+				memmove(dest, align_dest + 24 + s_off, n);
+				zassert_true(align_check(align_dest, 16 + d_off, n,
+							 set, 1),
+					     "memmove %d bytes %d->%d failed", n,
+					     s_off, d_off);
+			}
+
+			align_fill(align_dest, 1);
+			memset(set, 0xa5, n);
+			zassert_equal(memset(align_dest + 16 + s_off, 0xa5, n),
+				      align_dest + 16 + s_off, NULL);
+			zassert_true(align_check(align_dest, 16 + s_off, n, set, 1),
+				     "memset %d bytes at %d failed", n, s_off);
+
+			align_fill(align_src, 0);
+			memset(align_src + 16 + s_off, 'x', n);
+			align_src[16 + s_off + n] = '\0';
+			zassert_equal(strlen((char *)align_src + 16 + s_off), n,
+				      "strlen %d bytes at %d failed", n, s_off);
+		}
+	}
+}
+
 /**
  *
  * @brief test str operate functions
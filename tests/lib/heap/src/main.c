@@ -50,6 +50,13 @@
 #define SOLO_FREE_HEADER_HEAP_SZ (64)
 #endif
 
+/* And by another 8 bytes with SYS_HEAP_SIZE_CLASSES */
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+#define SOLO_FREE_HEADER_SZ (SOLO_FREE_HEADER_HEAP_SZ + 8)
+#else
+#define SOLO_FREE_HEADER_SZ SOLO_FREE_HEADER_HEAP_SZ
+#endif
+
 #define SCRATCH_SZ (sizeof(heapmem) / 2)
 
 /* The test memory.  Make them pointer arrays for robust alignment
@@ -259,7 +266,7 @@ ZTEST(lib_heap, test_solo_free_header)
 
 	TC_PRINT("Testing solo free header in a heap\n");
 
-	sys_heap_init(&heap, heapmem, SOLO_FREE_HEADER_HEAP_SZ);
+	sys_heap_init(&heap, heapmem, SOLO_FREE_HEADER_SZ);
 	if (sizeof(void *) > 4U) {
 		sys_heap_alloc(&heap, 1);
 		zassert_true(sys_heap_validate(&heap), "");
@@ -485,4 +492,91 @@ ZTEST(lib_heap, test_heap_listeners)
 #endif /* CONFIG_SYS_HEAP_LISTENER */
 }
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+void *classalloc(void *arg, size_t bytes)
+{
+	void *ret = sys_heap_alloc(arg, bytes);
+
+	if (ret != NULL) {
+		size_t blksz = sys_heap_usable_size(arg, ret);
+
+		/* Small ones may still get a chunk when no page fits */
+		zassert_true(blksz >= bytes,
+			     "short block returned bytes = %ld ret = %ld",
+			     bytes, blksz);
+	}
+
+	fill_block(ret, bytes);
+	sys_heap_validate(arg);
+	return ret;
+}
+#endif
+
+/* Size class objects must give all the memory back once freed, then
+ * the usual stress run.
+ */
+ZTEST(lib_heap, test_size_classes)
+{
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	struct sys_heap heap;
+	struct z_heap_stress_result result;
+	static void *p[96];
+	size_t big;
+	void *p2;
+
+	TC_PRINT("Testing size classes on a (%d byte) heap\n", (int) SMALL_HEAP_SZ * 4);
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ * 4);
+	zassert_ok(sys_heap_size_classes_enable(&heap), "");
+
+	/* Largest block the heap has to offer, all classes empty */
+	for (big = SMALL_HEAP_SZ * 4; big > 0; big -= 8) {
+		p2 = sys_heap_alloc(&heap, big);
+		if (p2 != NULL) {
+			sys_heap_free(&heap, p2);
+			break;
+		}
+	}
+
+	/* Several pages of every class */
+	for (int i = 0; i < ARRAY_SIZE(p); i++) {
+		size_t bytes = 1 + (i * 8) % CONFIG_SYS_HEAP_SIZE_CLASS_MAX;
+
+		p[i] = classalloc(&heap, bytes);
+		zassert_not_null(p[i], "");
+		zassert_equal(sys_heap_usable_size(&heap, p[i]), ROUND_UP(bytes, 16),
+			      "not a size class object bytes = %ld", bytes);
+	}
+
+	/* Objects grow within their class, move beyond it */
+	realloc_fill_block(p[0], 1);
+	p2 = sys_heap_realloc(&heap, p[0], 16);
+	zassert_equal(p2, p[0], "realloc within class moved");
+	p2 = sys_heap_realloc(&heap, p[0], CONFIG_SYS_HEAP_SIZE_CLASS_MAX + 1);
+	zassert_not_equal(p2, p[0], "realloc beyond class didn't move");
+	zassert_true(realloc_check_block(p2, p[0], 1), "data changed");
+	p[0] = p2;
+	fill_block(p[0], 1);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	for (int i = 0; i < ARRAY_SIZE(p); i++) {
+		testfree(&heap, p[i]);
+	}
+
+	/* Spare pages are handed back when memory runs short */
+	p2 = sys_heap_alloc(&heap, big);
+	zassert_not_null(p2, "empty pages not returned");
+	sys_heap_free(&heap, p2);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	sys_heap_stress(classalloc, testfree, &heap,
+			SMALL_HEAP_SZ * 4, ITERATION_COUNT,
+			scratchmem, sizeof(scratchmem),
+			100, &result);
+	log_result(SMALL_HEAP_SZ * 4, &result);
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_SUITE(lib_heap, NULL, NULL, NULL, NULL, NULL);
@@ -1017,4 +1017,221 @@ ZTEST(lib_json_test, test_large_descriptor)
 	zassert_true(ret & ((int64_t)1 << 39), "Field int39 not decoded");
 }
 
+#define MANY_FIELDS 70
+#define MANY_FIELD(i, _) int f##i
+#define MANY_FIELD_DESCR(i, _) \
+	JSON_OBJ_DESCR_PRIM(struct many_fields, f##i, JSON_TOK_NUMBER)
+
+struct many_fields {
+	LISTIFY(MANY_FIELDS, MANY_FIELD, (;));
+};
+
+static const struct json_obj_descr many_fields_descr[] = {
+	LISTIFY(MANY_FIELDS, MANY_FIELD_DESCR, (,))
+};
+
+ZTEST(lib_json_test, test_json_obj_parse_fields)
+{
+	char encoded[] = "{\"f1\":1,\"f69\":69,\"f64\":64,\"f0\":0,\"f31\":31,"
+			 "\"f32\":32,\"f68\":-68}";
+	uint32_t decoded[JSON_OBJ_DECODED_WORDS(MANY_FIELDS)];
+	struct many_fields mf = { 0 };
+	int ret;
+
+	ret = json_obj_parse_fields(encoded, sizeof(encoded) - 1,
+				    many_fields_descr,
+				    ARRAY_SIZE(many_fields_descr), &mf,
+				    decoded);
+
+	zassert_equal(ret, 7, "json_obj_parse_fields returned %d", ret);
+	zassert_equal(decoded[0], BIT(0) | BIT(1) | BIT(31), NULL);
+	zassert_equal(decoded[1], BIT(0), NULL);
+	zassert_equal(decoded[2], BIT(0) | BIT(4) | BIT(5), NULL);
+	zassert_equal(mf.f1, 1, NULL);
+	zassert_equal(mf.f31, 31, NULL);
+	zassert_equal(mf.f32, 32, NULL);
+	zassert_equal(mf.f64, 64, NULL);
+	zassert_equal(mf.f68, -68, NULL);
+	zassert_equal(mf.f69, 69, NULL);
+	zassert_equal(mf.f2, 0, NULL);
+}
+
+struct many_fields_outer {
+	struct many_fields inner;
+};
+
+static const struct json_obj_descr many_fields_outer_descr[] = {
+	JSON_OBJ_DESCR_OBJECT(struct many_fields_outer, inner, many_fields_descr),
+};
+
+ZTEST(lib_json_test, test_json_too_many_fields)
+{
+	char encoded[] = "{\"inner\":{\"f1\":1}}";
+	char arr[] = "[{\"f1\":1}]";
+	struct many_fields_outer outer = { 0 };
+	struct json_obj json;
+	int64_t ret;
+
+	BUILD_ASSERT(MANY_FIELDS > CONFIG_JSON_LIBRARY_MAX_FIELDS);
+
+	ret = json_obj_parse(encoded, sizeof(encoded) - 1,
+			     many_fields_outer_descr,
+			     ARRAY_SIZE(many_fields_outer_descr), &outer);
+	zassert_equal(ret, -EINVAL, "Nested descriptor over the limit accepted");
+	zassert_equal(outer.inner.f1, 0, NULL);
+
+	ret = json_arr_separate_object_parse_init(&json, arr, sizeof(arr) - 1);
+	zassert_equal(ret, 0, NULL);
+	ret = json_arr_separate_parse_object(&json, many_fields_descr, 32,
+					     &outer.inner);
+	zassert_equal(ret, -EINVAL, "32 fields descriptor accepted");
+
+	ret = json_arr_separate_object_parse_init(&json, arr, sizeof(arr) - 1);
+	zassert_equal(ret, 0, NULL);
+	ret = json_arr_separate_parse_object(&json, many_fields_descr, 31,
+					     &outer.inner);
+	zassert_equal(ret, BIT(1), "json_arr_separate_parse_object returned %d",
+		      (int)ret);
+	zassert_equal(outer.inner.f1, 1, NULL);
+}
+
+ZTEST(lib_json_test, test_json_field_order)
+{
+	/* Out of order, repeated and unknown keys */
+	char encoded[] = "{\"some_bool\":true,\"some_int\":42,\"unknown\":7,"
+			 "\"some_string\":\"zephyr\",\"some_int\":43,"
+			 "\"if\":true}";
+	struct test_struct ts = { 0 };
+	int64_t ret;
+
+	ret = json_obj_parse(encoded, sizeof(encoded) - 1, test_descr,
+			     ARRAY_SIZE(test_descr), &ts);
+
+	zassert_equal(ret, BIT(0) | BIT(1) | BIT(2) | BIT(6),
+		      "Decoded fields 0x%llx", (long long)ret);
+	zassert_equal(ts.some_int, 42, "The first value of a key is kept");
+	zassert_true(ts.some_bool, NULL);
+	zassert_true(ts.if_, NULL);
+	zassert_equal(strcmp(ts.some_string, "zephyr"), 0, NULL);
+}
+
+struct stream_result {
+	char text[512];
+	size_t len;
+	int fail_after;
+};
+
+/* Write the tokens as "depth:type:key=value " */
+static int stream_cb(const struct json_stream_token *token, void *user_data)
+{
+	struct stream_result *result = user_data;
+
+	result->len += snprintk(result->text + result->len,
+				sizeof(result->text) - result->len,
+				"%d:%c:%s=%s ", (int)token->depth, token->type,
+				token->key ? token->key : "",
+				token->value ? token->value : "");
+
+	if (token->key) {
+		zassert_equal(strlen(token->key), token->key_len, NULL);
+	}
+
+	if (token->value) {
+		zassert_equal(strlen(token->value), token->value_len, NULL);
+	}
+
+	if (result->fail_after > 0 && --result->fail_after == 0) {
+		return -ECANCELED;
+	}
+
+	return 0;
+}
+
+static int stream_parse(const char *json, size_t chunk_size, size_t buf_size,
+			struct stream_result *result)
+{
+	struct json_stream stream;
+	char buf[32];
+	size_t len = strlen(json);
+	int ret;
+
+	memset(result->text, 0, sizeof(result->text));
+	result->len = 0;
+
+	json_stream_init(&stream, buf, MIN(buf_size, sizeof(buf)), stream_cb,
+			 result);
+
+	for (size_t pos = 0; pos < len; pos += chunk_size) {
+		ret = json_stream_feed(&stream, json + pos,
+				       MIN(chunk_size, len - pos));
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return json_stream_finish(&stream);
+}
+
+ZTEST(lib_json_test, test_json_stream)
+{
+	static const char json[] =
+		"{\"some_string\": \"zep\\\"hyr\", \"some_int\": -1234,"
+		" \"nested\": {\"b\": false, \"n\": null, \"e\": {}},"
+		" \"array\": [1.5e3, true, [], [\"a\", {\"k\": \"v\"}]]}";
+	static const char expected[] =
+		"0:{:= 1:\":some_string=zep\\\"hyr 1:0:some_int=-1234 "
+		"1:{:nested= 2:f:b= 2:n:n= 2:{:e= 2:}:= 1:}:= "
+		"1:[:array= 2:0:=1.5e3 2:t:= 2:[:= 2:]:= 2:[:= 3:\":=a "
+		"3:{:= 4:\":k=v 3:}:= 2:]:= 1:]:= 0:}:= ";
+	struct stream_result result = { 0 };
+
+	/* The result does not depend on how the document is split */
+	for (size_t chunk = 1; chunk <= sizeof(json); chunk++) {
+		zassert_equal(stream_parse(json, chunk, 32, &result), 0,
+			      "Parsing in chunks of %u failed",
+			      (unsigned int)chunk);
+		zassert_equal(strcmp(result.text, expected), 0,
+			      "Chunks of %u: %s", (unsigned int)chunk,
+			      result.text);
+	}
+
+	/* Top level values */
+	zassert_equal(stream_parse(" 42", 1, 32, &result), 0, NULL);
+	zassert_equal(strcmp(result.text, "0:0:=42 "), 0, NULL);
+	zassert_equal(stream_parse("[\"x\"] ", 3, 32, &result), 0, NULL);
+	zassert_equal(strcmp(result.text, "0:[:= 1:\":=x 0:]:= "), 0, NULL);
+}
+
+ZTEST(lib_json_test, test_json_stream_errors)
+{
+	static const char *const invalid[] = {
+		"", "{", "{\"a\"}", "{\"a\":}", "{\"a\":1,}", "[1 2]", "[1}",
+		"{\"a\":1]", "{1:2}", "tru", "nul!", "-", "\"\\x\"",
+		"\"\\u12g4\"", "{} {}", "\"abc",
+	};
+	struct stream_result result = { 0 };
+	char deep[JSON_STREAM_MAX_DEPTH + 2];
+
+	for (int i = 0; i < ARRAY_SIZE(invalid); i++) {
+		zassert_equal(stream_parse(invalid[i], 2, 32, &result),
+			      -EINVAL, "%s was accepted", invalid[i]);
+	}
+
+	/* The key and value do not fit the buffer with their terminators */
+	zassert_equal(stream_parse("{\"abc\":\"de\"}", 4, 6, &result), -ENOMEM,
+		      NULL);
+	zassert_equal(stream_parse("{\"abc\":\"de\"}", 4, 7, &result), 0,
+		      NULL);
+
+	memset(deep, '[', sizeof(deep) - 1);
+	deep[sizeof(deep) - 1] = '\0';
+	zassert_equal(stream_parse(deep, 8, 32, &result), -ENOSPC, NULL);
+
+	/* Errors of the callback stop the parsing */
+	result.fail_after = 2;
+	zassert_equal(stream_parse("[1, 2, 3]", 9, 32, &result), -ECANCELED,
+		      NULL);
+	zassert_equal(strcmp(result.text, "0:[:= 1:0:=1 "), 0, NULL);
+}
+
 ZTEST_SUITE(lib_json_test, NULL, NULL, NULL, NULL, NULL);
@@ -722,4 +722,39 @@ ZTEST(net_buf_tests, test_net_buf_user_data)
 	net_buf_unref(buf);
 }
 
+#if defined(CONFIG_PIPES)
+K_PIPE_DEFINE(splice_pipe, 16, 4);
+
+ZTEST(net_buf_tests, test_net_buf_splice_pipe)
+{
+	static const char data[] = "0123456789abcdef";
+	struct net_buf *buf;
+	size_t written;
+
+	buf = net_buf_alloc_len(&var_pool, 10, K_NO_WAIT);
+	zassert_not_null(buf, "Failed to get buffer");
+
+	zassert_equal(k_pipe_put(&splice_pipe, (void *)data, 16, &written, 16,
+				 K_NO_WAIT), 0, "Failed to fill pipe");
+
+	net_buf_add_u8(buf, 'x');
+
+	/* Only the tailroom is read */
+	zassert_equal(net_buf_splice_pipe(buf, &splice_pipe, 16, 16, K_NO_WAIT),
+		      0, "Failed to splice");
+	zassert_equal(buf->len, 10, "Invalid buffer length");
+	zassert_mem_equal(&buf->data[1], data, 9, "Invalid data");
+	zassert_equal(k_pipe_read_avail(&splice_pipe), 7, "Invalid pipe data");
+
+	/* A full buffer reads nothing */
+	zassert_equal(net_buf_splice_pipe(buf, &splice_pipe, 16, 1, K_NO_WAIT),
+		      0, "Failed to splice");
+	zassert_equal(buf->len, 10, "Invalid buffer length");
+
+	net_buf_unref(buf);
+
+	k_pipe_flush(&splice_pipe);
+}
+#endif /* CONFIG_PIPES */
+
 ZTEST_SUITE(net_buf_tests, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_DNS_RESOLVER_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/dns_resolve.h>
+
+/* The DNS server of this test, on the loopback interface, answers every
+ * query after SERVER_DELAY with the addresses 192.0.2.1 and 192.0.2.2 and
+ * a TTL of one minute, except for names starting with:
+ *
+ * - "short": TTL of one second,
+ * - "zero": TTL of zero,
+ * - "none": NXDOMAIN, with a SOA record giving a negative TTL of one second.
+ */
+
+#define SERVER_PORT 15353
+#define SERVER_DELAY K_MSEC(50)
+#define DNS_TIMEOUT 500 /* ms */
+#define WAIT_TIME K_MSEC(DNS_TIMEOUT + 100)
+#define STACK_SIZE 2048
+#define MAX_ADDR 4
+
+static uint8_t server_buf[512];
+static atomic_t queries_received;
+
+struct result {
+	struct k_sem done;
+	int status;
+	int count;
+	struct in_addr addr[MAX_ADDR];
+};
+
+static const struct in_addr addr1 = { { { 192, 0, 2, 1 } } };
+static const struct in_addr addr2 = { { { 192, 0, 2, 2 } } };
+
+static bool name_starts_with(const uint8_t *qname, const char *label)
+{
+	return qname[0] >= strlen(label) &&
+	       memcmp(&qname[1], label, strlen(label)) == 0;
+}
+
+static uint8_t *put_rr_header(uint8_t *pos, uint16_t type, uint32_t ttl,
+			      uint16_t len)
+{
+	/* Name is a pointer to the question */
+	*pos++ = 0xc0;
+	*pos++ = 12;
+	UNALIGNED_PUT(htons(type), (uint16_t *)pos);
+	pos += 2;
+	UNALIGNED_PUT(htons(1), (uint16_t *)pos);
+	pos += 2;
+	UNALIGNED_PUT(htonl(ttl), (uint32_t *)pos);
+	pos += 4;
+	UNALIGNED_PUT(htons(len), (uint16_t *)pos);
+	pos += 2;
+
+	return pos;
+}
+
+static int make_response(int len)
+{
+	uint8_t *qname = &server_buf[12];
+	uint8_t *pos = qname;
+	uint32_t ttl = 60;
+
+	while (pos < &server_buf[len] && *pos != 0) {
+		pos += *pos + 1;
+	}
+
+	/* Zero label, type and class */
+	pos += 1 + 4;
+	if (pos > &server_buf[len]) {
+		return -EINVAL;
+	}
+
+	/* Response, recursion available */
+	server_buf[2] = 0x81;
+	server_buf[3] = 0x80;
+
+	if (name_starts_with(qname, "none")) {
+		server_buf[3] |= 3; /* NXDOMAIN */
+		UNALIGNED_PUT(htons(0), (uint16_t *)&server_buf[6]);
+		UNALIGNED_PUT(htons(1), (uint16_t *)&server_buf[8]);
+
+		pos = put_rr_header(pos, 6, 60, 2 + 5 * 4);
+		/* Root mname and rname, serial, refresh, retry, expire */
+		memset(pos, 0, 2 + 4 * 4);
+		pos += 2 + 4 * 4;
+		/* Minimum, the negative TTL */
+		UNALIGNED_PUT(htonl(1), (uint32_t *)pos);
+		pos += 4;
+
+		return pos - server_buf;
+	}
+
+	if (name_starts_with(qname, "short")) {
+		ttl = 1;
+	} else if (name_starts_with(qname, "zero")) {
+		ttl = 0;
+	}
+
+	UNALIGNED_PUT(htons(2), (uint16_t *)&server_buf[6]);
+
+	pos = put_rr_header(pos, 1, ttl, sizeof(addr1));
+	memcpy(pos, &addr1, sizeof(addr1));
+	pos += sizeof(addr1);
+
+	pos = put_rr_header(pos, 1, ttl, sizeof(addr2));
+	memcpy(pos, &addr2, sizeof(addr2));
+	pos += sizeof(addr2);
+
+	return pos - server_buf;
+}
+
+static void dns_server(void *p1, void *p2, void *p3)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+		.sin_addr = { { { 127, 0, 0, 1 } } },
+	};
+	socklen_t addr_len;
+	int sock, len;
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(sock >= 0, "Cannot create server socket");
+	zassert_ok(bind(sock, (struct sockaddr *)&addr, sizeof(addr)),
+		   "Cannot bind server socket");
+
+	while (true) {
+		addr_len = sizeof(addr);
+		len = recvfrom(sock, server_buf, sizeof(server_buf), 0,
+			       (struct sockaddr *)&addr, &addr_len);
+		if (len < 0) {
+			continue;
+		}
+
+		atomic_inc(&queries_received);
+
+		len = make_response(len);
+		if (len < 0) {
+			continue;
+		}
+
+		k_sleep(SERVER_DELAY);
+
+		(void)sendto(sock, server_buf, len, 0, (struct sockaddr *)&addr,
+			     addr_len);
+	}
+}
+
+K_THREAD_DEFINE(dns_server_thread, STACK_SIZE, dns_server, NULL, NULL, NULL,
+		K_PRIO_COOP(2), 0, 0);
+
+static void result_cb(enum dns_resolve_status status,
+		      struct dns_addrinfo *info, void *user_data)
+{
+	struct result *result = user_data;
+
+	if (status == DNS_EAI_INPROGRESS && info != NULL) {
+		if (result->count < MAX_ADDR) {
+			result->addr[result->count] =
+				net_sin(&info->ai_addr)->sin_addr;
+		}
+
+		result->count++;
+		return;
+	}
+
+	result->status = status;
+	k_sem_give(&result->done);
+}
+
+static void result_init(struct result *result)
+{
+	memset(result, 0, sizeof(*result));
+	k_sem_init(&result->done, 0, 1);
+}
+
+static int start_query(const char *name, struct result *result,
+		       uint16_t *dns_id)
+{
+	result_init(result);
+
+	return dns_get_addr_info(name, DNS_QUERY_TYPE_A, dns_id, result_cb,
+				 result, DNS_TIMEOUT);
+}
+
+static void check_addresses(struct result *result)
+{
+	zassert_equal(result->status, DNS_EAI_ALLDONE, "Status %d",
+		      result->status);
+	zassert_equal(result->count, 2, "Got %d addresses", result->count);
+	zassert_true(net_ipv4_addr_cmp(&result->addr[0], &addr1), "addr1");
+	zassert_true(net_ipv4_addr_cmp(&result->addr[1], &addr2), "addr2");
+}
+
+/* Resolve a name, checking whether the answer came from the cache */
+static void resolve(const char *name, bool cached, int status)
+{
+	int queries = atomic_get(&queries_received);
+	struct result result;
+	uint16_t dns_id;
+
+	zassert_ok(start_query(name, &result, &dns_id), "Cannot resolve %s",
+		   name);
+
+	if (cached) {
+		/* Answered before returning */
+		zassert_ok(k_sem_take(&result.done, K_NO_WAIT),
+			   "%s not in cache", name);
+		zassert_equal(dns_id, 0, "DNS id set for cached answer");
+	} else {
+		zassert_ok(k_sem_take(&result.done, WAIT_TIME),
+			   "No answer for %s", name);
+	}
+
+	zassert_equal(atomic_get(&queries_received), queries + (cached ? 0 : 1),
+		      "Unexpected queries for %s", name);
+
+	if (status == DNS_EAI_ALLDONE) {
+		check_addresses(&result);
+	} else {
+		zassert_equal(result.status, status, "Status %d", result.status);
+	}
+}
+
+ZTEST(dns_cache, test_hit)
+{
+	struct dns_cache_stats before, after;
+
+	dns_cache_stats_get(&before);
+
+	resolve("www.zephyr.test", false, DNS_EAI_ALLDONE);
+	resolve("www.zephyr.test", true, DNS_EAI_ALLDONE);
+	resolve("WWW.Zephyr.Test", true, DNS_EAI_ALLDONE);
+
+	dns_cache_stats_get(&after);
+	zassert_equal(after.hits - before.hits, 2, "");
+	zassert_equal(after.misses - before.misses, 1, "");
+	zassert_equal(after.entries, 1, "");
+}
+
+ZTEST(dns_cache, test_ttl)
+{
+	resolve("short.zephyr.test", false, DNS_EAI_ALLDONE);
+	resolve("short.zephyr.test", true, DNS_EAI_ALLDONE);
+
+	k_msleep(1100);
+
+	resolve("short.zephyr.test", false, DNS_EAI_ALLDONE);
+
+	/* Answers with zero TTL are not cached */
+	resolve("zero.zephyr.test", false, DNS_EAI_ALLDONE);
+	resolve("zero.zephyr.test", false, DNS_EAI_ALLDONE);
+}
+
+ZTEST(dns_cache, test_negative)
+{
+	struct dns_cache_stats before, after;
+
+	dns_cache_stats_get(&before);
+
+	resolve("none.zephyr.test", false, DNS_EAI_NODATA);
+	resolve("none.zephyr.test", true, DNS_EAI_NODATA);
+
+	dns_cache_stats_get(&after);
+	zassert_equal(after.negative_hits - before.negative_hits, 1, "");
+
+	/* Negative TTL of the SOA record */
+	k_msleep(1100);
+
+	resolve("none.zephyr.test", false, DNS_EAI_NODATA);
+}
+
+ZTEST(dns_cache, test_flush)
+{
+	resolve("www.zephyr.test", false, DNS_EAI_ALLDONE);
+	resolve("www.zephyr.test", true, DNS_EAI_ALLDONE);
+
+	dns_cache_flush();
+
+	resolve("www.zephyr.test", false, DNS_EAI_ALLDONE);
+}
+
+ZTEST(dns_cache, test_lru)
+{
+	struct dns_cache_stats before, after;
+
+	dns_cache_stats_get(&before);
+
+	resolve("a.zephyr.test", false, DNS_EAI_ALLDONE);
+	resolve("b.zephyr.test", false, DNS_EAI_ALLDONE);
+	resolve("c.zephyr.test", false, DNS_EAI_ALLDONE);
+	resolve("a.zephyr.test", true, DNS_EAI_ALLDONE);
+
+	/* The cache holds three answers, b is the least recently used */
+	resolve("d.zephyr.test", false, DNS_EAI_ALLDONE);
+	resolve("a.zephyr.test", true, DNS_EAI_ALLDONE);
+	resolve("c.zephyr.test", true, DNS_EAI_ALLDONE);
+	resolve("d.zephyr.test", true, DNS_EAI_ALLDONE);
+	resolve("b.zephyr.test", false, DNS_EAI_ALLDONE);
+
+	dns_cache_stats_get(&after);
+	zassert_equal(after.evictions - before.evictions, 2, "");
+	zassert_equal(after.entries, 3, "");
+}
+
+ZTEST(dns_cache, test_coalesce)
+{
+	int queries = atomic_get(&queries_received);
+	struct result result1, result2;
+	uint16_t id1, id2;
+
+	zassert_ok(start_query("co.zephyr.test", &result1, &id1), "");
+	zassert_ok(start_query("co.zephyr.test", &result2, &id2), "");
+	zassert_not_equal(id1, id2, "Same DNS id");
+
+	zassert_ok(k_sem_take(&result1.done, WAIT_TIME), "No answer");
+	zassert_ok(k_sem_take(&result2.done, WAIT_TIME), "No answer");
+	check_addresses(&result1);
+	check_addresses(&result2);
+
+	zassert_equal(atomic_get(&queries_received), queries + 1,
+		      "Query sent twice");
+}
+
+ZTEST(dns_cache, test_coalesce_cancel)
+{
+	int queries = atomic_get(&queries_received);
+	struct result result1, result2;
+	uint16_t id1, id2;
+
+	zassert_ok(start_query("cancel.zephyr.test", &result1, &id1), "");
+	zassert_ok(start_query("cancel.zephyr.test", &result2, &id2), "");
+
+	/* The query waiting for the canceled one still gets the answer */
+	zassert_ok(dns_cancel_addr_info(id1), "");
+	zassert_ok(k_sem_take(&result1.done, K_NO_WAIT), "Not canceled");
+	zassert_equal(result1.status, DNS_EAI_CANCELED, "");
+
+	zassert_ok(k_sem_take(&result2.done, WAIT_TIME), "No answer");
+	check_addresses(&result2);
+
+	zassert_equal(atomic_get(&queries_received), queries + 1,
+		      "Query sent twice");
+
+	/* Both slots are free again */
+	resolve("x.zephyr.test", false, DNS_EAI_ALLDONE);
+	resolve("y.zephyr.test", false, DNS_EAI_ALLDONE);
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	dns_cache_flush();
+}
+
+ZTEST_SUITE(dns_cache, NULL, NULL, before, NULL, NULL);
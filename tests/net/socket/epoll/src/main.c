@@ -0,0 +1,437 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <stdio.h>
+#include <zephyr/ztest_assert.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_epoll.h>
+
+#include "../../socket_helpers.h"
+
+#define BUF_AND_SIZE(buf) buf, sizeof(buf) - 1
+#define STRLEN(buf) (sizeof(buf) - 1)
+
+#define TEST_STR_SMALL "test"
+
+#define MY_IPV6_ADDR "::1"
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+/* On QEMU, a wait with timeout takes +10ms from the requested time. */
+#define FUZZ 10
+
+#define TEST_SNDBUF_SIZE CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE
+
+static int c_sock;
+static int s_sock;
+static struct sockaddr_in6 c_addr;
+static struct sockaddr_in6 s_addr;
+
+static void prepare_udp_pair(void)
+{
+	int res;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+}
+
+static void close_udp_pair(void)
+{
+	zassert_equal(close(c_sock), 0, "close failed");
+	zassert_equal(close(s_sock), 0, "close failed");
+}
+
+static int epoll_add(int epfd, int fd, uint32_t events)
+{
+	struct epoll_event ev = {
+		.events = events,
+		.data.fd = fd,
+	};
+
+	return epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+}
+
+static void send_small(int sock)
+{
+	ssize_t len;
+
+	len = send(sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+}
+
+static void recv_small(int sock)
+{
+	char buf[10];
+	ssize_t len;
+
+	len = recv(sock, buf, sizeof(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+}
+
+ZTEST(net_socket_epoll, test_epoll_level_triggered)
+{
+	struct epoll_event events[2];
+	uint32_t tstamp;
+	int epfd;
+	int res;
+
+	prepare_udp_pair();
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	zassert_equal(epoll_add(epfd, s_sock, EPOLLIN), 0, "");
+
+	/* Wait on a non-ready socket with timeout of 0 */
+	tstamp = k_uptime_get_32();
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_true(k_uptime_get_32() - tstamp <= FUZZ, "");
+	zassert_equal(res, 0, "");
+
+	/* Wait on a non-ready socket with timeout of 30 */
+	tstamp = k_uptime_get_32();
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	tstamp = k_uptime_get_32() - tstamp;
+	zassert_true(tstamp >= 30U && tstamp <= 30 + FUZZ, "tstamp %d", tstamp);
+	zassert_equal(res, 0, "");
+
+	send_small(c_sock);
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+	/* Level triggered: reported again while data is pending */
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+
+	recv_small(s_sock);
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* UDP socket is always writable */
+	zassert_equal(epoll_add(epfd, c_sock, EPOLLOUT), 0, "");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLOUT, "");
+	zassert_equal(events[0].data.fd, c_sock, "");
+
+	zassert_equal(close(epfd), 0, "close failed");
+
+	close_udp_pair();
+}
+
+ZTEST(net_socket_epoll, test_epoll_edge_triggered)
+{
+	struct epoll_event events[2];
+	int epfd;
+	int res;
+
+	prepare_udp_pair();
+
+	epfd = epoll_create(1);
+	zassert_true(epfd >= 0, "epoll_create failed");
+
+	zassert_equal(epoll_add(epfd, s_sock, EPOLLIN | EPOLLET), 0, "");
+
+	send_small(c_sock);
+	send_small(c_sock);
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+	/* Edge triggered: not reported again until more data arrives */
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	send_small(c_sock);
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+
+	recv_small(s_sock);
+	recv_small(s_sock);
+	recv_small(s_sock);
+
+	zassert_equal(close(epfd), 0, "close failed");
+
+	close_udp_pair();
+}
+
+ZTEST(net_socket_epoll, test_epoll_oneshot)
+{
+	struct epoll_event events[2];
+	struct epoll_event ev;
+	int epfd;
+	int res;
+
+	prepare_udp_pair();
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	zassert_equal(epoll_add(epfd, s_sock, EPOLLIN | EPOLLONESHOT), 0, "");
+
+	send_small(c_sock);
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+
+	/* Disabled after reporting once, even with data pending */
+	send_small(c_sock);
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 10);
+	zassert_equal(res, 0, "");
+
+	/* Rearmed by EPOLL_CTL_MOD */
+	ev.events = EPOLLIN | EPOLLONESHOT;
+	ev.data.u32 = 0x1234;
+	res = epoll_ctl(epfd, EPOLL_CTL_MOD, s_sock, &ev);
+	zassert_equal(res, 0, "");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+	zassert_equal(events[0].data.u32, 0x1234, "");
+
+	recv_small(s_sock);
+	recv_small(s_sock);
+
+	zassert_equal(close(epfd), 0, "close failed");
+
+	close_udp_pair();
+}
+
+static struct k_work_delayable send_work;
+
+static void send_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	send_small(c_sock);
+}
+
+ZTEST(net_socket_epoll, test_epoll_wakeup)
+{
+	struct epoll_event events[1];
+	int epfd;
+	int res;
+
+	prepare_udp_pair();
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	zassert_equal(epoll_add(epfd, s_sock, EPOLLIN), 0, "");
+
+	/* Data arriving while blocked in epoll_wait() wakes it up */
+	k_work_init_delayable(&send_work, send_work_handler);
+	k_work_schedule(&send_work, K_MSEC(50));
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), -1);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+
+	recv_small(s_sock);
+
+	/* Closing a socket removes it from the interest set */
+	zassert_equal(close(s_sock), 0, "close failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	zassert_equal(close(epfd), 0, "close failed");
+	zassert_equal(close(c_sock), 0, "close failed");
+}
+
+ZTEST(net_socket_epoll, test_epoll_ctl_errors)
+{
+	struct epoll_event events[1];
+	struct epoll_event ev = { .events = EPOLLIN };
+	int epfd;
+	int res;
+
+	zassert_equal(epoll_create(0), -1, "");
+	zassert_equal(errno, EINVAL, "");
+	zassert_equal(epoll_create1(1), -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	prepare_udp_pair();
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	zassert_equal(epoll_add(epfd, s_sock, EPOLLIN), 0, "");
+
+	res = epoll_add(epfd, s_sock, EPOLLIN);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EEXIST, "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_MOD, c_sock, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, c_sock, NULL);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	res = epoll_ctl(epfd, 0, s_sock, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	/* An epoll instance cannot watch itself */
+	res = epoll_add(epfd, epfd, EPOLLIN);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EPERM, "");
+
+	res = epoll_add(c_sock, s_sock, EPOLLIN);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	res = epoll_wait(epfd, events, 0, 0);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "");
+
+	send_small(c_sock);
+	k_msleep(10);
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	recv_small(s_sock);
+
+	zassert_equal(close(epfd), 0, "close failed");
+
+	res = epoll_add(epfd, s_sock, EPOLLIN);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EBADF, "");
+
+	close_udp_pair();
+}
+
+ZTEST(net_socket_epoll, test_epoll_tcp)
+{
+	struct epoll_event events[2];
+	char buf[TEST_SNDBUF_SIZE] = { };
+	int new_sock;
+	int epfd;
+	int res;
+
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "");
+	res = listen(s_sock, 0);
+	zassert_equal(res, 0, "");
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	zassert_equal(epoll_add(epfd, s_sock, EPOLLIN), 0, "");
+
+	res = connect(c_sock, (const struct sockaddr *)&s_addr,
+		      sizeof(s_addr));
+	zassert_equal(res, 0, "");
+
+	/* Pending connection makes the listening socket readable */
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+	new_sock = accept(s_sock, NULL, NULL);
+	zassert_true(new_sock >= 0, "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "");
+
+	k_msleep(10);
+
+	/* EPOLLOUT should be reported after connecting */
+	zassert_equal(epoll_add(epfd, c_sock, EPOLLOUT | EPOLLET), 0, "");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 10);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLOUT, "");
+	zassert_equal(events[0].data.fd, c_sock, "");
+
+	/* EPOLLOUT should not be reported after filling the window */
+	res = send(c_sock, buf, sizeof(buf), 0);
+	zassert_equal(res, sizeof(buf), "");
+
+	res = send(c_sock, buf, sizeof(buf), MSG_DONTWAIT);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EAGAIN, "");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 10);
+	zassert_equal(res, 0, "");
+
+	/* EPOLLOUT should be reported again after consuming the data server
+	 * side.
+	 */
+	zassert_equal(epoll_add(epfd, new_sock, EPOLLIN), 0, "");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+	zassert_equal(events[0].data.fd, new_sock, "");
+
+	res = recv(new_sock, buf, sizeof(buf), 0);
+	zassert_equal(res, sizeof(buf), "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, new_sock, NULL);
+	zassert_equal(res, 0, "");
+
+	/* Wait longer this time to give TCP stack a chance to send ZWP. */
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 500);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLOUT, "");
+
+	/* Peer closing the connection is reported as EPOLLIN | EPOLLHUP */
+	zassert_equal(epoll_add(epfd, new_sock, EPOLLIN), 0, "");
+
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLIN | EPOLLHUP, "");
+	zassert_equal(events[0].data.fd, new_sock, "");
+
+	k_msleep(10);
+
+	/* Finalize the test */
+	zassert_equal(close(epfd), 0, "close failed");
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+	res = close(new_sock);
+	zassert_equal(res, 0, "close failed");
+}
+
+ZTEST_SUITE(net_socket_epoll, NULL, NULL, NULL, NULL, NULL);
@@ -440,4 +440,57 @@ ZTEST_USER(socket_misc_test_suite, test_ipv6)
 	test_ipv6_getpeername();
 }
 
+#if defined(CONFIG_PIPES_ZERO_COPY)
+K_PIPE_DEFINE(splice_pipe, 8, 4);
+
+ZTEST(socket_misc_test_suite, test_splice_pipe)
+{
+	struct sockaddr_in6 c_addr, s_addr;
+	int c_sock, s_sock;
+	size_t written;
+	char buf[16];
+	int ret;
+
+	prepare_sock_udp_v6("::1", 5001, &c_sock, &c_addr);
+	prepare_sock_udp_v6("::1", 5002, &s_sock, &s_addr);
+	zassert_equal(bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr)), 0,
+		      "bind failed, %d", errno);
+	zassert_equal(connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr)), 0,
+		      "connect failed, %d", errno);
+
+	ret = zsock_splice_pipe(c_sock, &splice_pipe, sizeof(buf), MSG_DONTWAIT);
+	zassert_equal(ret, -1, "splice from empty pipe succeeded");
+	zassert_equal(errno, EAGAIN, "unexpected errno %d", errno);
+
+	zassert_ok(k_pipe_put(&splice_pipe, "abcdef", 6, &written, 6, K_NO_WAIT), "");
+	ret = zsock_splice_pipe(c_sock, &splice_pipe, sizeof(buf), 0);
+	zassert_equal(ret, 6, "splice failed, %d", errno);
+	zassert_equal(k_pipe_read_avail(&splice_pipe), 0, "data left in pipe");
+
+	ret = recv(s_sock, buf, sizeof(buf), 0);
+	zassert_equal(ret, 6, "recv failed, %d", errno);
+	zassert_mem_equal(buf, "abcdef", 6, "");
+
+	/* Data wrapping around the end of the pipe buffer is sent in order */
+	zassert_ok(k_pipe_put(&splice_pipe, "ghijklmn", 8, &written, 8, K_NO_WAIT), "");
+	ret = zsock_splice_pipe(c_sock, &splice_pipe, 2, 0);
+	zassert_equal(ret, 2, "splice failed, %d", errno);
+
+	ret = recv(s_sock, buf, sizeof(buf), 0);
+	zassert_equal(ret, 2, "recv failed, %d", errno);
+	zassert_mem_equal(buf, "gh", 2, "");
+
+	ret = zsock_splice_pipe(c_sock, &splice_pipe, sizeof(buf), 0);
+	zassert_equal(ret, 6, "splice failed, %d", errno);
+	zassert_equal(k_pipe_read_avail(&splice_pipe), 0, "data left in pipe");
+
+	ret = recv(s_sock, buf, sizeof(buf), 0);
+	zassert_equal(ret, 6, "recv failed, %d", errno);
+	zassert_mem_equal(buf, "ijklmn", 6, "");
+
+	zassert_equal(close(c_sock), 0, "close failed, %d", errno);
+	zassert_equal(close(s_sock), 0, "close failed, %d", errno);
+}
+#endif
+
 ZTEST_SUITE(socket_misc_test_suite, NULL, setup, NULL, NULL, NULL);
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <stdio.h>
+#include <zephyr/ztest_assert.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_rtio.h>
+
+#include "../../socket_helpers.h"
+
+#define BUF_AND_SIZE(buf) buf, sizeof(buf) - 1
+#define STRLEN(buf) (sizeof(buf) - 1)
+
+#define TEST_STR_SMALL "test"
+
+#define MY_IPV6_ADDR "::1"
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+#define MEMPOOL_BLK_SIZE 16
+#define MEMPOOL_BLK_COUNT 8
+
+RTIO_DEFINE_WITH_MEMPOOL(r, 4, 4, MEMPOOL_BLK_COUNT, MEMPOOL_BLK_SIZE, 4);
+
+ZSOCK_RTIO_IODEV_DEFINE(c_iodev);
+ZSOCK_RTIO_IODEV_DEFINE(s_iodev);
+
+static int c_sock;
+static int s_sock;
+static struct sockaddr_in6 c_addr;
+static struct sockaddr_in6 s_addr;
+
+static void prepare_udp_pair(void)
+{
+	int res;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+}
+
+static void close_udp_pair(void)
+{
+	zassert_equal(close(c_sock), 0, "close failed");
+	zassert_equal(close(s_sock), 0, "close failed");
+}
+
+static void submit_read(struct rtio_iodev *iodev, uint8_t *buf, uint32_t len, void *userdata)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+
+	zassert_not_null(sqe, "no sqe");
+	rtio_sqe_prep_read(sqe, iodev, RTIO_PRIO_NORM, buf, len, userdata);
+	zassert_equal(rtio_submit(&r, 0), 0, "submit failed");
+}
+
+static void submit_write(struct rtio_iodev *iodev, uint8_t *buf, uint32_t len, void *userdata)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+
+	zassert_not_null(sqe, "no sqe");
+	rtio_sqe_prep_write(sqe, iodev, RTIO_PRIO_NORM, buf, len, userdata);
+	zassert_equal(rtio_submit(&r, 0), 0, "submit failed");
+}
+
+/* Wait for the next completion, false if there is none within the timeout */
+static bool get_cqe(struct rtio_cqe *cqe, int timeout_ms)
+{
+	return rtio_cqe_copy_out(&r, cqe, 1, K_MSEC(timeout_ms)) == 1;
+}
+
+ZTEST(net_socket_rtio, test_rtio_attach)
+{
+	struct rtio_cqe cqe;
+	uint8_t buf[8];
+
+	/* Unattached iodev fails the submissions */
+	submit_read(&s_iodev, buf, sizeof(buf), &s_iodev);
+	zassert_true(get_cqe(&cqe, 10), "no completion");
+	zassert_equal(cqe.result, -EBADF, "%d", cqe.result);
+	zassert_equal_ptr(cqe.userdata, &s_iodev, "");
+
+	zassert_equal(zsock_rtio_iodev_attach(&s_iodev, -1), -EBADF, "");
+
+	prepare_udp_pair();
+
+	zassert_equal(zsock_rtio_iodev_attach(&s_iodev, s_sock), 0, "");
+	zassert_equal(zsock_rtio_iodev_attach(&s_iodev, c_sock), -EBUSY, "");
+	zassert_equal(zsock_rtio_iodev_attach(&c_iodev, s_sock), -EBUSY, "");
+
+	/* Detaching completes a pending receive as canceled */
+	submit_read(&s_iodev, buf, sizeof(buf), &s_iodev);
+	zassert_false(get_cqe(&cqe, 10), "unexpected completion");
+	zsock_rtio_iodev_detach(&s_iodev);
+	zassert_true(get_cqe(&cqe, 10), "no completion");
+	zassert_equal(cqe.result, -ECANCELED, "%d", cqe.result);
+
+	/* Closing the socket detaches it */
+	zassert_equal(zsock_rtio_iodev_attach(&s_iodev, s_sock), 0, "");
+	close_udp_pair();
+	zassert_equal(zsock_rtio_iodev_attach(&c_iodev, c_sock), -EBADF, "");
+
+	submit_read(&s_iodev, buf, sizeof(buf), &s_iodev);
+	zassert_true(get_cqe(&cqe, 10), "no completion");
+	zassert_equal(cqe.result, -EBADF, "%d", cqe.result);
+}
+
+ZTEST(net_socket_rtio, test_rtio_udp)
+{
+	uint8_t tx_buf[] = TEST_STR_SMALL;
+	struct rtio_cqe cqe;
+	uint8_t buf[10];
+
+	prepare_udp_pair();
+
+	zassert_equal(zsock_rtio_iodev_attach(&c_iodev, c_sock), 0, "");
+	zassert_equal(zsock_rtio_iodev_attach(&s_iodev, s_sock), 0, "");
+
+	/* Receive waits for the datagram */
+	submit_read(&s_iodev, buf, sizeof(buf), &s_iodev);
+	zassert_false(get_cqe(&cqe, 10), "unexpected completion");
+
+	submit_write(&c_iodev, BUF_AND_SIZE(tx_buf), &c_iodev);
+
+	zassert_true(get_cqe(&cqe, 100), "no completion");
+	zassert_equal_ptr(cqe.userdata, &c_iodev, "");
+	zassert_equal(cqe.result, STRLEN(TEST_STR_SMALL), "%d", cqe.result);
+
+	zassert_true(get_cqe(&cqe, 100), "no completion");
+	zassert_equal_ptr(cqe.userdata, &s_iodev, "");
+	zassert_equal(cqe.result, STRLEN(TEST_STR_SMALL), "%d", cqe.result);
+	zassert_mem_equal(buf, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL), "");
+
+	/* Datagram already received is served on submission */
+	submit_write(&c_iodev, BUF_AND_SIZE(tx_buf), &c_iodev);
+	zassert_true(get_cqe(&cqe, 100), "no completion");
+	zassert_equal_ptr(cqe.userdata, &c_iodev, "");
+	k_msleep(10);
+
+	memset(buf, 0, sizeof(buf));
+	submit_read(&s_iodev, buf, sizeof(buf), &s_iodev);
+	zassert_true(get_cqe(&cqe, 10), "no completion");
+	zassert_equal(cqe.result, STRLEN(TEST_STR_SMALL), "%d", cqe.result);
+	zassert_mem_equal(buf, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL), "");
+
+	close_udp_pair();
+}
+
+ZTEST(net_socket_rtio, test_rtio_multishot)
+{
+	struct rtio_sqe *handle;
+	struct rtio_cqe cqe;
+	uint32_t buf_len = 0;
+	uint8_t *buf = NULL;
+	int res;
+
+	prepare_udp_pair();
+
+	zassert_equal(zsock_rtio_iodev_attach(&s_iodev, s_sock), 0, "");
+
+	handle = rtio_sqe_acquire(&r);
+	zassert_not_null(handle, "no sqe");
+	rtio_sqe_prep_read_multishot(handle, &s_iodev, RTIO_PRIO_NORM, &s_iodev);
+	zassert_equal(rtio_submit(&r, 0), 0, "submit failed");
+
+	zassert_false(get_cqe(&cqe, 10), "unexpected completion");
+
+	for (int i = 0; i < 3; i++) {
+		char data[] = "test0";
+
+		data[4] += i;
+		res = send(c_sock, data, STRLEN(data), 0);
+		zassert_equal(res, STRLEN(data), "send failed");
+
+		zassert_true(get_cqe(&cqe, 100), "no completion %d", i);
+		zassert_equal(cqe.result, STRLEN(data), "%d", cqe.result);
+		zassert_equal(rtio_cqe_get_mempool_buffer(&r, &cqe, &buf, &buf_len), 0, "");
+		zassert_true(buf_len >= STRLEN(data), "");
+		zassert_mem_equal(buf, data, STRLEN(data), "");
+		rtio_release_buffer(&r, buf, buf_len);
+	}
+
+	/* Canceled receive is released once served, without completion */
+	zassert_equal(rtio_sqe_cancel(handle), 0, "");
+	res = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "send failed");
+	zassert_false(get_cqe(&cqe, 10), "unexpected completion");
+
+	close_udp_pair();
+}
+
+ZTEST(net_socket_rtio, test_rtio_tcp)
+{
+	uint8_t tx_buf[] = TEST_STR_SMALL;
+	struct rtio_cqe cqe;
+	uint8_t buf[10];
+	int new_sock;
+	int res;
+
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "");
+	res = listen(s_sock, 0);
+	zassert_equal(res, 0, "");
+
+	res = connect(c_sock, (const struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "");
+
+	new_sock = accept(s_sock, NULL, NULL);
+	zassert_true(new_sock >= 0, "");
+
+	zassert_equal(zsock_rtio_iodev_attach(&c_iodev, c_sock), 0, "");
+	zassert_equal(zsock_rtio_iodev_attach(&s_iodev, new_sock), 0, "");
+
+	submit_read(&s_iodev, buf, sizeof(buf), &s_iodev);
+	zassert_false(get_cqe(&cqe, 10), "unexpected completion");
+
+	submit_write(&c_iodev, BUF_AND_SIZE(tx_buf), &c_iodev);
+
+	zassert_true(get_cqe(&cqe, 100), "no completion");
+	zassert_equal_ptr(cqe.userdata, &c_iodev, "");
+	zassert_equal(cqe.result, STRLEN(TEST_STR_SMALL), "%d", cqe.result);
+
+	zassert_true(get_cqe(&cqe, 100), "no completion");
+	zassert_equal_ptr(cqe.userdata, &s_iodev, "");
+	zassert_equal(cqe.result, STRLEN(TEST_STR_SMALL), "%d", cqe.result);
+	zassert_mem_equal(buf, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL), "");
+
+	/* Peer closing the connection completes the receive with 0 */
+	submit_read(&s_iodev, buf, sizeof(buf), &s_iodev);
+	zassert_false(get_cqe(&cqe, 10), "unexpected completion");
+
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+
+	zassert_true(get_cqe(&cqe, 100), "no completion");
+	zassert_equal_ptr(cqe.userdata, &s_iodev, "");
+	zassert_equal(cqe.result, 0, "%d", cqe.result);
+
+	k_msleep(10);
+
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+	res = close(new_sock);
+	zassert_equal(res, 0, "close failed");
+}
+
+ZTEST_SUITE(net_socket_rtio, NULL, NULL, NULL, NULL, NULL);
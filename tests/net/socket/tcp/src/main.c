@@ -11,6 +11,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <fcntl.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/loopback.h>
+#include <zephyr/net/net_pkt.h>
 
 #include "../../socket_helpers.h"
 
@@ -1188,6 +1189,50 @@ ZTEST(net_socket_tcp, test_so_protocol)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_tcp_congestion)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+	struct sockaddr_in bind_addr4;
+	int sock, rv;
+	char name[16];
+	socklen_t optlen = sizeof(name);
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	rv = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(strcmp(name, CONFIG_NET_TCP_CONGESTION_DEFAULT), 0,
+		      "getsockopt got invalid algorithm %s", name);
+	zassert_equal(optlen, strlen(name) + 1, "getsockopt got invalid size");
+
+	rv = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "foo", strlen("foo"));
+	zassert_equal(rv, -1, "setsockopt accepted unknown algorithm");
+	zassert_equal(errno, ENOENT, "setsockopt got invalid errno (%d)", errno);
+
+	rv = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "newreno",
+			strlen("newreno"));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CUBIC)) {
+		rv = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "cubic",
+				strlen("cubic"));
+		zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+		optlen = sizeof(name);
+		rv = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+		zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+		zassert_equal(strcmp(name, "cubic"), 0,
+			      "getsockopt got invalid algorithm %s", name);
+	}
+
+	test_close(sock);
+
+	test_context_cleanup();
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST(net_socket_tcp, test_so_rcvbuf)
 {
 	struct sockaddr_in bind_addr4;
@@ -1793,6 +1838,103 @@ ZTEST(net_socket_tcp, test_v6_msg_waitall)
 	test_context_cleanup();
 }
 
+#define TEST_ZC_DATA_LEN 1000
+
+ZTEST(net_socket_tcp, test_v6_zero_copy)
+{
+	static uint8_t tx_data[TEST_ZC_DATA_LEN];
+	static uint8_t rx_data[TEST_ZC_DATA_LEN];
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in6 c_saddr;
+	struct sockaddr_in6 s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct net_buf *frags = NULL;
+	size_t received = 0;
+	size_t offset = 0;
+	int ret;
+
+	for (int i = 0; i < sizeof(tx_data); i++) {
+		tx_data[i] = (uint8_t)(i % TEST_PRIME);
+	}
+
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	ret = zsock_recv_zc(c_sock, &frags, 0);
+	zassert_equal(ret, -1, "recv_zc on unconnected socket succeeded");
+	zassert_equal(errno, ENOTCONN, "Invalid errno (%d)", errno);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+	zassert_equal(addrlen, sizeof(struct sockaddr_in6), "Wrong addrlen");
+
+	/* Send a chain of caller filled buffers, receive with a copy */
+	while (offset < sizeof(tx_data)) {
+		struct net_buf *buf;
+		size_t chunk;
+
+		buf = net_pkt_get_reserve_tx_data(0, K_NO_WAIT);
+		zassert_not_null(buf, "Cannot allocate data buffer");
+
+		chunk = MIN(sizeof(tx_data) - offset, net_buf_tailroom(buf));
+		net_buf_add_mem(buf, tx_data + offset, chunk);
+		offset += chunk;
+
+		if (frags == NULL) {
+			frags = buf;
+		} else {
+			net_buf_frag_add(frags, buf);
+		}
+	}
+
+	ret = zsock_send_zc(c_sock, frags, 0);
+	zassert_equal(ret, sizeof(tx_data), "send_zc failed (%d)", errno);
+
+	ret = recv(new_sock, rx_data, sizeof(rx_data), MSG_WAITALL);
+	zassert_equal(ret, sizeof(rx_data), "Invalid length received");
+	zassert_mem_equal(rx_data, tx_data, sizeof(rx_data),
+			  "Invalid data received");
+
+	/* Send with a copy, receive the stack's buffers */
+	test_send(c_sock, tx_data, sizeof(tx_data), 0);
+
+	memset(rx_data, 0, sizeof(rx_data));
+
+	while (received < sizeof(rx_data)) {
+		ret = zsock_recv_zc(new_sock, &frags, 0);
+		zassert_true(ret > 0, "recv_zc failed (%d)", errno);
+		zassert_true(received + ret <= sizeof(rx_data),
+			     "Too much data received");
+		zassert_equal(net_buf_frags_len(frags), ret, "Invalid length");
+
+		net_buf_linearize(rx_data + received, sizeof(rx_data) - received,
+				  frags, 0, ret);
+		net_buf_unref(frags);
+		received += ret;
+	}
+
+	zassert_mem_equal(rx_data, tx_data, sizeof(rx_data),
+			  "Invalid data received");
+
+	test_close(c_sock);
+
+	ret = zsock_recv_zc(new_sock, &frags, 0);
+	zassert_equal(ret, 0, "recv_zc did not report EOF");
+	zassert_is_null(frags, "Buffers returned at EOF");
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+}
+
 #ifdef CONFIG_USERSPACE
 #define CHILD_STACK_SZ		(2048 + CONFIG_TEST_EXTRA_STACK_SIZE)
 struct k_thread child_thread;
@@ -1866,6 +2008,10 @@ static void *setup(void)
 		k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(8));
 	}
 
+	if (IS_ENABLED(CONFIG_NET_TCP_GRO)) {
+		net_if_flag_set(net_if_get_default(), NET_IF_GRO);
+	}
+
 	return NULL;
 }
 
@@ -14,6 +14,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include <zephyr/net/socket.h>
 #include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_pkt.h>
 
 #include "ipv6.h"
 #include "../../socket_helpers.h"
@@ -1286,4 +1287,266 @@ ZTEST(net_socket_udp, test_23_v6_dgram_overflow)
 			    BUF_AND_SIZE(test_str_all_tx_bufs));
 }
 
+static struct net_buf *zc_alloc_data(const char *data, size_t len)
+{
+	struct net_buf *frags = NULL;
+
+	while (len > 0) {
+		struct net_buf *buf;
+		size_t chunk;
+
+		buf = net_pkt_get_reserve_tx_data(MIN(len, 64), K_NO_WAIT);
+		zassert_not_null(buf, "cannot allocate data buffer");
+
+		chunk = MIN(len, net_buf_tailroom(buf));
+		net_buf_add_mem(buf, data, chunk);
+		data += chunk;
+		len -= chunk;
+
+		if (frags == NULL) {
+			frags = buf;
+		} else {
+			net_buf_frag_add(frags, buf);
+		}
+	}
+
+	return frags;
+}
+
+ZTEST(net_socket_udp, test_24_v6_zero_copy)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+	struct sockaddr_in6 addr;
+	socklen_t addrlen;
+	struct net_buf *frags;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = bind(client_sock, (struct sockaddr *)&client_addr,
+		  sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	/* Nothing to receive yet */
+	rv = zsock_recv_zc(server_sock, &frags, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recv_zc succeeded");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+	zassert_is_null(frags, "buffers returned");
+
+	rv = zsock_recv_zc(server_sock, &frags, MSG_PEEK);
+	zassert_equal(rv, -1, "recv_zc succeeded");
+	zassert_equal(errno, EOPNOTSUPP, "incorrect errno value");
+
+	/* Data spanning several buffers is sent as one datagram */
+	frags = zc_alloc_data(TEST_STR2, STRLEN(TEST_STR2));
+	zassert_not_null(frags->frags, "data fits in one buffer");
+
+	rv = zsock_sendto_zc(client_sock, frags, 0,
+			     (struct sockaddr *)&server_addr,
+			     sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto_zc failed");
+
+	addrlen = sizeof(addr);
+	rv = zsock_recvfrom_zc(server_sock, &frags, 0,
+			       (struct sockaddr *)&addr, &addrlen);
+	zassert_equal(rv, STRLEN(TEST_STR2), "recvfrom_zc failed");
+	zassert_equal(net_buf_frags_len(frags), STRLEN(TEST_STR2),
+		      "invalid buffer length");
+	zassert_equal(addrlen, sizeof(addr), "invalid address length");
+	zassert_equal(addr.sin6_port, client_addr.sin6_port, "invalid port");
+
+	memset(rx_buf, 0, sizeof(rx_buf));
+	zassert_equal(net_buf_linearize(rx_buf, sizeof(rx_buf), frags, 0,
+					STRLEN(TEST_STR2)),
+		      STRLEN(TEST_STR2), "linearize failed");
+	zassert_mem_equal(rx_buf, TEST_STR2, STRLEN(TEST_STR2),
+			  "invalid rx data");
+	net_buf_unref(frags);
+
+	/* Copying and zero-copy calls can be mixed */
+	rv = connect(client_sock, (struct sockaddr *)&server_addr,
+		     sizeof(server_addr));
+	zassert_equal(rv, 0, "connect failed");
+
+	rv = send(client_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "send failed");
+
+	rv = zsock_recv_zc(server_sock, &frags, 0);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "recv_zc failed");
+	zassert_mem_equal(frags->data, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL),
+			  "invalid rx data");
+	net_buf_unref(frags);
+
+	frags = zc_alloc_data(TEST_STR_SMALL, STRLEN(TEST_STR_SMALL));
+
+	rv = zsock_send_zc(client_sock, frags, 0);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "send_zc failed");
+
+	memset(rx_buf, 0, sizeof(rx_buf));
+	rv = recv(server_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "recv failed");
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL),
+			  "invalid rx data");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+ZTEST_USER(net_socket_udp, test_25_v6_sendmmsg_recvmmsg)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+	struct sockaddr_in6 src_addr[3];
+	struct mmsghdr msgs[3];
+	struct mmsghdr tx_msg;
+	struct iovec tx_iov[4];
+	struct iovec rx_iov[4];
+	char rx_small[2][sizeof(TEST_STR_SMALL)];
+	char rx_trunc[8];
+	char rx_full[STRLEN(TEST_STR2) + 1];
+	struct zsock_timeval tv = {
+		.tv_sec = 0,
+		.tv_usec = 100000,
+	};
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = bind(client_sock, (struct sockaddr *)&client_addr,
+		  sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	memset(msgs, 0, sizeof(msgs));
+	rx_iov[0].iov_base = rx_full;
+	rx_iov[0].iov_len = sizeof(rx_full);
+	msgs[0].msg_hdr.msg_iov = rx_iov;
+	msgs[0].msg_hdr.msg_iovlen = 1;
+
+	/* Nothing to receive yet */
+	rv = recvmmsg(server_sock, msgs, 1, MSG_DONTWAIT, NULL);
+	zassert_equal(rv, -1, "recvmmsg succeeded");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	/* Three datagrams, the second one gathered from two buffers */
+	tx_iov[0].iov_base = TEST_STR_SMALL;
+	tx_iov[0].iov_len = STRLEN(TEST_STR_SMALL);
+	tx_iov[1].iov_base = TEST_STR2;
+	tx_iov[1].iov_len = 10;
+	tx_iov[2].iov_base = TEST_STR2 + 10;
+	tx_iov[2].iov_len = STRLEN(TEST_STR2) - 10;
+	tx_iov[3].iov_base = TEST_STR2;
+	tx_iov[3].iov_len = STRLEN(TEST_STR2);
+
+	memset(msgs, 0, sizeof(msgs));
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		msgs[i].msg_hdr.msg_name = &server_addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+	}
+
+	msgs[0].msg_hdr.msg_iov = &tx_iov[0];
+	msgs[0].msg_hdr.msg_iovlen = 1;
+	msgs[1].msg_hdr.msg_iov = &tx_iov[1];
+	msgs[1].msg_hdr.msg_iovlen = 2;
+	msgs[2].msg_hdr.msg_iov = &tx_iov[3];
+	msgs[2].msg_hdr.msg_iovlen = 1;
+
+	rv = sendmmsg(client_sock, msgs, ARRAY_SIZE(msgs), 0);
+	zassert_equal(rv, ARRAY_SIZE(msgs), "sendmmsg failed (%d)", errno);
+	zassert_equal(msgs[0].msg_len, STRLEN(TEST_STR_SMALL), "invalid length");
+	zassert_equal(msgs[1].msg_len, STRLEN(TEST_STR2), "invalid length");
+	zassert_equal(msgs[2].msg_len, STRLEN(TEST_STR2), "invalid length");
+
+	/* Scatter the first one, truncate the second one */
+	memset(rx_small, 0, sizeof(rx_small));
+	memset(rx_full, 0, sizeof(rx_full));
+
+	rx_iov[0].iov_base = rx_small[0];
+	rx_iov[0].iov_len = 2;
+	rx_iov[1].iov_base = rx_small[1];
+	rx_iov[1].iov_len = sizeof(rx_small[1]);
+	rx_iov[2].iov_base = rx_trunc;
+	rx_iov[2].iov_len = sizeof(rx_trunc);
+	rx_iov[3].iov_base = rx_full;
+	rx_iov[3].iov_len = sizeof(rx_full);
+
+	memset(msgs, 0, sizeof(msgs));
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		msgs[i].msg_hdr.msg_name = &src_addr[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(src_addr[i]);
+	}
+
+	msgs[0].msg_hdr.msg_iov = &rx_iov[0];
+	msgs[0].msg_hdr.msg_iovlen = 2;
+	msgs[1].msg_hdr.msg_iov = &rx_iov[2];
+	msgs[1].msg_hdr.msg_iovlen = 1;
+	msgs[2].msg_hdr.msg_iov = &rx_iov[3];
+	msgs[2].msg_hdr.msg_iovlen = 1;
+
+	rv = recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs), 0, NULL);
+	zassert_equal(rv, ARRAY_SIZE(msgs), "recvmmsg failed (%d)", errno);
+
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		zassert_equal(msgs[i].msg_hdr.msg_namelen, sizeof(src_addr[i]),
+			      "invalid address length");
+		zassert_equal(src_addr[i].sin6_port, client_addr.sin6_port,
+			      "invalid port");
+	}
+
+	zassert_equal(msgs[0].msg_len, STRLEN(TEST_STR_SMALL), "invalid length");
+	zassert_equal(msgs[0].msg_hdr.msg_flags, 0, "invalid flags");
+	zassert_mem_equal(rx_small[0], TEST_STR_SMALL, 2, "invalid rx data");
+	zassert_mem_equal(rx_small[1], TEST_STR_SMALL + 2,
+			  STRLEN(TEST_STR_SMALL) - 2, "invalid rx data");
+
+	zassert_equal(msgs[1].msg_len, sizeof(rx_trunc), "invalid length");
+	zassert_equal(msgs[1].msg_hdr.msg_flags, MSG_TRUNC, "invalid flags");
+	zassert_mem_equal(rx_trunc, TEST_STR2, sizeof(rx_trunc),
+			  "invalid rx data");
+
+	zassert_equal(msgs[2].msg_len, STRLEN(TEST_STR2), "invalid length");
+	zassert_mem_equal(rx_full, TEST_STR2, STRLEN(TEST_STR2),
+			  "invalid rx data");
+
+	/* A timeout ends the call with the datagrams received so far */
+	memset(&tx_msg, 0, sizeof(tx_msg));
+	tx_msg.msg_hdr.msg_name = &server_addr;
+	tx_msg.msg_hdr.msg_namelen = sizeof(server_addr);
+	tx_msg.msg_hdr.msg_iov = &tx_iov[0];
+	tx_msg.msg_hdr.msg_iovlen = 1;
+
+	rv = sendmmsg(client_sock, &tx_msg, 1, 0);
+	zassert_equal(rv, 1, "sendmmsg failed (%d)", errno);
+
+	rv = recvmmsg(server_sock, msgs, 2, 0, &tv);
+	zassert_equal(rv, 1, "recvmmsg failed (%d)", errno);
+	zassert_equal(msgs[0].msg_len, STRLEN(TEST_STR_SMALL), "invalid length");
+
+	/* MSG_WAITFORONE returns as soon as one datagram is in */
+	rv = sendmmsg(client_sock, &tx_msg, 1, 0);
+	zassert_equal(rv, 1, "sendmmsg failed (%d)", errno);
+
+	rv = recvmmsg(server_sock, msgs, 2, MSG_WAITFORONE, NULL);
+	zassert_equal(rv, 1, "recvmmsg failed (%d)", errno);
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 ZTEST_SUITE(net_socket_udp, NULL, NULL, NULL, NULL, NULL);
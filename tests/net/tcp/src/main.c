@@ -32,6 +32,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
 #include "tcp.h"
 #include "tcp_private.h"
 #include "net_stats.h"
+#include "net_private.h"
 
 #include <zephyr/ztest.h>
 
@@ -125,6 +126,11 @@ static void handle_syn_resend(void);
 static void handle_client_fin_wait_2_test(sa_family_t af, struct tcphdr *th);
 static void handle_client_closing_test(sa_family_t af, struct tcphdr *th);
 static void handle_server_recv_out_of_order(struct net_pkt *pkt);
+static void handle_server_sack(struct net_pkt *pkt);
+static void handle_server_gro(struct net_pkt *pkt);
+static void handle_server_tso(struct net_pkt *pkt);
+static void handle_server_sack_rexmit(struct net_pkt *pkt);
+static void handle_server_cwnd(struct net_pkt *pkt);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -206,6 +212,9 @@ static void test_sem_take(k_timeout_t timeout, int line)
 	}
 }
 
+/* Send tcp_options also in the SYN of create_server_socket() */
+static bool syn_options;
+
 static uint8_t tcp_options[20] = {
 	0x02, 0x04, 0x05, 0xb4, /* Max segment */
 	0x04, 0x02, /* SACK */
@@ -213,6 +222,10 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Options sent in segments other than SYN, if set */
+static const uint8_t *ack_options;
+static size_t ack_options_len;
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -223,11 +236,16 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct net_pkt *pkt;
 	struct tcphdr *th;
+	const uint8_t *opts = NULL;
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if ((test_case_no == 4U || syn_options) && (flags & SYN)) {
+		opts = tcp_options;
 		opts_len = sizeof(tcp_options);
+	} else if (!(flags & SYN) && ack_options) {
+		opts = ack_options;
+		opts_len = ack_options_len;
 	}
 
 	/* Allocate buffer */
@@ -262,14 +280,10 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
+	th->th_off = 5U + opts_len / 4U;
 
 	th->th_flags = flags;
-	th->th_win = NET_IPV6_MTU;
+	th->th_win = htons(NET_IPV6_MTU);
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -281,9 +295,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if (opts) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -420,6 +434,21 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case 9:
 		handle_server_recv_out_of_order(pkt);
 		break;
+	case 10:
+		handle_server_sack(pkt);
+		break;
+	case 11:
+		handle_server_gro(pkt);
+		break;
+	case 12:
+		handle_server_tso(pkt);
+		break;
+	case 13:
+		handle_server_sack_rexmit(pkt);
+		break;
+	case 14:
+		handle_server_cwnd(pkt);
+		break;
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -1539,4 +1568,745 @@ ZTEST(net_tcp, test_server_out_of_order_data)
 	test_server_timeout_out_of_order_data();
 }
 
+#define SACK_SEQ_INIT 1
+static uint32_t expected_sack_start;
+static uint32_t expected_sack_end;
+
+static void handle_server_sack(struct net_pkt *pkt)
+{
+	uint8_t opts[40];
+	uint32_t sack_start = 0, sack_end = 0;
+	struct tcphdr th;
+	size_t opts_len;
+	int ret, i;
+
+	ret = read_tcp_header(pkt, &th);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	opts_len = (th.th_off - 5) * 4;
+	net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+		     sizeof(struct tcphdr));
+	ret = net_pkt_read(pkt, opts, opts_len);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	for (i = 0; i < opts_len; ) {
+		if (opts[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		if (opts[i] == NET_TCP_SACK_OPT) {
+			zassert_equal(opts[i + 1], 2 + NET_TCP_SACK_BLOCK_SIZE,
+				      "Expected a single SACK block");
+			sack_start = ntohl(UNALIGNED_GET((uint32_t *)&opts[i + 2]));
+			sack_end = ntohl(UNALIGNED_GET((uint32_t *)&opts[i + 6]));
+		}
+
+		i += opts[i + 1];
+	}
+
+	zassert_equal(expected_ack, ntohl(th.th_ack),
+		      "Expected ACK %u but got %u",
+		      expected_ack, ntohl(th.th_ack));
+	zassert_equal(expected_sack_start, sack_start,
+		      "Expected SACK start %u but got %u",
+		      expected_sack_start, sack_start);
+	zassert_equal(expected_sack_end, sack_end,
+		      "Expected SACK end %u but got %u",
+		      expected_sack_end, sack_end);
+
+	test_sem_give();
+
+	return;
+
+fail:
+	zassert_true(false, "%s failed", __func__);
+	net_pkt_unref(pkt);
+}
+
+static void send_sack_test_data(int offset, int len, int ack_offset,
+				int sack_start, int sack_end)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	seq = SACK_SEQ_INIT + offset;
+	pkt = prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT),
+				  &lorem_ipsum[offset], len);
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	expected_ack = SACK_SEQ_INIT + ack_offset;
+	expected_sack_start = sack_start ? SACK_SEQ_INIT + sack_start : 0;
+	expected_sack_end = sack_end ? SACK_SEQ_INIT + sack_end : 0;
+
+	ret = net_recv_data(iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Peer will release the semaphore after it checked the ACK */
+	test_sem_take(K_MSEC(1000), __LINE__);
+}
+
+/* Test case scenario IPv6
+ *   Establish a connection with a peer advertising SACK-permitted,
+ *   send out-of-order data and expect it to be reported in SACK blocks,
+ *   send the missing data and expect a plain cumulative ACK.
+ */
+ZTEST(net_tcp, test_server_sack)
+{
+	struct net_context *ctx;
+	struct net_pkt *rst;
+	struct tcp *conn;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK) ||
+	    CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT == 0) {
+		ztest_test_skip();
+	}
+
+	k_sem_reset(&test_sem);
+
+	syn_options = true;
+	ctx = create_server_socket(SACK_SEQ_INIT - 1, 0);
+	syn_options = false;
+
+	conn = accepted_ctx->tcp;
+	zassert_true(conn->recv_options.sack_perm_found,
+		     "SACK-permitted not found in SYN");
+
+	test_case_no = 10;
+
+	send_sack_test_data(10, 10, 0, 10, 20);
+	send_sack_test_data(20, 5, 0, 10, 25);
+	send_sack_test_data(0, 10, 25, 0, 0);
+
+	/* Abort the connection, as in the out-of-order data test */
+	seq = expected_ack;
+	rst = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+
+	ret = net_recv_data(iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+#define GRO_SEQ_INIT 1
+#define GRO_SEG_LEN 10
+#define GRO_SEGS 3
+
+static void handle_server_gro(struct net_pkt *pkt)
+{
+	struct tcphdr th;
+	int ret;
+
+	ret = read_tcp_header(pkt, &th);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	/* A single ACK is expected for all the coalesced segments */
+	zassert_equal(expected_ack, ntohl(th.th_ack),
+		      "Expected ACK %u but got %u",
+		      expected_ack, ntohl(th.th_ack));
+
+	test_sem_give();
+
+	return;
+
+fail:
+	zassert_true(false, "%s failed", __func__);
+	net_pkt_unref(pkt);
+}
+
+/* Test case scenario IPv6
+ *   Establish a connection, enable GRO on the interface and queue
+ *   several in-order data segments at once. They are expected to be
+ *   coalesced and acknowledged with a single ACK.
+ */
+ZTEST(net_tcp, test_server_gro)
+{
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	int ret, i;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_GRO)) {
+		ztest_test_skip();
+	}
+
+	k_sem_reset(&test_sem);
+
+	ctx = create_server_socket(GRO_SEQ_INIT - 1, 0);
+
+	test_case_no = 11;
+	expected_ack = GRO_SEQ_INIT + GRO_SEGS * GRO_SEG_LEN;
+
+	net_if_flag_set(iface, NET_IF_GRO);
+
+	/* The RX thread only runs once all the segments are queued */
+	for (i = 0; i < GRO_SEGS; i++) {
+		seq = GRO_SEQ_INIT + i * GRO_SEG_LEN;
+		pkt = tester_prepare_tcp_pkt(AF_INET6, htons(MY_PORT),
+					     htons(PEER_PORT), ACK,
+					     &lorem_ipsum[i * GRO_SEG_LEN],
+					     GRO_SEG_LEN);
+		zassert_not_null(pkt, "Cannot create pkt");
+
+		ret = net_recv_data(iface, pkt);
+		zassert_true(ret == 0, "recv data failed (%d)", ret);
+	}
+
+	test_sem_take(K_MSEC(1000), __LINE__);
+
+	net_if_flag_clear(iface, NET_IF_GRO);
+
+	seq = expected_ack;
+	pkt = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+
+	ret = net_recv_data(iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+#define TSO_SEQ_INIT 1
+#define TSO_DATA_LEN 1200
+static uint32_t tso_next_seq;
+static uint32_t tso_end_seq;
+static uint16_t tso_mss;
+static int tso_segs;
+
+static void handle_server_tso(struct net_pkt *pkt)
+{
+	struct tcphdr th;
+	size_t len;
+	int ret;
+
+	ret = read_tcp_header(pkt, &th);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	/* Ignore retransmissions once all the data has been seen */
+	if (tso_next_seq == tso_end_seq) {
+		return;
+	}
+
+	len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+	      net_pkt_ip_opts_len(pkt) - th.th_off * 4U;
+
+	zassert_equal(net_pkt_tso_mss(pkt), 0, "Segment is a large send");
+	zassert_true(len > 0 && len <= tso_mss,
+		     "Segment length %zu not within MSS %u", len, tso_mss);
+	zassert_equal(tso_next_seq, ntohl(th.th_seq),
+		      "Expected seq %u but got %u",
+		      tso_next_seq, ntohl(th.th_seq));
+	zassert_equal(net_calc_chksum_tcp(pkt), 0, "Invalid checksum");
+
+	tso_next_seq += len;
+	tso_segs++;
+
+	/* Only the last segment of a large send carries PSH */
+	if (tso_next_seq == tso_end_seq) {
+		verify_flags(&th, PSH | ACK, __func__, __LINE__);
+		test_sem_give();
+	} else {
+		verify_flags(&th, ACK, __func__, __LINE__);
+	}
+
+	return;
+
+fail:
+	zassert_true(false, "%s failed", __func__);
+	net_pkt_unref(pkt);
+}
+
+/* Test case scenario IPv6
+ *   Establish a connection and send more than two MSS worth of data in
+ *   one go. The data is expected to leave TCP as one large send packet
+ *   that is cut into contiguous, checksummed, MSS sized segments before
+ *   it reaches the driver.
+ */
+ZTEST(net_tcp, test_server_tso)
+{
+	struct net_context *ctx;
+	struct net_pkt *rst;
+	struct tcp *conn;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_TSO)) {
+		ztest_test_skip();
+	}
+
+	k_sem_reset(&test_sem);
+
+	ctx = create_server_socket(TSO_SEQ_INIT - 1, 0);
+
+	/* The peer does not announce an MSS, so ours is derived from the MTU */
+	conn = accepted_ctx->tcp;
+	tso_mss = MIN(NET_TCP_DEFAULT_MSS,
+		      net_if_get_mtu(iface) - NET_IPV6TCPH_LEN);
+	tso_next_seq = conn->seq;
+	tso_end_seq = conn->seq + TSO_DATA_LEN;
+	tso_segs = 0;
+
+	/* Let the whole data fit into the peer and congestion windows */
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	conn->send_win = TSO_DATA_LEN;
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	conn->ca.cwnd = TSO_DATA_LEN;
+#endif
+	k_mutex_unlock(&conn->lock);
+
+	test_case_no = 12;
+
+	ret = net_context_send(accepted_ctx, lorem_ipsum, TSO_DATA_LEN, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, TSO_DATA_LEN, "Failed to send data (%d)", ret);
+
+	test_sem_take(K_MSEC(1000), __LINE__);
+
+	zassert_equal(tso_segs, DIV_ROUND_UP(TSO_DATA_LEN, tso_mss),
+		      "Unexpected number of segments %d", tso_segs);
+
+	seq = TSO_SEQ_INIT;
+	rst = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+
+	ret = net_recv_data(iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+#define SACK_REXMIT_SEQ_INIT 1
+#define SACK_REXMIT_MSS 60
+#define SACK_REXMIT_DATA_LEN (5 * SACK_REXMIT_MSS)
+#define SACK_REXMIT_MAX 4
+static uint32_t sack_rexmit_base;
+static uint32_t sack_rexmit_sent;
+static uint32_t sack_rexmit_seq[SACK_REXMIT_MAX];
+static size_t sack_rexmit_len[SACK_REXMIT_MAX];
+static int sack_rexmit_cnt;
+
+static void handle_server_sack_rexmit(struct net_pkt *pkt)
+{
+	struct tcphdr th;
+	size_t len;
+	int ret;
+
+	ret = read_tcp_header(pkt, &th);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+	      net_pkt_ip_opts_len(pkt) - th.th_off * 4U;
+	if (len == 0) {
+		return;
+	}
+
+	/* New data, signal once all of it has been sent */
+	if (ntohl(th.th_seq) == sack_rexmit_sent) {
+		sack_rexmit_sent += len;
+		if (sack_rexmit_sent == sack_rexmit_base + SACK_REXMIT_DATA_LEN) {
+			test_sem_give();
+		}
+
+		return;
+	}
+
+	zassert_true(sack_rexmit_cnt < SACK_REXMIT_MAX,
+		     "Too many retransmissions");
+
+	sack_rexmit_seq[sack_rexmit_cnt] = ntohl(th.th_seq);
+	sack_rexmit_len[sack_rexmit_cnt] = len;
+	sack_rexmit_cnt++;
+
+	test_sem_give();
+
+	return;
+
+fail:
+	zassert_true(false, "%s failed", __func__);
+	net_pkt_unref(pkt);
+}
+
+/* Send a duplicate ACK carrying the SACK blocks given as pairs of offsets
+ * into the sent data, and wait for a retransmission if one is expected.
+ */
+static void send_sack_dup_ack(const uint32_t *blocks, int n, bool rexmit)
+{
+	uint8_t opts[4 + NET_TCP_SACK_MAX_BLOCKS * NET_TCP_SACK_BLOCK_SIZE];
+	struct net_pkt *pkt;
+	int ret, i;
+
+	opts[0] = NET_TCP_NOP_OPT;
+	opts[1] = NET_TCP_NOP_OPT;
+	opts[2] = NET_TCP_SACK_OPT;
+	opts[3] = 2 + n * NET_TCP_SACK_BLOCK_SIZE;
+
+	for (i = 0; i < 2 * n; i++) {
+		UNALIGNED_PUT(htonl(sack_rexmit_base + blocks[i]),
+			      (uint32_t *)&opts[4 + i * sizeof(uint32_t)]);
+	}
+
+	seq = SACK_REXMIT_SEQ_INIT;
+	ack = sack_rexmit_base;
+	ack_options = opts;
+	ack_options_len = 4 + n * NET_TCP_SACK_BLOCK_SIZE;
+
+	pkt = prepare_ack_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+
+	ack_options = NULL;
+	ack_options_len = 0;
+
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	if (rexmit) {
+		test_sem_take(K_MSEC(100), __LINE__);
+	} else {
+		k_msleep(10);
+	}
+}
+
+/* Test case scenario IPv6
+ *   Establish a connection with a peer advertising SACK-permitted and
+ *   send five segments of data. The peer misses the first and the third
+ *   segment and reports the other ones in SACK blocks of duplicate ACKs.
+ *   Only the two holes are expected to be retransmitted, the first one on
+ *   the third duplicate ACK and the second one on the next duplicate ACK.
+ */
+ZTEST(net_tcp, test_server_sack_rexmit)
+{
+	static const uint32_t sack_1[] = {
+		SACK_REXMIT_MSS, 2 * SACK_REXMIT_MSS
+	};
+	static const uint32_t sack_2[] = {
+		SACK_REXMIT_MSS, 2 * SACK_REXMIT_MSS,
+		3 * SACK_REXMIT_MSS, 4 * SACK_REXMIT_MSS
+	};
+	static const uint32_t sack_3[] = {
+		SACK_REXMIT_MSS, 2 * SACK_REXMIT_MSS,
+		3 * SACK_REXMIT_MSS, 5 * SACK_REXMIT_MSS
+	};
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	struct tcp *conn;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK) ||
+	    !IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+		ztest_test_skip();
+	}
+
+	k_sem_reset(&test_sem);
+
+	syn_options = true;
+	ctx = create_server_socket(SACK_REXMIT_SEQ_INIT - 1, 0);
+	syn_options = false;
+
+	conn = accepted_ctx->tcp;
+	zassert_true(conn->recv_options.sack_perm_found,
+		     "SACK-permitted not found in SYN");
+
+	/* Send the data as segments smaller than the interface MTU allows,
+	 * all at once.
+	 */
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	conn->recv_options.mss = SACK_REXMIT_MSS;
+	conn->send_win = SACK_REXMIT_DATA_LEN;
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	conn->ca.cwnd = SACK_REXMIT_DATA_LEN;
+#endif
+	k_mutex_unlock(&conn->lock);
+
+	sack_rexmit_base = conn->seq;
+	sack_rexmit_sent = conn->seq;
+	sack_rexmit_cnt = 0;
+
+	test_case_no = 13;
+
+	ret = net_context_send(accepted_ctx, lorem_ipsum, SACK_REXMIT_DATA_LEN,
+			       NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, SACK_REXMIT_DATA_LEN, "Failed to send data (%d)", ret);
+
+	test_sem_take(K_MSEC(1000), __LINE__);
+
+	send_sack_dup_ack(sack_1, 1, false);
+	send_sack_dup_ack(sack_2, 2, false);
+	send_sack_dup_ack(sack_3, 2, true);
+	send_sack_dup_ack(sack_3, 2, true);
+	send_sack_dup_ack(sack_3, 2, false);
+
+	zassert_equal(sack_rexmit_cnt, 2, "Unexpected number of retransmissions %d",
+		      sack_rexmit_cnt);
+	zassert_equal(sack_rexmit_seq[0], sack_rexmit_base,
+		      "First hole not retransmitted");
+	zassert_equal(sack_rexmit_len[0], SACK_REXMIT_MSS,
+		      "Unexpected retransmission length %zu", sack_rexmit_len[0]);
+	zassert_equal(sack_rexmit_seq[1], sack_rexmit_base + 2 * SACK_REXMIT_MSS,
+		      "Second hole not retransmitted");
+	zassert_equal(sack_rexmit_len[1], SACK_REXMIT_MSS,
+		      "Unexpected retransmission length %zu", sack_rexmit_len[1]);
+
+	/* Acknowledge all the data and abort the connection */
+	seq = SACK_REXMIT_SEQ_INIT;
+	ack = sack_rexmit_base + SACK_REXMIT_DATA_LEN;
+	pkt = prepare_ack_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	pkt = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+
+	ret = net_recv_data(iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+#define CWND_SEQ_INIT 1
+static uint32_t cwnd_base;
+/* Offsets into the sent data of the last byte acked and of the last byte sent */
+static uint32_t cwnd_acked;
+static uint32_t cwnd_sent;
+
+static void handle_server_cwnd(struct net_pkt *pkt)
+{
+	struct tcp *conn = accepted_ctx->tcp;
+	struct tcphdr th;
+	uint32_t end;
+	size_t len;
+	int ret;
+
+	ret = read_tcp_header(pkt, &th);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+	      net_pkt_ip_opts_len(pkt) - th.th_off * 4U;
+	if (len == 0) {
+		return;
+	}
+
+	/* Retransmissions are not limited by the congestion window */
+	end = ntohl(th.th_seq) + len - cwnd_base;
+	if (end <= cwnd_sent) {
+		return;
+	}
+
+	zassert_true(end - cwnd_acked <= conn->ca.cwnd,
+		     "Data sent up to %u with %u acked, past cwnd %u",
+		     end, cwnd_acked, conn->ca.cwnd);
+
+	cwnd_sent = end;
+
+	return;
+
+fail:
+	zassert_true(false, "%s failed", __func__);
+	net_pkt_unref(pkt);
+}
+
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_NEWRENO)
+/* Acknowledge the first acked bytes of the data sent */
+static void send_cwnd_ack(uint32_t acked)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	seq = CWND_SEQ_INIT;
+	ack = cwnd_base + acked;
+	cwnd_acked = MAX(cwnd_acked, acked);
+
+	pkt = prepare_ack_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(10);
+}
+
+/* Connect, set the initial congestion state and send len bytes of data */
+static struct net_context *start_cwnd_test(uint32_t cwnd, uint32_t ssthresh,
+					   size_t len)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	int ret;
+
+	k_sem_reset(&test_sem);
+
+	ctx = create_server_socket(CWND_SEQ_INIT - 1, 0);
+	conn = accepted_ctx->tcp;
+
+	zassert_true(conn->send_win >= len, "Peer window %u too small",
+		     conn->send_win);
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	conn->ca.cwnd = cwnd;
+	conn->ca.ssthresh = ssthresh;
+	k_mutex_unlock(&conn->lock);
+
+	cwnd_base = conn->seq;
+	cwnd_acked = 0;
+	cwnd_sent = 0;
+	test_case_no = 14;
+
+	ret = net_context_send(accepted_ctx, lorem_ipsum, len, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, len, "Failed to send data (%d)", ret);
+
+	zassert_equal(conn->unacked_len, cwnd,
+		      "Data in flight %u not limited by cwnd %u",
+		      conn->unacked_len, cwnd);
+	zassert_equal(cwnd_sent, cwnd, "Sent %u, expected %u", cwnd_sent, cwnd);
+
+	return ctx;
+}
+
+static void stop_cwnd_test(struct net_context *ctx, uint32_t len)
+{
+	struct net_pkt *rst;
+	int ret;
+
+	send_cwnd_ack(len);
+
+	seq = CWND_SEQ_INIT;
+	rst = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+
+	ret = net_recv_data(iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_DEFAULT_NEWRENO */
+
+/* Test case scenario IPv6
+ *   Establish a connection and send data acknowledged one segment at a
+ *   time. Below ssthresh cwnd is expected to grow by one MSS per ACK
+ *   (slow start), above it by about one MSS per window of data acked
+ *   (congestion avoidance).
+ */
+ZTEST(net_tcp, test_server_cwnd_growth)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_NEWRENO)
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t mss, expected;
+	int i;
+
+	/* The MSS is derived from the MTU of the interface */
+	mss = MIN(NET_TCP_DEFAULT_MSS, net_if_get_mtu(iface) - NET_IPV6TCPH_LEN);
+
+	ctx = start_cwnd_test(2 * mss, 3 * mss, 8 * mss);
+	conn = accepted_ctx->tcp;
+
+	/* Slow start */
+	send_cwnd_ack(mss);
+	zassert_equal(conn->ca.cwnd, 3 * mss,
+		      "cwnd %u not grown by one MSS in slow start",
+		      conn->ca.cwnd);
+	zassert_equal(cwnd_sent, 4 * mss,
+		      "Sent %u, not the acked data plus cwnd", cwnd_sent);
+
+	/* Congestion avoidance, RFC 5681 equation (3) */
+	expected = conn->ca.cwnd;
+
+	for (i = 2; i <= 5; i++) {
+		send_cwnd_ack(i * mss);
+		expected += MAX(1U, mss * mss / expected);
+
+		zassert_equal(conn->ca.cwnd, expected,
+			      "cwnd %u, expected %u in congestion avoidance",
+			      conn->ca.cwnd, expected);
+	}
+
+	zassert_true(conn->ca.cwnd > 3 * mss && conn->ca.cwnd < 5 * mss,
+		     "cwnd %u grown by more than one MSS per window",
+		     conn->ca.cwnd);
+
+	stop_cwnd_test(ctx, 8 * mss);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/* Test case scenario IPv6
+ *   Establish a connection and send data. Three duplicate ACKs are
+ *   expected to halve the window and start fast recovery, which the
+ *   acknowledgment of all the data sent ends. A retransmission timeout
+ *   is then expected to bring cwnd down to one MSS.
+ */
+ZTEST(net_tcp, test_server_cwnd_reduction)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_NEWRENO)
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t mss;
+	int i;
+
+	mss = MIN(NET_TCP_DEFAULT_MSS, net_if_get_mtu(iface) - NET_IPV6TCPH_LEN);
+
+	ctx = start_cwnd_test(4 * mss, 8 * mss, 8 * mss);
+	conn = accepted_ctx->tcp;
+
+	/* Triple duplicate ACK, RFC 5681 chapter 3.2 */
+	for (i = 0; i < 3; i++) {
+		send_cwnd_ack(0);
+	}
+
+	zassert_true(conn->ca.in_recovery, "Fast recovery not started");
+	zassert_equal(conn->ca.ssthresh, 2 * mss,
+		      "ssthresh %u not half of the data in flight",
+		      conn->ca.ssthresh);
+	zassert_equal(conn->ca.cwnd, 5 * mss,
+		      "cwnd %u not ssthresh plus three MSS", conn->ca.cwnd);
+
+	/* Full acknowledgment, RFC 6582 chapter 3.2 step 3 */
+	send_cwnd_ack(4 * mss);
+
+	zassert_false(conn->ca.in_recovery, "Fast recovery not ended");
+	zassert_equal(conn->ca.cwnd, 2 * mss,
+		      "cwnd %u not deflated to ssthresh", conn->ca.cwnd);
+
+	/* Retransmission timeout, RFC 5681 chapter 3.1 */
+	k_msleep(2 * CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT);
+
+	zassert_equal(conn->ca.cwnd, mss,
+		      "cwnd %u not one MSS after a timeout", conn->ca.cwnd);
+	zassert_equal(conn->ca.ssthresh, 2 * mss,
+		      "ssthresh %u not half of the data in flight",
+		      conn->ca.ssthresh);
+
+	stop_cwnd_test(ctx, 6 * mss);
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
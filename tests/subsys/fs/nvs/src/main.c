@@ -869,3 +869,133 @@ ZTEST_F(nvs, test_nvs_cache_gc)
 	zassert_equal(num, 2, "invalid cache content after gc");
 #endif
 }
+
+#ifdef CONFIG_NVS_GC_BACKGROUND
+static bool sector_erased(struct nvs_fs *fs, uint32_t sector)
+{
+	uint8_t buf[64];
+	off_t offset = fs->offset + sector * fs->sector_size;
+
+	for (size_t i = 0; i < fs->sector_size; i += sizeof(buf)) {
+		zassert_equal(flash_read(fs->flash_device, offset + i, buf, sizeof(buf)), 0);
+		for (size_t j = 0; j < sizeof(buf); j++) {
+			if (buf[j] != fs->flash_parameters->erase_value) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+#endif
+
+/*
+ * Test that the background garbage collection erases the gc'ed sector and
+ * copies ahead the data of the next sector to gc, without losing content.
+ */
+ZTEST_F(nvs, test_nvs_gc_background)
+{
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	const uint16_t max_id = 10;
+	uint32_t sector, next_sector;
+	uint16_t writes = 0;
+	int err;
+
+	fixture->fs.sector_count = 4;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	for (int round = 0; round < 6; round++) {
+		sector = fixture->fs.ate_wra >> ADDR_SECT_SHIFT;
+
+		/* fill the write sector up to the switch to the next one */
+		while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) == sector) {
+			write_content(max_id, writes, writes + 1, &fixture->fs);
+			/* keep the written values below 256 */
+			writes = (writes + 1) % (25 * max_id);
+		}
+
+		sector = fixture->fs.ate_wra >> ADDR_SECT_SHIFT;
+		next_sector = (sector + 1) % fixture->fs.sector_count;
+
+		/* the gc'ed sector is left for the work queue to erase */
+		zassert_equal(fixture->fs.gc_erase_addr, next_sector << ADDR_SECT_SHIFT,
+			      "gc'ed sector erased by nvs_write");
+		/* reads stop before the sector waiting for the erase */
+		check_content(max_id, &fixture->fs);
+		k_msleep(1);
+		zassert_equal(fixture->fs.gc_erase_addr, NVS_GC_NO_SECTOR,
+			      "gc'ed sector not erased");
+		zassert_true(sector_erased(&fixture->fs, next_sector),
+			     "sector after write sector not empty");
+		check_content(max_id, &fixture->fs);
+
+		/* past half of the write sector the next sector to gc is copied */
+		while ((fixture->fs.ate_wra - fixture->fs.data_wra) >=
+		       (fixture->fs.sector_size / 2)) {
+			write_content(max_id, writes, writes + 1, &fixture->fs);
+			writes = (writes + 1) % (25 * max_id);
+		}
+
+		k_msleep(1);
+		zassert_equal(fixture->fs.gc_copy_state, NVS_GC_COPY_DONE,
+			      "no copy ahead of the next sector to gc");
+		check_content(max_id, &fixture->fs);
+
+		err = nvs_mount(&fixture->fs);
+		zassert_true(err == 0, "nvs_mount call failure: %d", err);
+		check_content(max_id, &fixture->fs);
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
+/*
+ * Test the erase counts and garbage collection statistics.
+ */
+ZTEST_F(nvs, test_nvs_stats)
+{
+#ifdef CONFIG_NVS_STATS
+	struct nvs_stats stats;
+	uint32_t erases = 0;
+	uint8_t data = 0;
+	int err;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* go three times around the sectors */
+	while (erases < 3 * fixture->fs.sector_count) {
+		++data;
+		err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+
+		k_msleep(0);
+		err = nvs_stats_get(&fixture->fs, &stats);
+		zassert_equal(err, 0, "nvs_stats_get call failure: %d", err);
+
+		erases = 0;
+		for (int i = 0; i < fixture->fs.sector_count; i++) {
+			erases += stats.erase_count[i];
+		}
+	}
+
+	zassert_true(stats.gc_count >= erases, "gc count %u for %u erases",
+		     stats.gc_count, erases);
+	for (int i = 0; i < fixture->fs.sector_count; i++) {
+		zassert_true(stats.erase_count[i] >= 2, "sector %d erased %u times",
+			     i, stats.erase_count[i]);
+	}
+	zassert_true(stats.gc_time_max_us <= stats.gc_time_total_us);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	err = nvs_stats_get(&fixture->fs, &stats);
+	zassert_equal(err, 0, "nvs_stats_get call failure: %d", err);
+	zassert_equal(stats.gc_count, 0, "stats not reset by mount");
+#else
+	ztest_test_skip();
+#endif
+}
@@ -29,7 +29,16 @@ FS_FSTAB_DECLARE_ENTRY(PARTITION_NODE);
 static const char *log_prefix = CONFIG_LOG_BACKEND_FS_FILE_PREFIX;
 
 int write_log_to_file(uint8_t *data, size_t length, void *ctx);
+int log_backend_fs_flush(void);
 
+static void flush_log(void)
+{
+	/* Buffered or unsynced data is not visible in the file yet. */
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_WRITE_BEHIND) ||
+	    !IS_ENABLED(CONFIG_LOG_BACKEND_FS_SYNC_WRITE)) {
+		zassert_equal(log_backend_fs_flush(), 0, "Can not flush log.");
+	}
+}
 
 ZTEST(test_log_backend_fs, test_fs_nonexist)
 {
@@ -97,6 +106,7 @@ ZTEST(test_log_backend_fs, test_log_fs_file_content)
 	fs_file_t_init(&file);
 
 	rc = write_log_to_file(to_log, sizeof(to_log), NULL);
+	flush_log();
 
 	sprintf(fname, "%s/%s0000", CONFIG_LOG_BACKEND_FS_DIR, log_prefix);
 
@@ -113,6 +123,7 @@ ZTEST(test_log_backend_fs, test_log_fs_file_content)
 
 	to_log[sizeof(to_log)-2] = '2';
 	rc = write_log_to_file(to_log, sizeof(to_log), NULL);
+	flush_log();
 
 	zassert_equal(fs_open(&file, fname, FS_O_READ), 0,
 		      "Can not open log file.");
@@ -153,6 +164,7 @@ ZTEST(test_log_backend_fs, test_log_fs_file_size)
 		/* Written length not tracked here. */
 		ARG_UNUSED(rc);
 	}
+	flush_log();
 
 	zassert_equal(fs_stat(fname, &entry), 0, "Can not get file info.");
 	size_t exp_size = CONFIG_LOG_BACKEND_FS_FILE_SIZE -
@@ -207,6 +219,7 @@ ZTEST(test_log_backend_fs, test_log_fs_files_max)
 		/* Written length not tracked here. */
 		ARG_UNUSED(rc);
 	}
+	flush_log();
 
 	rc = fs_opendir(&dir, CONFIG_LOG_BACKEND_FS_DIR);
 	zassert_equal(rc, 0, "Can not open directory.");
@@ -230,4 +243,78 @@ ZTEST(test_log_backend_fs, test_log_fs_files_max)
 	zassert_equal(test_mask, 0b11110, "Unexpected file numeration");
 }
 
+#if defined(CONFIG_LOG_BACKEND_FS_WRITE_BEHIND) && \
+	defined(CONFIG_LOG_BACKEND_FS_SYNC_PERIODIC)
+static int read_newest_log_tail(char *buf, size_t len)
+{
+	int rc;
+	int num;
+	int newest = -1;
+	struct fs_dir_t dir;
+	struct fs_file_t file;
+	struct fs_dirent ent;
+	static char fname[MAX_PATH_LEN];
+
+	fs_dir_t_init(&dir);
+	fs_file_t_init(&file);
+
+	rc = fs_opendir(&dir, CONFIG_LOG_BACKEND_FS_DIR);
+	zassert_equal(rc, 0, "Can not open directory.");
+	while (rc >= 0) {
+		rc = fs_readdir(&dir, &ent);
+		if ((rc < 0) || (ent.name[0] == 0)) {
+			break;
+		}
+		if (strstr(ent.name, log_prefix) != NULL) {
+			num = atoi(&ent.name[strlen(log_prefix)]);
+			newest = MAX(newest, num);
+		}
+	}
+	(void)fs_closedir(&dir);
+	zassert_true(newest >= 0, "No log file found.");
+
+	sprintf(fname, "%s/%s%04d", CONFIG_LOG_BACKEND_FS_DIR, log_prefix,
+		newest);
+	zassert_equal(fs_open(&file, fname, FS_O_READ), 0,
+		      "Can not open log file.");
+	/* Fails if the file is shorter than len. */
+	rc = fs_seek(&file, -(off_t)len, FS_SEEK_END);
+	if (rc == 0) {
+		rc = fs_read(&file, buf, len);
+	}
+	zassert_equal(fs_close(&file), 0, "Can not close log file.");
+
+	return rc;
+}
+
+ZTEST(test_log_backend_fs, test_log_fs_write_behind)
+{
+	int rc;
+	uint8_t to_log[] = "Buffered Log";
+	char tail[sizeof(to_log)];
+
+	rc = write_log_to_file(to_log, sizeof(to_log), NULL);
+	zassert_equal(rc, sizeof(to_log), "Unexpected retval.");
+
+	if (read_newest_log_tail(tail, sizeof(tail)) == sizeof(tail)) {
+		zassert_not_equal(memcmp(tail, to_log, sizeof(to_log)), 0,
+				  "Log written before the buffer was flushed.");
+	}
+
+	/* Buffered data is written out and synced once it is old enough. */
+	k_sleep(K_MSEC(CONFIG_LOG_BACKEND_FS_FLUSH_TIMEOUT_MS +
+		       CONFIG_LOG_BACKEND_FS_SYNC_PERIOD_MS + 100));
+
+	zassert_equal(read_newest_log_tail(tail, sizeof(tail)), sizeof(tail),
+		      "Can not read log file.");
+	zassert_equal(memcmp(tail, to_log, sizeof(to_log)), 0,
+		      "Buffered log not written.");
+}
+#else
+ZTEST(test_log_backend_fs, test_log_fs_write_behind)
+{
+	ztest_test_skip();
+}
+#endif
+
 ZTEST_SUITE(test_log_backend_fs, NULL, NULL, NULL, NULL, NULL);
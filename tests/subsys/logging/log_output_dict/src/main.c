@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Test dictionary-based log output
+ */
+
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log_output_dict.h>
+#include <zephyr/sys/cbprintf.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define OUTPUT_BUF_SIZE 128
+#define MAX_CALLS 8
+
+static uint8_t mock_buffer[512];
+static uint32_t mock_len;
+static uint32_t call_len[MAX_CALLS];
+static uint32_t calls;
+
+static uint8_t log_output_buf[OUTPUT_BUF_SIZE];
+
+static union {
+	struct log_msg msg;
+	uint8_t buf[512];
+} msg_buf;
+
+static void reset_mock_buffer(void)
+{
+	mock_len = 0U;
+	calls = 0U;
+	memset(mock_buffer, 0, sizeof(mock_buffer));
+}
+
+static int mock_output_func(uint8_t *buf, size_t size, void *ctx)
+{
+	zassert_true(mock_len + size <= sizeof(mock_buffer), "Output too long");
+	memcpy(&mock_buffer[mock_len], buf, size);
+	mock_len += size;
+
+	if (calls < MAX_CALLS) {
+		call_len[calls] = size;
+	}
+	calls++;
+
+	return size;
+}
+
+LOG_OUTPUT_DEFINE(log_output, mock_output_func,
+		  log_output_buf, sizeof(log_output_buf));
+
+static struct log_msg *create_msg(size_t data_len)
+{
+	struct log_msg *msg = &msg_buf.msg;
+	int len;
+
+	len = cbprintf_package(msg->data, sizeof(msg_buf) - sizeof(*msg), 0,
+			       "test %d", 100);
+	zassert_true(len > 0, "Can not create package");
+	zassert_true(sizeof(*msg) + len + data_len <= sizeof(msg_buf),
+		     "Message too long");
+
+	memset(&msg->data[len], 0xaa, data_len);
+
+	msg->hdr.desc.domain = 0;
+	msg->hdr.desc.level = LOG_LEVEL_INF;
+	msg->hdr.desc.package_len = len;
+	msg->hdr.desc.data_len = data_len;
+	msg->hdr.source = NULL;
+	msg->hdr.timestamp = 1234;
+
+	return msg;
+}
+
+static size_t msg_record_len(struct log_msg *msg)
+{
+	return sizeof(struct log_dict_output_normal_msg_hdr_t) +
+	       msg->hdr.desc.package_len + msg->hdr.desc.data_len;
+}
+
+static struct log_dict_output_frame_hdr_t get_frame_hdr(size_t offset)
+{
+	struct log_dict_output_frame_hdr_t frame_hdr;
+
+	memcpy(&frame_hdr, &mock_buffer[offset], sizeof(frame_hdr));
+	zassert_equal(frame_hdr.magic, LOG_DICT_OUTPUT_FRAME_MAGIC, "Bad magic");
+
+	return frame_hdr;
+}
+
+static void check_msg_record(const uint8_t *record, struct log_msg *msg)
+{
+	struct log_dict_output_normal_msg_hdr_t hdr;
+	size_t package_len = msg->hdr.desc.package_len;
+
+	memcpy(&hdr, record, sizeof(hdr));
+	zassert_equal(hdr.type, MSG_NORMAL, "Bad type");
+	zassert_equal(hdr.level, LOG_LEVEL_INF, "Bad level");
+	zassert_equal(hdr.package_len, package_len, "Bad package length");
+	zassert_equal(hdr.data_len, msg->hdr.desc.data_len, "Bad data length");
+	zassert_equal(hdr.timestamp, 1234, "Bad timestamp");
+
+	record += sizeof(hdr);
+	zassert_mem_equal(record, msg->data, package_len + hdr.data_len,
+			  "Bad package or data");
+}
+
+ZTEST(test_log_output_dict, test_unframed)
+{
+	struct log_msg *msg = create_msg(4);
+
+	log_dict_output_msg_process(&log_output, msg, 0);
+
+	zassert_equal(mock_len, msg_record_len(msg), "Unexpected length");
+	check_msg_record(mock_buffer, msg);
+}
+
+ZTEST(test_log_output_dict, test_framed)
+{
+	struct log_dict_output_frame_hdr_t frame_hdr;
+	struct log_msg *msg = create_msg(4);
+	size_t frame_len = sizeof(frame_hdr) + msg_record_len(msg);
+	uint16_t seq;
+
+	log_dict_output_framing_set(&log_output, true);
+
+	log_dict_output_msg_process(&log_output, msg, 0);
+
+	zassert_equal(calls, 1, "Record not written at once");
+	zassert_equal(mock_len, frame_len, "Unexpected length");
+
+	frame_hdr = get_frame_hdr(0);
+	zassert_equal(frame_hdr.len, msg_record_len(msg), "Bad record length");
+	check_msg_record(&mock_buffer[sizeof(frame_hdr)], msg);
+	seq = frame_hdr.seq;
+
+	log_dict_output_msg_process(&log_output, msg, 0);
+
+	zassert_equal(calls, 2, "Record not written at once");
+	frame_hdr = get_frame_hdr(frame_len);
+	zassert_equal(frame_hdr.seq, (uint16_t)(seq + 1), "Bad sequence number");
+}
+
+ZTEST(test_log_output_dict, test_framed_long)
+{
+	struct log_dict_output_frame_hdr_t frame_hdr;
+	struct log_msg *msg = create_msg(2 * OUTPUT_BUF_SIZE);
+	size_t frame_len = sizeof(frame_hdr) + msg_record_len(msg);
+
+	log_dict_output_framing_set(&log_output, true);
+
+	log_dict_output_msg_process(&log_output, msg, 0);
+
+	/* Written in buffer sized chunks */
+	zassert_equal(calls, DIV_ROUND_UP(frame_len, OUTPUT_BUF_SIZE),
+		      "Unexpected number of writes");
+	zassert_equal(call_len[0], OUTPUT_BUF_SIZE, "Unexpected write length");
+	zassert_equal(mock_len, frame_len, "Unexpected length");
+
+	frame_hdr = get_frame_hdr(0);
+	zassert_equal(frame_hdr.len, msg_record_len(msg), "Bad record length");
+	check_msg_record(&mock_buffer[sizeof(frame_hdr)], msg);
+}
+
+ZTEST(test_log_output_dict, test_framed_dropped)
+{
+	struct log_dict_output_frame_hdr_t frame_hdr;
+	struct log_dict_output_dropped_msg_t dropped;
+	struct log_msg *msg = create_msg(0);
+	size_t frame_len = sizeof(frame_hdr) + msg_record_len(msg);
+	uint16_t seq;
+
+	log_dict_output_framing_set(&log_output, true);
+
+	log_dict_output_msg_process(&log_output, msg, 0);
+	seq = get_frame_hdr(0).seq;
+
+	log_dict_output_dropped_process(&log_output, 5);
+
+	zassert_equal(calls, 2, "Record not written at once");
+	zassert_equal(mock_len, frame_len + sizeof(frame_hdr) + sizeof(dropped),
+		      "Unexpected length");
+
+	frame_hdr = get_frame_hdr(frame_len);
+	zassert_equal(frame_hdr.len, sizeof(dropped), "Bad record length");
+	zassert_equal(frame_hdr.seq, (uint16_t)(seq + 1), "Bad sequence number");
+
+	memcpy(&dropped, &mock_buffer[frame_len + sizeof(frame_hdr)],
+	       sizeof(dropped));
+	zassert_equal(dropped.type, MSG_DROPPED_MSG, "Bad type");
+	zassert_equal(dropped.num_dropped_messages, 5, "Bad count");
+}
+
+static void before(void *notused)
+{
+	reset_mock_buffer();
+	log_dict_output_framing_set(&log_output, false);
+}
+
+ZTEST_SUITE(test_log_output_dict, NULL, NULL, before, NULL, NULL);
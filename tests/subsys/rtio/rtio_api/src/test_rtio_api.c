@@ -591,6 +591,233 @@ ZTEST(rtio_api, test_rtio_transaction)
 	}
 }
 
+#ifdef CONFIG_RTIO_EXECUTOR_CONCURRENT
+RTIO_DEFINE(r_prio, SQE_POOL_SIZE, CQE_POOL_SIZE);
+
+RTIO_IODEV_TEST_DEFINE(iodev_test_prio);
+
+/**
+ * @brief Test priority of chains waiting on the same iodev
+ *
+ * The first chain is submitted and started on its own, the others wait in
+ * the executor until the iodev is done with it and are then started by
+ * priority rather than in submission order.
+ */
+ZTEST(rtio_api, test_rtio_priority)
+{
+	const uint8_t prio[4] = {RTIO_PRIO_LOW, RTIO_PRIO_LOW, RTIO_PRIO_NORM, RTIO_PRIO_HIGH};
+	const uintptr_t order[4] = {0, 3, 2, 1};
+	struct rtio *r = &r_prio;
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	int res;
+
+	rtio_iodev_test_init(&iodev_test_prio);
+
+	for (uintptr_t i = 0; i < 4; i++) {
+		sqe = rtio_sqe_acquire(r);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_nop(sqe, &iodev_test_prio, (void *)i);
+		sqe->prio = prio[i];
+
+		if (i == 0) {
+			res = rtio_submit(r, 0);
+			zassert_ok(res, "Should return ok from rtio_execute");
+		}
+	}
+
+	res = rtio_submit(r, 4);
+	zassert_ok(res, "Should return ok from rtio_execute");
+
+	for (int i = 0; i < 4; i++) {
+		cqe = rtio_cqe_consume(r);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_ok(cqe->result, "Result should be ok");
+		zassert_equal((uintptr_t)cqe->userdata, order[i],
+			      "Expected completion %u to be %u", i, order[i]);
+		rtio_cqe_release(r, cqe);
+	}
+}
+
+#define DEPTH_IODEVS 6
+BUILD_ASSERT(DEPTH_IODEVS > CONFIG_RTIO_EXECUTOR_CONCURRENT_DEPTH);
+
+RTIO_DEFINE(r_depth, DEPTH_IODEVS, DEPTH_IODEVS);
+
+#define DEPTH_IODEV_DEFINE(n, _) RTIO_IODEV_TEST_DEFINE(iodev_test_depth##n)
+#define DEPTH_IODEV_REF(n, _) &iodev_test_depth##n
+
+LISTIFY(DEPTH_IODEVS, DEPTH_IODEV_DEFINE, (;));
+struct rtio_iodev *iodev_test_depth[] = {LISTIFY(DEPTH_IODEVS, DEPTH_IODEV_REF, (,))};
+
+static atomic_val_t depth_submit_count(void)
+{
+	atomic_val_t count = 0;
+
+	for (int i = 0; i < DEPTH_IODEVS; i++) {
+		struct rtio_iodev_test_data *data = iodev_test_depth[i]->data;
+
+		count += atomic_get(&data->submit_count);
+	}
+
+	return count;
+}
+
+/**
+ * @brief Test the bound on chains in flight
+ *
+ * Chains for idle iodevs are started up to the configured depth, the
+ * others are started as those complete.
+ */
+ZTEST(rtio_api, test_rtio_inflight_depth)
+{
+	struct rtio *r = &r_depth;
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	atomic_val_t submitted;
+	int res;
+
+	for (int i = 0; i < DEPTH_IODEVS; i++) {
+		rtio_iodev_test_init(iodev_test_depth[i]);
+	}
+	submitted = depth_submit_count();
+
+	for (int i = 0; i < DEPTH_IODEVS; i++) {
+		sqe = rtio_sqe_acquire(r);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_nop(sqe, iodev_test_depth[i], NULL);
+	}
+
+	res = rtio_submit(r, 0);
+	zassert_ok(res, "Should return ok from rtio_execute");
+	zassert_equal(depth_submit_count() - submitted, CONFIG_RTIO_EXECUTOR_CONCURRENT_DEPTH,
+		      "Expected only the configured depth to be started");
+
+	for (int i = 0; i < DEPTH_IODEVS; i++) {
+		cqe = rtio_cqe_consume_block(r);
+		zassert_ok(cqe->result, "Result should be ok");
+		rtio_cqe_release(r, cqe);
+	}
+
+	zassert_equal(depth_submit_count() - submitted, DEPTH_IODEVS,
+		      "Expected all chains to be started");
+}
+
+#define BUSY_TXN_LEN 8
+
+RTIO_DEFINE(r_serial, BUSY_TXN_LEN + 2, BUSY_TXN_LEN + 2);
+
+RTIO_IODEV_TEST_DEFINE(iodev_test_serial0);
+RTIO_IODEV_TEST_DEFINE(iodev_test_serial1);
+
+/**
+ * @brief Test a chain moving on to an iodev busy with another chain
+ *
+ * The first chain goes from iodev 0 to iodev 1 while a longer transaction
+ * of the second chain is in flight on iodev 1. Its second submission is
+ * only handed to iodev 1 once the transaction is done.
+ */
+ZTEST(rtio_api, test_rtio_chain_iodev_busy)
+{
+	struct rtio_iodev_test_data *data = iodev_test_serial1.data;
+	struct rtio *r = &r_serial;
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	atomic_val_t submitted;
+	int res;
+
+	rtio_iodev_test_init(&iodev_test_serial0);
+	rtio_iodev_test_init(&iodev_test_serial1);
+	submitted = atomic_get(&data->submit_count);
+
+	sqe = rtio_sqe_acquire(r);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_nop(sqe, &iodev_test_serial0, NULL);
+	sqe->flags |= RTIO_SQE_CHAINED;
+	sqe = rtio_sqe_acquire(r);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_nop(sqe, &iodev_test_serial1, NULL);
+
+	for (int i = 0; i < BUSY_TXN_LEN; i++) {
+		sqe = rtio_sqe_acquire(r);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_nop(sqe, &iodev_test_serial1, NULL);
+		if (i < BUSY_TXN_LEN - 1) {
+			sqe->flags |= RTIO_SQE_TRANSACTION;
+		}
+	}
+
+	res = rtio_submit(r, 0);
+	zassert_ok(res, "Should return ok from rtio_execute");
+
+	/* The first chain is done on iodev 0, the transaction is not */
+	k_msleep(40);
+	zassert_equal(atomic_get(&data->submit_count) - submitted, 1,
+		      "Expected a single chain handed to iodev 1");
+
+	for (int i = 0; i < BUSY_TXN_LEN + 2; i++) {
+		cqe = rtio_cqe_consume_block(r);
+		zassert_ok(cqe->result, "Result should be ok");
+		rtio_cqe_release(r, cqe);
+	}
+
+	zassert_equal(atomic_get(&data->submit_count) - submitted, 2,
+		      "Expected both chains handed to iodev 1");
+}
+
+#define SYNC_CALLBACKS 8
+
+RTIO_DEFINE(r_sync, SYNC_CALLBACKS, SYNC_CALLBACKS);
+
+static uintptr_t sync_stack_min, sync_stack_max;
+
+static void sync_stack_cb(struct rtio *r, const struct rtio_sqe *sqe, void *arg0)
+{
+	int local;
+	uintptr_t sp = (uintptr_t)&local;
+
+	sync_stack_min = MIN(sync_stack_min, sp);
+	sync_stack_max = MAX(sync_stack_max, sp);
+}
+
+/**
+ * @brief Test chains completing synchronously
+ *
+ * Callbacks complete from within their start. The chains started as they
+ * complete are all run from the same stack depth, rather than one level
+ * deeper per chain.
+ */
+ZTEST(rtio_api, test_rtio_sync_completions)
+{
+	struct rtio *r = &r_sync;
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	int res;
+
+	sync_stack_min = UINTPTR_MAX;
+	sync_stack_max = 0;
+
+	for (int i = 0; i < SYNC_CALLBACKS; i++) {
+		sqe = rtio_sqe_acquire(r);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_callback(sqe, sync_stack_cb, NULL, NULL);
+	}
+
+	res = rtio_submit(r, SYNC_CALLBACKS);
+	zassert_ok(res, "Should return ok from rtio_execute");
+
+	for (int i = 0; i < SYNC_CALLBACKS; i++) {
+		cqe = rtio_cqe_consume(r);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_ok(cqe->result, "Result should be ok");
+		rtio_cqe_release(r, cqe);
+	}
+
+	zassert_equal(sync_stack_min, sync_stack_max,
+		      "Expected the callbacks to run at the same stack depth");
+}
+#endif /* CONFIG_RTIO_EXECUTOR_CONCURRENT */
+
 #define THROUGHPUT_ITERS 100000
 RTIO_DEFINE(r_throughput, SQE_POOL_SIZE, CQE_POOL_SIZE);
 
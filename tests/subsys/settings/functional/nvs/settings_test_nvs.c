@@ -6,6 +6,10 @@
 #include <errno.h>
 #include <zephyr/settings/settings.h>
 #include <zephyr/fs/nvs.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "settings/settings_nvs.h"
 
 ZTEST(settings_functional, test_setting_storage_get)
 {
@@ -23,4 +27,94 @@ ZTEST(settings_functional, test_setting_storage_get)
 
 	zassert_true(nvs_rc >= 0, "Can't read nvs record (err=%d).", rc);
 }
+#define NAME_CNT 40
+
+static uint32_t loaded[NAME_CNT];
+
+static int name_loader(const char *key, size_t len, settings_read_cb read_cb,
+		       void *cb_arg, void *param)
+{
+	uint32_t val;
+	int i;
+
+	zassert_equal(len, sizeof(val));
+	zassert_equal(read_cb(cb_arg, &val, sizeof(val)), sizeof(val));
+
+	/* Keys are "k<i>" or "n<i>", the value tells which one was found */
+	i = atoi(key + 1);
+	zassert_true(i >= 0 && i < NAME_CNT, "unexpected key %s", key);
+	loaded[i] = val;
+
+	return 0;
+}
+
+static uint16_t last_name_id(void)
+{
+	void *storage;
+	uint16_t id;
+
+	zassert_equal(settings_storage_get(&storage), 0);
+	zassert_equal(nvs_read(storage, NVS_NAMECNT_ID, &id, sizeof(id)),
+		      sizeof(id));
+
+	return id;
+}
+
+/* Overwrite, delete and add settings, checking that the NVS entries of
+ * deleted names get reused and that the stored values are all found again.
+ */
+ZTEST(settings_functional, test_name_reuse)
+{
+	char name[16];
+	uint16_t last_id;
+	uint32_t val;
+	int rc;
+
+	settings_subsys_init();
+
+	for (int i = 0; i < NAME_CNT; i++) {
+		snprintf(name, sizeof(name), "nr/k%d", i);
+		val = i;
+		rc = settings_save_one(name, &val, sizeof(val));
+		zassert_equal(rc, 0, "save of %s failed (err=%d)", name, rc);
+	}
+
+	last_id = last_name_id();
+
+	for (int i = 0; i < NAME_CNT; i++) {
+		snprintf(name, sizeof(name), "nr/k%d", i);
+		if ((i % 3) == 0) {
+			rc = settings_delete(name);
+		} else {
+			val = i + 1000;
+			rc = settings_save_one(name, &val, sizeof(val));
+		}
+		zassert_equal(rc, 0, "update of %s failed (err=%d)", name, rc);
+	}
+
+	for (int i = 0; i < NAME_CNT; i += 3) {
+		snprintf(name, sizeof(name), "nr/n%d", i);
+		val = i + 2000;
+		rc = settings_save_one(name, &val, sizeof(val));
+		zassert_equal(rc, 0, "save of %s failed (err=%d)", name, rc);
+	}
+
+	zassert_equal(last_name_id(), last_id, "deleted name entries not reused");
+
+	memset(loaded, 0, sizeof(loaded));
+	rc = settings_load_subtree_direct("nr", name_loader, NULL);
+	zassert_equal(rc, 0);
+
+	for (int i = 0; i < NAME_CNT; i++) {
+		zassert_equal(loaded[i], ((i % 3) == 0) ? i + 2000 : i + 1000,
+			      "wrong value for setting %d", i);
+	}
+
+	/* Saving an existing name after a load must not add a new entry */
+	val = 3000;
+	rc = settings_save_one("nr/k1", &val, sizeof(val));
+	zassert_equal(rc, 0);
+	zassert_equal(last_name_id(), last_id);
+}
+
 ZTEST_SUITE(settings_functional, NULL, NULL, NULL, NULL, NULL);
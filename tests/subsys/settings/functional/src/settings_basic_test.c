@@ -166,6 +166,65 @@ ZTEST(settings_functional, test_support_rtn)
 
 }
 
+static int lookup_set(const char *key, size_t len, settings_read_cb read_cb,
+		      void *cb_arg)
+{
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(lookup_b, "lk/a/b", NULL, lookup_set, NULL, NULL);
+SETTINGS_STATIC_HANDLER_DEFINE(lookup_root, "lk", NULL, lookup_set, NULL, NULL);
+SETTINGS_STATIC_HANDLER_DEFINE(lookup_a, "lk/a", NULL, lookup_set, NULL, NULL);
+SETTINGS_STATIC_HANDLER_DEFINE(lookup_x, "lkx", NULL, lookup_set, NULL, NULL);
+
+/*
+ * Test that the handler of a setting is the one with the longest name
+ * matching whole leading components of the setting name.
+ */
+ZTEST(settings_functional, test_static_lookup)
+{
+	static const struct {
+		const char *name;
+		const char *handler;
+		int next;
+	} lookups[] = {
+		{ "lk", "lk", -1 },
+		{ "lk=", "lk", -1 },
+		{ "lk/c", "lk", 3 },
+		{ "lk/ab", "lk", 3 },
+		{ "lk/a", "lk/a", -1 },
+		{ "lk/a/c/d", "lk/a", 5 },
+		{ "lk/a/b", "lk/a/b", -1 },
+		{ "lk/a/b/c=", "lk/a/b", 7 },
+		{ "lkx/a", "lkx", 4 },
+		{ "lky", NULL, -1 },
+		{ "l", NULL, -1 },
+	};
+	struct settings_handler_static *ch;
+	const char *next;
+
+	settings_subsys_init();
+
+	for (int i = 0; i < ARRAY_SIZE(lookups); i++) {
+		ch = settings_parse_and_lookup(lookups[i].name, &next);
+
+		if (lookups[i].handler == NULL) {
+			zassert_is_null(ch, "%s has a handler", lookups[i].name);
+			continue;
+		}
+
+		zassert_not_null(ch, "%s has no handler", lookups[i].name);
+		zassert_equal(strcmp(ch->name, lookups[i].handler), 0,
+			      "%s found %s", lookups[i].name, ch->name);
+		if (lookups[i].next < 0) {
+			zassert_is_null(next, "%s has a next", lookups[i].name);
+		} else {
+			zassert_equal_ptr(next, lookups[i].name + lookups[i].next,
+					  "%s has a wrong next", lookups[i].name);
+		}
+	}
+}
+
 struct stored_data {
 	uint8_t val1;
 	uint8_t val2;
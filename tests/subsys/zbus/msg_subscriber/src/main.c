@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/irq_offload.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+LOG_MODULE_DECLARE(zbus, CONFIG_ZBUS_LOG_LEVEL);
+
+struct sensor_data_msg {
+	int a;
+	int b;
+};
+
+static bool positive_validator(const void *msg, size_t msg_size)
+{
+	const struct sensor_data_msg *data = msg;
+
+	return data->a >= 0;
+}
+
+ZBUS_CHAN_DEFINE(sensor_chan,		 /* Name */
+		 struct sensor_data_msg, /* Message type */
+
+		 positive_validator,			  /* Validator */
+		 NULL,					  /* User data */
+		 ZBUS_OBSERVERS(lis, sub, msub1, msub2), /* observers */
+		 ZBUS_MSG_INIT(0)			  /* Initial value */
+);
+
+static int count_callback;
+static void callback(const struct zbus_channel *chan)
+{
+	++count_callback;
+}
+
+ZBUS_LISTENER_DEFINE(lis, callback);
+ZBUS_SUBSCRIBER_DEFINE(sub, 8);
+ZBUS_MSG_SUBSCRIBER_DEFINE(msub1);
+ZBUS_MSG_SUBSCRIBER_DEFINE(msub2);
+ZBUS_MSG_SUBSCRIBER_DEFINE(msub3);
+
+static void drain(void)
+{
+	const struct zbus_channel *chan;
+	struct sensor_data_msg msg;
+
+	while (zbus_sub_wait(&sub, &chan, K_NO_WAIT) == 0) {
+	}
+
+	while (zbus_sub_wait_msg(&msub1, &chan, &msg, K_NO_WAIT) == 0) {
+	}
+
+	while (zbus_sub_wait_msg(&msub2, &chan, &msg, K_NO_WAIT) == 0) {
+	}
+
+	while (zbus_sub_wait_msg(&msub3, &chan, &msg, K_NO_WAIT) == 0) {
+	}
+
+	count_callback = 0;
+}
+
+static void check_msgs(const struct zbus_observer *msub, int first, int count)
+{
+	const struct zbus_channel *chan;
+	struct sensor_data_msg msg;
+
+	for (int i = first; i < first + count; i++) {
+		zassert_equal(0, zbus_sub_wait_msg(msub, &chan, &msg, K_NO_WAIT), "%s missed %d",
+			      zbus_obs_name(msub), i);
+		zassert_equal_ptr(&sensor_chan, chan, NULL);
+		zassert_equal(i, msg.a, "%s got %d instead of %d", zbus_obs_name(msub), msg.a, i);
+		zassert_equal(-i, msg.b, NULL);
+	}
+
+	zassert_equal(-ENOMSG, zbus_sub_wait_msg(msub, &chan, &msg, K_NO_WAIT), NULL);
+}
+
+ZTEST(msg_subscriber, test_every_message_delivered)
+{
+	struct sensor_data_msg msg;
+
+	/* Messages published before the message subscribers run are all kept */
+	for (int i = 1; i <= 5; i++) {
+		msg.a = i;
+		msg.b = -i;
+		zassert_equal(0, zbus_chan_pub(&sensor_chan, &msg, K_MSEC(100)), NULL);
+	}
+
+	zassert_equal(5, count_callback, NULL);
+
+	check_msgs(&msub1, 1, 5);
+	check_msgs(&msub2, 1, 5);
+
+	/* The channel holds the last message */
+	zassert_equal(0, zbus_chan_read(&sensor_chan, &msg, K_NO_WAIT), NULL);
+	zassert_equal(5, msg.a, NULL);
+
+	/* Disabled message subscribers get nothing */
+	zbus_obs_set_enable(&msub2, false);
+	msg.a = 6;
+	msg.b = -6;
+	zassert_equal(0, zbus_chan_pub(&sensor_chan, &msg, K_MSEC(100)), NULL);
+	zbus_obs_set_enable(&msub2, true);
+
+	check_msgs(&msub1, 6, 1);
+	check_msgs(&msub2, 6, 0);
+
+	/* Notifying sends the current message again */
+	zassert_equal(0, zbus_chan_notify(&sensor_chan, K_MSEC(100)), NULL);
+	check_msgs(&msub1, 6, 1);
+	check_msgs(&msub2, 6, 1);
+}
+
+ZTEST(msg_subscriber, test_runtime_msg_subscriber)
+{
+	struct sensor_data_msg msg = {.a = 7, .b = -7};
+
+	zassert_equal(0, zbus_chan_add_obs(&sensor_chan, &msub3, K_MSEC(100)), NULL);
+	zassert_equal(0, zbus_chan_pub(&sensor_chan, &msg, K_MSEC(100)), NULL);
+	zassert_equal(0, zbus_chan_rm_obs(&sensor_chan, &msub3, K_MSEC(100)), NULL);
+
+	check_msgs(&msub1, 7, 1);
+	check_msgs(&msub3, 7, 1);
+}
+
+ZTEST(msg_subscriber, test_wait_msg)
+{
+	const struct zbus_channel *chan;
+	struct sensor_data_msg msg;
+
+	zassert_equal(-ENOMSG, zbus_sub_wait_msg(&msub1, &chan, &msg, K_NO_WAIT), NULL);
+	zassert_equal(-EAGAIN, zbus_sub_wait_msg(&msub1, &chan, &msg, K_MSEC(10)), NULL);
+
+	/* Each kind of subscriber has its own wait */
+	zassert_equal(-EINVAL, zbus_sub_wait_msg(&sub, &chan, &msg, K_NO_WAIT), NULL);
+	zassert_equal(-EINVAL, zbus_sub_wait(&msub1, &chan, K_NO_WAIT), NULL);
+}
+
+static int isr_result[3];
+
+static void isr_publish(const void *param)
+{
+	ARG_UNUSED(param);
+
+	for (int i = 0; i < ARRAY_SIZE(isr_result); i++) {
+		struct sensor_data_msg msg = {.a = 10 + i, .b = -(10 + i)};
+
+		isr_result[i] = zbus_chan_pub_isr(&sensor_chan, &msg);
+	}
+}
+
+static void isr_publish_invalid(const void *param)
+{
+	struct sensor_data_msg msg = {.a = -1};
+
+	ARG_UNUSED(param);
+
+	isr_result[0] = zbus_chan_pub_isr(&sensor_chan, &msg);
+}
+
+ZTEST(msg_subscriber, test_pub_isr)
+{
+	const struct zbus_channel *chan;
+	struct sensor_data_msg msg;
+
+	irq_offload(isr_publish, NULL);
+
+	for (int i = 0; i < ARRAY_SIZE(isr_result); i++) {
+		zassert_equal(0, isr_result[i], "publish %d failed", i);
+	}
+
+	/* Publishing is completed by the system work queue */
+	k_msleep(10);
+
+	zassert_equal(3, count_callback, NULL);
+	for (int i = 0; i < ARRAY_SIZE(isr_result); i++) {
+		zassert_equal(0, zbus_sub_wait(&sub, &chan, K_NO_WAIT), NULL);
+		zassert_equal_ptr(&sensor_chan, chan, NULL);
+	}
+
+	check_msgs(&msub1, 10, 3);
+	check_msgs(&msub2, 10, 3);
+
+	zassert_equal(0, zbus_chan_read(&sensor_chan, &msg, K_NO_WAIT), NULL);
+	zassert_equal(12, msg.a, NULL);
+
+	/* Invalid messages are rejected right away */
+	irq_offload(isr_publish_invalid, NULL);
+	zassert_equal(-ENOMSG, isr_result[0], NULL);
+
+	k_msleep(10);
+	zassert_equal(3, count_callback, NULL);
+}
+
+static void before(void *f)
+{
+	ARG_UNUSED(f);
+
+	drain();
+}
+
+ZTEST_SUITE(msg_subscriber, NULL, NULL, before, NULL, NULL);